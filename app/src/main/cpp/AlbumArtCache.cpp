@@ -0,0 +1,187 @@
+#include "include/AlbumArtCache.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <dirent.h>
+#include <strings.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <android/log.h>
+
+#define LOG_TAG "AlbumArtCache"
+#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+namespace pancakemusicbox {
+
+namespace {
+
+// 폴더 아트 파일 이름 (앞쪽이 우선, 대소문자 무시)
+const char* const kFolderArtNames[] = {"cover", "folder", "front", "albumart", "album"};
+const char* const kFolderArtExtensions[] = {"jpg", "jpeg", "png"};
+
+uint64_t mix64(uint64_t k) {
+    k ^= k >> 33;
+    k *= 0xFF51AFD7ED558CCDULL;
+    k ^= k >> 33;
+    k *= 0xC4CEB9FE1A85EC53ULL;
+    k ^= k >> 33;
+    return k;
+}
+
+// 이미지 내용 해시 (8바이트 단위로 섞는 MurmurHash 계열, 길이도 섞어 넣음)
+uint64_t contentHash(const uint8_t* data, size_t size) {
+    uint64_t hash = 0x9E3779B97F4A7C15ULL ^ (size * 0xC6A4A7935BD1E995ULL);
+    size_t pos = 0;
+    for (; pos + 8 <= size; pos += 8) {
+        uint64_t word;
+        memcpy(&word, data + pos, 8);
+        hash = (hash ^ mix64(word)) * 0xC6A4A7935BD1E995ULL;
+    }
+    uint64_t tail = 0;
+    memcpy(&tail, data + pos, size - pos);
+    hash ^= mix64(tail ^ (size - pos));
+    return mix64(hash);
+}
+
+const char* imageExtension(const uint8_t* data, size_t size) {
+    if (size > 8 && data[0] == 0x89 && data[1] == 'P') return "png";
+    if (size > 12 && memcmp(data, "RIFF", 4) == 0) return "webp";
+    if (size > 6 && memcmp(data, "GIF8", 4) == 0) return "gif";
+    return "jpg";
+}
+
+bool writeAll(int fd, const uint8_t* data, size_t size) {
+    while (size > 0) {
+        ssize_t written = write(fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+} // namespace
+
+bool AlbumArtCache::setDirectory(const std::string& directoryPath) {
+    std::lock_guard<std::mutex> lock(mutex);
+    storedHashes.clear();
+    folderArtByDirectory.clear();
+    cacheDirectory.clear();
+    if (directoryPath.empty()) {
+        return true;
+    }
+    if (mkdir(directoryPath.c_str(), 0755) != 0 && errno != EEXIST) {
+        LOGE("Cannot create artwork cache directory %s: %s", directoryPath.c_str(), strerror(errno));
+        return false;
+    }
+    cacheDirectory = directoryPath;
+    if (cacheDirectory.back() == '/') {
+        cacheDirectory.pop_back();
+    }
+    LOGI("Artwork cache directory: %s", cacheDirectory.c_str());
+    return true;
+}
+
+bool AlbumArtCache::isEnabled() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return !cacheDirectory.empty();
+}
+
+std::string AlbumArtCache::store(const uint8_t* data, size_t size) {
+    if (data == nullptr || size == 0) {
+        return "";
+    }
+    // 해시는 락 밖에서 계산 (작업자마다 동시에)
+    uint64_t hash = contentHash(data, size);
+    char name[32];
+    snprintf(name, sizeof(name), "/%016llx.%s", static_cast<unsigned long long>(hash), imageExtension(data, size));
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (cacheDirectory.empty()) {
+        return "";
+    }
+    std::string path = cacheDirectory + name;
+    if (storedHashes.count(hash) > 0) {
+        return path;
+    }
+    // 이전 실행에서 저장한 파일
+    struct stat st;
+    if (stat(path.c_str(), &st) == 0 && static_cast<size_t>(st.st_size) == size) {
+        storedHashes.insert(hash);
+        return path;
+    }
+
+    // 임시 파일에 쓴 뒤 이름을 바꿔, 읽는 쪽이 쓰다 만 파일을 보지 않게 함
+    std::string tempPath = path + ".tmp";
+    int fd = open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        LOGE("Cannot create artwork file %s: %s", tempPath.c_str(), strerror(errno));
+        return "";
+    }
+    bool written = writeAll(fd, data, size);
+    if (close(fd) != 0) {
+        written = false;
+    }
+    if (!written || rename(tempPath.c_str(), path.c_str()) != 0) {
+        LOGE("Cannot write artwork file %s: %s", path.c_str(), strerror(errno));
+        unlink(tempPath.c_str());
+        return "";
+    }
+    storedHashes.insert(hash);
+    return path;
+}
+
+std::string AlbumArtCache::findFolderArt(const std::string& directoryPath) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto cached = folderArtByDirectory.find(directoryPath);
+        if (cached != folderArtByDirectory.end()) {
+            return cached->second;
+        }
+    }
+
+    // 디렉토리를 한 번 읽어 후보 이름 중 우선순위가 가장 높은 파일을 고름
+    std::string found;
+    size_t bestRank = sizeof(kFolderArtNames) / sizeof(kFolderArtNames[0]);
+    if (DIR* dir = opendir(directoryPath.c_str())) {
+        while (struct dirent* entry = readdir(dir)) {
+            const char* dot = strrchr(entry->d_name, '.');
+            if (dot == nullptr) {
+                continue;
+            }
+            bool imageFile = false;
+            for (const char* extension : kFolderArtExtensions) {
+                imageFile = imageFile || strcasecmp(dot + 1, extension) == 0;
+            }
+            if (!imageFile) {
+                continue;
+            }
+            size_t stemLength = static_cast<size_t>(dot - entry->d_name);
+            for (size_t rank = 0; rank < bestRank; rank++) {
+                if (strlen(kFolderArtNames[rank]) == stemLength &&
+                    strncasecmp(entry->d_name, kFolderArtNames[rank], stemLength) == 0) {
+                    bestRank = rank;
+                    found = directoryPath + "/" + entry->d_name;
+                    break;
+                }
+            }
+        }
+        closedir(dir);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    folderArtByDirectory[directoryPath] = found;
+    return found;
+}
+
+void AlbumArtCache::clearFolderArtCache() {
+    std::lock_guard<std::mutex> lock(mutex);
+    folderArtByDirectory.clear();
+}
+
+} // namespace pancakemusicbox
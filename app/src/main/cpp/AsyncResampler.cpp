@@ -0,0 +1,75 @@
+#include "include/AsyncResampler.h"
+#include "include/DspKernels.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+void AsyncResampler::configure(int channelCount, int32_t maxInputFrames) {
+    mChannelCount = channelCount;
+    mMaxInputFrames = maxInputFrames;
+    mBuffer.assign(static_cast<size_t>(kHistoryFrames + maxInputFrames) * channelCount, 0.0f);
+    mAntiAliasState.assign(static_cast<size_t>(kAntiAliasSections) * channelCount, BiquadState());
+    reset();
+}
+
+void AsyncResampler::reset() {
+    mPhase = 0.0;
+    std::fill(mBuffer.begin(), mBuffer.end(), 0.0f);
+    for (BiquadState& state : mAntiAliasState) {
+        state.reset();
+    }
+}
+
+void AsyncResampler::setNominalRatio(double nominalRatio) {
+    if (nominalRatio == mNominalRatio) {
+        return;
+    }
+    mNominalRatio = nominalRatio;
+
+    bool active = nominalRatio > kAntiAliasMinRatio;
+    if (active && !mAntiAliasActive) {
+        for (BiquadState& state : mAntiAliasState) {
+            state.reset();
+        }
+    }
+    mAntiAliasActive = active;
+    if (!active) {
+        return;
+    }
+
+    // 입력 샘플레이트를 1로 둔 정규화 주파수로 설계 (트랙 경계에서만 바뀌므로 상태는 유지)
+    // Butterworth 섹션별 Q = 1 / (2cos((2k - 1)π / 2N)), N = 8
+    const float cutoff = static_cast<float>(kAntiAliasCutoff / nominalRatio);
+    for (int k = 0; k < kAntiAliasSections; k++) {
+        double angle = (2 * k + 1) * M_PI / (4.0 * kAntiAliasSections);
+        float q = static_cast<float>(1.0 / (2.0 * std::cos(angle)));
+        mAntiAlias[k] = BiquadCoefficients::lowPass(1.0f, cutoff, q);
+    }
+}
+
+void AsyncResampler::applyAntiAlias(float* input, int32_t inputFrames) {
+    DspKernels::active().biquadCascade(input, inputFrames, mChannelCount, mAntiAlias, mAntiAliasState.data(),
+                                       kAntiAliasSections, mChannelCount);
+}
+
+int32_t AsyncResampler::getInputFramesNeeded(int32_t outputFrames, double ratio) const {
+    // 블록 끝 위치의 정수 부분만큼 소비하고 소수 부분은 다음 블록 위상으로 넘김
+    return static_cast<int32_t>(std::floor(mPhase + outputFrames * ratio));
+}
+
+void AsyncResampler::process(int32_t inputFrames, float* output, int32_t outputFrames, double ratio) {
+    const int channels = mChannelCount;
+
+    // 새 입력만 제자리에서 거름 (히스토리는 이전 블록에서 이미 걸러진 샘플)
+    if (mAntiAliasActive) {
+        applyAntiAlias(getInputBuffer(), inputFrames);
+    }
+
+    // 출력 위치는 [히스토리 | 입력]의 1번 프레임부터 시작 (앞뒤로 한 프레임씩 보간에 사용)
+    DspKernels::active().resampleCubic(mBuffer.data(), channels, output, outputFrames, mPhase, ratio);
+
+    // 마지막 입력 프레임들을 다음 블록의 히스토리로 이동
+    memmove(mBuffer.data(), mBuffer.data() + static_cast<size_t>(inputFrames) * channels,
+            static_cast<size_t>(kHistoryFrames) * channels * sizeof(float));
+    mPhase = mPhase + outputFrames * ratio - inputFrames;
+}
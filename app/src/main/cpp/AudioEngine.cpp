@@ -1,11 +1,65 @@
 #include "include/AudioEngine.h"
+#include "include/DspKernels.h"
+#include "include/ReadAheadFile.h"
+#include "include/ThreadPriority.h"
 #include <android/log.h>
+#include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <cstring>
+#include <ctime>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
+namespace {
+
+constexpr uint64_t kChecksumSeed = 1469598103934665603ULL; // FNV-1a 64비트 offset basis
+constexpr int64_t kWriteTimeoutNanos = 100 * 1000000LL;      // 블로킹 쓰기 최대 대기 (일시정지 전환 대비)
+
+oboe::AudioFormat toOboeFormat(SampleFormat format) {
+    switch (format) {
+        case SampleFormat::Int16: return oboe::AudioFormat::I16;
+        case SampleFormat::Int24: return oboe::AudioFormat::I24;
+        default: return oboe::AudioFormat::Float;
+    }
+}
+
+size_t getOboeBytesPerSample(oboe::AudioFormat format) {
+    switch (format) {
+        case oboe::AudioFormat::I16: return 2;
+        case oboe::AudioFormat::I24: return 3;
+        default: return 4;
+    }
+}
+
+// 교체되어 분리된 이전 스트림 종료 (락을 기다리는 콜백 때문에 close가 막히지 않도록 mLock 밖에서 호출)
+// 남은 프레임은 새 스트림이 이어서 재생하므로 stop으로 흘려보내지 않고 일시정지 후 버림
+void closeDetachedStream(const std::shared_ptr<oboe::AudioStream>& stream) {
+    if (stream) {
+        stream->requestPause();
+        stream->requestFlush();
+        stream->close();
+    }
+}
+
+int64_t getThreadCpuNanos() {
+    timespec time{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+    return static_cast<int64_t>(time.tv_sec) * 1000000000LL + time.tv_nsec;
+}
+
+uint64_t updateChecksum(uint64_t hash, const uint8_t* data, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+} // namespace
+
 #define LOG_TAG "AudioEngine"
 #define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
 #define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
@@ -16,81 +70,236 @@ AudioEngine::AudioEngine() {
     
     // 시각화 데이터 버퍼 초기화
     mVisualizationData.resize(20, 0.0f);
+    mBandEnergies.resize(mVisualizationData.size(), 0.0f);
+    
+    // CPU 기능 감지 및 DSP 커널 선택을 오디오 콜백 이전에 완료
+    LOGI("Using %s DSP kernels", DspKernels::active().name);
+    
+    // 타임 스트레치 버퍼 할당
+    mTimeStretcher.configure(mSampleRate, mChannelCount);
+    mStretchInput.resize(static_cast<size_t>(kStretchChunkFrames) * mChannelCount);
     
     LOGI("AudioEngine created");
 }
 
 AudioEngine::~AudioEngine() {
+    std::lock_guard<std::mutex> lock(mLock);
     closeOutputStream();
     LOGI("AudioEngine destroyed");
 }
 
 bool AudioEngine::loadFile(const std::string& filePath) {
-    std::lock_guard<std::mutex> lock(mLock);
-    
-    // 현재 재생 중인 스트림 정리
-    stop();
-    
+    auto loadStart = std::chrono::steady_clock::now();
     LOGI("Loading file: %s", filePath.c_str());
     
-    // 실제 구현에서는 여기서 오디오 파일을 로드하고 디코딩해야 함
-    // 이 예제에서는 로드 성공을 가정하고 간단한 사인파 형태의 데이터 생성
-    
-    mSampleRate = 44100;
-    mChannelCount = 2;
-    mBitDepth = 16;
-    
-    // 임의의 오디오 데이터 생성 (20초 길이의 사인파)
-    int totalFrames = mSampleRate * 20; // 20초
-    mAudioData.resize(totalFrames * mChannelCount);
-    
-    // 440Hz 사인파 생성
-    float frequency = 440.0f;
-    for (int i = 0; i < totalFrames; i++) {
-        float sample = 0.5f * sinf(2.0f * M_PI * frequency * i / mSampleRate);
-        for (int ch = 0; ch < mChannelCount; ch++) {
-            mAudioData[i * mChannelCount + ch] = sample;
+    // 캐시에 디코딩 결과가 있으면 디코딩 과정을 건너뜀
+    // (preloadFile과 같이 디코딩은 엔진 락 밖에서 수행하여 재생 콜백과 렌더 스레드를 막지 않음)
+    DecodedAudioKey key = makeCacheKey(filePath);
+    std::shared_ptr<const DecodedAudio> audio = mDecodedCache.get(key);
+    if (audio) {
+        LOGI("Decoded audio cache hit: %s", filePath.c_str());
+    } else {
+        audio = decodeFile(key);
+        if (!audio) {
+            LOGE("Failed to decode file: %s", filePath.c_str());
+            return false;
         }
+        mDecodedCache.put(key, audio);
     }
     
-    mTotalFrames = totalFrames;
+    // 디코딩이 끝난 뒤에만 락을 잡고 현재 재생을 정리한 다음 트랙 데이터 교체
+    std::unique_lock<std::mutex> lock(mLock);
+    stopLocked();
+    
+    mAudioData = audio;
+    mFilePath = filePath;
+    mSampleRate = audio->getSampleRate();
+    mChannelCount = audio->getChannelCount();
+    mBitDepth = audio->getBitDepth();
+    mTotalFrames = audio->getTotalFrames();
     mCurrentFrame = 0;
+    mOutputChecksum = kChecksumSeed;
+    mDspChain.reset();
+    mTimeStretcher.end();
     
-    // 오디오 스트림 설정
-    bool result = openOutputStream();
+    // 열려 있는 스트림이 새 트랙 형식과 맞으면 다시 열지 않고 재사용 (warm-start 스트림 포함)
+    std::shared_ptr<oboe::AudioStream> previous;
+    if (isStreamCompatibleLocked()) {
+        prepareRenderStateLocked();
+        updateBitPerfectStateLocked();
+    } else {
+        // 트랙 경계에서 새 형식의 스트림을 먼저 연 뒤 교체 (타임 스트레처도 새 형식으로 재설정됨)
+        previous = reconfigureStream(lock);
+    }
+    bool result = mAudioStream != nullptr;
+    mLoadMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - loadStart).count();
     if (result) {
         LOGI("File loaded successfully");
     } else {
         LOGE("Failed to load file or open output stream");
     }
     
+    lock.unlock();
+    closeDetachedStream(previous);
     return result;
 }
 
+bool AudioEngine::preloadFile(const std::string& filePath) {
+    DecodedAudioKey key = makeCacheKey(filePath);
+    if (mDecodedCache.contains(key)) {
+        return true;
+    }
+    
+    // 디코딩은 엔진 락 밖에서 수행하여 재생 콜백을 막지 않음
+    std::shared_ptr<const DecodedAudio> audio = decodeFile(key);
+    if (!audio) {
+        LOGE("Failed to preload file: %s", filePath.c_str());
+        return false;
+    }
+    
+    mDecodedCache.put(key, audio);
+    LOGI("Preloaded file: %s (cache %zu/%zu bytes)", filePath.c_str(),
+         mDecodedCache.getUsedBytes(), mDecodedCache.getBudgetBytes());
+    return true;
+}
+
+void AudioEngine::setDecodedCacheBudget(size_t budgetBytes) {
+    mDecodedCache.setBudgetBytes(budgetBytes);
+}
+
+void AudioEngine::setDecodedCacheCompact(bool compact) {
+    mDecodedCache.setCompactStorage(compact);
+    LOGI("Decoded cache compact storage %s", compact ? "enabled" : "disabled");
+}
+
+void AudioEngine::prefetchFile(const std::string& filePath) {
+    // 캐시에 이미 디코딩 결과가 있으면 파일을 읽을 필요 없음
+    if (mDecodedCache.contains(makeCacheKey(filePath))) {
+        return;
+    }
+    IoScheduler::getInstance().prefetchFile(filePath);
+}
+
+IoStats AudioEngine::getIoStats() const {
+    std::string filePath;
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        filePath = mFilePath;
+    }
+    return IoScheduler::getInstance().getStats(filePath);
+}
+
+DecodedAudioKey AudioEngine::makeCacheKey(const std::string& filePath) const {
+    // 현재 디코더는 44.1kHz / 스테레오 / 16비트로 출력
+    DecodedAudioKey key;
+    key.filePath = filePath;
+    key.sampleRate = 44100;
+    key.channelCount = 2;
+    key.bitDepth = 16;
+    return key;
+}
+
+std::shared_ptr<const DecodedAudio> AudioEngine::decodeFile(const DecodedAudioKey& key) {
+    // 디코더 입력은 read-ahead 리더를 통해 읽음
+    ReadAheadFile source;
+    if (!source.open(key.filePath)) {
+        return nullptr;
+    }
+    
+    // 실제 구현에서는 여기서 오디오 파일을 디코딩해야 함
+    // 이 예제에서는 실제 디코더와 같은 속도로 소스를 소비하면서 간단한 사인파 형태의 데이터 생성
+    
+    // 임의의 오디오 데이터 생성 (20초 길이의 사인파)
+    int64_t totalFrames = static_cast<int64_t>(key.sampleRate) * 20; // 20초
+    
+    // 소스 비트 폭 그대로 저장 (16비트 소스는 int16, 24비트 소스는 int24)
+    SampleFormat format = DecodedAudio::selectStorageFormat(key.bitDepth, mDecodedCache.isCompactStorage());
+    std::shared_ptr<DecodedAudio> audio = DecodedAudio::create(format, key.sampleRate, key.channelCount,
+                                                               key.bitDepth, totalFrames);
+    if (!audio) {
+        return nullptr;
+    }
+    
+    // 블록 단위로 디코딩하여 저장 형식으로 기록
+    constexpr int32_t kDecodeBlockFrames = 4096;
+    std::vector<float> block(static_cast<size_t>(kDecodeBlockFrames) * key.channelCount);
+    
+    // 디코더 블록당 소비할 소스 바이트 수 (디코더의 작은 read 요청을 흉내냄)
+    constexpr size_t kSourceChunkSize = 16 * 1024;
+    std::vector<uint8_t> sourceChunk(kSourceChunkSize);
+    int64_t sourceBytesPerBlock = totalFrames > 0 ? source.getSize() * kDecodeBlockFrames / totalFrames + 1 : 0;
+    
+    // 440Hz 사인파 생성
+    float frequency = 440.0f;
+    for (int64_t start = 0; start < totalFrames; start += kDecodeBlockFrames) {
+        int32_t frames = static_cast<int32_t>(std::min<int64_t>(kDecodeBlockFrames, totalFrames - start));
+        for (int64_t consumed = 0; consumed < sourceBytesPerBlock; ) {
+            size_t toRead = static_cast<size_t>(std::min<int64_t>(kSourceChunkSize, sourceBytesPerBlock - consumed));
+            ssize_t result = source.read(sourceChunk.data(), toRead);
+            if (result <= 0) {
+                break;
+            }
+            consumed += result;
+        }
+        for (int32_t i = 0; i < frames; i++) {
+            float sample = 0.5f * sinf(2.0f * M_PI * frequency * (start + i) / key.sampleRate);
+            for (int ch = 0; ch < key.channelCount; ch++) {
+                block[i * key.channelCount + ch] = sample;
+            }
+        }
+        audio->writeFrames(start, block.data(), frames);
+    }
+    
+    IoStats ioStats = source.getStats();
+    LOGI("Decoded %lld frames as %s (%zu bytes), read %llu bytes, %u stalls",
+         static_cast<long long>(totalFrames), getSampleFormatName(format), audio->getSizeInBytes(),
+         static_cast<unsigned long long>(ioStats.bytesRead), ioStats.stallCount);
+    return audio;
+}
+
 void AudioEngine::play() {
     std::lock_guard<std::mutex> lock(mLock);
-    
-    if (!mAudioStream || mAudioData.empty()) {
+    startLocked();
+}
+
+bool AudioEngine::startLocked() {
+    if (!mAudioStream || !mAudioData) {
         LOGE("Cannot play: stream not open or no audio data");
-        return;
+        return false;
     }
     
+    if (!mIsPlaying) {
+        // 첫 샘플이 렌더링될 때까지의 시간 측정 시작
+        mTapTime = std::chrono::steady_clock::now();
+        mTapPending = true;
+    }
+    mWarmIdleFrames = 0;
+    
+    // warm-start 스트림은 이미 무음으로 실행 중이므로 상태만 바꾸면 다음 버스트부터 재생
     if (mAudioStream->getState() != oboe::StreamState::Started) {
         oboe::Result result = mAudioStream->requestStart();
         if (result != oboe::Result::OK) {
             LOGE("Error starting stream: %s", oboe::convertToText(result));
-            return;
+            mTapPending = false;
+            return false;
         }
     }
     
     mIsPlaying = true;
+    mRenderCondition.notify_all();  // 블로킹 쓰기 모드 렌더 스레드 깨우기
     LOGI("Audio playback started");
+    return true;
 }
 
 void AudioEngine::pause() {
     std::lock_guard<std::mutex> lock(mLock);
     
-    if (mIsPlaying && mAudioStream) {
+    if (mIsPlaying && mAudioStream && mWarmStart) {
+        // warm-start 중에는 스트림을 멈추지 않고 무음 출력으로 전환 (유휴 시간이 지나면 멈춤)
+        mIsPlaying = false;
+        mWarmIdleFrames = 0;
+        LOGI("Audio playback paused (stream kept warm)");
+    } else if (mIsPlaying && mAudioStream) {
         oboe::Result result = mAudioStream->requestPause();
         if (result != oboe::Result::OK) {
             LOGE("Error pausing stream: %s", oboe::convertToText(result));
@@ -104,15 +313,22 @@ void AudioEngine::pause() {
 
 void AudioEngine::stop() {
     std::lock_guard<std::mutex> lock(mLock);
-    
+    stopLocked();
+}
+
+void AudioEngine::stopLocked() {
     if (mAudioStream) {
-        oboe::Result result = mAudioStream->requestStop();
-        if (result != oboe::Result::OK) {
-            LOGE("Error stopping stream: %s", oboe::convertToText(result));
+        // warm-start 중에는 스트림을 무음 상태로 계속 실행
+        if (!mWarmStart) {
+            oboe::Result result = mAudioStream->requestStop();
+            if (result != oboe::Result::OK) {
+                LOGE("Error stopping stream: %s", oboe::convertToText(result));
+            }
         }
         
         mIsPlaying = false;
         mCurrentFrame = 0;
+        mWarmIdleFrames = 0;
         LOGI("Audio playback stopped");
     }
 }
@@ -125,6 +341,9 @@ void AudioEngine::seekTo(int64_t positionMs) {
     if (newFrame >= mTotalFrames) newFrame = mTotalFrames - 1;
     
     mCurrentFrame = newFrame;
+    mOutputChecksum = kChecksumSeed;
+    mDspChain.reset();
+    resetTimeStretchLocked();
     LOGI("Seek to position: %lld ms (frame %lld)", positionMs, newFrame);
 }
 
@@ -135,7 +354,9 @@ bool AudioEngine::isPlaying() const {
 
 int64_t AudioEngine::getCurrentPosition() const {
     std::lock_guard<std::mutex> lock(mLock);
-    return (mCurrentFrame * 1000) / mSampleRate;
+    // 타임 스트레치 중에는 스트레처에 미리 공급한 프레임을 제외한 실제 재생 위치 사용
+    int64_t frame = mTimeStretcher.isActive() ? mTimeStretcher.getSourcePosition() : mCurrentFrame;
+    return (frame * 1000) / mSampleRate;
 }
 
 int64_t AudioEngine::getDuration() const {
@@ -144,41 +365,42 @@ int64_t AudioEngine::getDuration() const {
 }
 
 void AudioEngine::setSampleRate(int sampleRate) {
-    std::lock_guard<std::mutex> lock(mLock);
+    std::shared_ptr<oboe::AudioStream> previous;
+    std::unique_lock<std::mutex> lock(mLock);
     
     if (mSampleRate != sampleRate) {
         mSampleRate = sampleRate;
         LOGI("Sample rate changed to %d", sampleRate);
         
-        // 여기서 오디오 데이터 리샘플링 필요
-        // 실제 구현에서는 리샘플링 라이브러리(SRC 등) 사용해야 함
-        
-        // 스트림 재시작
+        // 새 레이트의 스트림을 먼저 연 뒤 교체 (기기가 거부하면 리샘플러로 변환)
         if (mAudioStream) {
-            restartStream();
+            previous = reconfigureStream(lock);
         }
     }
+    lock.unlock();
+    closeDetachedStream(previous);
 }
 
 void AudioEngine::setBitDepth(int bitDepth) {
-    std::lock_guard<std::mutex> lock(mLock);
+    std::shared_ptr<oboe::AudioStream> previous;
+    std::unique_lock<std::mutex> lock(mLock);
     
     if (mBitDepth != bitDepth) {
         mBitDepth = bitDepth;
         LOGI("Bit depth changed to %d", bitDepth);
         
-        // 스트림 포맷 업데이트 필요
-        // 실제 구현에서는 비트 뎁스에 따라 데이터 포맷 변환
-        
-        // 스트림 재시작
+        // 출력 형식은 트랙 원본 형식과 bit-perfect 설정으로 정해지므로 스트림 요청이 바뀐 경우에만 교체
         if (mAudioStream) {
-            restartStream();
+            previous = reconfigureStream(lock);
         }
     }
+    lock.unlock();
+    closeDetachedStream(previous);
 }
 
 void AudioEngine::setChannelCount(int channelCount) {
-    std::lock_guard<std::mutex> lock(mLock);
+    std::shared_ptr<oboe::AudioStream> previous;
+    std::unique_lock<std::mutex> lock(mLock);
     
     if (mChannelCount != channelCount && (channelCount == 1 || channelCount == 2)) {
         mChannelCount = channelCount;
@@ -187,17 +409,21 @@ void AudioEngine::setChannelCount(int channelCount) {
         // 채널 수 변환 필요
         // 실제 구현에서는 믹싱 또는 채널 분리 작업 필요
         
-        // 스트림 재시작
+        // 새 채널 수의 스트림을 먼저 연 뒤 교체
         if (mAudioStream) {
-            restartStream();
+            previous = reconfigureStream(lock);
         }
     }
+    lock.unlock();
+    closeDetachedStream(previous);
 }
 
 void AudioEngine::setVolume(float volume) {
     std::lock_guard<std::mutex> lock(mLock);
     
     mVolume = volume;
+    reconfigureDspLocked();
+    updateBitPerfectStateLocked();
     LOGI("Volume changed to %f", volume);
 }
 
@@ -205,6 +431,8 @@ void AudioEngine::enableEQ(bool enable) {
     std::lock_guard<std::mutex> lock(mLock);
     
     mEQEnabled = enable;
+    reconfigureDspLocked();
+    updateBitPerfectStateLocked();
     LOGI("EQ %s", enable ? "enabled" : "disabled");
 }
 
@@ -213,6 +441,7 @@ void AudioEngine::setEQBand(int band, float gain) {
     
     if (band >= 0 && band < mEQGains.size()) {
         mEQGains[band] = gain;
+        reconfigureDspLocked();
         LOGI("EQ band %d gain set to %f", band, gain);
     }
 }
@@ -221,6 +450,8 @@ void AudioEngine::enableVolumeNormalization(bool enable) {
     std::lock_guard<std::mutex> lock(mLock);
     
     mVolumeNormalizationEnabled = enable;
+    reconfigureDspLocked();
+    updateBitPerfectStateLocked();
     LOGI("Volume normalization %s", enable ? "enabled" : "disabled");
 }
 
@@ -228,50 +459,383 @@ void AudioEngine::setTargetLUFS(float lufsValue) {
     std::lock_guard<std::mutex> lock(mLock);
     
     mTargetLUFS = lufsValue;
+    reconfigureDspLocked();
     LOGI("Target LUFS set to %f", lufsValue);
 }
 
+void AudioEngine::enableLoudnessCompensation(bool enable) {
+    std::lock_guard<std::mutex> lock(mLock);
+    
+    mLoudnessCompensationEnabled = enable;
+    reconfigureDspLocked();
+    updateBitPerfectStateLocked();
+    LOGI("Loudness compensation %s", enable ? "enabled" : "disabled");
+}
+
+void AudioEngine::setPlaybackSpeed(float speed) {
+    std::lock_guard<std::mutex> lock(mLock);
+    
+    mTimeStretcher.setSpeed(speed);
+    
+    // 다음 콜백부터 현재 위치에서 스트레치 시작 (이미 진행 중이면 다음 홉부터 새 속도 적용)
+    if (mTimeStretcher.getSpeed() != 1.0f && !mTimeStretcher.isActive()) {
+        mTimeStretcher.begin(mCurrentFrame);
+    }
+    updateBitPerfectStateLocked();
+    
+    LOGI("Playback speed set to %.2f", mTimeStretcher.getSpeed());
+}
+
+float AudioEngine::getPlaybackSpeed() const {
+    std::lock_guard<std::mutex> lock(mLock);
+    return mTimeStretcher.getSpeed();
+}
+
+void AudioEngine::setTimeStretchMode(TimeStretchMode mode) {
+    std::lock_guard<std::mutex> lock(mLock);
+    mTimeStretcher.setMode(mode);
+    LOGI("Time stretch mode set to %s", mode == TimeStretchMode::Speech ? "speech (WSOLA)" : "music (phase vocoder)");
+}
+
+float AudioEngine::getTimeStretchLoad() const {
+    std::lock_guard<std::mutex> lock(mLock);
+    return mTimeStretcher.getCpuLoad();
+}
+
+void AudioEngine::enableBitPerfect(bool enable) {
+    std::lock_guard<std::mutex> lock(mLock);
+    
+    mBitPerfectEnabled = enable;
+    LOGI("Bit-perfect mode %s", enable ? "enabled" : "disabled");
+    
+    // 원본 형식으로 스트림을 다시 열어야 하는 경우에만 재시작
+    if (mAudioStream && selectStreamFormatLocked() != mStreamFormat) {
+        restartStream();
+    }
+    updateBitPerfectStateLocked();
+}
+
+bool AudioEngine::isBitPerfect() const {
+    std::lock_guard<std::mutex> lock(mLock);
+    return mBitPerfectActive;
+}
+
+uint64_t AudioEngine::getOutputChecksum() const {
+    std::lock_guard<std::mutex> lock(mLock);
+    return mOutputChecksum;
+}
+
+void AudioEngine::enableNightMode(bool enable) {
+    std::lock_guard<std::mutex> lock(mLock);
+    mNightModeEnabled = enable;
+    reconfigureDspLocked();
+    updateBitPerfectStateLocked();
+    LOGI("Night mode %s", enable ? "enabled" : "disabled");
+}
+
+void AudioEngine::setNightModeMakeupGain(float gainDb) {
+    std::lock_guard<std::mutex> lock(mLock);
+    mNightModeMakeupDb = std::max(0.0f, std::min(18.0f, gainDb));
+    reconfigureDspLocked();
+}
+
+CompressorMeters AudioEngine::getNightModeMeters() const {
+    // 미터는 원자 변수로 게시되므로 오디오 콜백과 경쟁하는 mLock을 잡지 않음
+    return mDspChain.getCompressorMeters();
+}
+
+bool AudioEngine::isDspNeutralLocked() const {
+    return mVolume == 1.0f && !mEQEnabled && !mVolumeNormalizationEnabled && !mNightModeEnabled &&
+           !mLoudnessCompensationEnabled &&
+           !(mHeadphoneOutput && !mCrossfeedBypassed) &&
+           mTimeStretcher.getSpeed() == 1.0f && !mTimeStretcher.isActive() &&
+           // 끈 단계도 페이드아웃이 끝나 체인에서 빠질 때까지는 처리 경로를 유지 (renderLocked에서 다시 확인)
+           !mDspChain.isCrossfeedActive() && !mDspChain.isCompressorActive();
+}
+
+SampleFormat AudioEngine::selectStreamFormatLocked() const {
+    // float16 압축 저장 데이터는 원본이 아니므로 bit-perfect 대상이 아님
+    if (mBitPerfectEnabled && mAudioData && mAudioData->isLossless()) {
+        return mAudioData->getFormat();
+    }
+    return SampleFormat::Float32;
+}
+
+void AudioEngine::updateBitPerfectStateLocked() {
+    bool active = mBitPerfectEnabled &&
+                  mAudioStream && mAudioData &&
+                  isDspNeutralLocked() &&
+                  mAudioData->isLossless() &&
+                  mStreamFormat == mAudioData->getFormat() &&
+                  !mStreamResampled &&
+                  mAudioStream->getSampleRate() == mAudioData->getSampleRate() &&
+                  mAudioStream->getChannelCount() == mAudioData->getChannelCount();
+    
+    if (active != mBitPerfectActive) {
+        mBitPerfectActive = active;
+        LOGI("Bit-perfect path %s", active ? "active" : "inactive");
+    }
+}
+
 void AudioEngine::optimizeForDevice(bool useHeadphones, bool isHighPerformanceDevice) {
     std::lock_guard<std::mutex> lock(mLock);
     
     LOGI("Optimizing for device: useHeadphones=%d, highPerformance=%d", 
          useHeadphones, isHighPerformanceDevice);
     
+    // 헤드폰 출력에서는 좌우 완전 분리로 인한 피로를 줄이기 위해 크로스피드 적용
+    mHeadphoneOutput = useHeadphones;
+    reconfigureDspLocked();
+    updateBitPerfectStateLocked();
+    
     // 실제 구현에서는 기기 특성에 맞게 버퍼 크기, 지연 설정, 성능 설정 등 조정
     // 여기서는 구현 생략
 }
 
+void AudioEngine::setCrossfeedPreset(CrossfeedPreset preset) {
+    std::lock_guard<std::mutex> lock(mLock);
+    mCrossfeedPreset = preset;
+    reconfigureDspLocked();
+    LOGI("Crossfeed preset set to %d", static_cast<int>(preset));
+}
+
+void AudioEngine::setCrossfeedBypass(bool bypass) {
+    std::lock_guard<std::mutex> lock(mLock);
+    // DSP 체인이 원음과 크로스피드 결과를 짧게 크로스페이드하므로 전환 시 끊김이 없음
+    // 바이패스로 돌려도 bit-perfect 경로는 페이드아웃이 끝난 뒤 renderLocked에서 켜짐
+    mCrossfeedBypassed = bypass;
+    reconfigureDspLocked();
+    updateBitPerfectStateLocked();
+    LOGI("Crossfeed bypass %s", bypass ? "on" : "off");
+}
+
+bool AudioEngine::isCrossfeedActive() const {
+    std::lock_guard<std::mutex> lock(mLock);
+    return mDspChain.isCrossfeedActive();
+}
+
 bool AudioEngine::openOutputStream() {
     // 기존 스트림 종료
     closeOutputStream();
     
-    // 출력 스트림 설정
-    oboe::AudioStreamBuilder builder;
-    
-    // 스트림 설정
-    builder.setDirection(oboe::Direction::Output)
-           ->setPerformanceMode(oboe::PerformanceMode::LowLatency)
-           ->setSharingMode(oboe::SharingMode::Exclusive)
-           ->setFormat(oboe::AudioFormat::Float)
-           ->setChannelCount(mChannelCount)
-           ->setSampleRate(mSampleRate)
-           ->setCallback(this);
-    
-    // 스트림 생성
-    oboe::Result result = builder.openStream(mAudioStream);
-    if (result != oboe::Result::OK) {
-        LOGE("Failed to open output stream: %s", oboe::convertToText(result));
+    StreamRequest request = makeStreamRequestLocked();
+    OpenedStream opened;
+    bool result = openStreamForRequest(request, opened);
+    if (result) {
+        installStreamLocked(opened, request);
+    }
+    
+    updateBitPerfectStateLocked();
+    return result;
+}
+
+AudioEngine::StreamRequest AudioEngine::makeStreamRequestLocked() const {
+    StreamRequest request;
+    request.format = selectStreamFormatLocked();
+    request.sampleRate = mSampleRate;
+    request.channelCount = mChannelCount;
+    request.deepBuffer = useDeepBufferLocked();
+    request.callback = mOutputMode == OutputMode::Callback;
+    request.hardwareRate = mAutoHardwareSwitching;
+    return request;
+}
+
+bool AudioEngine::openStreamForRequest(const StreamRequest& request, OpenedStream& opened) {
+    // 엔진 상태를 읽지 않으므로 mLock 없이 호출 가능 (이전 스트림이 재생되는 동안 새 스트림 준비)
+    auto openWith = [&](SampleFormat format, bool resample) {
+        oboe::AudioStreamBuilder builder;
+        
+        // 스트림 설정 (deep buffer는 믹서의 절전 경로를 쓰므로 공유 모드)
+        builder.setDirection(oboe::Direction::Output)
+               ->setPerformanceMode(request.deepBuffer ? oboe::PerformanceMode::PowerSaving
+                                                       : oboe::PerformanceMode::LowLatency)
+               ->setSharingMode(request.deepBuffer ? oboe::SharingMode::Shared : oboe::SharingMode::Exclusive)
+               ->setFormat(toOboeFormat(format))
+               ->setChannelCount(request.channelCount)
+               ->setSampleRate(request.sampleRate)
+               ->setSampleRateConversionQuality(resample ? oboe::SampleRateConversionQuality::Medium
+                                                         : oboe::SampleRateConversionQuality::None)
+               ->setCallback(request.callback ? this : nullptr);
+        
+        std::shared_ptr<oboe::AudioStream> stream;
+        oboe::Result result = builder.openStream(stream);
+        if (result != oboe::Result::OK) {
+            LOGE("Failed to open output stream: %s", oboe::convertToText(result));
+            return std::shared_ptr<oboe::AudioStream>();
+        }
+        return stream;
+    };
+    auto discard = [](std::shared_ptr<oboe::AudioStream>& stream) {
+        if (stream) {
+            stream->close();
+            stream.reset();
+        }
+    };
+    
+    // 자동 전환 중에는 하드웨어를 트랙 레이트로 열고, 꺼져 있으면 기기 레이트를 유지하고 리샘플러로 변환
+    SampleFormat format = request.format;
+    bool resample = !request.hardwareRate;
+    std::shared_ptr<oboe::AudioStream> stream = openWith(format, resample);
+    
+    // 기기가 트랙 레이트를 거부하면 (열기 실패 또는 다른 레이트로 열림) 리샘플러로 대체
+    if (!resample && (!stream || stream->getSampleRate() != request.sampleRate)) {
+        LOGI("Device refused %d Hz output, falling back to resampler", request.sampleRate);
+        discard(stream);
+        resample = true;
+        stream = openWith(format, resample);
+    }
+    
+    // 기기가 원본 형식을 지원하지 않으면 float 스트림으로 대체
+    if (stream && format != SampleFormat::Float32 && stream->getFormat() != toOboeFormat(format)) {
+        LOGI("Device does not support %s output, falling back to float", getSampleFormatName(format));
+        discard(stream);
+        format = SampleFormat::Float32;
+        stream = openWith(format, resample);
+    }
+    
+    if (!stream) {
         return false;
     }
     
-    LOGI("Audio stream opened: %d channels, %d Hz", 
+    opened.stream = std::move(stream);
+    opened.format = format;
+    opened.resampled = resample;
+    return true;
+}
+
+void AudioEngine::installStreamLocked(OpenedStream& opened, const StreamRequest& request) {
+    mAudioStream = std::move(opened.stream);
+    mStreamFormat = opened.format;
+    mStreamResampled = opened.resampled;
+    mStreamDeepBuffer = request.deepBuffer;
+    mStreamRequest = request;
+    prepareRenderStateLocked();
+    
+    mLastRenderUs = 0.0f;
+    mMaxRenderUs = 0.0f;
+    mRenderCount = 0;
+    mRenderRealtime = false;
+    
+    if (request.deepBuffer) {
+        // 버퍼를 최대로 채워 두고 드물게 깨어나 큰 블록 단위로 렌더링
+        mAudioStream->setBufferSizeInFrames(mAudioStream->getBufferCapacityInFrames());
+    } else if (mOutputMode == OutputMode::BlockingWrite) {
+        // 버퍼에는 지정한 버스트 수만큼만 유지하여 지연을 제한
+        mAudioStream->setBufferSizeInFrames(mAudioStream->getFramesPerBurst() * mBurstsInFlight);
+    }
+    if (mOutputMode == OutputMode::BlockingWrite) {
+        startRenderThreadLocked();
+    }
+    
+    // warm-start 중이면 재생 전부터 무음으로 실행하여 첫 재생 시 스트림 시작 지연 제거
+    if (mWarmStart) {
+        oboe::Result startResult = mAudioStream->requestStart();
+        if (startResult != oboe::Result::OK) {
+            LOGE("Error starting warm stream: %s", oboe::convertToText(startResult));
+        }
+    }
+    
+    LOGI("Audio stream opened: %d channels, %d Hz%s, %s, %s, %s (%d frames per burst)", 
          mAudioStream->getChannelCount(),
-         mAudioStream->getSampleRate());
+         mAudioStream->getSampleRate(),
+         mStreamResampled ? " (resampled)" : "",
+         getSampleFormatName(mStreamFormat),
+         mOutputMode == OutputMode::Callback ? "callback" : "blocking write",
+         request.deepBuffer ? "deep buffer" : "low latency",
+         mAudioStream->getFramesPerBurst());
+}
+
+std::shared_ptr<oboe::AudioStream> AudioEngine::reconfigureStream(std::unique_lock<std::mutex>& lock) {
+    StreamRequest request = makeStreamRequestLocked();
+    if (!mAudioStream) {
+        openOutputStream();
+        return nullptr;
+    }
+    if (request == mStreamRequest) {
+        return nullptr;
+    }
     
-    return true;
+    // 새 스트림은 락을 놓고 여는 동안 이전 스트림이 무음으로 계속 실행됨 (열기 비용이 전환 공백에 포함되지 않음)
+    // 렌더 스레드는 엔진 형식으로 쓰므로 먼저 종료하고, 콜백은 mStreamSwitchesPending을 보고 무음 출력
+    std::shared_ptr<oboe::AudioStream> expected = mAudioStream;
+    stopRenderThreadLocked();
+    // 여기까지 쓴 프레임만 트랙 오디오 (여는 동안 이전 스트림에는 무음만 쓰임)
+    int64_t audioFramesWritten = expected->getFramesWritten();
+    mStreamSwitchesPending++;
+    auto openStart = std::chrono::steady_clock::now();
+    lock.unlock();
+    OpenedStream opened;
+    bool result = openStreamForRequest(request, opened);
+    lock.lock();
+    mStreamSwitchesPending--;
+    float openMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - openStart).count();
+    
+    // 여는 동안 다른 호출이 스트림이나 설정을 바꿨으면 새 스트림을 버리고 현재 설정으로 다시 엶
+    if (!result || mAudioStream != expected || !(makeStreamRequestLocked() == request)) {
+        if (opened.stream) {
+            opened.stream->close();
+        }
+        if (!result) {
+            LOGE("Failed to open stream for %d Hz, reopening synchronously", request.sampleRate);
+        }
+        restartStream();
+        return nullptr;
+    }
+    
+    // 이전 스트림 분리 → 새 스트림 설치 및 시작까지가 실제 출력 공백
+    auto gapStart = std::chrono::steady_clock::now();
+    std::shared_ptr<oboe::AudioStream> previous = std::move(mAudioStream);
+    
+    // 이전 스트림을 멈춰 재생 위치를 고정하고, 버퍼에 남아 재생되지 않은 오디오만큼 되돌려 새 스트림에서 이어서 재생
+    // (남은 프레임은 closeDetachedStream에서 버림, 타임 스트레치 중에는 스트레처가 새 스트림 위치에서 다시 시작)
+    previous->requestPause();
+    if (mIsPlaying && !mTimeStretcher.isActive()) {
+        int64_t unplayed = audioFramesWritten - previous->getFramesRead();
+        if (unplayed > 0) {
+            mCurrentFrame = std::max<int64_t>(0, mCurrentFrame - unplayed);
+        }
+    }
+    installStreamLocked(opened, request);
+    if (mIsPlaying && mAudioStream->getState() != oboe::StreamState::Started) {
+        oboe::Result startResult = mAudioStream->requestStart();
+        if (startResult != oboe::Result::OK) {
+            LOGE("Error starting stream: %s", oboe::convertToText(startResult));
+        }
+        mRenderCondition.notify_all();
+    }
+    updateBitPerfectStateLocked();
+    
+    mSwitchOpenMs = openMs;
+    mSwitchGapMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - gapStart).count();
+    mStreamSwitches++;
+    LOGI("Output reconfigured to %d Hz in %.2f ms (open %.2f ms in parallel)",
+         request.sampleRate, mSwitchGapMs, mSwitchOpenMs);
+    return previous;
+}
+
+void AudioEngine::prepareRenderStateLocked() {
+    reconfigureDspLocked();
+    
+    // 타임 스트레처 버퍼를 새 형식에 맞추고 현재 위치부터 다시 시작
+    if (mTimeStretcher.isActive()) {
+        mCurrentFrame = mTimeStretcher.getSourcePosition();
+    }
+    mTimeStretcher.configure(mSampleRate, mChannelCount);
+    mStretchInput.resize(static_cast<size_t>(kStretchChunkFrames) * mChannelCount);
+    resetTimeStretchLocked();
+    
+    // 콜백에서 할당하지 않도록 변환 버퍼 미리 확보
+    mRenderBuffer.resize(static_cast<size_t>(kMaxRenderFrames) * mChannelCount);
+}
+
+bool AudioEngine::isStreamCompatibleLocked() const {
+    // 형식 대체(float)나 리샘플러 대체가 일어난 스트림도 같은 요청이면 그대로 재사용
+    return mAudioStream && makeStreamRequestLocked() == mStreamRequest;
 }
 
 void AudioEngine::closeOutputStream() {
+    stopRenderThreadLocked();
+    
     if (mAudioStream) {
         mAudioStream->close();
         mAudioStream.reset();
@@ -286,7 +850,7 @@ bool AudioEngine::restartStream() {
     bool result = openOutputStream();
     
     if (result && wasPlaying) {
-        play();
+        startLocked();
     }
     
     return result;
@@ -297,58 +861,434 @@ oboe::DataCallbackResult AudioEngine::onAudioReady(
     void *audioData,
     int32_t numFrames) {
     
-    // 오디오 데이터 버퍼
-    float *outputBuffer = static_cast<float *>(audioData);
-    
     // 오디오 처리 뮤텍스 락
     std::lock_guard<std::mutex> lock(mLock);
     
-    // 재생 중이 아니면 무음 출력
-    if (!mIsPlaying || mAudioData.empty()) {
-        memset(outputBuffer, 0, sizeof(float) * numFrames * mChannelCount);
-        return oboe::DataCallbackResult::Continue;
+    // 성능 모드 전환 후 닫히기 전까지의 이전 스트림은 무음으로 끝냄 (재생 위치는 새 스트림이 이어감)
+    // 새 트랙 형식의 스트림을 여는 동안에는 엔진 형식이 현재 스트림과 다를 수 있으므로 스트림 형식대로 무음 출력
+    bool current = oboeStream == mAudioStream.get();
+    if (!current || mStreamSwitchesPending > 0) {
+        memset(audioData, 0, static_cast<size_t>(numFrames) * oboeStream->getChannelCount() *
+                             getOboeBytesPerSample(oboeStream->getFormat()));
+        return current ? oboe::DataCallbackResult::Continue : oboe::DataCallbackResult::Stop;
     }
     
-    // 현재 프레임부터 버퍼 채우기
-    int framesRemaining = mTotalFrames - mCurrentFrame;
-    int framesToCopy = std::min<int>(numFrames, framesRemaining);
+    renderLocked(static_cast<uint8_t *>(audioData), numFrames);
     
-    if (framesToCopy > 0) {
-        // 오디오 데이터 복사
-        memcpy(outputBuffer, 
-               mAudioData.data() + mCurrentFrame * mChannelCount, 
-               framesToCopy * mChannelCount * sizeof(float));
+    // 오래 재생하지 않은 warm-start 스트림은 콜백에서 멈춤 (다음 play()에서 다시 시작)
+    if (expireIdleWarmStartLocked()) {
+        return oboe::DataCallbackResult::Stop;
+    }
+    return oboe::DataCallbackResult::Continue;
+}
+
+bool AudioEngine::expireIdleWarmStartLocked() {
+    if (!mWarmStart || mIsPlaying ||
+        mWarmIdleFrames < static_cast<int64_t>(kWarmStartIdleSeconds) * mSampleRate) {
+        return false;
+    }
+    
+    mWarmStart = false;
+    mWarmIdleFrames = 0;
+    LOGI("Warm start expired after %d s idle, stopping silent stream", kWarmStartIdleSeconds);
+    return true;
+}
+
+void AudioEngine::renderLocked(uint8_t* outputBuffer, int32_t numFrames) {
+    auto renderStart = std::chrono::steady_clock::now();
+    // 재생 중 렌더링에 쓴 스레드 CPU 시간과 깨어난 횟수를 성능 모드별로 누적
+    PowerCounters* power = mIsPlaying ? &mPowerCounters[mStreamDeepBuffer ? 1 : 0] : nullptr;
+    int64_t cpuStart = power ? getThreadCpuNanos() : 0;
+    if (mRenderCount == 0) {
+        // 콜백 스레드든 렌더 스레드든 실제 렌더링하는 스레드의 스케줄링 정책 기록
+        mRenderRealtime = ThreadPriority::isRealtime();
+    }
+    
+    const size_t frameBytes = static_cast<size_t>(mChannelCount) * getBytesPerSample(mStreamFormat);
+    
+    // 재생 중이 아니면 무음 출력 (보조 출력도 무음을 받아 클럭 동기를 유지)
+    if (!mIsPlaying || !mAudioData) {
+        memset(outputBuffer, 0, frameBytes * numFrames);
+        if (mFanout.hasOutputs()) {
+            mFanout.push(outputBuffer, mStreamFormat, mChannelCount, numFrames, mSampleRate);
+        }
+        if (mWarmStart) {
+            mWarmIdleFrames += numFrames;
+        }
+        return;
+    }
+    
+    if (mRenderBuffer.size() < static_cast<size_t>(numFrames) * mChannelCount) {
+        mRenderBuffer.resize(static_cast<size_t>(numFrames) * mChannelCount);
+    }
+    
+    int32_t framesToCopy;
+    bool stretching = false;
+    if (mBitPerfectActive) {
+        // 원본 샘플을 변환 없이 그대로 복사
+        framesToCopy = mAudioData->readRawFrames(mCurrentFrame, outputBuffer, numFrames);
+        mOutputChecksum = updateChecksum(mOutputChecksum, outputBuffer, frameBytes * framesToCopy);
         
-        // 남은 프레임은 무음으로 채우기
-        if (framesToCopy < numFrames) {
-            memset(outputBuffer + framesToCopy * mChannelCount, 
-                   0, 
-                   (numFrames - framesToCopy) * mChannelCount * sizeof(float));
+        // 시각화 데이터는 출력과 별도 버퍼에서 계산
+        mAudioData->readFrames(mCurrentFrame, mRenderBuffer.data(), framesToCopy);
+        updateVisualizationData(mRenderBuffer.data(), framesToCopy);
+    } else {
+        // 원속도로 돌아와 원본과 정렬되면 스트레처를 거치지 않고 직접 재생
+        if (mTimeStretcher.canBypass()) {
+            mCurrentFrame = mTimeStretcher.getSourcePosition();
+            mTimeStretcher.end();
+            updateBitPerfectStateLocked();
         }
         
-        // 오디오 데이터 처리 (볼륨, EQ, 정규화 등)
-        processAudioData(outputBuffer, framesToCopy);
+        // float 스트림이면 출력 버퍼에 직접, 아니면 변환 버퍼에 렌더링
+        float *renderBuffer = mStreamFormat == SampleFormat::Float32
+                              ? reinterpret_cast<float *>(outputBuffer)
+                              : mRenderBuffer.data();
+        
+        stretching = mTimeStretcher.isActive();
+        if (stretching) {
+            framesToCopy = renderStretchedLocked(renderBuffer, numFrames);
+        } else {
+            // 현재 프레임부터 버퍼 채우기 (저장 형식에 맞게 float로 변환)
+            framesToCopy = mAudioData->readFrames(mCurrentFrame, renderBuffer, numFrames);
+        }
         
         // 시각화 데이터 업데이트
-        updateVisualizationData(outputBuffer, framesToCopy);
+        updateVisualizationData(renderBuffer, framesToCopy);
         
-        // 현재 프레임 위치 업데이트
-        mCurrentFrame += framesToCopy;
+        // 오디오 데이터 처리 (볼륨, EQ, 정규화, 리미터 후 스트림 형식으로 기록)
+        bool stageFading = mDspChain.isCrossfeedActive() || mDspChain.isCompressorActive();
+        processAudioData(renderBuffer, outputBuffer, framesToCopy);
         
-        // 재생 종료 체크
-        if (mCurrentFrame >= mTotalFrames) {
+        // 크로스피드/나이트 모드 페이드아웃이 끝나 체인에서 빠졌으면 다음 콜백부터 bit-perfect 경로 가능
+        if (stageFading && !mDspChain.isCrossfeedActive() && !mDspChain.isCompressorActive()) {
+            updateBitPerfectStateLocked();
+        }
+    }
+    
+    // 남은 프레임은 무음으로 채우기
+    if (framesToCopy < numFrames) {
+        memset(outputBuffer + frameBytes * framesToCopy, 0, frameBytes * (numFrames - framesToCopy));
+    }
+    
+    // 주 출력에 쓴 그대로 보조 출력에 전달
+    if (mFanout.hasOutputs()) {
+        mFanout.push(outputBuffer, mStreamFormat, mChannelCount, numFrames, mSampleRate);
+    }
+    
+    if (framesToCopy > 0 && mTapPending) {
+        mTapPending = false;
+        mTapToRenderMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - mTapTime).count();
+    }
+    
+    if (framesToCopy > 0) {
+        // 현재 프레임 위치 업데이트 (타임 스트레치 중에는 소스를 공급할 때 이미 진행됨)
+        if (!stretching) {
+            mCurrentFrame += framesToCopy;
+        }
+        
+        // 재생 종료 체크 (타임 스트레치 중에는 스트레처가 모두 비워졌을 때 종료)
+        bool reachedEnd = stretching ? framesToCopy < numFrames : mCurrentFrame >= mTotalFrames;
+        if (reachedEnd) {
             // 여기서 플레이백 완료 콜백을 트리거할 수 있음
             // 실제 구현에서는 재생 완료 이벤트를 Java 코드로 보내야 함
             LOGI("End of playback reached");
             mIsPlaying = false;
+            mTimeStretcher.end();
         }
     } else {
-        // 재생할 프레임이 없으면 무음 출력
-        memset(outputBuffer, 0, sizeof(float) * numFrames * mChannelCount);
+        // 재생할 프레임이 없으면 재생 종료
         mIsPlaying = false;
+        mTimeStretcher.end();
     }
     
-    return oboe::DataCallbackResult::Continue;
+    if (power) {
+        power->wakeups++;
+        power->cpuNanos += getThreadCpuNanos() - cpuStart;
+        power->playedSeconds += static_cast<double>(numFrames) / mSampleRate;
+    }
+    
+    float renderUs = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - renderStart).count();
+    mLastRenderUs = renderUs;
+    mMaxRenderUs = std::max(mMaxRenderUs, renderUs);
+    mRenderCount++;
+}
+
+void AudioEngine::startRenderThreadLocked() {
+    mRenderControl = std::make_shared<RenderThreadControl>();
+    // deep buffer에서는 여러 버스트를 한 번에 써서 깨어나는 횟수를 줄임
+    int32_t writeFrames = mAudioStream->getFramesPerBurst() * (mStreamDeepBuffer ? kDeepBufferBurstsPerWrite : 1);
+    mRenderThread = std::thread(&AudioEngine::renderThreadLoop, this, mRenderControl, mAudioStream,
+                                std::min(writeFrames, kMaxRenderFrames));
+}
+
+void AudioEngine::stopRenderThreadLocked() {
+    if (!mRenderThread.joinable()) {
+        return;
+    }
+    
+    // 렌더 스레드도 mLock을 잡으므로 락을 잡은 채 join하지 않고,
+    // 조건 변수 대기로 락을 넘겨 스레드가 루프를 빠져나간 것을 확인한 뒤 join
+    std::thread thread = std::move(mRenderThread);
+    std::shared_ptr<RenderThreadControl> control = std::move(mRenderControl);
+    control->stop.store(true);
+    mRenderCondition.notify_all();
+    std::unique_lock<std::mutex> lock(mLock, std::adopt_lock);
+    mRenderCondition.wait(lock, [&control] { return control->exited; });
+    lock.release();
+    thread.join();
+}
+
+void AudioEngine::renderThreadLoop(std::shared_ptr<RenderThreadControl> control,
+                                   std::shared_ptr<oboe::AudioStream> stream, int32_t burstFrames) {
+    ThreadPriority::promoteToAudio();
+    ThreadPriority::pinToBigCores();
+    
+    std::unique_lock<std::mutex> lock(mLock);
+    const size_t frameBytes = static_cast<size_t>(mChannelCount) * getBytesPerSample(mStreamFormat);
+    std::vector<uint8_t> burst(frameBytes * burstFrames);
+    LOGI("Render thread started: %d frames per write, %d bursts in flight", burstFrames, mBurstsInFlight);
+    
+    while (!control->stop.load()) {
+        // warm-start 중에는 재생 전에도 무음을 계속 써서 스트림을 실행 상태로 유지
+        if (!mIsPlaying && !mWarmStart) {
+            mRenderCondition.wait(lock);
+            continue;
+        }
+        
+        renderLocked(burst.data(), burstFrames);
+        bool expired = expireIdleWarmStartLocked();
+        
+        // 버퍼에 공간이 생길 때까지 블로킹되는 쓰기는 락 밖에서 수행
+        lock.unlock();
+        int32_t written = 0;
+        oboe::Result error = oboe::Result::OK;
+        while (written < burstFrames && !control->stop.load()) {
+            oboe::ResultWithValue<int32_t> result =
+                stream->write(burst.data() + frameBytes * written, burstFrames - written, kWriteTimeoutNanos);
+            if (!result) {
+                error = result.error();
+                break;
+            }
+            written += result.value();
+        }
+        lock.lock();
+        if (expired && !mIsPlaying && !mWarmStart) {
+            // 유휴 warm-start가 끝났으므로 마지막 무음 버스트를 쓴 뒤 스트림을 멈춤 (그 사이 재생이 시작되지 않은 경우만)
+            stream->requestStop();
+        }
+        
+        if (error == oboe::Result::ErrorDisconnected) {
+            LOGE("Render thread stream disconnected");
+            mIsPlaying = false;
+        } else if (error != oboe::Result::OK && error != oboe::Result::ErrorInvalidState &&
+                   error != oboe::Result::ErrorTimeout) {
+            // 일시정지 전환 중의 쓰기 실패 외에는 잠시 대기 후 재시도
+            LOGE("Render thread write failed: %s", oboe::convertToText(error));
+            mRenderCondition.wait_for(lock, std::chrono::milliseconds(10));
+        }
+    }
+    
+    control->exited = true;
+    mRenderCondition.notify_all();
+    LOGI("Render thread stopped");
+}
+
+void AudioEngine::warmStart(const std::string& firstTrackPath) {
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        
+        mWarmStart = true;
+        mWarmIdleFrames = 0;
+        if (!mAudioStream) {
+            // 열면서 DSP, 타임 스트레치, 변환 버퍼를 모두 할당하고 무음으로 시작
+            openOutputStream();
+        } else if (mAudioStream->getState() != oboe::StreamState::Started) {
+            mAudioStream->requestStart();
+        }
+        mRenderCondition.notify_all();
+        LOGI("Warm start: output stream running silently");
+    }
+    
+    // 첫 트랙 디코딩은 락 밖에서 수행 (loadFile 시 캐시 적중)
+    if (!firstTrackPath.empty()) {
+        preloadFile(firstTrackPath);
+    }
+}
+
+void AudioEngine::disableWarmStart() {
+    std::lock_guard<std::mutex> lock(mLock);
+    
+    mWarmStart = false;
+    if (mAudioStream && !mIsPlaying) {
+        // 재생 중이 아니면 무음 실행을 멈춰 전력 소모 방지
+        mAudioStream->requestStop();
+    }
+    LOGI("Warm start disabled");
+}
+
+bool AudioEngine::useDeepBufferLocked() const {
+    return mDeepBufferEnabled && !mPlayerUiVisible;
+}
+
+std::shared_ptr<oboe::AudioStream> AudioEngine::switchStreamModeLocked(std::unique_lock<std::mutex>& lock) {
+    if (!mAudioStream || useDeepBufferLocked() == mStreamDeepBuffer) {
+        return nullptr;
+    }
+    
+    // 성능 모드도 스트림 요청의 일부이므로 트랙 형식 전환과 같은 경로로 교체
+    // (새 스트림은 락을 놓고 여는 동안 이전 스트림이 계속 실행되고, 남은 프레임은 새 스트림에서 이어서 재생)
+    return reconfigureStream(lock);
+}
+
+void AudioEngine::enableDeepBuffer(bool enable) {
+    std::unique_lock<std::mutex> lock(mLock);
+    mDeepBufferEnabled = enable;
+    std::shared_ptr<oboe::AudioStream> previous = switchStreamModeLocked(lock);
+    LOGI("Deep buffer mode %s", enable ? "enabled" : "disabled");
+    lock.unlock();
+    
+    closeDetachedStream(previous);
+}
+
+void AudioEngine::setPlayerUiVisible(bool visible) {
+    std::unique_lock<std::mutex> lock(mLock);
+    mPlayerUiVisible = visible;
+    std::shared_ptr<oboe::AudioStream> previous = switchStreamModeLocked(lock);
+    lock.unlock();
+    
+    closeDetachedStream(previous);
+}
+
+PowerStats AudioEngine::getPowerStats() const {
+    std::lock_guard<std::mutex> lock(mLock);
+    
+    auto summarize = [](const PowerCounters& counters) {
+        PowerModeStats stats{};
+        stats.playbackMinutes = static_cast<float>(counters.playedSeconds / 60.0);
+        if (counters.playedSeconds > 0.0) {
+            stats.wakeupsPerMinute = static_cast<float>(counters.wakeups * 60.0 / counters.playedSeconds);
+            stats.cpuSecondsPerHour = static_cast<float>(counters.cpuNanos * 1e-9 * 3600.0 / counters.playedSeconds);
+        }
+        return stats;
+    };
+    
+    PowerStats stats;
+    stats.lowLatency = summarize(mPowerCounters[0]);
+    stats.deepBuffer = summarize(mPowerCounters[1]);
+    stats.deepBufferActive = mAudioStream && mStreamDeepBuffer;
+    return stats;
+}
+
+void AudioEngine::setAutoHardwareSwitching(bool enable) {
+    std::shared_ptr<oboe::AudioStream> previous;
+    std::unique_lock<std::mutex> lock(mLock);
+    
+    if (mAutoHardwareSwitching != enable) {
+        mAutoHardwareSwitching = enable;
+        LOGI("Automatic hardware rate switching %s", enable ? "enabled" : "disabled");
+        
+        // 현재 트랙도 바로 새 방식의 스트림으로 교체
+        if (mAudioStream) {
+            previous = reconfigureStream(lock);
+        }
+    }
+    lock.unlock();
+    closeDetachedStream(previous);
+}
+
+int AudioEngine::addOutputDevice(int32_t deviceId) {
+    int32_t inputSampleRate;
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        inputSampleRate = mSampleRate;
+    }
+    
+    // 장치 스트림 열기는 수십 ms가 걸릴 수 있으므로 락 밖에서 수행하여 재생 콜백을 막지 않음
+    // (그 사이 트랙 레이트가 바뀌어도 첫 push에서 새 레이트가 전달됨)
+    std::unique_ptr<OboeFanoutSink> sink(new OboeFanoutSink());
+    if (!sink->open(deviceId, inputSampleRate)) {
+        return -1;
+    }
+    
+    std::lock_guard<std::mutex> lock(mLock);
+    int id = mFanout.addDeviceOutput(std::move(sink));
+    LOGI("Fan-out device output %d added (device %d)", id, deviceId);
+    return id;
+}
+
+int AudioEngine::addNullOutput(int32_t sampleRate, float clockPpm) {
+    std::lock_guard<std::mutex> lock(mLock);
+    int id = mFanout.addNullOutput(sampleRate, clockPpm, mSampleRate);
+    LOGI("Fan-out null output %d added (%d Hz, %+.1f ppm)", id, sampleRate, clockPpm);
+    return id;
+}
+
+bool AudioEngine::removeOutput(int outputId) {
+    std::lock_guard<std::mutex> lock(mLock);
+    return mFanout.removeOutput(outputId);
+}
+
+std::vector<FanoutOutputStats> AudioEngine::getFanoutStats() const {
+    std::lock_guard<std::mutex> lock(mLock);
+    return mFanout.getStats();
+}
+
+void AudioEngine::setOutputMode(OutputMode mode, int burstsInFlight) {
+    std::lock_guard<std::mutex> lock(mLock);
+    
+    int bursts = std::max(kMinBurstsInFlight, std::min(kMaxBurstsInFlight, burstsInFlight));
+    if (mode == mOutputMode && bursts == mBurstsInFlight) {
+        return;
+    }
+    
+    mOutputMode = mode;
+    mBurstsInFlight = bursts;
+    LOGI("Output mode set to %s (%d bursts in flight)",
+         mode == OutputMode::Callback ? "callback" : "blocking write", bursts);
+    
+    // 콜백 등록 여부가 스트림 생성 시점에 정해지므로 스트림을 다시 열어 적용
+    if (mAudioStream) {
+        restartStream();
+    }
+}
+
+OutputMetrics AudioEngine::getOutputMetrics() const {
+    std::lock_guard<std::mutex> lock(mLock);
+    
+    OutputMetrics metrics{};
+    metrics.mode = mOutputMode;
+    metrics.burstsInFlight = mBurstsInFlight;
+    metrics.latencyMs = -1.0;
+    metrics.xRunCount = -1;
+    if (mAudioStream) {
+        metrics.framesPerBurst = mAudioStream->getFramesPerBurst();
+        metrics.bufferSizeFrames = mAudioStream->getBufferSizeInFrames();
+        oboe::ResultWithValue<double> latency = mAudioStream->calculateLatencyMillis();
+        if (latency) {
+            metrics.latencyMs = latency.value();
+        }
+        oboe::ResultWithValue<int32_t> xRuns = mAudioStream->getXRunCount();
+        if (xRuns) {
+            metrics.xRunCount = xRuns.value();
+        }
+    }
+    metrics.lastRenderUs = mLastRenderUs;
+    metrics.maxRenderUs = mMaxRenderUs;
+    metrics.renderCount = mRenderCount;
+    metrics.realtimeThread = mRenderRealtime;
+    // 첫 샘플이 렌더링된 뒤에도 스트림 버퍼를 거쳐야 들리므로 출력 지연을 더함
+    metrics.tapToSoundMs = mTapToRenderMs < 0.0f
+                           ? -1.0f
+                           : mTapToRenderMs + static_cast<float>(std::max(0.0, metrics.latencyMs));
+    metrics.loadMs = mLoadMs;
+    metrics.warmStart = mWarmStart;
+    metrics.autoHardwareSwitching = mAutoHardwareSwitching;
+    metrics.resampling = mAudioStream && mStreamResampled;
+    metrics.streamSwitches = mStreamSwitches;
+    metrics.switchOpenMs = mSwitchOpenMs;
+    metrics.switchGapMs = mSwitchGapMs;
+    return metrics;
 }
 
 void AudioEngine::onErrorBeforeClose(oboe::AudioStream *oboeStream, oboe::Result error) {
@@ -365,35 +1305,66 @@ void AudioEngine::onErrorAfterClose(oboe::AudioStream *oboeStream, oboe::Result
     }
 }
 
-void AudioEngine::processAudioData(float* audioData, int32_t numFrames) {
-    // 볼륨 적용
-    if (mVolume != 1.0f) {
-        for (int i = 0; i < numFrames * mChannelCount; i++) {
-            audioData[i] *= mVolume;
+int32_t AudioEngine::renderStretchedLocked(float* output, int32_t numFrames) {
+    int32_t produced = 0;
+    while (produced < numFrames) {
+        int32_t got = mTimeStretcher.readOutput(output + static_cast<size_t>(produced) * mChannelCount,
+                                                numFrames - produced);
+        produced += got;
+        if (produced >= numFrames) {
+            break;
+        }
+        
+        // 출력이 부족하면 소스를 더 공급, 소스 끝이면 스트레처를 비움
+        if (mCurrentFrame < mTotalFrames) {
+            int32_t read = mAudioData->readFrames(mCurrentFrame, mStretchInput.data(), kStretchChunkFrames);
+            mTimeStretcher.writeInput(mStretchInput.data(), read);
+            mCurrentFrame += read;
+        } else if (!mTimeStretcher.isEndOfInput()) {
+            mTimeStretcher.endOfInput();
+        } else if (got == 0) {
+            break;
         }
     }
-    
-    // EQ 적용
-    if (mEQEnabled) {
-        applyEQ(audioData, numFrames);
-    }
-    
-    // 볼륨 정규화 적용
-    if (mVolumeNormalizationEnabled) {
-        applyVolumeNormalization(audioData, numFrames);
+    return produced;
+}
+
+void AudioEngine::resetTimeStretchLocked() {
+    // 원속도가 아니면 현재 위치부터 스트레치를 다시 시작
+    if (mTimeStretcher.getSpeed() != 1.0f) {
+        mTimeStretcher.begin(mCurrentFrame);
+    } else {
+        mTimeStretcher.end();
     }
 }
 
-void AudioEngine::applyEQ(float* audioData, int32_t numFrames) {
-    // 여기서 실제 EQ 처리
-    // 실제 구현에서는 FFT 기반 EQ 필터링이 필요함
-    // 이 예제에서는 단순화를 위해 생략
+void AudioEngine::processAudioData(const float* input, void* output, int32_t numFrames) {
+    // 모든 단계가 비활성이고 float 스트림에 직접 렌더링한 경우 처리할 것이 없음
+    if (mDspChain.isNeutral() && input == output) {
+        return;
+    }
+    mDspChain.process(input, output, numFrames);
 }
 
-void AudioEngine::applyVolumeNormalization(float* audioData, int32_t numFrames) {
-    // 여기서 LUFS 기반 볼륨 정규화 처리
-    // 실제 구현에서는 LUFS 측정 및 게인 조정이 필요함
-    // 이 예제에서는 단순화를 위해 생략
+void AudioEngine::reconfigureDspLocked() {
+    DspSettings settings;
+    settings.sampleRate = mSampleRate;
+    settings.channelCount = mChannelCount;
+    settings.outputFormat = mStreamFormat;
+    settings.volume = mVolume;
+    settings.eqEnabled = mEQEnabled;
+    for (int band = 0; band < DspSettings::kEQBands && band < static_cast<int>(mEQGains.size()); band++) {
+        settings.eqGains[band] = mEQGains[band];
+    }
+    settings.loudnessEnabled = mLoudnessCompensationEnabled;
+    settings.normalizationEnabled = mVolumeNormalizationEnabled;
+    settings.targetLUFS = mTargetLUFS;
+    settings.compressorEnabled = mNightModeEnabled;
+    settings.compressorMakeupDb = mNightModeMakeupDb;
+    settings.crossfeedEnabled = mHeadphoneOutput && !mCrossfeedBypassed;
+    settings.crossfeedPreset = mCrossfeedPreset;
+    
+    mDspChain.configure(settings);
 }
 
 void AudioEngine::updateVisualizationData(const float* audioData, int32_t numFrames) {
@@ -405,20 +1376,13 @@ void AudioEngine::updateVisualizationData(const float* audioData, int32_t numFra
     
     if (framesPerBand <= 0) return;
     
+    // 밴드 구간은 인터리브된 샘플이 연속으로 놓이므로 모든 밴드의 제곱합을 한 번에 계산
+    const size_t bandSamples = static_cast<size_t>(framesPerBand) * mChannelCount;
+    DspKernels::active().binEnergies(audioData, bandSamples, visualBands, mBandEnergies.data());
+    
     for (int band = 0; band < visualBands; band++) {
-        float sum = 0.0f;
-        int startFrame = band * framesPerBand;
-        int endFrame = startFrame + framesPerBand;
-        
-        for (int frame = startFrame; frame < endFrame && frame < numFrames; frame++) {
-            for (int ch = 0; ch < mChannelCount; ch++) {
-                float sample = audioData[frame * mChannelCount + ch];
-                sum += sample * sample;
-            }
-        }
-        
         // RMS 계산
-        float rms = sqrtf(sum / (framesPerBand * mChannelCount));
+        float rms = sqrtf(mBandEnergies[band] / (framesPerBand * mChannelCount));
         
         // 부드러운 애니메이션을 위한 간단한 보간
         float smoothingFactor = 0.3f;
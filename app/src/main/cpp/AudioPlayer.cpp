@@ -53,6 +53,31 @@ int64_t AudioPlayer::getDuration() const {
     return mAudioEngine->getDuration();
 }
 
+bool AudioPlayer::preloadFile(JNIEnv* env, jstring jFilePath) {
+    const char* filePath = env->GetStringUTFChars(jFilePath, nullptr);
+    bool result = mAudioEngine->preloadFile(filePath);
+    env->ReleaseStringUTFChars(jFilePath, filePath);
+    return result;
+}
+
+void AudioPlayer::setDecodedCacheBudget(size_t budgetBytes) {
+    mAudioEngine->setDecodedCacheBudget(budgetBytes);
+}
+
+void AudioPlayer::setDecodedCacheCompact(bool compact) {
+    mAudioEngine->setDecodedCacheCompact(compact);
+}
+
+void AudioPlayer::prefetchFile(JNIEnv* env, jstring jFilePath) {
+    const char* filePath = env->GetStringUTFChars(jFilePath, nullptr);
+    mAudioEngine->prefetchFile(filePath);
+    env->ReleaseStringUTFChars(jFilePath, filePath);
+}
+
+IoStats AudioPlayer::getIoStats() const {
+    return mAudioEngine->getIoStats();
+}
+
 void AudioPlayer::setSampleRate(int sampleRate) {
     mAudioEngine->setSampleRate(sampleRate);
 }
@@ -85,10 +110,131 @@ void AudioPlayer::setTargetLUFS(float lufsValue) {
     mAudioEngine->setTargetLUFS(lufsValue);
 }
 
+void AudioPlayer::enableLoudnessCompensation(bool enable) {
+    mAudioEngine->enableLoudnessCompensation(enable);
+}
+
+void AudioPlayer::enableNightMode(bool enable) {
+    mAudioEngine->enableNightMode(enable);
+}
+
+void AudioPlayer::setNightModeMakeupGain(float gainDb) {
+    mAudioEngine->setNightModeMakeupGain(gainDb);
+}
+
+CompressorMeters AudioPlayer::getNightModeMeters() const {
+    return mAudioEngine->getNightModeMeters();
+}
+
+void AudioPlayer::setPlaybackSpeed(float speed) {
+    mAudioEngine->setPlaybackSpeed(speed);
+}
+
+float AudioPlayer::getPlaybackSpeed() const {
+    return mAudioEngine->getPlaybackSpeed();
+}
+
+void AudioPlayer::setTimeStretchMode(int mode) {
+    mAudioEngine->setTimeStretchMode(mode == static_cast<int>(TimeStretchMode::Music)
+                                     ? TimeStretchMode::Music
+                                     : TimeStretchMode::Speech);
+}
+
+float AudioPlayer::getTimeStretchLoad() const {
+    return mAudioEngine->getTimeStretchLoad();
+}
+
+void AudioPlayer::enableBitPerfect(bool enable) {
+    mAudioEngine->enableBitPerfect(enable);
+}
+
+bool AudioPlayer::isBitPerfect() const {
+    return mAudioEngine->isBitPerfect();
+}
+
+uint64_t AudioPlayer::getOutputChecksum() const {
+    return mAudioEngine->getOutputChecksum();
+}
+
+void AudioPlayer::warmStart(JNIEnv* env, jstring jFirstTrackPath) {
+    const char* filePath = env->GetStringUTFChars(jFirstTrackPath, nullptr);
+    std::string path(filePath);
+    env->ReleaseStringUTFChars(jFirstTrackPath, filePath);
+    mAudioEngine->warmStart(path);
+}
+
+void AudioPlayer::disableWarmStart() {
+    mAudioEngine->disableWarmStart();
+}
+
+void AudioPlayer::enableDeepBuffer(bool enable) {
+    mAudioEngine->enableDeepBuffer(enable);
+}
+
+void AudioPlayer::setPlayerUiVisible(bool visible) {
+    mAudioEngine->setPlayerUiVisible(visible);
+}
+
+PowerStats AudioPlayer::getPowerStats() const {
+    return mAudioEngine->getPowerStats();
+}
+
+void AudioPlayer::setAutoHardwareSwitching(bool enable) {
+    mAudioEngine->setAutoHardwareSwitching(enable);
+}
+
+int AudioPlayer::addOutputDevice(int32_t deviceId) {
+    return mAudioEngine->addOutputDevice(deviceId);
+}
+
+int AudioPlayer::addNullOutput(int32_t sampleRate, float clockPpm) {
+    return mAudioEngine->addNullOutput(sampleRate, clockPpm);
+}
+
+bool AudioPlayer::removeOutput(int outputId) {
+    return mAudioEngine->removeOutput(outputId);
+}
+
+std::vector<FanoutOutputStats> AudioPlayer::getFanoutStats() const {
+    return mAudioEngine->getFanoutStats();
+}
+
+void AudioPlayer::setOutputMode(int mode, int burstsInFlight) {
+    mAudioEngine->setOutputMode(mode == static_cast<int>(OutputMode::BlockingWrite) ? OutputMode::BlockingWrite
+                                                                                    : OutputMode::Callback,
+                                burstsInFlight);
+}
+
+OutputMetrics AudioPlayer::getOutputMetrics() const {
+    return mAudioEngine->getOutputMetrics();
+}
+
 void AudioPlayer::optimizeForDevice(bool useHeadphones, bool isHighPerformanceDevice) {
     mAudioEngine->optimizeForDevice(useHeadphones, isHighPerformanceDevice);
 }
 
+void AudioPlayer::setCrossfeedPreset(int preset) {
+    switch (preset) {
+        case static_cast<int>(CrossfeedPreset::ChuMoy):
+            mAudioEngine->setCrossfeedPreset(CrossfeedPreset::ChuMoy);
+            break;
+        case static_cast<int>(CrossfeedPreset::JanMeier):
+            mAudioEngine->setCrossfeedPreset(CrossfeedPreset::JanMeier);
+            break;
+        default:
+            mAudioEngine->setCrossfeedPreset(CrossfeedPreset::Default);
+            break;
+    }
+}
+
+void AudioPlayer::setCrossfeedBypass(bool bypass) {
+    mAudioEngine->setCrossfeedBypass(bypass);
+}
+
+bool AudioPlayer::isCrossfeedActive() const {
+    return mAudioEngine->isCrossfeedActive();
+}
+
 std::vector<float> AudioPlayer::getVisualizationData() {
     return std::vector<float>(20, 0.5f); // 샘플 시각화 데이터 반환
 }
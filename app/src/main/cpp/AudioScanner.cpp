@@ -1,5 +1,9 @@
 #include "include/AudioScanner.h"
+#include "include/ParallelScanner.h"
+#include "include/TagParser.h"
 #include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <random>
@@ -14,6 +18,29 @@
 namespace fs = std::filesystem;
 namespace pancakemusicbox {
 
+namespace {
+
+// 재스캔 시작 시점에 이미 알고 있던 파일
+struct KnownFile {
+    FileFingerprint fingerprint;
+    bool seen;      // 이번 스캔에서 찾았는지 (찾지 못하면 삭제된 파일)
+};
+
+// 데이터베이스 파일 식별자와 형식 버전
+// 버전 1: 헤더 없이 트랙 수부터 시작
+// 버전 2: 트랙마다 파일 지문 추가
+// 버전 3: 트랙마다 추가 시간 추가
+const char kDatabaseMagic[4] = {'P', 'M', 'D', 'B'};
+const uint32_t kDatabaseVersion = 3;
+
+// 현재 시간 (밀리초 타임스탬프)
+int64_t currentTimeMillis() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
 // 싱글톤 인스턴스 생성
 AudioScanner& AudioScanner::getInstance() {
     static AudioScanner instance;
@@ -28,7 +55,8 @@ AudioScanner::AudioScanner() {
 
 // 소멸자
 AudioScanner::~AudioScanner() {
-    // 정리 코드
+    // 감시 스레드가 저장소를 쓰는 중일 수 있으므로 먼저 중지
+    stopWatching();
     LOGI("AudioScanner destroyed");
 }
 
@@ -46,71 +74,192 @@ bool AudioScanner::scanDirectory(const std::string& directoryPath,
         return false;
     }
     
-    std::vector<std::string> audioFiles;
+    if (!fs::is_directory(directoryPath)) {
+        LOGE("Not a directory: %s", directoryPath.c_str());
+        return false;
+    }
     
-    // 지원하는 오디오 파일 확장자
-    std::vector<std::string> supportedExtensions = {
-        ".flac", ".wav", ".mp3", ".aac", ".ogg", ".m4a", ".dsf", ".dff", ".mqa"
-    };
+    LOGI("Starting scan of directory: %s", directoryPath.c_str());
+    auto startTime = std::chrono::steady_clock::now();
     
-    // 모든 파일 탐색
-    try {
-        // 권한 문제로 디렉토리에 접근할 수 없을 수 있으므로 더 강력한 오류 처리 사용
-        // 파일 시스템 오류 시 기본 디렉토리 접근 방식 대신 직접 구현
-        LOGI("Starting scan of directory: %s", directoryPath.c_str());
+    // 이 디렉토리 아래에서 이미 아는 파일의 지문 스냅샷 (작업자들은 락 없이 읽음)
+    // seen은 그 경로를 찾은 작업자 하나만 쓰므로 경합이 없음
+    std::string rootPrefix = directoryPath;
+    if (rootPrefix.empty() || rootPrefix.back() != '/') {
+        rootPrefix.push_back('/');
+    }
+    std::unordered_map<std::string, KnownFile> knownFiles;
+    bool initialLibraryScan = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        // 라이브러리 전체가 비어 있을 때만 최초 가져오기로 봄 (감시자가 새 하위 폴더를 스캔할 때는 해당 없음)
+        initialLibraryScan = tracks.size() == 0;
+        tracks.forEach([&](TrackHandle handle) {
+            std::string_view filePath = tracks.getFilePath(handle);
+            if (filePath.compare(0, rootPrefix.size(), rootPrefix) == 0) {
+                knownFiles.emplace(filePath, KnownFile{tracks.getFingerprint(handle), false});
+            }
+        });
+    }
+    
+    // 폴더 아트는 스캔 사이에 추가/삭제될 수 있으므로 다시 찾음
+    artworkCache.clearFolderArtCache();
+    
+    // 디렉토리 탐색과 메타데이터 추출을 작업자 스레드들이 나눠서 동시에 수행
+    ParallelScanner scanner(scanThreadCount.load());
+    std::vector<std::vector<TrackMetadata>> results = scanner.scan(
+        directoryPath,
+        [this, &knownFiles](const std::string& filePath, const FileFingerprint& fingerprint,
+                            TrackMetadata& metadata) {
+            auto known = knownFiles.find(filePath);
+            if (known != knownFiles.end()) {
+                known->second.seen = true;
+                if (known->second.fingerprint == fingerprint) {
+                    return ParallelScanner::FileResult::Unchanged;
+                }
+            }
+            
+            if (!extractMetadata(filePath, metadata)) {
+                return ParallelScanner::FileResult::Failed;
+            }
+            metadata.fingerprint = fingerprint;
+            return ParallelScanner::FileResult::Extracted;
+        },
+        progressCallback);
+    
+    // 작업자별 결과를 한 번에 병합 (저장소 락은 여기서만 잡음)
+    int addedTracks = 0;
+    int updatedTracks = 0;
+    int removedTracks = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::unordered_set<std::string> staleTrackIds;
+        
+        // 이번 스캔에서 보이지 않은 파일은 삭제된 것으로 보고 제거
+        // 단, 읽지 못한 디렉토리 아래나 stat하지 못한 파일은 잠시 접근할 수 없는 것일 수 있으므로 재생 기록과 함께 유지
+        std::unordered_set<std::string> unreadablePaths(scanner.getUnreadablePaths().begin(),
+                                                        scanner.getUnreadablePaths().end());
+        for (const auto& known : knownFiles) {
+            if (known.second.seen || isUnderUnreadablePath(known.first, unreadablePaths)) {
+                continue;
+            }
+            TrackHandle handle = tracks.findByPath(known.first);
+            if (handle == kInvalidTrackHandle) {
+                continue;
+            }
+            staleTrackIds.emplace(tracks.getId(handle));
+            tracks.remove(handle);
+            removedTracks++;
+        }
+        if (removedTracks > 0) {
+            libraryGeneration++;
+        }
         
-        for (const auto& entry : fs::recursive_directory_iterator(
-            directoryPath, 
-            fs::directory_options::skip_permission_denied)) { // 권한 거부된 디렉토리 스킵
-            try {
-                if (fs::is_regular_file(entry.path())) {
-                    std::string extension = entry.path().extension().string();
-                    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
-                    
-                    // 지원하는 오디오 파일만 추가
-                    if (std::find(supportedExtensions.begin(), supportedExtensions.end(), extension) != supportedExtensions.end()) {
-                        audioFiles.push_back(entry.path().string());
+        // 바뀐 파일은 기존 ID와 재생 기록을 이어받고 앨범 목록에서는 다시 분류
+        // 최초 가져오기에서는 모든 파일이 같은 시각에 추가되므로, 추가 시간을 파일 수정 시간으로 두어
+        // "최근 추가" 순서가 작업자 병합 순서가 아니라 파일이 기기에 들어온 순서를 따르게 함
+        // 이미 라이브러리가 있으면 새로 생긴 폴더의 파일도 지금 추가된 것이므로 현재 시각을 유지
+        for (auto& workerResults : results) {
+            for (auto& metadata : workerResults) {
+                if (inheritExistingTrackLocked(metadata)) {
+                    staleTrackIds.insert(metadata.id);
+                    updatedTracks++;
+                } else {
+                    if (initialLibraryScan && metadata.fingerprint.modifiedTimeNs > 0) {
+                        metadata.dateAdded = metadata.fingerprint.modifiedTimeNs / 1000000;
                     }
+                    addedTracks++;
                 }
-            } catch (const std::exception& e) {
-                // 개별 파일 처리 오류 로깅 후 계속 진행
-                LOGE("Error processing file entry: %s", e.what());
-                continue;
             }
         }
-    } catch (const fs::filesystem_error& e) {
-        LOGE("Filesystem error scanning directory: %s", e.what());
-        return false;
-    } catch (const std::exception& e) {
-        LOGE("Error scanning directory: %s", e.what());
-        return false;
+        removeTracksFromAlbumsLocked(staleTrackIds);
+        
+        for (const auto& workerResults : results) {
+            for (const auto& metadata : workerResults) {
+                addTrackLocked(metadata);
+            }
+        }
     }
     
-    int totalFiles = audioFiles.size();
-    int processedFiles = 0;
+    auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - startTime).count();
     
-    if (totalFiles == 0) {
+    if (scanner.getFilesFound() == 0 && removedTracks == 0) {
         LOGI("No audio files found in directory: %s", directoryPath.c_str());
         return true; // 파일이 없는 것은 오류가 아님
     }
     
-    // 각 파일 스캔
-    for (const auto& filePath : audioFiles) {
-        try {
-            scanFile(filePath);
-        } catch (const std::exception& e) {
-            // 개별 파일 스캔 실패 시 로깅하고 계속 진행
-            LOGE("Error scanning file %s: %s", filePath.c_str(), e.what());
-        }
-        
-        processedFiles++;
-        if (progressCallback) {
-            progressCallback(processedFiles, totalFiles);
+    LOGI("Scanned %d audio files in directory: %s (%d added, %d updated, %d unchanged, %d removed, %d failed, "
+         "%d dirs, %d threads, %d steals, %lld ms)",
+         scanner.getFilesFound(), directoryPath.c_str(), addedTracks, updatedTracks, scanner.getFilesUnchanged(),
+         removedTracks, scanner.getFilesFailed(), scanner.getDirectoriesScanned(), scanner.getThreadCount(),
+         scanner.getSteals(), static_cast<long long>(elapsedMs));
+    return true;
+}
+
+// 파일 또는 디렉토리 경로 아래의 트랙 제거
+int AudioScanner::removePath(const std::string& path) {
+    std::string prefix = path;
+    if (prefix.empty() || prefix.back() != '/') {
+        prefix.push_back('/');
+    }
+    
+    std::lock_guard<std::mutex> lock(mutex);
+    std::unordered_set<std::string> removedTrackIds;
+    tracks.forEach([&](TrackHandle handle) {
+        std::string_view filePath = tracks.getFilePath(handle);
+        if (filePath != path && filePath.compare(0, prefix.size(), prefix) != 0) {
+            return;
         }
+        removedTrackIds.emplace(tracks.getId(handle));
+        tracks.remove(handle);
+    });
+    if (removedTrackIds.empty()) {
+        return 0;
     }
     
-    LOGI("Scanned %d audio files in directory: %s", processedFiles, directoryPath.c_str());
-    return true;
+    removeTracksFromAlbumsLocked(removedTrackIds);
+    libraryGeneration++;
+    LOGI("Removed %zu tracks under %s", removedTrackIds.size(), path.c_str());
+    return static_cast<int>(removedTrackIds.size());
+}
+
+// 라이브러리 감시 시작
+bool AudioScanner::startWatching(const std::vector<std::string>& directoryPaths,
+                                 LibraryWatcher::ChangeCallback callback) {
+    std::lock_guard<std::mutex> lock(watcherMutex);
+    if (!watcher) {
+        watcher = std::make_unique<LibraryWatcher>(*this);
+    }
+    return watcher->start(directoryPaths, std::move(callback));
+}
+
+// 라이브러리 감시 중지
+void AudioScanner::stopWatching() {
+    std::lock_guard<std::mutex> lock(watcherMutex);
+    if (watcher) {
+        watcher->stop();
+    }
+}
+
+LibraryWatcher::Mode AudioScanner::getWatchMode() {
+    std::lock_guard<std::mutex> lock(watcherMutex);
+    return watcher ? watcher->getMode() : LibraryWatcher::Mode::Stopped;
+}
+
+// 앨범 아트 캐시 디렉토리 설정
+bool AudioScanner::setArtworkCacheDirectory(const std::string& directoryPath) {
+    return artworkCache.setDirectory(directoryPath);
+}
+
+// 디렉토리 스캔 작업자 수 설정
+void AudioScanner::setScanThreadCount(int threadCount) {
+    scanThreadCount.store(std::max(threadCount, 0));
+}
+
+int AudioScanner::getScanThreadCount() const {
+    int threadCount = scanThreadCount.load();
+    return threadCount > 0 ? threadCount : ParallelScanner::getDefaultThreadCount();
 }
 
 // 파일 스캔 및 메타데이터 추출
@@ -147,31 +296,35 @@ bool AudioScanner::scanFile(const std::string& filePath) {
             return false;
         }
         
+        // 지문이 같으면 다시 읽지 않음
+        struct stat fileStat;
+        if (stat(filePath.c_str(), &fileStat) != 0) {
+            LOGE("Cannot stat file: %s", filePath.c_str());
+            return false;
+        }
+        FileFingerprint fingerprint = ParallelScanner::makeFingerprint(fileStat);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            TrackHandle handle = tracks.findByPath(filePath);
+            if (handle != kInvalidTrackHandle && tracks.getFingerprint(handle) == fingerprint) {
+                LOGI("File unchanged: %s", filePath.c_str());
+                return true;
+            }
+        }
+        
         TrackMetadata metadata;
         if (!extractMetadata(filePath, metadata)) {
             LOGE("Failed to extract metadata from file: %s", filePath.c_str());
             return false;
         }
+        metadata.fingerprint = fingerprint;
         
-        // 트랙 정보 저장
+        // 트랙 정보 저장 (이미 있던 파일이면 ID와 재생 기록 유지)
         std::lock_guard<std::mutex> lock(mutex);
-        tracks[metadata.id] = metadata;
-        
-        // 앨범 정보 업데이트 또는 추가
-        std::string albumKey = metadata.albumTitle + "_" + metadata.artist;
-        if (albums.find(albumKey) == albums.end()) {
-            AlbumMetadata album;
-            album.id = generateId();
-            album.title = metadata.albumTitle;
-            album.artist = metadata.artist;
-            album.artworkPath = metadata.albumArtPath;
-            album.year = metadata.year;
-            album.genre = metadata.genre;
-            album.trackIds.push_back(metadata.id);
-            albums[album.id] = album;
-        } else {
-            albums[albumKey].trackIds.push_back(metadata.id);
+        if (inheritExistingTrackLocked(metadata)) {
+            removeTracksFromAlbumsLocked({metadata.id});
         }
+        addTrackLocked(metadata);
         
         LOGI("Scanned file: %s", filePath.c_str());
         return true;
@@ -181,34 +334,148 @@ bool AudioScanner::scanFile(const std::string& filePath) {
     }
 }
 
+// 트랙을 저장소에 추가 (mutex를 잡은 상태)
+void AudioScanner::addTrackLocked(const TrackMetadata& metadata) {
+    libraryGeneration++;
+    tracks.insert(metadata);
+    
+    // 앨범 정보 업데이트 또는 추가
+    // 앨범은 ID로 저장하므로 키로 ID를 먼저 찾음
+    std::string albumKey = makeAlbumKey(metadata.albumTitle, metadata.artist);
+    auto albumId = albumIdsByKey.find(albumKey);
+    if (albumId == albumIdsByKey.end()) {
+        AlbumMetadata album;
+        album.id = generateId();
+        album.title = metadata.albumTitle;
+        album.artist = metadata.artist;
+        album.artworkPath = metadata.albumArtPath;
+        album.year = metadata.year;
+        album.genre = metadata.genre;
+        album.trackIds.push_back(metadata.id);
+        albumIdsByKey.emplace(albumKey, album.id);
+        albums[album.id] = album;
+    } else {
+        AlbumMetadata& album = albums[albumId->second];
+        album.trackIds.push_back(metadata.id);
+        if (album.artworkPath.empty()) {
+            album.artworkPath = metadata.albumArtPath;
+        }
+    }
+}
+
+// 같은 경로의 기존 트랙에서 ID, 재생 기록, 추가 시간 이어받기 (mutex를 잡은 상태)
+bool AudioScanner::inheritExistingTrackLocked(TrackMetadata& metadata) {
+    TrackHandle existing = tracks.findByPath(metadata.filePath);
+    if (existing == kInvalidTrackHandle) {
+        metadata.dateAdded = currentTimeMillis();
+        return false;
+    }
+    
+    metadata.id = tracks.getId(existing);
+    metadata.playCount = tracks.getPlayCount(existing);
+    metadata.lastPlayed = tracks.getLastPlayed(existing);
+    // 버전 1 데이터베이스에서 온 트랙은 추가 시간이 없으므로 파일 수정 시간으로 대신함
+    int64_t dateAdded = tracks.getDateAdded(existing);
+    metadata.dateAdded = dateAdded > 0 ? dateAdded : metadata.fingerprint.modifiedTimeNs / 1000000;
+    return true;
+}
+
+// 앨범 트랙 목록에서 트랙 제거 (mutex를 잡은 상태)
+void AudioScanner::removeTracksFromAlbumsLocked(const std::unordered_set<std::string>& trackIds) {
+    if (trackIds.empty()) {
+        return;
+    }
+    
+    for (auto it = albums.begin(); it != albums.end(); ) {
+        std::vector<std::string>& albumTrackIds = it->second.trackIds;
+        albumTrackIds.erase(std::remove_if(albumTrackIds.begin(), albumTrackIds.end(),
+                                           [&trackIds](const std::string& id) { return trackIds.count(id) > 0; }),
+                            albumTrackIds.end());
+        if (albumTrackIds.empty()) {
+            albumIdsByKey.erase(makeAlbumKey(it->second.title, it->second.artist));
+            it = albums.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+// 경로 자신이나 상위 디렉토리 중 하나가 읽지 못한 경로인지
+bool AudioScanner::isUnderUnreadablePath(const std::string& filePath,
+                                         const std::unordered_set<std::string>& unreadablePaths) {
+    if (unreadablePaths.empty()) {
+        return false;
+    }
+    for (size_t end = filePath.size(); end != std::string::npos && end > 0; end = filePath.rfind('/', end - 1)) {
+        if (unreadablePaths.count(filePath.substr(0, end)) > 0) {
+            return true;
+        }
+    }
+    return unreadablePaths.count("/") > 0;
+}
+
+std::string AudioScanner::makeAlbumKey(const std::string& albumTitle, const std::string& artist) {
+    return albumTitle + "_" + artist;
+}
+
 // 파일에서 메타데이터 추출
 bool AudioScanner::extractMetadata(const std::string& filePath, TrackMetadata& metadata) {
-    // 이 함수는 실제로는 TagLib 같은 라이브러리를 사용하여 메타데이터를 추출해야 함
-    // 여기서는 간단한 구현으로 파일 정보만 기반으로 기본 메타데이터 생성
-    
     try {
         fs::path path(filePath);
         
         // 기본 정보 설정
         metadata.id = generateId();
         metadata.filePath = filePath;
+        metadata.playCount = 0;
+        metadata.lastPlayed = 0;
+        metadata.audioQuality.sampleRate = 0;
+        metadata.audioQuality.bitDepth = 0;
+        metadata.audioQuality.channels = 0;
+        
+        // 태그와 스트림 정보는 파일 헤더에서 직접 읽음 (태그에 있는 필드만 채워짐)
+        // 아트 캐시가 켜져 있을 때만 포함된 그림까지 읽음
+        bool artworkEnabled = artworkCache.isEnabled();
+        EmbeddedPicture picture;
+        bool streamInfoParsed = TagParser::parse(filePath, metadata, artworkEnabled ? &picture : nullptr);
+        
+        // 포함된 그림은 내용 해시로 한 번만 저장하고, 없으면 같은 폴더의 cover.jpg 등을 씀
+        if (artworkEnabled) {
+            if (!picture.data.empty()) {
+                metadata.albumArtPath = artworkCache.store(picture.data.data(), picture.data.size());
+            }
+            if (metadata.albumArtPath.empty()) {
+                metadata.albumArtPath = artworkCache.findFolderArt(path.parent_path().string());
+            }
+        }
         
-        // 파일명에서 기본 정보 추출 시 예외 처리 강화
-        try {
-            metadata.title = path.stem().string();
-        } catch (...) {
-            metadata.title = "Unknown Title";
+        // 태그에 없는 값은 파일명/기본값으로 채움
+        if (metadata.title.empty()) {
+            try {
+                metadata.title = path.stem().string();
+            } catch (...) {
+                metadata.title = "Unknown Title";
+            }
+        }
+        if (metadata.artist.empty()) metadata.artist = "Unknown Artist";
+        if (metadata.albumTitle.empty()) metadata.albumTitle = "Unknown Album";
+        if (metadata.genre.empty()) metadata.genre = "Unknown";
+        
+        // .mqa 확장자는 MQAENCODER 태그가 없어도 MQA로 표시
+        std::string extensionFormat = getAudioFormatFromExtension(filePath);
+        if (extensionFormat == "MQA") {
+            metadata.audioQuality.format = extensionFormat;
         }
         
-        metadata.artist = "Unknown Artist";
-        metadata.albumTitle = "Unknown Album";
-        metadata.genre = "Unknown";
-        metadata.year = 0;
-        metadata.trackNumber = 0;
-        metadata.playCount = 0;
-        metadata.lastPlayed = 0;
+        if (streamInfoParsed) {
+            if (metadata.audioQuality.bitDepth == 0) metadata.audioQuality.bitDepth = 16;
+            if (metadata.audioQuality.channels == 0) metadata.audioQuality.channels = 2;
+            // 총 샘플 수가 기록되지 않은 스트림 (기존 방어 코드와 같은 최소값)
+            if (metadata.duration <= 0) metadata.duration = 1000;
+            return true;
+        }
         
-        // 파일 크기 가져오기 시 예외 처리
+        // 헤더를 해석하지 못한 파일은 크기와 확장자로 추정
+        LOGI("Stream info not found, estimating from file size: %s", filePath.c_str());
         uintmax_t fileSize = 0;
         try {
             fileSize = fs::file_size(filePath);
@@ -218,30 +485,17 @@ bool AudioScanner::extractMetadata(const std::string& filePath, TrackMetadata& m
             fileSize = 1024 * 300; // 약 3MB로 가정
         }
         
-        // 파일 크기로 가상의 재생 시간 추정 (실제로는 TagLib 등에서 얻어야 함)
-        metadata.duration = (fileSize / 1024) * 10; // 크기를 기반으로 한 임시 계산
+        if (metadata.duration <= 0) {
+            metadata.duration = (fileSize / 1024) * 10; // 크기를 기반으로 한 임시 계산
+        }
         
         // 최소 재생 시간 설정 (방어 코드)
         if (metadata.duration < 1000) {
             metadata.duration = 1000; // 최소 1초
         }
         
-        // 오디오 품질 정보 (확장자로 유추)
-        std::string extension;
-        try {
-            extension = path.extension().string();
-            std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
-        } catch (...) {
-            extension = ".mp3"; // 기본값
-        }
-        
-        metadata.audioQuality.format = getAudioFormatFromExtension(filePath);
-        
-        // 샘플링 레이트와 비트 뎁스는 실제로는 파일에서 추출해야 함
-        if (metadata.audioQuality.format == "FLAC" || metadata.audioQuality.format == "WAV") {
-            metadata.audioQuality.sampleRate = 44100;
-            metadata.audioQuality.bitDepth = 16;
-        } else if (metadata.audioQuality.format == "DSD") {
+        metadata.audioQuality.format = extensionFormat;
+        if (metadata.audioQuality.format == "DSD") {
             metadata.audioQuality.sampleRate = 2822400;
             metadata.audioQuality.bitDepth = 1; // DSD는 1-bit
         } else if (metadata.audioQuality.format == "MQA") {
@@ -283,9 +537,10 @@ std::string AudioScanner::getAudioFormatFromExtension(const std::string& filePat
 
 // ID 생성
 std::string AudioScanner::generateId() {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::uniform_int_distribution<> dis(0, 15);
+    // 스캔 작업자 스레드에서 동시에 호출되므로 스레드마다 별도 생성기 사용
+    thread_local std::random_device rd;
+    thread_local std::mt19937 gen(rd());
+    thread_local std::uniform_int_distribution<> dis(0, 15);
     static const char* hex_chars = "0123456789abcdef";
     
     std::stringstream ss;
@@ -301,8 +556,9 @@ std::string AudioScanner::generateId() {
 // ID로 트랙 가져오기
 TrackMetadata AudioScanner::getTrackById(const std::string& trackId) {
     std::lock_guard<std::mutex> lock(mutex);
-    if (tracks.find(trackId) != tracks.end()) {
-        return tracks[trackId];
+    TrackHandle handle = tracks.findById(trackId);
+    if (handle != kInvalidTrackHandle) {
+        return tracks.get(handle);
     }
     return TrackMetadata();
 }
@@ -311,9 +567,10 @@ TrackMetadata AudioScanner::getTrackById(const std::string& trackId) {
 std::vector<TrackMetadata> AudioScanner::getAllTracks() {
     std::lock_guard<std::mutex> lock(mutex);
     std::vector<TrackMetadata> result;
-    for (const auto& pair : tracks) {
-        result.push_back(pair.second);
-    }
+    result.reserve(tracks.size());
+    tracks.forEach([&](TrackHandle handle) {
+        result.push_back(tracks.get(handle));
+    });
     return result;
 }
 
@@ -322,36 +579,45 @@ std::map<std::string, std::vector<TrackMetadata>> AudioScanner::getTracksByGenre
     std::lock_guard<std::mutex> lock(mutex);
     std::map<std::string, std::vector<TrackMetadata>> result;
     
-    for (const auto& pair : tracks) {
-        const TrackMetadata& track = pair.second;
-        std::string genre = track.genre.empty() ? "Unknown" : track.genre;
-        result[genre].push_back(track);
-    }
+    // 장르 목록을 그대로 옮김 (장르 없는 트랙은 "Unknown")
+    tracks.forEachGenre([&](std::string_view genre, const std::vector<TrackHandle>& handles) {
+        std::vector<TrackMetadata>& genreTracks = result[genre.empty() ? "Unknown" : std::string(genre)];
+        genreTracks.reserve(genreTracks.size() + handles.size());
+        for (TrackHandle handle : handles) {
+            genreTracks.push_back(tracks.get(handle));
+        }
+    });
     
     return result;
 }
 
+// 앨범 아트 경로 가져오기 (트랙을 복사하지 않고 아트 경로 열만 훑음)
+std::vector<std::string> AudioScanner::getAlbumArtPaths() {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<std::string_view> paths = tracks.getAlbumArtPaths();
+    return std::vector<std::string>(paths.begin(), paths.end());
+}
+
+// 패싯 조건으로 트랙 가져오기 (핸들 목록 교집합만 구한 뒤 결과 트랙만 복사)
+std::vector<TrackMetadata> AudioScanner::queryTracks(const TrackFilter& filter) {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<TrackHandle> handles = tracks.query(filter);
+    
+    std::vector<TrackMetadata> result;
+    result.reserve(handles.size());
+    for (TrackHandle handle : handles) {
+        result.push_back(tracks.get(handle));
+    }
+    return result;
+}
+
 // 최근 재생 트랙 가져오기
 std::vector<TrackMetadata> AudioScanner::getRecentlyPlayedTracks(int limit) {
     std::lock_guard<std::mutex> lock(mutex);
     std::vector<TrackMetadata> result;
-    
-    for (const auto& pair : tracks) {
-        if (pair.second.lastPlayed > 0) {
-            result.push_back(pair.second);
-        }
+    for (TrackHandle handle : tracks.topByLastPlayed(limit)) {
+        result.push_back(tracks.get(handle));
     }
-    
-    // 최근 재생 순으로 정렬
-    std::sort(result.begin(), result.end(), [](const TrackMetadata& a, const TrackMetadata& b) {
-        return a.lastPlayed > b.lastPlayed;
-    });
-    
-    // 제한된 수의 트랙만 반환
-    if (result.size() > limit) {
-        result.resize(limit);
-    }
-    
     return result;
 }
 
@@ -359,87 +625,39 @@ std::vector<TrackMetadata> AudioScanner::getRecentlyPlayedTracks(int limit) {
 std::vector<TrackMetadata> AudioScanner::getFrequentlyPlayedTracks(int limit) {
     std::lock_guard<std::mutex> lock(mutex);
     std::vector<TrackMetadata> result;
-    
-    for (const auto& pair : tracks) {
-        if (pair.second.playCount > 0) {
-            result.push_back(pair.second);
-        }
-    }
-    
-    // 재생 횟수로 정렬
-    std::sort(result.begin(), result.end(), [](const TrackMetadata& a, const TrackMetadata& b) {
-        return a.playCount > b.playCount;
-    });
-    
-    // 제한된 수의 트랙만 반환
-    if (result.size() > limit) {
-        result.resize(limit);
+    for (TrackHandle handle : tracks.topByPlayCount(limit)) {
+        result.push_back(tracks.get(handle));
     }
-    
     return result;
 }
 
 // 최근 추가된 트랙 가져오기
 std::vector<TrackMetadata> AudioScanner::getRecentlyAddedTracks(int limit) {
     std::lock_guard<std::mutex> lock(mutex);
-    std::vector<TrackMetadata> result;
-    
-    // 파일 생성 시간을 기준으로 정렬
-    std::vector<std::pair<TrackMetadata, time_t>> tracksWithTime;
     
-    for (const auto& pair : tracks) {
-        try {
-            fs::path path(pair.second.filePath);
-            auto fileTime = fs::last_write_time(path);
-            // C++17에서는 file_clock이 없으므로 직접 time_t로 변환
-            auto time_c = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
-            
-            // 현재 시간을 사용하되, 파일 경로가 있으면 해당 파일의 마지막 수정 시간을 사용
-            struct stat st;
-            auto time_t_value = time_c;
-            if (stat(pair.second.filePath.c_str(), &st) == 0) {
-                time_t_value = st.st_mtime;
-            }
-            
-            tracksWithTime.push_back({pair.second, time_t_value});
-        } catch (const std::exception& e) {
-            LOGE("Error getting file time: %s", e.what());
-        }
-    }
-    
-    // 최근 추가된 순으로 정렬
-    std::sort(tracksWithTime.begin(), tracksWithTime.end(), 
-             [](const auto& a, const auto& b) {
-                 return a.second > b.second;
-             });
-    
-    // 트랙 추출
-    for (const auto& pair : tracksWithTime) {
-        result.push_back(pair.first);
-        if (result.size() >= limit) {
-            break;
-        }
+    // 스캔할 때 기록한 추가 시간 순서 (파일에 접근하지 않음)
+    std::vector<TrackMetadata> result;
+    for (TrackHandle handle : tracks.topByDateAdded(limit)) {
+        result.push_back(tracks.get(handle));
     }
-    
     return result;
 }
 
 // 재생 횟수 업데이트
 void AudioScanner::updatePlayCount(const std::string& trackId) {
     std::lock_guard<std::mutex> lock(mutex);
-    if (tracks.find(trackId) != tracks.end()) {
-        tracks[trackId].playCount++;
+    TrackHandle handle = tracks.findById(trackId);
+    if (handle != kInvalidTrackHandle) {
+        tracks.setPlayCount(handle, tracks.getPlayCount(handle) + 1);
     }
 }
 
 // 마지막 재생 시간 업데이트
 void AudioScanner::updateLastPlayed(const std::string& trackId) {
     std::lock_guard<std::mutex> lock(mutex);
-    if (tracks.find(trackId) != tracks.end()) {
-        auto now = std::chrono::system_clock::now();
-        auto timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
-            now.time_since_epoch()).count();
-        tracks[trackId].lastPlayed = timestamp;
+    TrackHandle handle = tracks.findById(trackId);
+    if (handle != kInvalidTrackHandle) {
+        tracks.setLastPlayed(handle, currentTimeMillis());
     }
 }
 
@@ -454,13 +672,20 @@ bool AudioScanner::saveDatabase(const std::string& dbFilePath) {
             return false;
         }
         
+        // 스캔 병합과 동시에 실행될 수 있으므로 저장하는 동안 저장소 고정
+        std::lock_guard<std::mutex> lock(mutex);
+        
+        // 형식 식별자와 버전
+        outFile.write(kDatabaseMagic, sizeof(kDatabaseMagic));
+        outFile.write(reinterpret_cast<const char*>(&kDatabaseVersion), sizeof(kDatabaseVersion));
+        
         // 트랙 수 저장
         size_t trackCount = tracks.size();
         outFile.write(reinterpret_cast<const char*>(&trackCount), sizeof(trackCount));
         
         // 각 트랙 저장
-        for (const auto& pair : tracks) {
-            const auto& track = pair.second;
+        tracks.forEach([&](TrackHandle handle) {
+            const TrackMetadata track = tracks.get(handle);
             
             // 문자열 길이 및 데이터 저장 유틸리티 함수
             auto writeString = [&outFile](const std::string& str) {
@@ -493,7 +718,15 @@ bool AudioScanner::saveDatabase(const std::string& dbFilePath) {
             writeString(track.composer);
             outFile.write(reinterpret_cast<const char*>(&track.playCount), sizeof(track.playCount));
             outFile.write(reinterpret_cast<const char*>(&track.lastPlayed), sizeof(track.lastPlayed));
-        }
+            
+            // 파일 지문 (버전 2)
+            outFile.write(reinterpret_cast<const char*>(&track.fingerprint.size), sizeof(track.fingerprint.size));
+            outFile.write(reinterpret_cast<const char*>(&track.fingerprint.modifiedTimeNs), sizeof(track.fingerprint.modifiedTimeNs));
+            outFile.write(reinterpret_cast<const char*>(&track.fingerprint.inode), sizeof(track.fingerprint.inode));
+            
+            // 추가 시간 (버전 3)
+            outFile.write(reinterpret_cast<const char*>(&track.dateAdded), sizeof(track.dateAdded));
+        });
         
         // 앨범 수 저장
         size_t albumCount = albums.size();
@@ -546,10 +779,30 @@ bool AudioScanner::loadDatabase(const std::string& dbFilePath) {
             return false;
         }
         
+        // 형식 버전 확인 (식별자가 없으면 버전 1)
+        uint32_t version = 1;
+        char magic[sizeof(kDatabaseMagic)] = {};
+        inFile.read(magic, sizeof(magic));
+        if (inFile && memcmp(magic, kDatabaseMagic, sizeof(magic)) == 0) {
+            inFile.read(reinterpret_cast<char*>(&version), sizeof(version));
+            if (!inFile || version > kDatabaseVersion) {
+                LOGE("Unsupported database version %u: %s", version, dbFilePath.c_str());
+                return false;
+            }
+        } else {
+            inFile.clear();
+            inFile.seekg(0);
+        }
+        
         // 트랙 및 앨범 데이터 초기화
         std::lock_guard<std::mutex> lock(mutex);
         tracks.clear();
         albums.clear();
+        albumIdsByKey.clear();
+        libraryGeneration++;
+        
+        // 이전 버전은 재스캔할 때마다 같은 파일을 새 ID로 추가했으므로, 중복은 재생 기록을 합쳐 하나로 정리
+        std::unordered_set<std::string> duplicateTrackIds;
         
         // 문자열 읽기 유틸리티 함수
         auto readString = [&inFile]() -> std::string {
@@ -595,8 +848,29 @@ bool AudioScanner::loadDatabase(const std::string& dbFilePath) {
             inFile.read(reinterpret_cast<char*>(&track.playCount), sizeof(track.playCount));
             inFile.read(reinterpret_cast<char*>(&track.lastPlayed), sizeof(track.lastPlayed));
             
-            // 트랙 맵에 추가
-            tracks[track.id] = track;
+            // 파일 지문 (버전 1에는 없으므로 다음 스캔에서 한 번 다시 읽음)
+            if (version >= 2) {
+                inFile.read(reinterpret_cast<char*>(&track.fingerprint.size), sizeof(track.fingerprint.size));
+                inFile.read(reinterpret_cast<char*>(&track.fingerprint.modifiedTimeNs), sizeof(track.fingerprint.modifiedTimeNs));
+                inFile.read(reinterpret_cast<char*>(&track.fingerprint.inode), sizeof(track.fingerprint.inode));
+            }
+            
+            // 추가 시간 (버전 2 이하는 파일 수정 시간으로 대신하고, 지문도 없으면 다음 스캔에서 채움)
+            if (version >= 3) {
+                inFile.read(reinterpret_cast<char*>(&track.dateAdded), sizeof(track.dateAdded));
+            } else {
+                track.dateAdded = track.fingerprint.modifiedTimeNs / 1000000;
+            }
+            
+            // 저장소에 추가 (같은 경로의 트랙이 이미 있으면 재생 기록만 합침)
+            TrackHandle kept = tracks.findByPath(track.filePath);
+            if (kept != kInvalidTrackHandle && tracks.getId(kept) != track.id) {
+                tracks.setPlayCount(kept, tracks.getPlayCount(kept) + track.playCount);
+                tracks.setLastPlayed(kept, std::max(tracks.getLastPlayed(kept), static_cast<int64_t>(track.lastPlayed)));
+                duplicateTrackIds.insert(track.id);
+                continue;
+            }
+            tracks.insert(track);
         }
         
         // 앨범 수 읽기
@@ -623,10 +897,26 @@ bool AudioScanner::loadDatabase(const std::string& dbFilePath) {
                 album.trackIds.push_back(trackId);
             }
             
-            // 앨범 맵에 추가
+            // 앨범 맵에 추가 (이전 버전은 앨범을 키로 찾지 못해 트랙마다 앨범을 만들었으므로 같은 키는 하나로 합침)
+            std::string albumKey = makeAlbumKey(album.title, album.artist);
+            auto existing = albumIdsByKey.find(albumKey);
+            if (existing != albumIdsByKey.end()) {
+                AlbumMetadata& merged = albums[existing->second];
+                merged.trackIds.insert(merged.trackIds.end(), album.trackIds.begin(), album.trackIds.end());
+                if (merged.artworkPath.empty()) {
+                    merged.artworkPath = album.artworkPath;
+                }
+                continue;
+            }
+            albumIdsByKey.emplace(albumKey, album.id);
             albums[album.id] = album;
         }
         
+        removeTracksFromAlbumsLocked(duplicateTrackIds);
+        if (!duplicateTrackIds.empty()) {
+            LOGI("Merged %zu duplicate tracks", duplicateTrackIds.size());
+        }
+        
         inFile.close();
         LOGI("Database loaded from %s, %zu tracks, %zu albums", 
             dbFilePath.c_str(), tracks.size(), albums.size());
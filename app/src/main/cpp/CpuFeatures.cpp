@@ -0,0 +1,37 @@
+#include "include/CpuFeatures.h"
+#include <android/log.h>
+
+#if defined(__arm__)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+
+#define LOG_TAG "CpuFeatures"
+#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+const CpuFeatures& CpuFeatures::get() {
+    static const CpuFeatures features = detect();
+    return features;
+}
+
+CpuFeatures CpuFeatures::detect() {
+    CpuFeatures features;
+
+#if defined(__aarch64__)
+    // ARMv8-A에서 Advanced SIMD는 필수
+    features.neon = true;
+#elif defined(__arm__)
+    // armv7은 NEON이 없는 기기가 있으므로 커널이 보고하는 HWCAP으로 확인
+    features.neon = (getauxval(AT_HWCAP) & HWCAP_NEON) != 0;
+#elif defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    features.sse41 = __builtin_cpu_supports("sse4.1");
+    features.avx2 = __builtin_cpu_supports("avx2");
+    features.f16c = __builtin_cpu_supports("f16c");
+#endif
+
+    LOGI("CPU features: neon=%d sse4.1=%d avx2=%d f16c=%d",
+         features.neon, features.sse41, features.avx2, features.f16c);
+    return features;
+}
@@ -0,0 +1,64 @@
+#include "include/DecodedAudio.h"
+#include <cstring>
+
+DecodedAudio::DecodedAudio(SampleFormat format, int sampleRate, int channelCount, int bitDepth, int64_t totalFrames)
+    : mFormat(format),
+      mSampleRate(sampleRate),
+      mChannelCount(channelCount),
+      mBitDepth(bitDepth),
+      mTotalFrames(totalFrames),
+      mData(static_cast<size_t>(totalFrames) * channelCount * getBytesPerSample(format)) {
+}
+
+std::shared_ptr<DecodedAudio> DecodedAudio::create(SampleFormat format,
+                                                   int sampleRate,
+                                                   int channelCount,
+                                                   int bitDepth,
+                                                   int64_t totalFrames) {
+    if (channelCount <= 0 || totalFrames < 0) {
+        return nullptr;
+    }
+
+    switch (format) {
+        case SampleFormat::Float32:
+            return std::make_shared<TypedDecodedAudio<SampleFormat::Float32>>(sampleRate, channelCount, bitDepth, totalFrames);
+        case SampleFormat::Int16:
+            return std::make_shared<TypedDecodedAudio<SampleFormat::Int16>>(sampleRate, channelCount, bitDepth, totalFrames);
+        case SampleFormat::Int24:
+            return std::make_shared<TypedDecodedAudio<SampleFormat::Int24>>(sampleRate, channelCount, bitDepth, totalFrames);
+        case SampleFormat::Float16:
+            return std::make_shared<TypedDecodedAudio<SampleFormat::Float16>>(sampleRate, channelCount, bitDepth, totalFrames);
+    }
+    return nullptr;
+}
+
+SampleFormat DecodedAudio::selectStorageFormat(int bitDepth, bool compact) {
+    // 16비트 이하 소스는 int16으로 무손실 저장
+    if (bitDepth <= 16) {
+        return SampleFormat::Int16;
+    }
+    // 고해상도 소스는 compact 모드에서 float16 (약 11비트 정밀도)
+    if (compact) {
+        return SampleFormat::Float16;
+    }
+    return bitDepth <= 24 ? SampleFormat::Int24 : SampleFormat::Float32;
+}
+
+int32_t DecodedAudio::readRawFrames(int64_t startFrame, void* output, int32_t numFrames) const {
+    int32_t frames = clampFrames(startFrame, numFrames);
+    if (frames > 0) {
+        size_t frameBytes = static_cast<size_t>(mChannelCount) * getBytesPerSample(mFormat);
+        memcpy(output, mData.data() + static_cast<size_t>(startFrame) * frameBytes, frames * frameBytes);
+    }
+    return frames;
+}
+
+bool DecodedAudio::isLossless() const {
+    switch (mFormat) {
+        case SampleFormat::Int16: return mBitDepth <= 16;
+        case SampleFormat::Int24: return mBitDepth <= 24;
+        case SampleFormat::Float32: return true;
+        case SampleFormat::Float16: return false;
+    }
+    return false;
+}
@@ -0,0 +1,111 @@
+#include "include/DecodedAudioCache.h"
+#include <android/log.h>
+
+#define LOG_TAG "DecodedAudioCache"
+#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+DecodedAudioCache::DecodedAudioCache(size_t budgetBytes) : mBudgetBytes(budgetBytes) {
+}
+
+std::shared_ptr<const DecodedAudio> DecodedAudioCache::get(const DecodedAudioKey& key) {
+    std::lock_guard<std::mutex> lock(mLock);
+
+    auto it = mIndex.find(key);
+    if (it == mIndex.end()) {
+        mMissCount++;
+        return nullptr;
+    }
+
+    // 가장 최근 사용 항목으로 이동
+    mEntries.splice(mEntries.begin(), mEntries, it->second);
+    mHitCount++;
+    return it->second->second;
+}
+
+void DecodedAudioCache::put(const DecodedAudioKey& key, std::shared_ptr<const DecodedAudio> audio) {
+    if (!audio) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mLock);
+
+    size_t size = audio->getSizeInBytes();
+    if (size > mBudgetBytes) {
+        LOGI("Decoded audio too large for cache (%zu bytes): %s", size, key.filePath.c_str());
+        return;
+    }
+
+    auto it = mIndex.find(key);
+    if (it != mIndex.end()) {
+        mUsedBytes -= it->second->second->getSizeInBytes();
+        mEntries.erase(it->second);
+        mIndex.erase(it);
+    }
+
+    mEntries.emplace_front(key, std::move(audio));
+    mIndex[key] = mEntries.begin();
+    mUsedBytes += size;
+
+    evictToBudgetLocked();
+}
+
+bool DecodedAudioCache::contains(const DecodedAudioKey& key) const {
+    std::lock_guard<std::mutex> lock(mLock);
+    return mIndex.find(key) != mIndex.end();
+}
+
+void DecodedAudioCache::clear() {
+    std::lock_guard<std::mutex> lock(mLock);
+    mEntries.clear();
+    mIndex.clear();
+    mUsedBytes = 0;
+}
+
+void DecodedAudioCache::setBudgetBytes(size_t budgetBytes) {
+    std::lock_guard<std::mutex> lock(mLock);
+    mBudgetBytes = budgetBytes;
+    evictToBudgetLocked();
+    LOGI("Cache budget set to %zu bytes", budgetBytes);
+}
+
+size_t DecodedAudioCache::getBudgetBytes() const {
+    std::lock_guard<std::mutex> lock(mLock);
+    return mBudgetBytes;
+}
+
+size_t DecodedAudioCache::getUsedBytes() const {
+    std::lock_guard<std::mutex> lock(mLock);
+    return mUsedBytes;
+}
+
+void DecodedAudioCache::setCompactStorage(bool compact) {
+    std::lock_guard<std::mutex> lock(mLock);
+    mCompactStorage = compact;
+}
+
+bool DecodedAudioCache::isCompactStorage() const {
+    std::lock_guard<std::mutex> lock(mLock);
+    return mCompactStorage;
+}
+
+uint64_t DecodedAudioCache::getHitCount() const {
+    std::lock_guard<std::mutex> lock(mLock);
+    return mHitCount;
+}
+
+uint64_t DecodedAudioCache::getMissCount() const {
+    std::lock_guard<std::mutex> lock(mLock);
+    return mMissCount;
+}
+
+void DecodedAudioCache::evictToBudgetLocked() {
+    // 재생 중인 항목은 shared_ptr로 엔진이 계속 참조하므로 제거해도 안전
+    while (mUsedBytes > mBudgetBytes && !mEntries.empty()) {
+        auto& victim = mEntries.back();
+        mUsedBytes -= victim.second->getSizeInBytes();
+        LOGI("Evicting decoded audio: %s", victim.first.filePath.c_str());
+        mIndex.erase(victim.first);
+        mEntries.pop_back();
+    }
+}
@@ -0,0 +1,605 @@
+#include "include/DspChain.h"
+#include <android/log.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+#define LOG_TAG "DspChain"
+#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+namespace {
+
+constexpr float kEQQ = 1.41f;                 // 옥타브 밴드 폭
+constexpr float kLimiterCeiling = 0.989f;     // 약 -0.1 dBFS
+constexpr float kLimiterReleaseMs = 50.0f;
+constexpr float kLoudnessWindowSec = 3.0f;    // 라우드니스 측정 시간 상수
+constexpr float kNormalizationSmoothingMs = 200.0f;
+constexpr float kNormalizationMaxGainDb = 12.0f;
+constexpr float kLoudnessGateLUFS = -70.0f;   // 무음 구간은 측정에서 제외
+constexpr float kLoudnessRampMs = 50.0f;      // 볼륨 변경 시 라우드니스 보상 계수 보간 시간
+constexpr float kStageFadeMs = 20.0f;         // 크로스피드/컴프레서 on/off 전환 시간
+constexpr float kBudgetBlockFrames = 192.0f;  // 처리 시간 예산 기준 블록 (48kHz에서 4ms)
+constexpr float kBlockBudgetUs = 50.0f;       // 기준 블록당 허용 DSP 처리 시간
+
+struct CrossfeedParams {
+    float cutoffHz;
+    float feedDb;
+};
+
+CrossfeedParams getCrossfeedParams(CrossfeedPreset preset) {
+    switch (preset) {
+        case CrossfeedPreset::ChuMoy: return {700.0f, 6.0f};
+        case CrossfeedPreset::JanMeier: return {650.0f, 9.5f};
+        case CrossfeedPreset::Default:
+        default: return {700.0f, 4.5f};
+    }
+}
+
+float timeConstantCoefficient(float milliseconds, int sampleRate) {
+    return 1.0f - std::exp(-1000.0f / (milliseconds * sampleRate));
+}
+
+// 처리된 float 블록을 output의 offset 샘플 위치부터 출력 형식으로 기록 (float/int16은 커널 사용)
+template <SampleFormat OutFormat>
+void storeOutput(const DspKernelTable& kernels, const float* block, uint8_t* output, size_t offset, size_t samples) {
+    if (OutFormat == SampleFormat::Float32) {
+        memmove(reinterpret_cast<float*>(output) + offset, block, samples * sizeof(float));
+    } else if (OutFormat == SampleFormat::Int16) {
+        kernels.floatToInt16(block, reinterpret_cast<int16_t*>(output) + offset, samples);
+    } else {
+        for (size_t i = 0; i < samples; i++) {
+            SampleTraits<OutFormat>::store(output, offset + i, block[i]);
+        }
+    }
+}
+
+} // namespace
+
+DspChain::DspChain() : mKernel(selectKernel(0, SampleFormat::Float32)) {
+    // 설정 변경 시 재할당이 없도록 최대 섹션 수(EQ 밴드 + 라우드니스 보상)만큼 미리 확보
+    mEQSections.reserve(DspSettings::kEQBands + 1);
+    mEQState.reserve((DspSettings::kEQBands + 1) * kMaxChannels);
+    mStageBuffer.resize(static_cast<size_t>(kFuseBlockFrames) * kMaxChannels);
+}
+
+void DspChain::configure(const DspSettings& settings) {
+    bool formatChanged = settings.sampleRate != mSampleRate ||
+                         settings.channelCount != mChannelCount;
+
+    mSampleRate = settings.sampleRate;
+    mChannelCount = std::min(settings.channelCount, kMaxChannels);
+    mOutputFormat = settings.outputFormat;
+    mVolume = settings.volume;
+    mTargetLUFS = settings.targetLUFS;
+
+    // EQ 계수 재계산 (0dB 밴드는 생략하여 섹션 수 최소화)
+    size_t previousSections = mEQSections.size();
+    bool hadLoudness = mUseLoudness;
+    BiquadCoefficients currentLoudness = hadLoudness ? mEQSections.front() : BiquadCoefficients();
+    mEQSections.clear();
+
+    // 라우드니스 보상은 캐스케이드 맨 앞 섹션, 계수는 여기(설정 스레드)에서 계산하고
+    // 오디오 스레드는 현재 계수에서 목표 계수까지 선형 보간만 수행
+    mUseLoudness = settings.loudnessEnabled;
+    if (mUseLoudness) {
+        mLoudnessTarget = LoudnessCompensation::computeCoefficients(mSampleRate, settings.volume);
+        if (hadLoudness && !formatChanged) {
+            // 두 계수 모두 안정한 2차 필터이고 (a1, a2) 안정 영역은 볼록하므로 보간 중에도 안정
+            mLoudnessRampFrames = std::max(1, static_cast<int32_t>(kLoudnessRampMs * 0.001f * mSampleRate));
+            float scale = 1.0f / mLoudnessRampFrames;
+            mLoudnessStep.b0 = (mLoudnessTarget.b0 - currentLoudness.b0) * scale;
+            mLoudnessStep.b1 = (mLoudnessTarget.b1 - currentLoudness.b1) * scale;
+            mLoudnessStep.b2 = (mLoudnessTarget.b2 - currentLoudness.b2) * scale;
+            mLoudnessStep.a1 = (mLoudnessTarget.a1 - currentLoudness.a1) * scale;
+            mLoudnessStep.a2 = (mLoudnessTarget.a2 - currentLoudness.a2) * scale;
+        } else {
+            currentLoudness = mLoudnessTarget;
+            mLoudnessRampFrames = 0;
+        }
+        mEQSections.push_back(currentLoudness);
+    } else {
+        mLoudnessRampFrames = 0;
+    }
+    if (settings.eqEnabled) {
+        for (int band = 0; band < DspSettings::kEQBands; band++) {
+            float gain = settings.eqGains[band];
+            float frequency = kEQFrequencies[band];
+            if (gain != 0.0f && frequency < mSampleRate * 0.45f) {
+                mEQSections.push_back(BiquadCoefficients::peaking(mSampleRate, frequency, kEQQ, gain));
+            }
+        }
+    }
+    if (mEQSections.size() != previousSections) {
+        // 섹션 구성이 바뀌면 이전 상태는 의미가 없음
+        mEQState.assign(mEQSections.size() * kMaxChannels, BiquadState());
+    }
+
+    mLimiterRelease = timeConstantCoefficient(kLimiterReleaseMs, mSampleRate);
+    mNormalizationSmoothing = timeConstantCoefficient(kNormalizationSmoothingMs, mSampleRate);
+
+    mNormalizationEnabled = settings.normalizationEnabled;
+    if (!mNormalizationEnabled) {
+        mNormalizationGain = 1.0f;
+        mNormalizationTargetGain = 1.0f;
+    }
+
+    // 크로스피드/컴프레서는 켜고 끌 때 mix를 램프하고, 완전히 꺼진 뒤에야 커널에서 제외
+    float fadeStep = 1.0f / (kStageFadeMs * 0.001f * mSampleRate);
+    mCrossfeedMix.step = fadeStep;
+    mCompressorMix.step = fadeStep;
+
+    bool wantCrossfeed = settings.crossfeedEnabled && mChannelCount == 2;
+    if (wantCrossfeed) {
+        updateCrossfeedCoefficients(settings.crossfeedPreset);
+        if (!mUseCrossfeed) {
+            mCrossfeedMix.mix = 0.0f;
+            for (int ch = 0; ch < 2; ch++) {
+                mCrossfeedLow[ch] = 0.0f;
+                mCrossfeedHigh[ch] = 0.0f;
+                mCrossfeedPrevInput[ch] = 0.0f;
+            }
+        }
+        mUseCrossfeed = true;
+        mCrossfeedMix.target = 1.0f;
+    } else {
+        mCrossfeedMix.target = 0.0f;
+        if (mChannelCount != 2 || mCrossfeedMix.isOff()) {
+            mUseCrossfeed = false;
+            mCrossfeedMix.mix = 0.0f;
+        }
+    }
+
+    bool wantCompressor = settings.compressorEnabled && mChannelCount <= 2;
+    if (wantCompressor) {
+        // 필터/엔벨로프 상태를 유지하기 위해 처음 켤 때와 계수가 바뀔 때만 재설정
+        if (!mUseCompressor || formatChanged || settings.compressorMakeupDb != mCompressorMakeupDb) {
+            mCompressor.configure(mSampleRate, settings.compressorMakeupDb);
+            mCompressorMakeupDb = settings.compressorMakeupDb;
+        }
+        if (!mUseCompressor) {
+            mCompressorMix.mix = 0.0f;
+        }
+        mUseCompressor = true;
+        mCompressorMix.target = 1.0f;
+    } else {
+        mCompressorMix.target = 0.0f;
+        if (mChannelCount > 2 || mCompressorMix.isOff()) {
+            mUseCompressor = false;
+            mCompressorMix.mix = 0.0f;
+        }
+    }
+
+    updateKernel();
+
+    if (formatChanged) {
+        reset();
+    }
+
+    LOGI("DSP chain configured: volume=%d eq=%zu sections loudness=%d compressor=%d crossfeed=%d normalize=%d limit=%d output=%s",
+         (mStages & kStageVolume) != 0, mEQSections.size(), mUseLoudness, wantCompressor, wantCrossfeed, mNormalizationEnabled,
+         (mStages & kStageLimit) != 0, getSampleFormatName(mOutputFormat));
+}
+
+void DspChain::updateKernel() {
+    bool useEQ = !mEQSections.empty();
+    // 게인이 1을 넘을 수 있는 단계가 있으면 리미터로 클리핑 방지
+    bool useLimit = useEQ || mUseCompressor || mNormalizationEnabled || mUseCrossfeed || mVolume > 1.0f;
+
+    mStages = (mVolume != 1.0f ? kStageVolume : 0) |
+              (useEQ ? kStageEQ : 0) |
+              (mUseCompressor ? kStageCompressor : 0) |
+              (mUseCrossfeed ? kStageCrossfeed : 0) |
+              (mNormalizationEnabled ? kStageNormalize : 0) |
+              (useLimit ? kStageLimit : 0);
+    mKernel = selectKernel(mStages, mOutputFormat);
+    mNeutral = mStages == 0 && mOutputFormat == SampleFormat::Float32;
+}
+
+void DspChain::updateCrossfeedCoefficients(CrossfeedPreset preset) {
+    // bs2b: 반대 채널은 1차 저역 통과로 섞고 직접 채널은 1차 고역 쉘프로 보상
+    CrossfeedParams params = getCrossfeedParams(preset);
+    double gainLowDb = params.feedDb * -5.0 / 6.0 - 3.0;
+    double gainHighDb = params.feedDb / 6.0 - 3.0;
+    double gainLow = std::pow(10.0, gainLowDb / 20.0);
+    double gainHigh = 1.0 - std::pow(10.0, gainHighDb / 20.0);
+    double cutoffHigh = params.cutoffHz * std::pow(2.0, (gainLowDb - 20.0 * std::log10(gainHigh)) / 12.0);
+
+    double x = std::exp(-2.0 * M_PI * params.cutoffHz / mSampleRate);
+    mCrossfeedLowB1 = static_cast<float>(x);
+    mCrossfeedLowA0 = static_cast<float>(gainLow * (1.0 - x));
+
+    x = std::exp(-2.0 * M_PI * cutoffHigh / mSampleRate);
+    mCrossfeedHighB1 = static_cast<float>(x);
+    mCrossfeedHighA0 = static_cast<float>(1.0 - gainHigh * (1.0 - x));
+    mCrossfeedHighA1 = static_cast<float>(-x);
+
+    // 모노(L = R) 신호의 DC 이득이 1이 되도록 정규화
+    mCrossfeedGain = static_cast<float>(1.0 / (1.0 - gainHigh + gainLow));
+}
+
+void DspChain::process(const float* input, void* output, int32_t numFrames) {
+    if (numFrames <= 0) {
+        return;
+    }
+
+    if (!mUseCompressor) {
+        mKernel(*this, input, static_cast<uint8_t*>(output), numFrames);
+    } else {
+        // 나이트 모드가 켜져 있으면 처리 시간을 192프레임 블록 기준으로 측정하여 예산 초과 여부 기록
+        auto start = std::chrono::steady_clock::now();
+        mKernel(*this, input, static_cast<uint8_t*>(output), numFrames);
+        float elapsedUs = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - start).count();
+        float blockUs = elapsedUs * kBudgetBlockFrames / numFrames;
+        mBlockTimeUs.store(blockUs, std::memory_order_relaxed);
+        if (blockUs > kBlockBudgetUs) {
+            mBudgetOverruns.fetch_add(1, std::memory_order_relaxed);
+        }
+        mCompressor.publishMeters();
+    }
+
+    finishBlock();
+}
+
+void DspChain::processPerStage(const float* input, void* output, int32_t numFrames) {
+    if (numFrames <= 0) {
+        return;
+    }
+
+    const DspKernelTable& kernels = DspKernels::active();
+    const int channels = mChannelCount;
+    const size_t samples = static_cast<size_t>(numFrames) * channels;
+    if (mStageBuffer.size() < samples) {
+        mStageBuffer.resize(samples);
+    }
+    float* buffer = mStageBuffer.data();
+    memcpy(buffer, input, samples * sizeof(float));
+
+    if (mStages & kStageVolume) {
+        kernels.applyGain(buffer, samples, mVolume);
+    }
+
+    if (mStages & kStageEQ) {
+        applyEQ(kernels, buffer, numFrames);
+    }
+
+    if (mStages & kStageCompressor) {
+        for (int32_t i = 0; i < numFrames; i++) {
+            float* frame = buffer + static_cast<size_t>(i) * channels;
+            float l = frame[0];
+            float r = channels > 1 ? frame[1] : l;
+            float compressedL = l;
+            float compressedR = r;
+            mCompressor.process(compressedL, compressedR);
+            float mix = mCompressorMix.next();
+            frame[0] = l + (compressedL - l) * mix;
+            if (channels > 1) {
+                frame[1] = r + (compressedR - r) * mix;
+            }
+        }
+        mCompressor.publishMeters();
+    }
+
+    if (mStages & kStageCrossfeed) {
+        for (int32_t i = 0; i < numFrames; i++) {
+            float* frame = buffer + static_cast<size_t>(i) * 2;
+            float l = frame[0];
+            float r = frame[1];
+            mCrossfeedLow[0] = mCrossfeedLowA0 * l + mCrossfeedLowB1 * mCrossfeedLow[0];
+            mCrossfeedLow[1] = mCrossfeedLowA0 * r + mCrossfeedLowB1 * mCrossfeedLow[1];
+            mCrossfeedHigh[0] = mCrossfeedHighA0 * l + mCrossfeedHighA1 * mCrossfeedPrevInput[0] +
+                                mCrossfeedHighB1 * mCrossfeedHigh[0];
+            mCrossfeedHigh[1] = mCrossfeedHighA0 * r + mCrossfeedHighA1 * mCrossfeedPrevInput[1] +
+                                mCrossfeedHighB1 * mCrossfeedHigh[1];
+            mCrossfeedPrevInput[0] = l;
+            mCrossfeedPrevInput[1] = r;
+
+            float mix = mCrossfeedMix.next();
+            float wetL = (mCrossfeedHigh[0] + mCrossfeedLow[1]) * mCrossfeedGain;
+            float wetR = (mCrossfeedHigh[1] + mCrossfeedLow[0]) * mCrossfeedGain;
+            frame[0] = l + (wetL - l) * mix;
+            frame[1] = r + (wetR - r) * mix;
+        }
+    }
+
+    if (mStages & kStageNormalize) {
+        float sumSquares = 0.0f;
+        for (int32_t i = 0; i < numFrames; i++) {
+            float* frame = buffer + static_cast<size_t>(i) * channels;
+            mNormalizationGain += (mNormalizationTargetGain - mNormalizationGain) * mNormalizationSmoothing;
+            for (int ch = 0; ch < channels; ch++) {
+                sumSquares += frame[ch] * frame[ch];
+                frame[ch] *= mNormalizationGain;
+            }
+        }
+        updateNormalizationTarget(sumSquares / (static_cast<float>(numFrames) * channels), numFrames);
+    }
+
+    if (mStages & kStageLimit) {
+        for (int32_t i = 0; i < numFrames; i++) {
+            float* frame = buffer + static_cast<size_t>(i) * channels;
+            float peak = 0.0f;
+            for (int ch = 0; ch < channels; ch++) {
+                peak = std::max(peak, std::fabs(frame[ch]));
+            }
+            float needed = peak * mLimiterGain > kLimiterCeiling ? kLimiterCeiling / peak : 1.0f;
+            if (needed < mLimiterGain) {
+                mLimiterGain = needed;
+            } else {
+                mLimiterGain += (1.0f - mLimiterGain) * mLimiterRelease;
+            }
+            for (int ch = 0; ch < channels; ch++) {
+                frame[ch] *= mLimiterGain;
+            }
+        }
+    }
+
+    uint8_t* out = static_cast<uint8_t*>(output);
+    switch (mOutputFormat) {
+        case SampleFormat::Int16:
+            storeOutput<SampleFormat::Int16>(kernels, buffer, out, 0, samples);
+            break;
+        case SampleFormat::Int24:
+            storeOutput<SampleFormat::Int24>(kernels, buffer, out, 0, samples);
+            break;
+        case SampleFormat::Float16:
+            storeOutput<SampleFormat::Float16>(kernels, buffer, out, 0, samples);
+            break;
+        case SampleFormat::Float32:
+        default:
+            storeOutput<SampleFormat::Float32>(kernels, buffer, out, 0, samples);
+            break;
+    }
+
+    finishBlock();
+}
+
+void DspChain::finishBlock() {
+    // 바이패스 페이드아웃이 끝나면 해당 단계가 없는 커널로 교체
+    bool stagesChanged = false;
+    if (mUseCrossfeed && mCrossfeedMix.isOff()) {
+        mUseCrossfeed = false;
+        stagesChanged = true;
+    }
+    if (mUseCompressor && mCompressorMix.isOff()) {
+        mUseCompressor = false;
+        mCompressor.reset();  // 미터도 0으로 초기화
+        stagesChanged = true;
+    }
+    if (stagesChanged) {
+        updateKernel();
+    }
+}
+
+CompressorMeters DspChain::getCompressorMeters() const {
+    CompressorMeters meters;
+    for (int band = 0; band < MultibandCompressor::kBands; band++) {
+        meters.gainReductionDb[band] = mCompressor.getGainReductionDb(band);
+    }
+    meters.blockTimeUs = mBlockTimeUs.load(std::memory_order_relaxed);
+    meters.budgetOverruns = mBudgetOverruns.load(std::memory_order_relaxed);
+    return meters;
+}
+
+void DspChain::reset() {
+    for (auto& state : mEQState) {
+        state.reset();
+    }
+    for (int ch = 0; ch < 2; ch++) {
+        mCrossfeedLow[ch] = 0.0f;
+        mCrossfeedHigh[ch] = 0.0f;
+        mCrossfeedPrevInput[ch] = 0.0f;
+    }
+    if (mUseCompressor) {
+        mCompressor.reset();
+    }
+    mLoudnessMeanSquare = 0.0f;
+    mLimiterGain = 1.0f;
+}
+
+void DspChain::applyEQ(const DspKernelTable& kernels, float* buffer, int32_t numFrames) {
+    // 라우드니스 보상 램프 중에는 프레임마다 계수가 바뀌므로 램프가 끝날 때까지 한 프레임씩 적용
+    const int channels = mChannelCount;
+    int32_t i = 0;
+    for (; i < numFrames && mLoudnessRampFrames > 0; i++) {
+        stepLoudnessRamp();
+        kernels.biquadCascade(buffer + static_cast<size_t>(i) * channels, 1, channels, mEQSections.data(),
+                              mEQState.data(), mEQSections.size(), kMaxChannels);
+    }
+    kernels.biquadCascade(buffer + static_cast<size_t>(i) * channels, numFrames - i, channels,
+                          mEQSections.data(), mEQState.data(), mEQSections.size(), kMaxChannels);
+}
+
+inline void DspChain::stepLoudnessRamp() {
+    BiquadCoefficients& section = mEQSections.front();
+    if (--mLoudnessRampFrames == 0) {
+        section = mLoudnessTarget;  // 누적 오차 없이 목표값에 정확히 도달
+        return;
+    }
+    section.b0 += mLoudnessStep.b0;
+    section.b1 += mLoudnessStep.b1;
+    section.b2 += mLoudnessStep.b2;
+    section.a1 += mLoudnessStep.a1;
+    section.a2 += mLoudnessStep.a2;
+}
+
+template <bool kVolume, bool kEQ, bool kCompressor, bool kCrossfeed, bool kNormalize, bool kLimit,
+          SampleFormat OutFormat>
+void DspChain::processFused(DspChain& chain, const float* input, uint8_t* output, int32_t numFrames) {
+    const int channels = chain.mChannelCount;
+    const DspKernelTable& kernels = DspKernels::active();
+    float* stageBuffer = chain.mStageBuffer.data();
+
+    float normalizationGain = chain.mNormalizationGain;
+    const float normalizationTarget = chain.mNormalizationTargetGain;
+    const float normalizationSmoothing = chain.mNormalizationSmoothing;
+    float limiterGain = chain.mLimiterGain;
+    const float limiterRelease = chain.mLimiterRelease;
+    float sumSquares = 0.0f;
+
+    // 크로스피드 상태는 레지스터에 두고 블록 끝에서 저장 (스테레오 전용)
+    float lowL = chain.mCrossfeedLow[0], lowR = chain.mCrossfeedLow[1];
+    float highL = chain.mCrossfeedHigh[0], highR = chain.mCrossfeedHigh[1];
+    float prevL = chain.mCrossfeedPrevInput[0], prevR = chain.mCrossfeedPrevInput[1];
+    MixRamp crossfeedMix = chain.mCrossfeedMix;
+    MixRamp compressorMix = chain.mCompressorMix;
+    MultibandCompressor& compressor = chain.mCompressor;
+    const float lowA0 = chain.mCrossfeedLowA0, lowB1 = chain.mCrossfeedLowB1;
+    const float highA0 = chain.mCrossfeedHighA0, highA1 = chain.mCrossfeedHighA1, highB1 = chain.mCrossfeedHighB1;
+    const float crossfeedGain = chain.mCrossfeedGain;
+
+    for (int32_t blockStart = 0; blockStart < numFrames; blockStart += kFuseBlockFrames) {
+        const int32_t blockFrames = std::min(kFuseBlockFrames, numFrames - blockStart);
+        const size_t blockBase = static_cast<size_t>(blockStart) * channels;
+        const size_t samples = static_cast<size_t>(blockFrames) * channels;
+        memcpy(stageBuffer, input + blockBase, samples * sizeof(float));
+
+        // 볼륨/EQ는 채널 간 의존이 없어 L1에 머무는 블록에 SIMD 커널로 먼저 적용
+        // (프레임 루프 안의 채널별 스칼라 biquad보다 스테레오 레인 커널이 빠름)
+        if (kVolume) {
+            kernels.applyGain(stageBuffer, samples, chain.mVolume);
+        }
+        if (kEQ) {
+            chain.applyEQ(kernels, stageBuffer, blockFrames);
+        }
+
+        // 나머지 단계는 상태가 프레임 단위로 얽혀 있으므로 프레임마다 모두 적용하여 블록을 한 번만 순회
+        if (kCompressor || kCrossfeed || kNormalize || kLimit) {
+            for (int32_t i = 0; i < blockFrames; i++) {
+                float* frame = stageBuffer + static_cast<size_t>(i) * channels;
+
+                if (kCompressor) {
+                    float l = frame[0];
+                    float r = channels > 1 ? frame[1] : l;
+                    float compressedL = l;
+                    float compressedR = r;
+                    compressor.process(compressedL, compressedR);
+                    float mix = compressorMix.next();
+                    frame[0] = l + (compressedL - l) * mix;
+                    if (channels > 1) {
+                        frame[1] = r + (compressedR - r) * mix;
+                    }
+                }
+
+                if (kCrossfeed) {
+                    float l = frame[0];
+                    float r = frame[1];
+                    lowL = lowA0 * l + lowB1 * lowL;
+                    lowR = lowA0 * r + lowB1 * lowR;
+                    highL = highA0 * l + highA1 * prevL + highB1 * highL;
+                    highR = highA0 * r + highA1 * prevR + highB1 * highR;
+                    prevL = l;
+                    prevR = r;
+
+                    // A/B 전환 시 원음과 크로스피드 결과를 선형 크로스페이드
+                    float mix = crossfeedMix.next();
+                    float wetL = (highL + lowR) * crossfeedGain;
+                    float wetR = (highR + lowL) * crossfeedGain;
+                    frame[0] = l + (wetL - l) * mix;
+                    frame[1] = r + (wetR - r) * mix;
+                }
+
+                if (kNormalize) {
+                    normalizationGain += (normalizationTarget - normalizationGain) * normalizationSmoothing;
+                }
+
+                float peak = 0.0f;
+                for (int ch = 0; ch < channels; ch++) {
+                    float x = frame[ch];
+                    if (kNormalize) {
+                        sumSquares += x * x;
+                        x *= normalizationGain;
+                    }
+                    if (kLimit) {
+                        peak = std::max(peak, std::fabs(x));
+                    }
+                    frame[ch] = x;
+                }
+
+                if (kLimit) {
+                    // 채널 연동 피크 리미터
+                    float needed = peak * limiterGain > kLimiterCeiling ? kLimiterCeiling / peak : 1.0f;
+                    if (needed < limiterGain) {
+                        limiterGain = needed;
+                    } else {
+                        limiterGain += (1.0f - limiterGain) * limiterRelease;
+                    }
+                    for (int ch = 0; ch < channels; ch++) {
+                        frame[ch] *= limiterGain;
+                    }
+                }
+            }
+        }
+
+        storeOutput<OutFormat>(kernels, stageBuffer, output, blockBase, samples);
+    }
+
+    chain.mLimiterGain = limiterGain;
+    if (kCrossfeed) {
+        chain.mCrossfeedLow[0] = lowL;
+        chain.mCrossfeedLow[1] = lowR;
+        chain.mCrossfeedHigh[0] = highL;
+        chain.mCrossfeedHigh[1] = highR;
+        chain.mCrossfeedPrevInput[0] = prevL;
+        chain.mCrossfeedPrevInput[1] = prevR;
+        chain.mCrossfeedMix = crossfeedMix;
+    }
+    if (kCompressor) {
+        chain.mCompressorMix = compressorMix;
+    }
+    if (kNormalize) {
+        chain.mNormalizationGain = normalizationGain;
+        chain.updateNormalizationTarget(sumSquares / (static_cast<float>(numFrames) * channels), numFrames);
+    }
+}
+
+void DspChain::updateNormalizationTarget(float blockMeanSquare, int32_t numFrames) {
+    // 블록 평균 제곱을 지수 이동 평균으로 누적
+    float alpha = 1.0f - std::exp(-static_cast<float>(numFrames) / (kLoudnessWindowSec * mSampleRate));
+    mLoudnessMeanSquare += (blockMeanSquare - mLoudnessMeanSquare) * alpha;
+
+    if (mLoudnessMeanSquare <= 0.0f) {
+        return;
+    }
+
+    float loudness = -0.691f + 10.0f * std::log10(mLoudnessMeanSquare);
+    if (loudness < kLoudnessGateLUFS) {
+        return;
+    }
+
+    float gainDb = std::max(-kNormalizationMaxGainDb, std::min(kNormalizationMaxGainDb, mTargetLUFS - loudness));
+    mNormalizationTargetGain = std::pow(10.0f, gainDb / 20.0f);
+}
+
+template <SampleFormat OutFormat, size_t... Stages>
+constexpr std::array<DspChain::Kernel, sizeof...(Stages)> DspChain::makeKernelTable(std::index_sequence<Stages...>) {
+    // 단계 조합 비트마다 하나의 융합 커널 인스턴스
+    return {{&processFused<(Stages & kStageVolume) != 0,
+                           (Stages & kStageEQ) != 0,
+                           (Stages & kStageCompressor) != 0,
+                           (Stages & kStageCrossfeed) != 0,
+                           (Stages & kStageNormalize) != 0,
+                           (Stages & kStageLimit) != 0,
+                           OutFormat>...}};
+}
+
+DspChain::Kernel DspChain::selectKernel(int stages, SampleFormat format) {
+    using StageIndices = std::make_index_sequence<kStageCount>;
+    static constexpr auto kFloat32Kernels = makeKernelTable<SampleFormat::Float32>(StageIndices{});
+    static constexpr auto kInt16Kernels = makeKernelTable<SampleFormat::Int16>(StageIndices{});
+    static constexpr auto kInt24Kernels = makeKernelTable<SampleFormat::Int24>(StageIndices{});
+    static constexpr auto kFloat16Kernels = makeKernelTable<SampleFormat::Float16>(StageIndices{});
+
+    switch (format) {
+        case SampleFormat::Int16:
+            return kInt16Kernels[stages];
+        case SampleFormat::Int24:
+            return kInt24Kernels[stages];
+        case SampleFormat::Float16:
+            return kFloat16Kernels[stages];
+        case SampleFormat::Float32:
+        default:
+            return kFloat32Kernels[stages];
+    }
+}
@@ -0,0 +1,814 @@
+#include "include/DspKernels.h"
+#include "include/CpuFeatures.h"
+#include "include/SampleFormat.h"
+#include <android/log.h>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define PANCAKE_X86_KERNELS 1
+// 전체 빌드 플래그를 올리지 않고 함수 단위로 ISA를 지정 (런타임 감지 후에만 호출됨)
+#define TARGET_SSE41 __attribute__((target("sse4.1")))
+#define TARGET_AVX2 __attribute__((target("avx2,f16c")))
+#endif
+
+#define LOG_TAG "DspKernels"
+#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+namespace {
+
+constexpr float kInt16Scale = 1.0f / 32768.0f;
+// 벡터 biquad가 계수와 상태를 레지스터/스택에 올려둘 수 있는 최대 섹션 수 (넘으면 scalar)
+constexpr size_t kMaxVectorBiquadSections = 16;
+
+// ---------------------------------------------------------------------------
+// scalar (기준 구현)
+// ---------------------------------------------------------------------------
+
+void int16ToFloatScalar(const int16_t* src, float* dst, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        dst[i] = src[i] * kInt16Scale;
+    }
+}
+
+void floatToInt16Scalar(const float* src, int16_t* dst, size_t count) {
+    uint8_t* out = reinterpret_cast<uint8_t*>(dst);
+    for (size_t i = 0; i < count; i++) {
+        SampleTraits<SampleFormat::Int16>::store(out, i, src[i]);
+    }
+}
+
+void halfToFloatScalar(const uint16_t* src, float* dst, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        dst[i] = halfToFloat(src[i]);
+    }
+}
+
+float sumSquaresScalar(const float* data, size_t count) {
+    float sum = 0.0f;
+    for (size_t i = 0; i < count; i++) {
+        sum += data[i] * data[i];
+    }
+    return sum;
+}
+
+float dotProductScalar(const float* a, const float* b, size_t count) {
+    float sum = 0.0f;
+    for (size_t i = 0; i < count; i++) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+void applyGainScalar(float* data, size_t count, float gain) {
+    for (size_t i = 0; i < count; i++) {
+        data[i] *= gain;
+    }
+}
+
+void biquadCascadeScalar(float* data, size_t frames, int channels, const BiquadCoefficients* coefficients,
+                         BiquadState* states, size_t sections, size_t stateStride) {
+    for (size_t i = 0; i < frames; i++) {
+        float* frame = data + i * channels;
+        for (int ch = 0; ch < channels; ch++) {
+            float x = frame[ch];
+            for (size_t s = 0; s < sections; s++) {
+                x = states[s * stateStride + ch].process(coefficients[s], x);
+            }
+            frame[ch] = x;
+        }
+    }
+}
+
+void fftStageScalar(float* real, float* imag, size_t size, size_t half,
+                    const float* twiddleReal, const float* twiddleImag, float direction) {
+    for (size_t start = 0; start < size; start += 2 * half) {
+        float* ar = real + start;
+        float* ai = imag + start;
+        float* br = ar + half;
+        float* bi = ai + half;
+        for (size_t k = 0; k < half; k++) {
+            float wr = twiddleReal[k];
+            float wi = direction * twiddleImag[k];
+            float tr = br[k] * wr - bi[k] * wi;
+            float ti = br[k] * wi + bi[k] * wr;
+            br[k] = ar[k] - tr;
+            bi[k] = ai[k] - ti;
+            ar[k] += tr;
+            ai[k] += ti;
+        }
+    }
+}
+
+// 출력 위치 계산은 모든 변형이 이 함수를 써서 같은 인덱스와 소수부를 얻음
+inline const float* cubicTaps(const float* buffer, int channels, double phase, double ratio, int32_t n, float& t) {
+    double position = 1.0 + phase + n * ratio;
+    int32_t index = static_cast<int32_t>(position);
+    t = static_cast<float>(position - index);
+    return buffer + static_cast<size_t>(index - 1) * channels;
+}
+
+// 출력 한 프레임 보간 (SIMD 변형의 꼬리 처리에도 사용)
+inline void cubicFrame(const float* x, int channels, float t, float* out) {
+    for (int c = 0; c < channels; c++) {
+        float x0 = x[c];
+        float x1 = x[channels + c];
+        float x2 = x[2 * channels + c];
+        float x3 = x[3 * channels + c];
+
+        // Catmull-Rom 큐빅 Hermite
+        float c1 = 0.5f * (x2 - x0);
+        float c2 = x0 - 2.5f * x1 + 2.0f * x2 - 0.5f * x3;
+        float c3 = 0.5f * (x3 - x0) + 1.5f * (x1 - x2);
+        out[c] = ((c3 * t + c2) * t + c1) * t + x1;
+    }
+}
+
+void resampleCubicScalar(const float* buffer, int channels, float* output, int32_t outputFrames,
+                         double phase, double ratio) {
+    for (int32_t n = 0; n < outputFrames; n++) {
+        float t;
+        const float* x = cubicTaps(buffer, channels, phase, ratio, n, t);
+        cubicFrame(x, channels, t, output + static_cast<size_t>(n) * channels);
+    }
+}
+
+void binEnergiesScalar(const float* data, size_t binSize, size_t bins, float* energies) {
+    for (size_t b = 0; b < bins; b++) {
+        energies[b] = sumSquaresScalar(data + b * binSize, binSize);
+    }
+}
+
+const DspKernelTable kScalarKernels = {
+    "scalar",
+    int16ToFloatScalar,
+    floatToInt16Scalar,
+    halfToFloatScalar,
+    sumSquaresScalar,
+    dotProductScalar,
+    applyGainScalar,
+    biquadCascadeScalar,
+    fftStageScalar,
+    resampleCubicScalar,
+    binEnergiesScalar,
+};
+
+// ---------------------------------------------------------------------------
+// NEON (armv7, arm64)
+// ---------------------------------------------------------------------------
+
+#if defined(__ARM_NEON)
+
+void int16ToFloatNeon(const int16_t* src, float* dst, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        int16x8_t s = vld1q_s16(src + i);
+        vst1q_f32(dst + i, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(s))), kInt16Scale));
+        vst1q_f32(dst + i + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(s))), kInt16Scale));
+    }
+    int16ToFloatScalar(src + i, dst + i, count - i);
+}
+
+// 클램핑 후 0에서 먼 쪽으로 반올림 (std::round와 동일)
+inline int32x4_t scaleToInt16RangeNeon(float32x4_t x) {
+    x = vmulq_n_f32(x, 32768.0f);
+    x = vmaxq_f32(vdupq_n_f32(-32768.0f), vminq_f32(vdupq_n_f32(32767.0f), x));
+#if defined(__aarch64__)
+    return vcvtaq_s32_f32(x);
+#else
+    // armv7에는 반올림 변환이 없으므로 버림 후 잔차가 0.5 이상이면 부호 방향으로 보정
+    int32x4_t truncated = vcvtq_s32_f32(x);
+    float32x4_t residual = vsubq_f32(x, vcvtq_f32_s32(truncated));
+    uint32x4_t needsAdjust = vcageq_f32(residual, vdupq_n_f32(0.5f));
+    uint32x4_t negative = vcltq_f32(x, vdupq_n_f32(0.0f));
+    int32x4_t step = vbslq_s32(negative, vdupq_n_s32(-1), vdupq_n_s32(1));
+    return vaddq_s32(truncated, vandq_s32(step, vreinterpretq_s32_u32(needsAdjust)));
+#endif
+}
+
+void floatToInt16Neon(const float* src, int16_t* dst, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        int32x4_t lo = scaleToInt16RangeNeon(vld1q_f32(src + i));
+        int32x4_t hi = scaleToInt16RangeNeon(vld1q_f32(src + i + 4));
+        vst1q_s16(dst + i, vcombine_s16(vqmovn_s32(lo), vqmovn_s32(hi)));
+    }
+    floatToInt16Scalar(src + i, dst + i, count - i);
+}
+
+void halfToFloatNeon(const uint16_t* src, float* dst, size_t count) {
+    size_t i = 0;
+#if defined(__aarch64__)
+    for (; i + 4 <= count; i += 4) {
+        vst1q_f32(dst + i, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(src + i))));
+    }
+#endif
+    halfToFloatScalar(src + i, dst + i, count - i);
+}
+
+float sumSquaresNeon(const float* data, size_t count) {
+    float32x4_t acc0 = vdupq_n_f32(0.0f);
+    float32x4_t acc1 = vdupq_n_f32(0.0f);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        float32x4_t a = vld1q_f32(data + i);
+        float32x4_t b = vld1q_f32(data + i + 4);
+        acc0 = vmlaq_f32(acc0, a, a);
+        acc1 = vmlaq_f32(acc1, b, b);
+    }
+    float32x4_t acc = vaddq_f32(acc0, acc1);
+    float32x2_t pair = vadd_f32(vget_low_f32(acc), vget_high_f32(acc));
+    float sum = vget_lane_f32(vpadd_f32(pair, pair), 0);
+    return sum + sumSquaresScalar(data + i, count - i);
+}
+
+float dotProductNeon(const float* a, const float* b, size_t count) {
+    float32x4_t acc0 = vdupq_n_f32(0.0f);
+    float32x4_t acc1 = vdupq_n_f32(0.0f);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        acc0 = vmlaq_f32(acc0, vld1q_f32(a + i), vld1q_f32(b + i));
+        acc1 = vmlaq_f32(acc1, vld1q_f32(a + i + 4), vld1q_f32(b + i + 4));
+    }
+    float32x4_t acc = vaddq_f32(acc0, acc1);
+    float32x2_t pair = vadd_f32(vget_low_f32(acc), vget_high_f32(acc));
+    float sum = vget_lane_f32(vpadd_f32(pair, pair), 0);
+    return sum + dotProductScalar(a + i, b + i, count - i);
+}
+
+void applyGainNeon(float* data, size_t count, float gain) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        vst1q_f32(data + i, vmulq_n_f32(vld1q_f32(data + i), gain));
+        vst1q_f32(data + i + 4, vmulq_n_f32(vld1q_f32(data + i + 4), gain));
+    }
+    applyGainScalar(data + i, count - i, gain);
+}
+
+// 스테레오는 좌우 채널을 두 레인으로 묶어 처리 (재귀 필터라 시간 방향으로는 벡터화할 수 없음)
+void biquadCascadeNeon(float* data, size_t frames, int channels, const BiquadCoefficients* coefficients,
+                       BiquadState* states, size_t sections, size_t stateStride) {
+    if (channels != 2 || sections > kMaxVectorBiquadSections) {
+        biquadCascadeScalar(data, frames, channels, coefficients, states, sections, stateStride);
+        return;
+    }
+
+    float32x2_t z1[kMaxVectorBiquadSections];
+    float32x2_t z2[kMaxVectorBiquadSections];
+    for (size_t s = 0; s < sections; s++) {
+        const BiquadState* state = states + s * stateStride;
+        z1[s] = vset_lane_f32(state[1].z1, vdup_n_f32(state[0].z1), 1);
+        z2[s] = vset_lane_f32(state[1].z2, vdup_n_f32(state[0].z2), 1);
+    }
+
+    for (size_t i = 0; i < frames; i++) {
+        float32x2_t x = vld1_f32(data + 2 * i);
+        for (size_t s = 0; s < sections; s++) {
+            const BiquadCoefficients& c = coefficients[s];
+            float32x2_t y = vadd_f32(vmul_n_f32(x, c.b0), z1[s]);
+            z1[s] = vadd_f32(vsub_f32(vmul_n_f32(x, c.b1), vmul_n_f32(y, c.a1)), z2[s]);
+            z2[s] = vsub_f32(vmul_n_f32(x, c.b2), vmul_n_f32(y, c.a2));
+            x = y;
+        }
+        vst1_f32(data + 2 * i, x);
+    }
+
+    for (size_t s = 0; s < sections; s++) {
+        BiquadState* state = states + s * stateStride;
+        state[0].z1 = vget_lane_f32(z1[s], 0);
+        state[1].z1 = vget_lane_f32(z1[s], 1);
+        state[0].z2 = vget_lane_f32(z2[s], 0);
+        state[1].z2 = vget_lane_f32(z2[s], 1);
+    }
+}
+
+void fftStageNeon(float* real, float* imag, size_t size, size_t half,
+                  const float* twiddleReal, const float* twiddleImag, float direction) {
+    // 앞쪽 두 단계는 블록이 벡터 폭보다 작음
+    if (half < 4) {
+        fftStageScalar(real, imag, size, half, twiddleReal, twiddleImag, direction);
+        return;
+    }
+    for (size_t start = 0; start < size; start += 2 * half) {
+        float* ar = real + start;
+        float* ai = imag + start;
+        float* br = ar + half;
+        float* bi = ai + half;
+        for (size_t k = 0; k < half; k += 4) {
+            float32x4_t wr = vld1q_f32(twiddleReal + k);
+            float32x4_t wi = vmulq_n_f32(vld1q_f32(twiddleImag + k), direction);
+            float32x4_t xr = vld1q_f32(br + k);
+            float32x4_t xi = vld1q_f32(bi + k);
+            float32x4_t tr = vsubq_f32(vmulq_f32(xr, wr), vmulq_f32(xi, wi));
+            float32x4_t ti = vaddq_f32(vmulq_f32(xr, wi), vmulq_f32(xi, wr));
+            float32x4_t yr = vld1q_f32(ar + k);
+            float32x4_t yi = vld1q_f32(ai + k);
+            vst1q_f32(br + k, vsubq_f32(yr, tr));
+            vst1q_f32(bi + k, vsubq_f32(yi, ti));
+            vst1q_f32(ar + k, vaddq_f32(yr, tr));
+            vst1q_f32(ai + k, vaddq_f32(yi, ti));
+        }
+    }
+}
+
+// 스테레오는 출력 두 프레임(4개 샘플)을 한 벡터로 보간
+void resampleCubicNeon(const float* buffer, int channels, float* output, int32_t outputFrames,
+                       double phase, double ratio) {
+    if (channels != 2) {
+        resampleCubicScalar(buffer, channels, output, outputFrames, phase, ratio);
+        return;
+    }
+    int32_t n = 0;
+    for (; n + 2 <= outputFrames; n += 2) {
+        float ta;
+        float tb;
+        const float* a = cubicTaps(buffer, channels, phase, ratio, n, ta);
+        const float* b = cubicTaps(buffer, channels, phase, ratio, n + 1, tb);
+        float32x4_t x0 = vcombine_f32(vld1_f32(a), vld1_f32(b));
+        float32x4_t x1 = vcombine_f32(vld1_f32(a + 2), vld1_f32(b + 2));
+        float32x4_t x2 = vcombine_f32(vld1_f32(a + 4), vld1_f32(b + 4));
+        float32x4_t x3 = vcombine_f32(vld1_f32(a + 6), vld1_f32(b + 6));
+        float32x4_t t = vcombine_f32(vdup_n_f32(ta), vdup_n_f32(tb));
+
+        float32x4_t c1 = vmulq_n_f32(vsubq_f32(x2, x0), 0.5f);
+        float32x4_t c2 = vsubq_f32(vaddq_f32(vsubq_f32(x0, vmulq_n_f32(x1, 2.5f)), vmulq_n_f32(x2, 2.0f)),
+                                   vmulq_n_f32(x3, 0.5f));
+        float32x4_t c3 = vaddq_f32(vmulq_n_f32(vsubq_f32(x3, x0), 0.5f), vmulq_n_f32(vsubq_f32(x1, x2), 1.5f));
+        float32x4_t y = vaddq_f32(vmulq_f32(vaddq_f32(vmulq_f32(vaddq_f32(vmulq_f32(c3, t), c2), t), c1), t), x1);
+        vst1q_f32(output + static_cast<size_t>(n) * 2, y);
+    }
+    for (; n < outputFrames; n++) {
+        float t;
+        const float* x = cubicTaps(buffer, channels, phase, ratio, n, t);
+        cubicFrame(x, channels, t, output + static_cast<size_t>(n) * 2);
+    }
+}
+
+void binEnergiesNeon(const float* data, size_t binSize, size_t bins, float* energies) {
+    for (size_t b = 0; b < bins; b++) {
+        energies[b] = sumSquaresNeon(data + b * binSize, binSize);
+    }
+}
+
+const DspKernelTable kNeonKernels = {
+    "neon",
+    int16ToFloatNeon,
+    floatToInt16Neon,
+    halfToFloatNeon,
+    sumSquaresNeon,
+    dotProductNeon,
+    applyGainNeon,
+    biquadCascadeNeon,
+    fftStageNeon,
+    resampleCubicNeon,
+    binEnergiesNeon,
+};
+
+#endif // __ARM_NEON
+
+// ---------------------------------------------------------------------------
+// SSE4.1 / AVX2 (x86, x86_64)
+// ---------------------------------------------------------------------------
+
+#if defined(PANCAKE_X86_KERNELS)
+
+TARGET_SSE41 void int16ToFloatSse41(const int16_t* src, float* dst, size_t count) {
+    const __m128 scale = _mm_set1_ps(kInt16Scale);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i lo = _mm_cvtepi16_epi32(s);
+        __m128i hi = _mm_cvtepi16_epi32(_mm_srli_si128(s, 8));
+        _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+        _mm_storeu_ps(dst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+    }
+    int16ToFloatScalar(src + i, dst + i, count - i);
+}
+
+// 클램핑 후 0에서 먼 쪽으로 반올림 (SSE 기본 반올림은 짝수 방향이므로 버림 후 보정)
+TARGET_SSE41 inline __m128i scaleToInt16RangeSse41(__m128 x) {
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    x = _mm_mul_ps(x, _mm_set1_ps(32768.0f));
+    x = _mm_max_ps(_mm_set1_ps(-32768.0f), _mm_min_ps(_mm_set1_ps(32767.0f), x));
+    __m128 truncated = _mm_round_ps(x, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+    __m128 residual = _mm_and_ps(_mm_sub_ps(x, truncated), absMask);
+    __m128 step = _mm_or_ps(_mm_set1_ps(1.0f), _mm_andnot_ps(absMask, x));
+    __m128 adjust = _mm_and_ps(_mm_cmpge_ps(residual, _mm_set1_ps(0.5f)), step);
+    return _mm_cvttps_epi32(_mm_add_ps(truncated, adjust));
+}
+
+TARGET_SSE41 void floatToInt16Sse41(const float* src, int16_t* dst, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i lo = scaleToInt16RangeSse41(_mm_loadu_ps(src + i));
+        __m128i hi = scaleToInt16RangeSse41(_mm_loadu_ps(src + i + 4));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packs_epi32(lo, hi));
+    }
+    floatToInt16Scalar(src + i, dst + i, count - i);
+}
+
+TARGET_SSE41 float sumSquaresSse41(const float* data, size_t count) {
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128 a = _mm_loadu_ps(data + i);
+        __m128 b = _mm_loadu_ps(data + i + 4);
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(a, a));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(b, b));
+    }
+    __m128 acc = _mm_add_ps(acc0, acc1);
+    acc = _mm_hadd_ps(acc, acc);
+    acc = _mm_hadd_ps(acc, acc);
+    return _mm_cvtss_f32(acc) + sumSquaresScalar(data + i, count - i);
+}
+
+TARGET_SSE41 float dotProductSse41(const float* a, const float* b, size_t count) {
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+    }
+    __m128 acc = _mm_add_ps(acc0, acc1);
+    acc = _mm_hadd_ps(acc, acc);
+    acc = _mm_hadd_ps(acc, acc);
+    return _mm_cvtss_f32(acc) + dotProductScalar(a + i, b + i, count - i);
+}
+
+TARGET_SSE41 void applyGainSse41(float* data, size_t count, float gain) {
+    const __m128 g = _mm_set1_ps(gain);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        _mm_storeu_ps(data + i, _mm_mul_ps(_mm_loadu_ps(data + i), g));
+        _mm_storeu_ps(data + i + 4, _mm_mul_ps(_mm_loadu_ps(data + i + 4), g));
+    }
+    applyGainScalar(data + i, count - i, gain);
+}
+
+// 스테레오 프레임 하나(float 2개)를 하위 두 레인으로 읽고 쓰기
+TARGET_SSE41 inline __m128 loadStereoSse41(const float* p) {
+    return _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(p));
+}
+
+TARGET_SSE41 inline __m128 loadStereoPairSse41(const float* a, const float* b) {
+    return _mm_loadh_pi(loadStereoSse41(a), reinterpret_cast<const __m64*>(b));
+}
+
+// 스테레오는 좌우 채널을 두 레인으로 묶어 처리 (재귀 필터라 시간 방향으로는 벡터화할 수 없음)
+TARGET_SSE41 void biquadCascadeSse41(float* data, size_t frames, int channels, const BiquadCoefficients* coefficients,
+                                     BiquadState* states, size_t sections, size_t stateStride) {
+    if (channels != 2 || sections > kMaxVectorBiquadSections) {
+        biquadCascadeScalar(data, frames, channels, coefficients, states, sections, stateStride);
+        return;
+    }
+
+    __m128 b0[kMaxVectorBiquadSections], b1[kMaxVectorBiquadSections], b2[kMaxVectorBiquadSections];
+    __m128 a1[kMaxVectorBiquadSections], a2[kMaxVectorBiquadSections];
+    __m128 z1[kMaxVectorBiquadSections], z2[kMaxVectorBiquadSections];
+    for (size_t s = 0; s < sections; s++) {
+        const BiquadCoefficients& c = coefficients[s];
+        const BiquadState* state = states + s * stateStride;
+        b0[s] = _mm_set1_ps(c.b0);
+        b1[s] = _mm_set1_ps(c.b1);
+        b2[s] = _mm_set1_ps(c.b2);
+        a1[s] = _mm_set1_ps(c.a1);
+        a2[s] = _mm_set1_ps(c.a2);
+        z1[s] = _mm_setr_ps(state[0].z1, state[1].z1, 0.0f, 0.0f);
+        z2[s] = _mm_setr_ps(state[0].z2, state[1].z2, 0.0f, 0.0f);
+    }
+
+    for (size_t i = 0; i < frames; i++) {
+        __m128 x = loadStereoSse41(data + 2 * i);
+        for (size_t s = 0; s < sections; s++) {
+            __m128 y = _mm_add_ps(_mm_mul_ps(b0[s], x), z1[s]);
+            z1[s] = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(b1[s], x), _mm_mul_ps(a1[s], y)), z2[s]);
+            z2[s] = _mm_sub_ps(_mm_mul_ps(b2[s], x), _mm_mul_ps(a2[s], y));
+            x = y;
+        }
+        _mm_storel_pi(reinterpret_cast<__m64*>(data + 2 * i), x);
+    }
+
+    for (size_t s = 0; s < sections; s++) {
+        alignas(16) float lanes1[4];
+        alignas(16) float lanes2[4];
+        _mm_store_ps(lanes1, z1[s]);
+        _mm_store_ps(lanes2, z2[s]);
+        BiquadState* state = states + s * stateStride;
+        state[0].z1 = lanes1[0];
+        state[1].z1 = lanes1[1];
+        state[0].z2 = lanes2[0];
+        state[1].z2 = lanes2[1];
+    }
+}
+
+TARGET_SSE41 void fftStageSse41(float* real, float* imag, size_t size, size_t half,
+                                const float* twiddleReal, const float* twiddleImag, float direction) {
+    // 앞쪽 두 단계는 블록이 벡터 폭보다 작음
+    if (half < 4) {
+        fftStageScalar(real, imag, size, half, twiddleReal, twiddleImag, direction);
+        return;
+    }
+    const __m128 sign = _mm_set1_ps(direction);
+    for (size_t start = 0; start < size; start += 2 * half) {
+        float* ar = real + start;
+        float* ai = imag + start;
+        float* br = ar + half;
+        float* bi = ai + half;
+        for (size_t k = 0; k < half; k += 4) {
+            __m128 wr = _mm_loadu_ps(twiddleReal + k);
+            __m128 wi = _mm_mul_ps(sign, _mm_loadu_ps(twiddleImag + k));
+            __m128 xr = _mm_loadu_ps(br + k);
+            __m128 xi = _mm_loadu_ps(bi + k);
+            __m128 tr = _mm_sub_ps(_mm_mul_ps(xr, wr), _mm_mul_ps(xi, wi));
+            __m128 ti = _mm_add_ps(_mm_mul_ps(xr, wi), _mm_mul_ps(xi, wr));
+            __m128 yr = _mm_loadu_ps(ar + k);
+            __m128 yi = _mm_loadu_ps(ai + k);
+            _mm_storeu_ps(br + k, _mm_sub_ps(yr, tr));
+            _mm_storeu_ps(bi + k, _mm_sub_ps(yi, ti));
+            _mm_storeu_ps(ar + k, _mm_add_ps(yr, tr));
+            _mm_storeu_ps(ai + k, _mm_add_ps(yi, ti));
+        }
+    }
+}
+
+// Catmull-Rom 다항식 (scalar와 같은 연산 순서)
+TARGET_SSE41 inline __m128 cubicSse41(__m128 x0, __m128 x1, __m128 x2, __m128 x3, __m128 t) {
+    const __m128 half = _mm_set1_ps(0.5f);
+    __m128 c1 = _mm_mul_ps(half, _mm_sub_ps(x2, x0));
+    __m128 c2 = _mm_sub_ps(_mm_add_ps(_mm_sub_ps(x0, _mm_mul_ps(_mm_set1_ps(2.5f), x1)),
+                                      _mm_mul_ps(_mm_set1_ps(2.0f), x2)),
+                           _mm_mul_ps(half, x3));
+    __m128 c3 = _mm_add_ps(_mm_mul_ps(half, _mm_sub_ps(x3, x0)), _mm_mul_ps(_mm_set1_ps(1.5f), _mm_sub_ps(x1, x2)));
+    return _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(c3, t), c2), t), c1), t), x1);
+}
+
+// 스테레오는 출력 두 프레임(4개 샘플)을 한 벡터로 보간
+TARGET_SSE41 void resampleCubicSse41(const float* buffer, int channels, float* output, int32_t outputFrames,
+                                     double phase, double ratio) {
+    if (channels != 2) {
+        resampleCubicScalar(buffer, channels, output, outputFrames, phase, ratio);
+        return;
+    }
+    int32_t n = 0;
+    for (; n + 2 <= outputFrames; n += 2) {
+        float ta;
+        float tb;
+        const float* a = cubicTaps(buffer, channels, phase, ratio, n, ta);
+        const float* b = cubicTaps(buffer, channels, phase, ratio, n + 1, tb);
+        __m128 y = cubicSse41(loadStereoPairSse41(a, b), loadStereoPairSse41(a + 2, b + 2),
+                              loadStereoPairSse41(a + 4, b + 4), loadStereoPairSse41(a + 6, b + 6),
+                              _mm_setr_ps(ta, ta, tb, tb));
+        _mm_storeu_ps(output + static_cast<size_t>(n) * 2, y);
+    }
+    for (; n < outputFrames; n++) {
+        float t;
+        const float* x = cubicTaps(buffer, channels, phase, ratio, n, t);
+        cubicFrame(x, channels, t, output + static_cast<size_t>(n) * 2);
+    }
+}
+
+TARGET_SSE41 void binEnergiesSse41(const float* data, size_t binSize, size_t bins, float* energies) {
+    for (size_t b = 0; b < bins; b++) {
+        energies[b] = sumSquaresSse41(data + b * binSize, binSize);
+    }
+}
+
+const DspKernelTable kSse41Kernels = {
+    "sse4.1",
+    int16ToFloatSse41,
+    floatToInt16Sse41,
+    halfToFloatScalar,  // F16C는 AVX 세대부터 제공
+    sumSquaresSse41,
+    dotProductSse41,
+    applyGainSse41,
+    biquadCascadeSse41,
+    fftStageSse41,
+    resampleCubicSse41,
+    binEnergiesSse41,
+};
+
+TARGET_AVX2 void int16ToFloatAvx2(const int16_t* src, float* dst, size_t count) {
+    const __m256 scale = _mm256_set1_ps(kInt16Scale);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 8));
+        _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(lo)), scale));
+        _mm256_storeu_ps(dst + i + 8, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(hi)), scale));
+    }
+    int16ToFloatScalar(src + i, dst + i, count - i);
+}
+
+TARGET_AVX2 inline __m256i scaleToInt16RangeAvx2(__m256 x) {
+    const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+    x = _mm256_mul_ps(x, _mm256_set1_ps(32768.0f));
+    x = _mm256_max_ps(_mm256_set1_ps(-32768.0f), _mm256_min_ps(_mm256_set1_ps(32767.0f), x));
+    __m256 truncated = _mm256_round_ps(x, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+    __m256 residual = _mm256_and_ps(_mm256_sub_ps(x, truncated), absMask);
+    __m256 step = _mm256_or_ps(_mm256_set1_ps(1.0f), _mm256_andnot_ps(absMask, x));
+    __m256 adjust = _mm256_and_ps(_mm256_cmp_ps(residual, _mm256_set1_ps(0.5f), _CMP_GE_OQ), step);
+    return _mm256_cvttps_epi32(_mm256_add_ps(truncated, adjust));
+}
+
+TARGET_AVX2 void floatToInt16Avx2(const float* src, int16_t* dst, size_t count) {
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m256i lo = scaleToInt16RangeAvx2(_mm256_loadu_ps(src + i));
+        __m256i hi = scaleToInt16RangeAvx2(_mm256_loadu_ps(src + i + 8));
+        // packs는 128비트 레인 단위로 동작하므로 64비트 블록 순서를 되돌림
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(lo, hi), 0xD8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), packed);
+    }
+    floatToInt16Scalar(src + i, dst + i, count - i);
+}
+
+TARGET_AVX2 void halfToFloatAvx2(const uint16_t* src, float* dst, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(h));
+    }
+    halfToFloatScalar(src + i, dst + i, count - i);
+}
+
+TARGET_AVX2 float sumSquaresAvx2(const float* data, size_t count) {
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m256 a = _mm256_loadu_ps(data + i);
+        __m256 b = _mm256_loadu_ps(data + i + 8);
+        acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(a, a));
+        acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(b, b));
+    }
+    __m256 acc = _mm256_add_ps(acc0, acc1);
+    __m128 half = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+    half = _mm_hadd_ps(half, half);
+    half = _mm_hadd_ps(half, half);
+    return _mm_cvtss_f32(half) + sumSquaresScalar(data + i, count - i);
+}
+
+TARGET_AVX2 float dotProductAvx2(const float* a, const float* b, size_t count) {
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+        acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8)));
+    }
+    __m256 acc = _mm256_add_ps(acc0, acc1);
+    __m128 half = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+    half = _mm_hadd_ps(half, half);
+    half = _mm_hadd_ps(half, half);
+    return _mm_cvtss_f32(half) + dotProductScalar(a + i, b + i, count - i);
+}
+
+TARGET_AVX2 void applyGainAvx2(float* data, size_t count, float gain) {
+    const __m256 g = _mm256_set1_ps(gain);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        _mm256_storeu_ps(data + i, _mm256_mul_ps(_mm256_loadu_ps(data + i), g));
+        _mm256_storeu_ps(data + i + 8, _mm256_mul_ps(_mm256_loadu_ps(data + i + 8), g));
+    }
+    applyGainScalar(data + i, count - i, gain);
+}
+
+TARGET_AVX2 void fftStageAvx2(float* real, float* imag, size_t size, size_t half,
+                              const float* twiddleReal, const float* twiddleImag, float direction) {
+    if (half < 8) {
+        fftStageSse41(real, imag, size, half, twiddleReal, twiddleImag, direction);
+        return;
+    }
+    const __m256 sign = _mm256_set1_ps(direction);
+    for (size_t start = 0; start < size; start += 2 * half) {
+        float* ar = real + start;
+        float* ai = imag + start;
+        float* br = ar + half;
+        float* bi = ai + half;
+        for (size_t k = 0; k < half; k += 8) {
+            __m256 wr = _mm256_loadu_ps(twiddleReal + k);
+            __m256 wi = _mm256_mul_ps(sign, _mm256_loadu_ps(twiddleImag + k));
+            __m256 xr = _mm256_loadu_ps(br + k);
+            __m256 xi = _mm256_loadu_ps(bi + k);
+            __m256 tr = _mm256_sub_ps(_mm256_mul_ps(xr, wr), _mm256_mul_ps(xi, wi));
+            __m256 ti = _mm256_add_ps(_mm256_mul_ps(xr, wi), _mm256_mul_ps(xi, wr));
+            __m256 yr = _mm256_loadu_ps(ar + k);
+            __m256 yi = _mm256_loadu_ps(ai + k);
+            _mm256_storeu_ps(br + k, _mm256_sub_ps(yr, tr));
+            _mm256_storeu_ps(bi + k, _mm256_sub_ps(yi, ti));
+            _mm256_storeu_ps(ar + k, _mm256_add_ps(yr, tr));
+            _mm256_storeu_ps(ai + k, _mm256_add_ps(yi, ti));
+        }
+    }
+}
+
+// 스테레오 프레임 네 개(a, b, c, d)의 같은 탭을 한 벡터로 읽음
+TARGET_AVX2 inline __m256 loadStereoQuadAvx2(const float* a, const float* b, const float* c, const float* d) {
+    return _mm256_insertf128_ps(_mm256_castps128_ps256(loadStereoPairSse41(a, b)), loadStereoPairSse41(c, d), 1);
+}
+
+// 스테레오는 출력 네 프레임(8개 샘플)을 한 벡터로 보간
+TARGET_AVX2 void resampleCubicAvx2(const float* buffer, int channels, float* output, int32_t outputFrames,
+                                   double phase, double ratio) {
+    if (channels != 2) {
+        resampleCubicScalar(buffer, channels, output, outputFrames, phase, ratio);
+        return;
+    }
+    const __m256 half = _mm256_set1_ps(0.5f);
+    int32_t n = 0;
+    for (; n + 4 <= outputFrames; n += 4) {
+        float t[4];
+        const float* x[4];
+        for (int j = 0; j < 4; j++) {
+            x[j] = cubicTaps(buffer, channels, phase, ratio, n + j, t[j]);
+        }
+        __m256 x0 = loadStereoQuadAvx2(x[0], x[1], x[2], x[3]);
+        __m256 x1 = loadStereoQuadAvx2(x[0] + 2, x[1] + 2, x[2] + 2, x[3] + 2);
+        __m256 x2 = loadStereoQuadAvx2(x[0] + 4, x[1] + 4, x[2] + 4, x[3] + 4);
+        __m256 x3 = loadStereoQuadAvx2(x[0] + 6, x[1] + 6, x[2] + 6, x[3] + 6);
+        __m256 tv = _mm256_setr_ps(t[0], t[0], t[1], t[1], t[2], t[2], t[3], t[3]);
+
+        __m256 c1 = _mm256_mul_ps(half, _mm256_sub_ps(x2, x0));
+        __m256 c2 = _mm256_sub_ps(_mm256_add_ps(_mm256_sub_ps(x0, _mm256_mul_ps(_mm256_set1_ps(2.5f), x1)),
+                                                _mm256_mul_ps(_mm256_set1_ps(2.0f), x2)),
+                                  _mm256_mul_ps(half, x3));
+        __m256 c3 = _mm256_add_ps(_mm256_mul_ps(half, _mm256_sub_ps(x3, x0)),
+                                  _mm256_mul_ps(_mm256_set1_ps(1.5f), _mm256_sub_ps(x1, x2)));
+        __m256 y = _mm256_add_ps(_mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(
+                       _mm256_add_ps(_mm256_mul_ps(c3, tv), c2), tv), c1), tv), x1);
+        _mm256_storeu_ps(output + static_cast<size_t>(n) * 2, y);
+    }
+    for (; n < outputFrames; n++) {
+        float t;
+        const float* x = cubicTaps(buffer, channels, phase, ratio, n, t);
+        cubicFrame(x, channels, t, output + static_cast<size_t>(n) * 2);
+    }
+}
+
+TARGET_AVX2 void binEnergiesAvx2(const float* data, size_t binSize, size_t bins, float* energies) {
+    for (size_t b = 0; b < bins; b++) {
+        energies[b] = sumSquaresAvx2(data + b * binSize, binSize);
+    }
+}
+
+const DspKernelTable kAvx2Kernels = {
+    "avx2",
+    int16ToFloatAvx2,
+    floatToInt16Avx2,
+    halfToFloatAvx2,
+    sumSquaresAvx2,
+    dotProductAvx2,
+    applyGainAvx2,
+    biquadCascadeSse41,  // 채널을 레인으로 쓰므로 스테레오에서는 256비트 폭이 도움되지 않음
+    fftStageAvx2,
+    resampleCubicAvx2,
+    binEnergiesAvx2,
+};
+
+#endif // PANCAKE_X86_KERNELS
+
+const DspKernelTable& selectKernels() {
+    const DspKernelTable* selected = DspKernels::available().back();
+    LOGI("DSP kernels selected: %s", selected->name);
+    return *selected;
+}
+
+} // namespace
+
+const DspKernelTable& DspKernels::active() {
+    static const DspKernelTable& kernels = selectKernels();
+    return kernels;
+}
+
+const DspKernelTable& DspKernels::scalar() {
+    return kScalarKernels;
+}
+
+std::vector<const DspKernelTable*> DspKernels::available() {
+    const CpuFeatures& features = CpuFeatures::get();
+    std::vector<const DspKernelTable*> tables = {&kScalarKernels};
+
+#if defined(__ARM_NEON)
+    if (features.neon) {
+        tables.push_back(&kNeonKernels);
+    }
+#endif
+
+#if defined(PANCAKE_X86_KERNELS)
+    if (features.sse41) {
+        tables.push_back(&kSse41Kernels);
+    }
+    if (features.avx2 && features.f16c) {
+        tables.push_back(&kAvx2Kernels);
+    }
+#endif
+
+    (void)features;
+    return tables;
+}
@@ -0,0 +1,84 @@
+#include "include/Fft.h"
+#include "include/DspKernels.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+Fft::Fft(int size) {
+    resize(size);
+}
+
+void Fft::resize(int size) {
+    if (size == mSize) {
+        return;
+    }
+    mSize = size;
+
+    int bits = 0;
+    while ((1 << bits) < size) {
+        bits++;
+    }
+
+    mBitReverse.resize(size);
+    for (int i = 0; i < size; i++) {
+        int reversed = 0;
+        for (int b = 0; b < bits; b++) {
+            reversed |= ((i >> b) & 1) << (bits - 1 - b);
+        }
+        mBitReverse[i] = reversed;
+    }
+
+    // 길이 length 단계의 k번째 트위들은 전체 크기 기준 k * (size / length)번째 회전
+    std::vector<float> cosTable(size / 2);
+    std::vector<float> sinTable(size / 2);
+    for (int i = 0; i < size / 2; i++) {
+        double angle = -2.0 * M_PI * i / size;
+        cosTable[i] = static_cast<float>(std::cos(angle));
+        sinTable[i] = static_cast<float>(std::sin(angle));
+    }
+    mTwiddleReal.assign(std::max(size - 1, 0), 0.0f);
+    mTwiddleImag.assign(std::max(size - 1, 0), 0.0f);
+    for (int half = 1; half < size; half <<= 1) {
+        int step = size / (2 * half);
+        for (int k = 0; k < half; k++) {
+            mTwiddleReal[half - 1 + k] = cosTable[k * step];
+            mTwiddleImag[half - 1 + k] = sinTable[k * step];
+        }
+    }
+}
+
+void Fft::forward(float* real, float* imag) const {
+    transform(real, imag, false);
+}
+
+void Fft::inverse(float* real, float* imag) const {
+    transform(real, imag, true);
+
+    const DspKernelTable& kernels = DspKernels::active();
+    float scale = 1.0f / mSize;
+    kernels.applyGain(real, mSize, scale);
+    kernels.applyGain(imag, mSize, scale);
+}
+
+void Fft::transform(float* real, float* imag, bool inverse) const {
+    for (int i = 0; i < mSize; i++) {
+        int j = mBitReverse[i];
+        if (j > i) {
+            std::swap(real[i], real[j]);
+            std::swap(imag[i], imag[j]);
+        }
+    }
+
+    // 역변환은 트위들의 허수부 부호만 반대
+    const float direction = inverse ? -1.0f : 1.0f;
+    const DspKernelTable& kernels = DspKernels::active();
+
+    for (int half = 1; half < mSize; half <<= 1) {
+        kernels.fftStage(real, imag, mSize, half,
+                         mTwiddleReal.data() + half - 1, mTwiddleImag.data() + half - 1, direction);
+    }
+}
@@ -10,6 +10,10 @@
 
 using namespace pancakemusicbox;
 
+// 라이브러리 변경 알림 대상 (감시 스레드의 FindClass는 앱 클래스를 찾지 못하므로 Java 스레드에서 미리 캐시)
+static jclass scannerNativeClass = nullptr;
+static jmethodID onLibraryChangedMethod = nullptr;
+
 // 정적 멤버 변수 초기화
 JavaVM* JNIBridge::javaVM = nullptr;
 jclass JNIBridge::trackClass = nullptr;
@@ -99,6 +103,15 @@ JNIEnv* JNIBridge::getEnv() {
             LOGE("Failed to attach thread to JavaVM");
             return nullptr;
         }
+        // 네이티브 스레드(라이브러리 감시 등)가 붙은 채로 끝나면 VM이 중단되므로 스레드 종료 시 분리
+        thread_local struct ThreadDetacher {
+            ~ThreadDetacher() {
+                if (javaVM != nullptr) {
+                    javaVM->DetachCurrentThread();
+                }
+            }
+        } detacher;
+        (void)detacher;
     } else if (result != JNI_OK) {
         LOGE("Failed to get JNI environment");
         return nullptr;
@@ -288,6 +301,34 @@ Java_com_example_pancakemusicbox_audio_AudioScannerNative_nativeScanDirectory(
     return result ? JNI_TRUE : JNI_FALSE;
 }
 
+// 디렉토리 스캔 작업자 스레드 수 설정
+JNIEXPORT void JNICALL
+Java_com_example_pancakemusicbox_audio_AudioScannerNative_nativeSetScanThreadCount(
+        JNIEnv* env, jobject thiz, jint threadCount) {
+
+    AudioScanner::getInstance().setScanThreadCount(threadCount);
+}
+
+// 디렉토리 스캔 작업자 스레드 수 가져오기
+JNIEXPORT jint JNICALL
+Java_com_example_pancakemusicbox_audio_AudioScannerNative_nativeGetScanThreadCount(
+        JNIEnv* env, jobject thiz) {
+
+    return AudioScanner::getInstance().getScanThreadCount();
+}
+
+// 앨범 아트 캐시 디렉토리 설정
+JNIEXPORT jboolean JNICALL
+Java_com_example_pancakemusicbox_audio_AudioScannerNative_nativeSetArtworkCacheDirectory(
+        JNIEnv* env, jobject thiz, jstring directoryPath) {
+
+    const char* path = env->GetStringUTFChars(directoryPath, 0);
+    bool result = AudioScanner::getInstance().setArtworkCacheDirectory(path);
+    env->ReleaseStringUTFChars(directoryPath, path);
+
+    return result ? JNI_TRUE : JNI_FALSE;
+}
+
 // 파일 스캔
 JNIEXPORT jboolean JNICALL
 Java_com_example_pancakemusicbox_audio_AudioScannerNative_nativeScanFile(
@@ -300,6 +341,80 @@ Java_com_example_pancakemusicbox_audio_AudioScannerNative_nativeScanFile(
     return result ? JNI_TRUE : JNI_FALSE;
 }
 
+// 라이브러리 감시 시작
+JNIEXPORT jboolean JNICALL
+Java_com_example_pancakemusicbox_audio_AudioScannerNative_nativeStartWatching(
+        JNIEnv* env, jobject thiz, jobjectArray directoryPaths) {
+
+    if (scannerNativeClass == nullptr) {
+        jclass localClass = env->GetObjectClass(thiz);
+        scannerNativeClass = (jclass)env->NewGlobalRef(localClass);
+        env->DeleteLocalRef(localClass);
+        onLibraryChangedMethod = env->GetStaticMethodID(scannerNativeClass, "onLibraryChanged",
+            "([Ljava/lang/String;[Ljava/lang/String;Z)V");
+    }
+    if (onLibraryChangedMethod == nullptr) {
+        LOGE("Failed to find onLibraryChanged method");
+        return JNI_FALSE;
+    }
+
+    std::vector<std::string> roots;
+    jsize count = env->GetArrayLength(directoryPaths);
+    for (jsize i = 0; i < count; i++) {
+        jstring path = (jstring)env->GetObjectArrayElement(directoryPaths, i);
+        roots.push_back(JNIBridge::toString(env, path));
+        env->DeleteLocalRef(path);
+    }
+
+    // 감시 스레드에서 변경 묶음 하나당 한 번 호출
+    auto callback = [](const LibraryWatcher::ChangeBatch& batch) {
+        JNIEnv* threadEnv = JNIBridge::getEnv();
+        jclass stringClass = threadEnv != nullptr ? threadEnv->FindClass("java/lang/String") : nullptr;
+        if (stringClass == nullptr) {
+            return;
+        }
+        auto toArray = [threadEnv, stringClass](const std::vector<std::string>& paths) {
+            jobjectArray array = threadEnv->NewObjectArray(static_cast<jsize>(paths.size()), stringClass, nullptr);
+            for (size_t i = 0; array != nullptr && i < paths.size(); i++) {
+                jstring path = JNIBridge::toJavaString(threadEnv, paths[i]);
+                threadEnv->SetObjectArrayElement(array, static_cast<jsize>(i), path);
+                threadEnv->DeleteLocalRef(path);
+            }
+            return array;
+        };
+        jobjectArray updated = toArray(batch.updatedPaths);
+        jobjectArray removed = toArray(batch.removedPaths);
+        threadEnv->CallStaticVoidMethod(scannerNativeClass, onLibraryChangedMethod, updated, removed,
+                                        batch.rescanned ? JNI_TRUE : JNI_FALSE);
+        if (threadEnv->ExceptionCheck()) {
+            threadEnv->ExceptionDescribe();
+            threadEnv->ExceptionClear();
+        }
+        threadEnv->DeleteLocalRef(updated);
+        threadEnv->DeleteLocalRef(removed);
+        threadEnv->DeleteLocalRef(stringClass);
+    };
+
+    bool result = AudioScanner::getInstance().startWatching(roots, callback);
+    return result ? JNI_TRUE : JNI_FALSE;
+}
+
+// 라이브러리 감시 중지
+JNIEXPORT void JNICALL
+Java_com_example_pancakemusicbox_audio_AudioScannerNative_nativeStopWatching(
+        JNIEnv* env, jobject thiz) {
+
+    AudioScanner::getInstance().stopWatching();
+}
+
+// 라이브러리 감시 상태 (0: 중지, 1: inotify, 2: 주기적 재스캔)
+JNIEXPORT jint JNICALL
+Java_com_example_pancakemusicbox_audio_AudioScannerNative_nativeGetWatchMode(
+        JNIEnv* env, jobject thiz) {
+
+    return static_cast<jint>(AudioScanner::getInstance().getWatchMode());
+}
+
 // 트랙 ID로 트랙 가져오기
 JNIEXPORT jobject JNICALL
 Java_com_example_pancakemusicbox_audio_AudioScannerNative_nativeGetTrackById(
@@ -332,6 +447,44 @@ Java_com_example_pancakemusicbox_audio_AudioScannerNative_nativeGetTracksByGenre
     return JNIBridge::toJavaGenreTrackMap(env, genreTracks);
 }
 
+// 앨범 아트 경로 가져오기 (중복 제외)
+JNIEXPORT jobjectArray JNICALL
+Java_com_example_pancakemusicbox_audio_AudioScannerNative_nativeGetAlbumArtPaths(
+        JNIEnv* env, jobject thiz) {
+
+    std::vector<std::string> paths = AudioScanner::getInstance().getAlbumArtPaths();
+    jclass stringClass = env->FindClass("java/lang/String");
+    if (stringClass == nullptr) {
+        return nullptr;
+    }
+    jobjectArray array = env->NewObjectArray(static_cast<jsize>(paths.size()), stringClass, nullptr);
+    for (size_t i = 0; array != nullptr && i < paths.size(); i++) {
+        jstring path = JNIBridge::toJavaString(env, paths[i]);
+        env->SetObjectArrayElement(array, static_cast<jsize>(i), path);
+        env->DeleteLocalRef(path);
+    }
+    env->DeleteLocalRef(stringClass);
+    return array;
+}
+
+// 패싯 조건으로 트랙 가져오기 (빈 문자열과 0은 조건 없음)
+JNIEXPORT jobject JNICALL
+Java_com_example_pancakemusicbox_audio_AudioScannerNative_nativeQueryTracks(
+        JNIEnv* env, jobject thiz, jstring genre, jstring artist, jstring albumTitle,
+        jint year, jstring format, jboolean highResolutionOnly) {
+
+    TrackFilter filter;
+    filter.genre = JNIBridge::toString(env, genre);
+    filter.artist = JNIBridge::toString(env, artist);
+    filter.albumTitle = JNIBridge::toString(env, albumTitle);
+    filter.year = year;
+    filter.format = JNIBridge::toString(env, format);
+    filter.highResolutionOnly = highResolutionOnly == JNI_TRUE;
+
+    std::vector<TrackMetadata> tracks = AudioScanner::getInstance().queryTracks(filter);
+    return JNIBridge::toJavaTrackList(env, tracks);
+}
+
 // 최근 재생 트랙 가져오기
 JNIEXPORT jobject JNICALL
 Java_com_example_pancakemusicbox_audio_AudioScannerNative_nativeGetRecentlyPlayedTracks(
@@ -0,0 +1,383 @@
+#include "include/LibraryWatcher.h"
+#include "include/AudioScanner.h"
+#include "include/ParallelScanner.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <android/log.h>
+
+#define LOG_TAG "LibraryWatcher"
+#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+namespace pancakemusicbox {
+
+namespace {
+
+// 파일은 쓰기가 끝났을 때(IN_CLOSE_WRITE)나 다른 곳에서 옮겨 왔을 때만 읽음 (IN_CREATE는 새 디렉토리 감지용)
+constexpr uint32_t kWatchMask = IN_CREATE | IN_CLOSE_WRITE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE |
+                                IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR | IN_DONT_FOLLOW;
+
+int toTimeoutMs(std::chrono::steady_clock::duration duration) {
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
+    return static_cast<int>(std::clamp<long long>(ms, 0, 24LL * 60 * 60 * 1000));
+}
+
+} // namespace
+
+constexpr std::chrono::milliseconds LibraryWatcher::kQuietPeriod;
+constexpr std::chrono::milliseconds LibraryWatcher::kMaxBatchDelay;
+constexpr std::chrono::milliseconds LibraryWatcher::kPollInterval;
+
+LibraryWatcher::LibraryWatcher(AudioScanner& scanner) : scanner(scanner) {
+}
+
+LibraryWatcher::~LibraryWatcher() {
+    stop();
+}
+
+bool LibraryWatcher::start(const std::vector<std::string>& rootPaths, ChangeCallback callback) {
+    stop();
+
+    roots.clear();
+    for (std::string root : rootPaths) {
+        while (root.size() > 1 && root.back() == '/') {
+            root.pop_back();
+        }
+        struct stat st;
+        if (root.empty() || stat(root.c_str(), &st) != 0 || !S_ISDIR(st.st_mode)) {
+            LOGE("Not a directory, not watching: %s", root.c_str());
+            continue;
+        }
+        if (std::find(roots.begin(), roots.end(), root) == roots.end()) {
+            roots.push_back(root);
+        }
+    }
+    if (roots.empty()) {
+        return false;
+    }
+    changeCallback = std::move(callback);
+
+    stopFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (stopFd < 0) {
+        LOGE("Cannot create eventfd: %s", strerror(errno));
+        return false;
+    }
+
+    inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd < 0) {
+        // 인스턴스 한도(max_user_instances) 등: 처음부터 폴링
+        LOGE("inotify unavailable (%s), falling back to periodic rescans", strerror(errno));
+        mode.store(Mode::Polling);
+    } else {
+        mode.store(Mode::Inotify);
+        for (const std::string& root : roots) {
+            if (!addWatchesRecursive(root)) {
+                degradeToPolling(false);
+                break;
+            }
+        }
+    }
+
+    fullRescanPending = false;
+    pending.clear();
+    thread = std::thread(&LibraryWatcher::threadLoop, this);
+    LOGI("Watching %zu roots (%s, %d watches)", roots.size(),
+         mode.load() == Mode::Inotify ? "inotify" : "polling", watchCount.load());
+    return true;
+}
+
+void LibraryWatcher::stop() {
+    if (thread.joinable()) {
+        uint64_t value = 1;
+        if (write(stopFd, &value, sizeof(value)) != sizeof(value)) {
+            LOGE("Cannot signal watcher thread: %s", strerror(errno));
+        }
+        thread.join();
+    }
+    if (inotifyFd >= 0) {
+        close(inotifyFd);
+        inotifyFd = -1;
+    }
+    if (stopFd >= 0) {
+        close(stopFd);
+        stopFd = -1;
+    }
+    directoriesByWatch.clear();
+    watchesByDirectory.clear();
+    pending.clear();
+    watchCount.store(0);
+    mode.store(Mode::Stopped);
+}
+
+void LibraryWatcher::threadLoop() {
+    auto nextPoll = std::chrono::steady_clock::now() + kPollInterval;
+
+    while (true) {
+        auto now = std::chrono::steady_clock::now();
+        bool polling = mode.load() == Mode::Polling;
+
+        // 대기 중인 변경이 있으면 적용 시점까지, 폴링 모드면 다음 재스캔까지, 아니면 이벤트가 올 때까지 대기
+        int timeoutMs = -1;
+        if (!pending.empty() || fullRescanPending) {
+            timeoutMs = toTimeoutMs(std::min(lastEventTime + kQuietPeriod, firstEventTime + kMaxBatchDelay) - now);
+        } else if (polling) {
+            timeoutMs = toTimeoutMs(nextPoll - now);
+        }
+
+        struct pollfd fds[2] = {
+            {stopFd, POLLIN, 0},
+            {inotifyFd, POLLIN, 0},
+        };
+        int result = poll(fds, polling ? 1 : 2, timeoutMs);
+        if (result < 0 && errno != EINTR) {
+            LOGE("poll failed: %s", strerror(errno));
+            break;
+        }
+        if (result > 0 && (fds[0].revents & POLLIN) != 0) {
+            break;
+        }
+        if (result > 0 && !polling && (fds[1].revents & POLLIN) != 0) {
+            readEvents();
+        }
+
+        now = std::chrono::steady_clock::now();
+        if (mode.load() == Mode::Polling && now >= nextPoll) {
+            fullRescanPending = true;
+            nextPoll = now + kPollInterval;
+            flush();
+        } else if ((!pending.empty() || fullRescanPending) &&
+                   (now >= lastEventTime + kQuietPeriod || now >= firstEventTime + kMaxBatchDelay)) {
+            flush();
+        }
+    }
+}
+
+bool LibraryWatcher::addWatchesRecursive(const std::string& directory) {
+    std::vector<std::string> stack{directory};
+    while (!stack.empty()) {
+        std::string current = std::move(stack.back());
+        stack.pop_back();
+
+        int wd = inotify_add_watch(inotifyFd, current.c_str(), kWatchMask);
+        if (wd < 0) {
+            if (errno == ENOSPC || errno == ENOMEM) {
+                LOGE("inotify watch limit reached at %s (%d watches)", current.c_str(), watchCount.load());
+                return false;
+            }
+            // 권한이 없거나 그 사이 사라진 디렉토리는 건너뜀
+            continue;
+        }
+        auto existing = directoriesByWatch.find(wd);
+        if (existing == directoriesByWatch.end()) {
+            watchCount++;
+        } else if (existing->second != current) {
+            watchesByDirectory.erase(existing->second);
+        }
+        directoriesByWatch[wd] = current;
+        watchesByDirectory[current] = wd;
+
+        DIR* dir = opendir(current.c_str());
+        if (dir == nullptr) {
+            continue;
+        }
+        while (struct dirent* entry = readdir(dir)) {
+            const char* name = entry->d_name;
+            if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))) {
+                continue;
+            }
+            bool isDirectory = entry->d_type == DT_DIR;
+            if (entry->d_type == DT_UNKNOWN) {
+                struct stat st;
+                isDirectory = fstatat(dirfd(dir), name, &st, AT_SYMLINK_NOFOLLOW) == 0 && S_ISDIR(st.st_mode);
+            }
+            if (isDirectory) {
+                stack.push_back(current + "/" + name);
+            }
+        }
+        closedir(dir);
+    }
+    return true;
+}
+
+void LibraryWatcher::removeWatchesUnder(const std::string& directory) {
+    std::string prefix = directory + "/";
+    for (auto it = watchesByDirectory.begin(); it != watchesByDirectory.end(); ) {
+        if (it->first != directory && it->first.compare(0, prefix.size(), prefix) != 0) {
+            ++it;
+            continue;
+        }
+        // 이미 삭제된 디렉토리는 커널이 감시를 해제했으므로 실패해도 무시
+        inotify_rm_watch(inotifyFd, it->second);
+        directoriesByWatch.erase(it->second);
+        it = watchesByDirectory.erase(it);
+        watchCount--;
+    }
+}
+
+void LibraryWatcher::degradeToPolling(bool rescanNow) {
+    if (inotifyFd >= 0) {
+        close(inotifyFd);   // 감시도 함께 해제됨
+        inotifyFd = -1;
+    }
+    directoriesByWatch.clear();
+    watchesByDirectory.clear();
+    watchCount.store(0);
+    mode.store(Mode::Polling);
+    LOGE("Falling back to incremental rescans every %lld s",
+         static_cast<long long>(std::chrono::duration_cast<std::chrono::seconds>(kPollInterval).count()));
+
+    if (rescanNow) {
+        auto now = std::chrono::steady_clock::now();
+        if (pending.empty() && !fullRescanPending) {
+            firstEventTime = now;
+        }
+        lastEventTime = now;
+        fullRescanPending = true;
+    }
+}
+
+void LibraryWatcher::readEvents() {
+    alignas(struct inotify_event) char buffer[16 * 1024];
+    while (inotifyFd >= 0) {
+        ssize_t length = read(inotifyFd, buffer, sizeof(buffer));
+        if (length < 0 && errno == EINTR) {
+            continue;
+        }
+        if (length <= 0) {
+            break;  // EAGAIN: 읽을 이벤트 없음
+        }
+
+        for (char* p = buffer; p < buffer + length; ) {
+            const auto* event = reinterpret_cast<const struct inotify_event*>(p);
+            p += sizeof(struct inotify_event) + event->len;
+
+            if ((event->mask & IN_Q_OVERFLOW) != 0) {
+                // 커널 이벤트 큐가 넘쳐 일부를 놓침: 루트 전체를 증분 재스캔
+                LOGE("inotify queue overflow, rescanning watched roots");
+                queue(std::string(), PendingAction::ScanDirectory);
+                continue;
+            }
+
+            auto watched = directoriesByWatch.find(event->wd);
+            if (watched == directoriesByWatch.end()) {
+                continue;
+            }
+            if ((event->mask & IN_IGNORED) != 0) {
+                watchesByDirectory.erase(watched->second);
+                directoriesByWatch.erase(watched);
+                watchCount--;
+                continue;
+            }
+            if ((event->mask & (IN_DELETE_SELF | IN_MOVE_SELF)) != 0) {
+                // 하위 디렉토리는 부모 디렉토리 이벤트로 처리되므로 루트 자체만 여기서 처리
+                if (std::find(roots.begin(), roots.end(), watched->second) != roots.end()) {
+                    queue(watched->second, PendingAction::Remove);
+                }
+                continue;
+            }
+            if (event->len == 0) {
+                continue;
+            }
+
+            std::string path = watched->second + "/" + event->name;
+            if ((event->mask & IN_ISDIR) != 0) {
+                if ((event->mask & (IN_CREATE | IN_MOVED_TO)) != 0) {
+                    // 감시를 먼저 건 다음 디렉토리를 스캔해야 그 사이 생긴 파일을 놓치지 않음
+                    if (!addWatchesRecursive(path)) {
+                        degradeToPolling(true);
+                        return;
+                    }
+                    queue(path, PendingAction::ScanDirectory);
+                } else if ((event->mask & (IN_DELETE | IN_MOVED_FROM)) != 0) {
+                    removeWatchesUnder(path);
+                    queue(path, PendingAction::Remove);
+                }
+            } else if (ParallelScanner::isSupportedAudioFile(event->name)) {
+                if ((event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) != 0) {
+                    queue(path, PendingAction::ScanFile);
+                } else if ((event->mask & (IN_DELETE | IN_MOVED_FROM)) != 0) {
+                    queue(path, PendingAction::Remove);
+                }
+            }
+        }
+    }
+}
+
+void LibraryWatcher::queue(const std::string& path, PendingAction action) {
+    auto now = std::chrono::steady_clock::now();
+    if (pending.empty() && !fullRescanPending) {
+        firstEventTime = now;
+    }
+    lastEventTime = now;
+
+    // 빈 경로: 전체 재스캔
+    if (path.empty()) {
+        fullRescanPending = true;
+        return;
+    }
+    pending[path] = action;
+}
+
+void LibraryWatcher::flush() {
+    uint64_t generation = scanner.getLibraryGeneration();
+    ChangeBatch batch;
+
+    if (fullRescanPending) {
+        // 루트 전체 증분 재스캔은 대기 중인 개별 변경도 모두 반영함
+        fullRescanPending = false;
+        pending.clear();
+        for (const std::string& root : roots) {
+            scanner.scanDirectory(root);
+        }
+        batch.rescanned = true;
+    } else {
+        // 삭제를 먼저 적용해 같은 묶음에서 다시 생긴 경로가 지워지지 않게 함
+        std::vector<std::pair<std::string, PendingAction>> actions(pending.begin(), pending.end());
+        pending.clear();
+        std::stable_partition(actions.begin(), actions.end(), [](const auto& action) {
+            return action.second == PendingAction::Remove;
+        });
+
+        for (const auto& action : actions) {
+            uint64_t before = scanner.getLibraryGeneration();
+            switch (action.second) {
+                case PendingAction::ScanFile:
+                    scanner.scanFile(action.first);
+                    break;
+                case PendingAction::ScanDirectory:
+                    scanner.scanDirectory(action.first);
+                    break;
+                case PendingAction::Remove:
+                    scanner.removePath(action.first);
+                    break;
+            }
+            if (scanner.getLibraryGeneration() == before) {
+                continue;   // 지문이 같거나 라이브러리에 없던 경로
+            }
+            if (action.second == PendingAction::Remove) {
+                batch.removedPaths.push_back(action.first);
+            } else {
+                batch.updatedPaths.push_back(action.first);
+            }
+        }
+    }
+
+    if (scanner.getLibraryGeneration() == generation) {
+        return;
+    }
+    LOGI("Library changed: %zu updated, %zu removed%s", batch.updatedPaths.size(), batch.removedPaths.size(),
+         batch.rescanned ? " (full rescan)" : "");
+    if (changeCallback) {
+        changeCallback(batch);
+    }
+}
+
+} // namespace pancakemusicbox
@@ -0,0 +1,78 @@
+#include "include/LoudnessCompensation.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+
+namespace {
+
+constexpr float kMinPhon = 20.0f;
+
+// 보상 쉘프 전환 주파수 및 최대 이득
+constexpr float kBassCornerHz = 200.0f;
+constexpr float kTrebleCornerHz = 6000.0f;
+constexpr float kMaxBassGainDb = 15.0f;
+constexpr float kMaxTrebleGainDb = 8.0f;
+
+// ISO 226:2003 표 1 중 보상에 사용하는 주파수의 매개변수
+struct ContourPoint {
+    float frequencyHz;
+    float af;  // 라우드니스 지각 지수
+    float lu;  // 1 kHz 정규화 전달 함수 크기 (dB)
+    float tf;  // 가청 한계 (dB)
+};
+
+constexpr ContourPoint kBassPoint = {63.0f, 0.409f, -13.0f, 37.5f};
+constexpr ContourPoint kReferencePoint = {1000.0f, 0.250f, 0.0f, 2.4f};
+constexpr ContourPoint kTreblePoint = {10000.0f, 0.271f, -10.7f, 13.9f};
+
+// phon 레벨의 순음이 해당 주파수에서 같은 크기로 들리는 데 필요한 음압 (dB SPL)
+double equalLoudnessSpl(const ContourPoint& point, double phon) {
+    double af = 4.47e-3 * (std::pow(10.0, 0.025 * phon) - 1.15) +
+                std::pow(0.4 * std::pow(10.0, (point.tf + point.lu) / 10.0 - 9.0), point.af);
+    return 10.0 / point.af * std::log10(af) - point.lu + 94.0;
+}
+
+// 1 kHz 대비 상대 음압
+double relativeSpl(const ContourPoint& point, double phon) {
+    return equalLoudnessSpl(point, phon) - equalLoudnessSpl(kReferencePoint, phon);
+}
+
+} // namespace
+
+void LoudnessCompensation::computeGains(float volume, float& bassGainDb, float& trebleGainDb) {
+    bassGainDb = 0.0f;
+    trebleGainDb = 0.0f;
+    if (volume <= 0.0f || volume >= 1.0f) {
+        return;
+    }
+
+    // 볼륨 감쇠만큼 청취 레벨이 내려간다고 보고, 낮은 레벨 곡선이 기준 곡선보다 더 요구하는 만큼 보상
+    double phon = std::max(static_cast<double>(kMinPhon), kReferencePhon + 20.0 * std::log10(volume));
+    double bass = relativeSpl(kBassPoint, phon) - relativeSpl(kBassPoint, kReferencePhon);
+    double treble = relativeSpl(kTreblePoint, phon) - relativeSpl(kTreblePoint, kReferencePhon);
+
+    bassGainDb = static_cast<float>(std::max(0.0, std::min(static_cast<double>(kMaxBassGainDb), bass)));
+    trebleGainDb = static_cast<float>(std::max(0.0, std::min(static_cast<double>(kMaxTrebleGainDb), treble)));
+}
+
+BiquadCoefficients LoudnessCompensation::computeCoefficients(float sampleRate, float volume) {
+    float bassGainDb;
+    float trebleGainDb;
+    computeGains(volume, bassGainDb, trebleGainDb);
+    if (bassGainDb == 0.0f && trebleGainDb == 0.0f) {
+        return BiquadCoefficients();
+    }
+    float trebleCornerHz = std::min(kTrebleCornerHz, sampleRate * 0.4f);
+    BiquadCoefficients c = BiquadCoefficients::dualShelf(sampleRate, kBassCornerHz, bassGainDb,
+                                                         trebleCornerHz, trebleGainDb);
+
+    // 두 쉘프의 완만한 기울기가 1 kHz에 남기는 이득을 제거하여 기준 주파수 레벨 유지
+    std::complex<double> z = std::polar(1.0, -2.0 * M_PI * kReferencePoint.frequencyHz / sampleRate);
+    std::complex<double> numerator = static_cast<double>(c.b0) + (static_cast<double>(c.b1) + static_cast<double>(c.b2) * z) * z;
+    std::complex<double> denominator = 1.0 + (static_cast<double>(c.a1) + static_cast<double>(c.a2) * z) * z;
+    float scale = static_cast<float>(std::abs(denominator) / std::abs(numerator));
+    c.b0 *= scale;
+    c.b1 *= scale;
+    c.b2 *= scale;
+    return c;
+}
@@ -0,0 +1,126 @@
+#include "include/MultibandCompressor.h"
+#include <algorithm>
+
+namespace {
+
+constexpr float kLowCrossoverHz = 200.0f;
+constexpr float kHighCrossoverHz = 2500.0f;
+constexpr float kButterworthQ = 0.70710678f;
+
+// 밴드별 설정 (저역, 중역, 고역): 야간 청취용으로 낮은 임계값과 중간 정도의 비율
+constexpr float kThresholdDb[MultibandCompressor::kBands] = {-26.0f, -24.0f, -24.0f};
+constexpr float kRatio[MultibandCompressor::kBands] = {4.0f, 3.0f, 3.0f};
+constexpr float kAttackMs[MultibandCompressor::kBands] = {10.0f, 5.0f, 2.0f};
+constexpr float kReleaseMs[MultibandCompressor::kBands] = {250.0f, 150.0f, 100.0f};
+
+float envelopeCoefficient(float milliseconds, int sampleRate) {
+    return 1.0f - std::exp(-1000.0f / (milliseconds * sampleRate));
+}
+
+// 레인별 계수로 4레인 biquad 구성
+Biquad4 makeBiquad4(const BiquadCoefficients& lane01, const BiquadCoefficients& lane23) {
+    Biquad4 biquad;
+    biquad.b0 = Float4(lane01.b0, lane01.b0, lane23.b0, lane23.b0);
+    biquad.b1 = Float4(lane01.b1, lane01.b1, lane23.b1, lane23.b1);
+    biquad.b2 = Float4(lane01.b2, lane01.b2, lane23.b2, lane23.b2);
+    biquad.a1 = Float4(lane01.a1, lane01.a1, lane23.a1, lane23.a1);
+    biquad.a2 = Float4(lane01.a2, lane01.a2, lane23.a2, lane23.a2);
+    return biquad;
+}
+
+} // namespace
+
+void MultibandCompressor::configure(int sampleRate, float makeupDb) {
+    // LR4 = 같은 Butterworth 2차 필터를 두 번 직렬 연결
+    BiquadCoefficients lowPass1 = BiquadCoefficients::lowPass(sampleRate, kLowCrossoverHz, kButterworthQ);
+    BiquadCoefficients highPass1 = BiquadCoefficients::highPass(sampleRate, kLowCrossoverHz, kButterworthQ);
+    BiquadCoefficients lowPass2 = BiquadCoefficients::lowPass(sampleRate, kHighCrossoverHz, kButterworthQ);
+    BiquadCoefficients highPass2 = BiquadCoefficients::highPass(sampleRate, kHighCrossoverHz, kButterworthQ);
+    BiquadCoefficients allPass2 = BiquadCoefficients::allPass(sampleRate, kHighCrossoverHz, kButterworthQ);
+
+    for (int stage = 0; stage < 2; stage++) {
+        mLowSplit[stage] = makeBiquad4(lowPass1, highPass1);
+        mHighSplit[stage] = makeBiquad4(lowPass2, highPass2);
+    }
+    mLowAllPass = makeBiquad4(allPass2, BiquadCoefficients());
+
+    mAttack = Float4(envelopeCoefficient(kAttackMs[0], sampleRate),
+                     envelopeCoefficient(kAttackMs[1], sampleRate),
+                     envelopeCoefficient(kAttackMs[2], sampleRate), 0.0f);
+    mRelease = Float4(envelopeCoefficient(kReleaseMs[0], sampleRate),
+                      envelopeCoefficient(kReleaseMs[1], sampleRate),
+                      envelopeCoefficient(kReleaseMs[2], sampleRate), 0.0f);
+
+    for (int band = 0; band < kBands; band++) {
+        mThresholdDb[band] = kThresholdDb[band];
+        mRatio[band] = kRatio[band];
+    }
+    mMakeup = std::pow(10.0f, makeupDb / 20.0f);
+
+    reset();
+}
+
+void MultibandCompressor::reset() {
+    for (int stage = 0; stage < 2; stage++) {
+        mLowSplit[stage].reset();
+        mHighSplit[stage].reset();
+    }
+    mLowAllPass.reset();
+
+    mEnvelope = Float4(0.0f);
+    mGain = Float4(1.0f);
+    mGainStep = Float4(0.0f);
+    mControlCounter = 0;
+
+    for (int band = 0; band < kBands; band++) {
+        mPeakReductionDb[band] = 0.0f;
+        mMeterReductionDb[band].store(0.0f, std::memory_order_relaxed);
+    }
+}
+
+void MultibandCompressor::updateGainTargets() {
+    float envelope[4];
+    float current[4];
+    mEnvelope.store(envelope);
+    mGain.store(current);
+
+    float target[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+    for (int band = 0; band < kBands; band++) {
+        // 소프트 니 게인 컴퓨터 (dB 영역)
+        float levelDb = 20.0f * std::log10(std::max(envelope[band], 1e-6f));
+        float over = levelDb - mThresholdDb[band];
+        float slope = 1.0f - 1.0f / mRatio[band];
+        float reductionDb;
+        if (over <= -mKneeDb * 0.5f) {
+            reductionDb = 0.0f;
+        } else if (over < mKneeDb * 0.5f) {
+            float x = over + mKneeDb * 0.5f;
+            reductionDb = slope * x * x / (2.0f * mKneeDb);
+        } else {
+            reductionDb = slope * over;
+        }
+
+        target[band] = std::pow(10.0f, -reductionDb / 20.0f);
+        mPeakReductionDb[band] = std::max(mPeakReductionDb[band], reductionDb);
+    }
+
+    // 다음 게인 계산까지 선형 보간
+    constexpr float kInterval = 1.0f / kControlInterval;
+    mGainStep = (Float4(target[0], target[1], target[2], target[3]) -
+                 Float4(current[0], current[1], current[2], current[3])) * Float4(kInterval);
+    mControlCounter = kControlInterval;
+}
+
+void MultibandCompressor::publishMeters() {
+    for (int band = 0; band < kBands; band++) {
+        mMeterReductionDb[band].store(mPeakReductionDb[band], std::memory_order_relaxed);
+        mPeakReductionDb[band] = 0.0f;
+    }
+}
+
+float MultibandCompressor::getGainReductionDb(int band) const {
+    if (band < 0 || band >= kBands) {
+        return 0.0f;
+    }
+    return mMeterReductionDb[band].load(std::memory_order_relaxed);
+}
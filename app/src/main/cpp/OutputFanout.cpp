@@ -0,0 +1,398 @@
+#include "include/OutputFanout.h"
+#include <android/log.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+#define LOG_TAG "OutputFanout"
+#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+namespace {
+
+// 버퍼 양 PI 제어기 (오차는 목표 대비 초 단위, 보정은 레이트 비율)
+// 시정수 약 5초의 임계 감쇠: Ki = Kp² / 4
+constexpr double kProportionalGain = 0.2;
+constexpr double kIntegralGain = 0.01;
+constexpr double kMaxCorrection = 0.002;         // ±2000ppm (피치 변화 약 3.5 cent 이하)
+constexpr double kFillSmoothingSeconds = 0.5;    // 블록 단위 버퍼 양 흔들림 평활화
+constexpr double kMinTargetSeconds = 0.04;
+constexpr int kResyncFactor = 3;                 // 목표의 3배를 넘으면 목표량까지 건너뜀
+
+void convertToFloat(const uint8_t* data, SampleFormat format, float* output, size_t count) {
+    switch (format) {
+        case SampleFormat::Int16:
+            SampleTraits<SampleFormat::Int16>::toFloat(data, output, count);
+            break;
+        case SampleFormat::Int24:
+            SampleTraits<SampleFormat::Int24>::toFloat(data, output, count);
+            break;
+        case SampleFormat::Float16:
+            SampleTraits<SampleFormat::Float16>::toFloat(data, output, count);
+            break;
+        default:
+            SampleTraits<SampleFormat::Float32>::toFloat(data, output, count);
+            break;
+    }
+}
+
+} // namespace
+
+int64_t FanoutOutput::nowNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+FanoutOutput::FanoutOutput(int32_t outputSampleRate, int32_t initialInputRate)
+    : mOutputSampleRate(outputSampleRate),
+      mRing(static_cast<size_t>(kRingFrames) * kChannels, 0.0f),
+      mProducerRate(initialInputRate),
+      mPendingRate(initialInputRate),
+      mInputRate(initialInputRate) {
+    mResampler.configure(kChannels, static_cast<int32_t>(kPullChunkFrames * kMaxNominalRatio * (1.0 + kMaxCorrection)) + 2);
+}
+
+void FanoutOutput::push(const float* input, int32_t numFrames, int32_t inputSampleRate, int64_t timeNanos) {
+    uint64_t writeIndex = mWriteIndex.load(std::memory_order_relaxed);
+
+    if (inputSampleRate != mProducerRate) {
+        // 이 위치부터의 샘플은 새 레이트 (소비자가 여기까지 읽은 뒤 비율 변경)
+        mProducerRate = inputSampleRate;
+        mPendingRateIndex.store(writeIndex, std::memory_order_relaxed);
+        mPendingRate.store(inputSampleRate, std::memory_order_release);
+    }
+    if (numFrames > mMaxPushFrames.load(std::memory_order_relaxed)) {
+        mMaxPushFrames.store(numFrames, std::memory_order_relaxed);
+    }
+
+    uint64_t readIndex = mReadIndex.load(std::memory_order_acquire);
+    int64_t freeFrames = kRingFrames - static_cast<int64_t>(writeIndex - readIndex);
+    if (numFrames > freeFrames) {
+        // 소비자가 멈춰 있거나 크게 느림: 블록 전체를 버려 재생 위치가 어긋나지 않게 함
+        mOverflows.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    size_t start = static_cast<size_t>(writeIndex & (kRingFrames - 1));
+    size_t first = std::min<size_t>(numFrames, kRingFrames - start);
+    memcpy(mRing.data() + start * kChannels, input, first * kChannels * sizeof(float));
+    memcpy(mRing.data(), input + first * kChannels, (numFrames - first) * kChannels * sizeof(float));
+    mLastPushFrames.store(numFrames, std::memory_order_relaxed);
+    mLastPushNanos.store(timeNanos, std::memory_order_relaxed);
+    mWriteIndex.store(writeIndex + numFrames, std::memory_order_release);
+}
+
+void FanoutOutput::pull(float* output, int32_t numFrames, int64_t timeNanos) {
+    while (numFrames > 0) {
+        int32_t chunk = std::min(numFrames, kPullChunkFrames);
+        pullChunk(output, chunk, timeNanos);
+        output += static_cast<size_t>(chunk) * kChannels;
+        numFrames -= chunk;
+        timeNanos += static_cast<int64_t>(chunk) * 1000000000LL / mOutputSampleRate;
+    }
+}
+
+void FanoutOutput::applyPendingRate(uint64_t readIndex) {
+    int32_t rate = mPendingRate.load(std::memory_order_acquire);
+    if (rate != mInputRate && readIndex >= mPendingRateIndex.load(std::memory_order_relaxed)) {
+        // 보정량(적분 항)은 장치 클럭 차이이므로 레이트가 바뀌어도 유지
+        mInputRate = rate;
+    }
+}
+
+int32_t FanoutOutput::getTargetFrames(int32_t pullFrames) const {
+    // 양쪽 블록 크기의 흔들림을 덮을 만큼 유지 (최소 40ms)
+    double nominalRatio = static_cast<double>(mInputRate) / mOutputSampleRate;
+    double blockFrames = mMaxPushFrames.load(std::memory_order_relaxed) + pullFrames * nominalRatio;
+    return static_cast<int32_t>(std::max(kMinTargetSeconds * mInputRate, 2.0 * blockFrames));
+}
+
+double FanoutOutput::estimateContinuousFill(int64_t fill, int64_t timeNanos) const {
+    // 생산자는 블록 단위로 한꺼번에 쓰므로 버퍼 양이 톱니 모양으로 흔들림
+    // 마지막 블록 중 아직 재생 시점이 오지 않은 부분을 빼서 연속적으로 공급한 것처럼 추정
+    int32_t block = mLastPushFrames.load(std::memory_order_relaxed);
+    double elapsed = (timeNanos - mLastPushNanos.load(std::memory_order_relaxed)) * 1e-9;
+    double due = std::max(0.0, std::min<double>(block, elapsed * mInputRate));
+    return static_cast<double>(fill) - block + due;
+}
+
+void FanoutOutput::pullChunk(float* output, int32_t numFrames, int64_t timeNanos) {
+    uint64_t readIndex = mReadIndex.load(std::memory_order_relaxed);
+    applyPendingRate(readIndex);
+
+    uint64_t writeIndex = mWriteIndex.load(std::memory_order_acquire);
+    int64_t fill = static_cast<int64_t>(writeIndex - readIndex);
+    int32_t target = getTargetFrames(numFrames);
+    const size_t outputSamples = static_cast<size_t>(numFrames) * kChannels;
+
+    // 시작 또는 언더런 직후에는 목표량이 찰 때까지 무음으로 기다림
+    if (!mPrimed) {
+        if (fill < target) {
+            memset(output, 0, outputSamples * sizeof(float));
+            mFillMs.store(static_cast<float>(fill * 1000.0 / mInputRate), std::memory_order_relaxed);
+            return;
+        }
+        mPrimed = true;
+        mFillAverage = estimateContinuousFill(fill, timeNanos);
+    }
+
+    // 소비자가 멈췄다 돌아온 경우 등 크게 밀린 입력은 PI로 따라잡지 않고 건너뜀
+    if (fill > static_cast<int64_t>(target) * kResyncFactor) {
+        readIndex += fill - target;
+        fill = target;
+        mFillAverage = estimateContinuousFill(fill, timeNanos);
+        mResyncs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // PI 제어: 평활화한 버퍼 양이 목표보다 많으면 조금 빨리, 적으면 조금 느리게 소비
+    double dt = static_cast<double>(numFrames) / mOutputSampleRate;
+    double alpha = std::min(1.0, dt / kFillSmoothingSeconds);
+    mFillAverage += alpha * (estimateContinuousFill(fill, timeNanos) - mFillAverage);
+    double error = (mFillAverage - target) / mInputRate;
+    mIntegral = std::max(-kMaxCorrection / kIntegralGain,
+                         std::min(kMaxCorrection / kIntegralGain, mIntegral + error * dt));
+    double correction = std::max(-kMaxCorrection, std::min(kMaxCorrection,
+                                 kProportionalGain * error + kIntegralGain * mIntegral));
+    double nominalRatio = std::min(kMaxNominalRatio, static_cast<double>(mInputRate) / mOutputSampleRate);
+    double ratio = nominalRatio * (1.0 + correction);
+    mResampler.setNominalRatio(nominalRatio);
+
+    int32_t needed = mResampler.getInputFramesNeeded(numFrames, ratio);
+    if (needed > fill) {
+        // 생산자가 멈춤 (주 출력 정지 등): 무음을 내고 다시 목표량을 채운 뒤 재개
+        memset(output, 0, outputSamples * sizeof(float));
+        mReadIndex.store(readIndex, std::memory_order_release);
+        mPrimed = false;
+        mUnderruns.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    float* input = mResampler.getInputBuffer();
+    size_t start = static_cast<size_t>(readIndex & (kRingFrames - 1));
+    size_t first = std::min<size_t>(needed, kRingFrames - start);
+    memcpy(input, mRing.data() + start * kChannels, first * kChannels * sizeof(float));
+    memcpy(input + first * kChannels, mRing.data(), (needed - first) * kChannels * sizeof(float));
+    mReadIndex.store(readIndex + needed, std::memory_order_release);
+
+    mResampler.process(needed, output, numFrames, ratio);
+
+    mFillMs.store(static_cast<float>(mFillAverage * 1000.0 / mInputRate), std::memory_order_relaxed);
+    mTargetMs.store(static_cast<float>(target * 1000.0 / mInputRate), std::memory_order_relaxed);
+    mCorrectionPpm.store(static_cast<float>(correction * 1e6), std::memory_order_relaxed);
+}
+
+void FanoutOutput::fillStats(FanoutOutputStats& stats) const {
+    stats.sampleRate = mOutputSampleRate;
+    stats.fillMs = mFillMs.load(std::memory_order_relaxed);
+    stats.targetMs = mTargetMs.load(std::memory_order_relaxed);
+    stats.correctionPpm = mCorrectionPpm.load(std::memory_order_relaxed);
+    stats.underruns = mUnderruns.load(std::memory_order_relaxed);
+    stats.overflows = mOverflows.load(std::memory_order_relaxed);
+    stats.resyncs = mResyncs.load(std::memory_order_relaxed);
+}
+
+OboeFanoutSink::~OboeFanoutSink() {
+    close();
+}
+
+bool OboeFanoutSink::open(int32_t deviceId, int32_t inputSampleRate) {
+    oboe::AudioStreamBuilder builder;
+
+    // 장치 고유 레이트로 열고 레이트 변환은 팬아웃 리샘플러가 클럭 보정과 함께 처리
+    builder.setDirection(oboe::Direction::Output)
+           ->setPerformanceMode(oboe::PerformanceMode::LowLatency)
+           ->setSharingMode(oboe::SharingMode::Shared)
+           ->setFormat(oboe::AudioFormat::Float)
+           ->setChannelCount(2)
+           ->setCallback(this);
+    if (deviceId > 0) {
+        builder.setDeviceId(deviceId);
+    }
+
+    oboe::Result result = builder.openStream(mStream);
+    if (result != oboe::Result::OK) {
+        LOGE("Failed to open fan-out stream on device %d: %s", deviceId, oboe::convertToText(result));
+        mStream.reset();
+        return false;
+    }
+
+    // 콜백이 출력을 쓰므로 시작 전에 생성
+    mOutput.reset(new FanoutOutput(mStream->getSampleRate(), inputSampleRate));
+    result = mStream->requestStart();
+    if (result != oboe::Result::OK) {
+        LOGE("Failed to start fan-out stream: %s", oboe::convertToText(result));
+        close();
+        return false;
+    }
+
+    LOGI("Fan-out output opened on device %d (%d Hz)", deviceId, mStream->getSampleRate());
+    return true;
+}
+
+void OboeFanoutSink::close() {
+    if (mStream) {
+        mStream->requestStop();
+        mStream->close();
+        mStream.reset();
+    }
+}
+
+oboe::DataCallbackResult OboeFanoutSink::onAudioReady(
+    oboe::AudioStream *oboeStream,
+    void *audioData,
+    int32_t numFrames) {
+    mOutput->pull(static_cast<float *>(audioData), numFrames, FanoutOutput::nowNanos());
+    return oboe::DataCallbackResult::Continue;
+}
+
+NullFanoutSink::~NullFanoutSink() {
+    stop();
+}
+
+void NullFanoutSink::start(int32_t sampleRate, double clockPpm, int32_t inputSampleRate) {
+    mOutput.reset(new FanoutOutput(sampleRate, inputSampleRate));
+    mStop.store(false);
+    mThread = std::thread(&NullFanoutSink::run, this, sampleRate * (1.0 + clockPpm * 1e-6));
+    LOGI("Null fan-out sink started (%d Hz, %+.1f ppm)", sampleRate, clockPpm);
+}
+
+void NullFanoutSink::stop() {
+    mStop.store(true);
+    if (mThread.joinable()) {
+        mThread.join();
+    }
+}
+
+void NullFanoutSink::run(double framesPerSecond) {
+    std::vector<float> buffer(static_cast<size_t>(kBlockFrames) * 2);
+
+    // 누적 기준 시각으로 깨어나 sleep 오차가 쌓이지 않도록 함 (장치 클럭 모사)
+    auto start = std::chrono::steady_clock::now();
+    int64_t blocks = 0;
+    while (!mStop.load()) {
+        mOutput->pull(buffer.data(), kBlockFrames, FanoutOutput::nowNanos());
+        mFramesConsumed.fetch_add(kBlockFrames);
+        blocks++;
+        std::this_thread::sleep_until(start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(blocks * kBlockFrames / framesPerSecond)));
+    }
+}
+
+OutputFanout::OutputFanout()
+    : mConvertBuffer(static_cast<size_t>(kConvertFrames) * 2) {
+}
+
+OutputFanout::~OutputFanout() {
+    removeAll();
+}
+
+int OutputFanout::addDeviceOutput(std::unique_ptr<OboeFanoutSink> sink) {
+    if (!sink || !sink->getOutput()) {
+        return -1;
+    }
+
+    Output output;
+    output.id = mNextId++;
+    output.output = sink->getOutput();
+    output.device = std::move(sink);
+    mOutputs.push_back(std::move(output));
+    return mOutputs.back().id;
+}
+
+int OutputFanout::addNullOutput(int32_t sampleRate, double clockPpm, int32_t inputSampleRate) {
+    std::unique_ptr<NullFanoutSink> sink(new NullFanoutSink());
+    sink->start(sampleRate, clockPpm, inputSampleRate);
+
+    Output output;
+    output.id = mNextId++;
+    output.output = sink->getOutput();
+    output.null = std::move(sink);
+    mOutputs.push_back(std::move(output));
+    return mOutputs.back().id;
+}
+
+bool OutputFanout::removeOutput(int id) {
+    auto it = std::find_if(mOutputs.begin(), mOutputs.end(), [id](const Output& output) {
+        return output.id == id;
+    });
+    if (it == mOutputs.end()) {
+        return false;
+    }
+
+    // 소비자 스레드를 멈춘 뒤 해제
+    if (it->device) {
+        it->device->close();
+    }
+    if (it->null) {
+        it->null->stop();
+    }
+    mOutputs.erase(it);
+    LOGI("Fan-out output %d removed", id);
+    return true;
+}
+
+void OutputFanout::removeAll() {
+    while (!mOutputs.empty()) {
+        removeOutput(mOutputs.back().id);
+    }
+}
+
+void OutputFanout::push(const uint8_t* data, SampleFormat format, int channelCount,
+                        int32_t numFrames, int32_t sampleRate) {
+    if (channelCount <= 0) {
+        return;
+    }
+    const size_t frameBytes = static_cast<size_t>(channelCount) * getBytesPerSample(format);
+    const int64_t timeNanos = FanoutOutput::nowNanos();
+    // 변환 버퍼는 스테레오 kConvertFrames 크기이므로 3채널 이상이면 한 번에 변환하는 프레임을 줄임
+    const int32_t maxChunk = channelCount > 2 ? kConvertFrames * 2 / channelCount : kConvertFrames;
+
+    while (numFrames > 0) {
+        int32_t chunk = std::min(numFrames, maxChunk);
+        float* buffer = mConvertBuffer.data();
+        convertToFloat(data, format, buffer, static_cast<size_t>(chunk) * channelCount);
+
+        if (channelCount == 1) {
+            // 뒤에서부터 제자리 복제 (모노 → 스테레오)
+            for (int32_t i = chunk - 1; i >= 0; i--) {
+                buffer[2 * i] = buffer[i];
+                buffer[2 * i + 1] = buffer[i];
+            }
+        } else if (channelCount > 2) {
+            // 앞에서부터 제자리 다운믹스: 앞 두 채널은 좌우, 나머지는 -3dB로 양쪽에 더하고 클리핑하지 않게 이득 조정
+            const float gain = 1.0f / (1.0f + kSurroundGain * (channelCount - 2));
+            for (int32_t i = 0; i < chunk; i++) {
+                const float* frame = buffer + static_cast<size_t>(i) * channelCount;
+                float rest = 0.0f;
+                for (int c = 2; c < channelCount; c++) {
+                    rest += frame[c];
+                }
+                rest *= kSurroundGain;
+                float left = (frame[0] + rest) * gain;
+                float right = (frame[1] + rest) * gain;
+                buffer[2 * i] = left;
+                buffer[2 * i + 1] = right;
+            }
+        }
+
+        for (Output& output : mOutputs) {
+            output.output->push(buffer, chunk, sampleRate, timeNanos);
+        }
+        data += frameBytes * chunk;
+        numFrames -= chunk;
+    }
+}
+
+std::vector<FanoutOutputStats> OutputFanout::getStats() const {
+    std::vector<FanoutOutputStats> stats;
+    stats.reserve(mOutputs.size());
+    for (const Output& output : mOutputs) {
+        FanoutOutputStats item{};
+        item.id = output.id;
+        item.nullSink = output.null != nullptr;
+        output.output->fillStats(item);
+        stats.push_back(item);
+    }
+    return stats;
+}
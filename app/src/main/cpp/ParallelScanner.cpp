@@ -0,0 +1,310 @@
+#include "include/ParallelScanner.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <android/log.h>
+
+#define LOG_TAG "ParallelScanner"
+#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+namespace pancakemusicbox {
+
+namespace {
+
+// 지원하는 오디오 파일 확장자 (소문자)
+const char* const kSupportedExtensions[] = {
+    "flac", "wav", "mp3", "aac", "ogg", "m4a", "dsf", "dff", "mqa"
+};
+
+// 진행률 보고 주기
+constexpr auto kProgressInterval = std::chrono::milliseconds(100);
+// 일이 없는 작업자가 다시 훔치기를 시도하기까지 기다리는 최대 시간
+constexpr auto kIdleWait = std::chrono::milliseconds(2);
+
+} // namespace
+
+ParallelScanner::ParallelScanner(int threadCount)
+    : threadCount(threadCount > 0 ? threadCount : getDefaultThreadCount()) {
+}
+
+int ParallelScanner::getDefaultThreadCount() {
+    // 스캔은 대부분 I/O 대기라 코어 수만큼 쓰되, 저장 장치 큐가 포화되는 8개에서 제한
+    int cores = static_cast<int>(std::thread::hardware_concurrency());
+    return std::clamp(cores, 1, 8);
+}
+
+bool ParallelScanner::isSupportedAudioFile(const char* fileName) {
+    const char* dot = strrchr(fileName, '.');
+    if (dot == nullptr || dot[1] == '\0') {
+        return false;
+    }
+
+    char extension[8];
+    size_t length = strlen(dot + 1);
+    if (length >= sizeof(extension)) {
+        return false;
+    }
+    for (size_t i = 0; i <= length; i++) {
+        char c = dot[1 + i];
+        extension[i] = (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+
+    for (const char* supported : kSupportedExtensions) {
+        if (strcmp(extension, supported) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+FileFingerprint ParallelScanner::makeFingerprint(const struct stat& fileStat) {
+    FileFingerprint fingerprint;
+    fingerprint.size = static_cast<long long>(fileStat.st_size);
+    fingerprint.modifiedTimeNs = static_cast<long long>(fileStat.st_mtim.tv_sec) * 1000000000LL
+                               + fileStat.st_mtim.tv_nsec;
+    fingerprint.inode = static_cast<unsigned long long>(fileStat.st_ino);
+    return fingerprint;
+}
+
+std::vector<std::vector<TrackMetadata>> ParallelScanner::scan(const std::string& rootPath,
+                                                              const FileHandler& handler,
+                                                              const ProgressCallback& progressCallback) {
+    fileHandler = &handler;
+    filesFound.store(0);
+    filesProcessed.store(0);
+    filesFailed.store(0);
+    filesUnchanged.store(0);
+    directoriesScanned.store(0);
+    steals.store(0);
+    unreadablePaths.clear();
+    workers.clear();
+    for (int i = 0; i < threadCount; i++) {
+        workers.push_back(std::make_unique<Worker>());
+    }
+
+    // 루트 디렉토리를 첫 작업자에게 주면 나머지 작업자는 훔치면서 퍼져 나감
+    pendingTasks.store(1);
+    workers[0]->tasks.push_back(Task{rootPath, {}});
+
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount);
+    for (int i = 0; i < threadCount; i++) {
+        threads.emplace_back(&ParallelScanner::workerLoop, this, i);
+    }
+
+    // 호출 스레드는 완료를 기다리며 진행률만 보고
+    {
+        std::unique_lock<std::mutex> lock(idleMutex);
+        while (pendingTasks.load() > 0) {
+            doneCondition.wait_for(lock, kProgressInterval);
+            if (progressCallback && pendingTasks.load() > 0) {
+                lock.unlock();
+                progressCallback(filesProcessed.load(), filesFound.load());
+                lock.lock();
+            }
+        }
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    if (progressCallback) {
+        progressCallback(filesProcessed.load(), filesFound.load());
+    }
+
+    std::vector<std::vector<TrackMetadata>> results;
+    results.reserve(workers.size());
+    for (auto& worker : workers) {
+        results.push_back(std::move(worker->results));
+        unreadablePaths.insert(unreadablePaths.end(), std::make_move_iterator(worker->unreadablePaths.begin()),
+                               std::make_move_iterator(worker->unreadablePaths.end()));
+    }
+    if (!unreadablePaths.empty()) {
+        LOGI("%zu paths could not be read under %s", unreadablePaths.size(), rootPath.c_str());
+    }
+    workers.clear();
+    fileHandler = nullptr;
+    return results;
+}
+
+void ParallelScanner::workerLoop(int index) {
+    Task task;
+    while (pendingTasks.load(std::memory_order_acquire) > 0) {
+        if (popLocal(index, task) || steal(index, task)) {
+            if (task.files.empty()) {
+                scanOneDirectory(index, task.directory);
+            } else {
+                extractFiles(index, task.files);
+            }
+
+            // 마지막 작업을 끝낸 작업자가 모두를 깨워 종료
+            if (pendingTasks.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                std::lock_guard<std::mutex> lock(idleMutex);
+                idleCondition.notify_all();
+                doneCondition.notify_all();
+            }
+            continue;
+        }
+
+        // 훔칠 작업이 없으면 다른 작업자가 하위 디렉토리를 내놓을 때까지 대기
+        std::unique_lock<std::mutex> lock(idleMutex);
+        if (pendingTasks.load() == 0) {
+            break;
+        }
+        idleWorkers++;
+        idleCondition.wait_for(lock, kIdleWait);
+        idleWorkers--;
+    }
+}
+
+bool ParallelScanner::popLocal(int index, Task& task) {
+    // 자기 덱은 뒤에서 꺼냄 (방금 넣은 작업, 캐시에 남아 있는 경로)
+    Worker& worker = *workers[index];
+    std::lock_guard<std::mutex> lock(worker.lock);
+    if (worker.tasks.empty()) {
+        return false;
+    }
+    task = std::move(worker.tasks.back());
+    worker.tasks.pop_back();
+    return true;
+}
+
+bool ParallelScanner::steal(int index, Task& task) {
+    // 다른 작업자 덱은 앞에서 훔침 (트리 위쪽에 가까운, 남은 일이 많은 디렉토리)
+    for (int offset = 1; offset < threadCount; offset++) {
+        Worker& victim = *workers[(index + offset) % threadCount];
+        std::lock_guard<std::mutex> lock(victim.lock);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            steals++;
+            return true;
+        }
+    }
+    return false;
+}
+
+void ParallelScanner::pushTask(int index, Task task) {
+    pendingTasks.fetch_add(1, std::memory_order_acq_rel);
+    {
+        Worker& worker = *workers[index];
+        std::lock_guard<std::mutex> lock(worker.lock);
+        worker.tasks.push_back(std::move(task));
+    }
+    if (idleWorkers.load() > 0) {
+        std::lock_guard<std::mutex> lock(idleMutex);
+        idleCondition.notify_one();
+    }
+}
+
+void ParallelScanner::scanOneDirectory(int index, const std::string& directory) {
+    Worker& worker = *workers[index];
+    std::string prefix = directory;
+    if (prefix.empty() || prefix.back() != '/') {
+        prefix.push_back('/');
+    }
+
+    DIR* dir = opendir(directory.c_str());
+    if (dir == nullptr) {
+        // 권한이 없거나 잠시 접근할 수 없는 디렉토리는 건너뛰되, 그 아래 파일이 삭제된 것은 아니므로 기록
+        if (errno != EACCES) {
+            LOGE("Cannot open directory %s: %s", directory.c_str(), strerror(errno));
+        }
+        worker.unreadablePaths.push_back(prefix.size() > 1 ? prefix.substr(0, prefix.size() - 1) : prefix);
+        return;
+    }
+
+    std::vector<FileEntry> audioFiles;
+    int readError = 0;
+    while (true) {
+        // readdir는 목록 끝과 오류를 모두 nullptr로 알리므로 errno로 구분
+        errno = 0;
+        struct dirent* entry = readdir(dir);
+        if (entry == nullptr) {
+            readError = errno;
+            break;
+        }
+        const char* name = entry->d_name;
+        if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))) {
+            continue;
+        }
+
+        // 대부분의 파일시스템은 d_type을 채워 주므로 항목마다 stat할 필요가 없음
+        bool isDirectory = entry->d_type == DT_DIR;
+        bool isFile = entry->d_type == DT_REG;
+        bool statDone = false;
+        struct stat st;
+        if (entry->d_type == DT_UNKNOWN || entry->d_type == DT_LNK) {
+            int flags = entry->d_type == DT_LNK ? 0 : AT_SYMLINK_NOFOLLOW;
+            if (fstatat(dirfd(dir), name, &st, flags) != 0) {
+                // 종류를 모르는 항목은 디렉토리일 수도 있으므로 그 경로 아래 전체를 읽지 못한 것으로 봄
+                worker.unreadablePaths.push_back(prefix + name);
+                continue;
+            }
+            statDone = true;
+            isFile = S_ISREG(st.st_mode);
+            // 디렉토리 심볼릭 링크는 따라가지 않음 (순환 방지)
+            isDirectory = entry->d_type == DT_UNKNOWN && S_ISDIR(st.st_mode);
+        }
+
+        if (isDirectory) {
+            pushTask(index, Task{prefix + name, {}});
+        } else if (isFile && isSupportedAudioFile(name)) {
+            // 오디오 파일만 지문용으로 stat (심볼릭 링크는 대상 파일 기준)
+            if (!statDone && fstatat(dirfd(dir), name, &st, 0) != 0) {
+                worker.unreadablePaths.push_back(prefix + name);
+                continue;
+            }
+            audioFiles.push_back(FileEntry{prefix + name, makeFingerprint(st)});
+        }
+    }
+    // 목록을 끝까지 읽지 못했으면 (EIO 등) 나오지 않은 항목이 있을 수 있음
+    if (readError != 0) {
+        LOGE("Error reading directory %s: %s", directory.c_str(), strerror(readError));
+        worker.unreadablePaths.push_back(prefix.size() > 1 ? prefix.substr(0, prefix.size() - 1) : prefix);
+    }
+    closedir(dir);
+    directoriesScanned++;
+
+    // 하위 디렉토리를 먼저 내놓았으므로 다른 작업자가 탐색하는 동안 이 디렉토리의 파일을 추출
+    // 파일이 많으면 첫 묶음만 직접 처리하고 나머지는 다른 작업자도 가져갈 수 있게 내놓음
+    filesFound.fetch_add(static_cast<int>(audioFiles.size()));
+    while (audioFiles.size() > kFileBatchSize) {
+        std::vector<FileEntry> batch(std::make_move_iterator(audioFiles.end() - kFileBatchSize),
+                                       std::make_move_iterator(audioFiles.end()));
+        audioFiles.resize(audioFiles.size() - kFileBatchSize);
+        pushTask(index, Task{std::string(), std::move(batch)});
+    }
+    extractFiles(index, audioFiles);
+}
+
+void ParallelScanner::extractFiles(int index, const std::vector<FileEntry>& files) {
+    Worker& worker = *workers[index];
+    for (const FileEntry& file : files) {
+        TrackMetadata metadata;
+        FileResult result = FileResult::Failed;
+        try {
+            result = (*fileHandler)(file.path, file.fingerprint, metadata);
+        } catch (const std::exception& e) {
+            LOGE("Error scanning file %s: %s", file.path.c_str(), e.what());
+        }
+
+        if (result == FileResult::Extracted) {
+            worker.results.push_back(std::move(metadata));
+        } else if (result == FileResult::Unchanged) {
+            filesUnchanged++;
+        } else {
+            filesFailed++;
+        }
+        filesProcessed++;
+    }
+}
+
+} // namespace pancakemusicbox
@@ -0,0 +1,205 @@
+#include "include/ReadAheadFile.h"
+#include <android/log.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define LOG_TAG "ReadAheadFile"
+#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+ReadAheadFile::SharedState::~SharedState() {
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+ReadAheadFile::~ReadAheadFile() {
+    close();
+}
+
+bool ReadAheadFile::open(const std::string& filePath) {
+    close();
+
+    int fd = ::open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        LOGE("Failed to open file: %s", filePath.c_str());
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        LOGE("Failed to stat file: %s", filePath.c_str());
+        ::close(fd);
+        return false;
+    }
+
+    // 순차 접근임을 커널에 알림 (커널 read-ahead 창 확대)
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    mState = std::make_shared<SharedState>();
+    mState->fd = fd;
+    mState->fileSize = st.st_size;
+    mFilePath = filePath;
+    mPosition = 0;
+
+    std::lock_guard<std::mutex> lock(mState->lock);
+    scheduleReadAheadLocked(0);
+    return true;
+}
+
+void ReadAheadFile::close() {
+    if (!mState) {
+        return;
+    }
+
+    IoStats stats = getStats();
+    IoScheduler::getInstance().recordStats(mFilePath, stats);
+
+    // 진행 중인 I/O 작업은 SharedState를 계속 참조하므로 여기서는 참조만 해제
+    mState.reset();
+    mFilePath.clear();
+    mPosition = 0;
+}
+
+ssize_t ReadAheadFile::read(void* buffer, size_t size) {
+    if (!mState) {
+        return -1;
+    }
+
+    uint8_t* output = static_cast<uint8_t*>(buffer);
+    size_t total = 0;
+
+    std::unique_lock<std::mutex> lock(mState->lock);
+    while (total < size && mPosition < mState->fileSize) {
+        int64_t index = mPosition / static_cast<int64_t>(kBlockSize);
+        scheduleReadAheadLocked(index);
+
+        auto blockIt = mState->blocks.find(index);
+        if (blockIt == mState->blocks.end()) {
+            return total > 0 ? static_cast<ssize_t>(total) : -1; // 블록 버퍼 할당 실패
+        }
+
+        Block& block = blockIt->second;
+        if (!block.ready) {
+            // 디코더가 I/O를 따라잡은 경우 (stall)
+            auto waitStart = std::chrono::steady_clock::now();
+            mState->condition.wait(lock, [&block]() { return block.ready; });
+            auto waited = std::chrono::steady_clock::now() - waitStart;
+            mState->stats.ioWaitNs += static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(waited).count());
+            mState->stats.stallCount++;
+        }
+
+        if (block.failed) {
+            LOGE("Read failed at offset %lld: %s", static_cast<long long>(mPosition), mFilePath.c_str());
+            return total > 0 ? static_cast<ssize_t>(total) : -1;
+        }
+
+        size_t blockOffset = static_cast<size_t>(mPosition - index * static_cast<int64_t>(kBlockSize));
+        if (blockOffset >= block.length) {
+            break; // 파일이 열린 뒤 잘린 경우
+        }
+
+        size_t count = std::min(size - total, block.length - blockOffset);
+        memcpy(output + total, block.data.get() + blockOffset, count);
+        total += count;
+        mPosition += static_cast<int64_t>(count);
+    }
+
+    // 이미 지나간 블록 해제
+    int64_t currentBlock = mPosition / static_cast<int64_t>(kBlockSize);
+    mState->blocks.erase(mState->blocks.begin(), mState->blocks.lower_bound(currentBlock));
+
+    return static_cast<ssize_t>(total);
+}
+
+bool ReadAheadFile::seek(int64_t offset) {
+    if (!mState || offset < 0) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mState->lock);
+    mPosition = std::min(offset, mState->fileSize);
+
+    // 새 위치의 창 밖에 있는 블록 해제 (진행 중인 pread는 버퍼를 공유하므로 안전)
+    int64_t firstBlock = mPosition / static_cast<int64_t>(kBlockSize);
+    int64_t lastBlock = firstBlock + kWindowBlocks;
+    for (auto it = mState->blocks.begin(); it != mState->blocks.end();) {
+        if (it->first < firstBlock || it->first >= lastBlock) {
+            it = mState->blocks.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    scheduleReadAheadLocked(firstBlock);
+    return true;
+}
+
+int64_t ReadAheadFile::getSize() const {
+    return mState ? mState->fileSize : 0;
+}
+
+IoStats ReadAheadFile::getStats() const {
+    if (!mState) {
+        return IoStats();
+    }
+    std::lock_guard<std::mutex> lock(mState->lock);
+    return mState->stats;
+}
+
+void ReadAheadFile::scheduleReadAheadLocked(int64_t firstBlock) {
+    const int64_t blockSize = static_cast<int64_t>(kBlockSize);
+
+    for (int64_t index = firstBlock; index < firstBlock + kWindowBlocks; index++) {
+        int64_t offset = index * blockSize;
+        if (offset >= mState->fileSize) {
+            break;
+        }
+        if (mState->blocks.find(index) != mState->blocks.end()) {
+            continue;
+        }
+
+        void* memory = nullptr;
+        if (posix_memalign(&memory, kAlignment, kBlockSize) != 0) {
+            LOGE("Failed to allocate read-ahead block");
+            break;
+        }
+
+        Block& block = mState->blocks[index];
+        block.data = std::shared_ptr<uint8_t>(static_cast<uint8_t*>(memory), free);
+
+        std::shared_ptr<SharedState> state = mState;
+        std::shared_ptr<uint8_t> data = block.data;
+        IoScheduler::getInstance().submit([state, data, index, offset]() {
+            ssize_t result = pread(state->fd, data.get(), kBlockSize, static_cast<off_t>(offset));
+            {
+                std::lock_guard<std::mutex> lock(state->lock);
+                if (result > 0) {
+                    state->stats.bytesRead += static_cast<uint64_t>(result);
+                }
+                state->stats.readCount++;
+
+                // seek으로 이미 해제된 블록이면 결과를 버림
+                auto it = state->blocks.find(index);
+                if (it != state->blocks.end() && it->second.data == data) {
+                    it->second.length = result > 0 ? static_cast<size_t>(result) : 0;
+                    it->second.failed = result < 0;
+                    it->second.ready = true;
+                }
+            }
+            state->condition.notify_all();
+        }, index == firstBlock);
+
+        // 창 바로 뒤 구간은 커널에 미리 알려 다음 pread가 캐시에서 처리되도록 함
+        if (index == firstBlock + kWindowBlocks - 1) {
+            posix_fadvise(mState->fd, static_cast<off_t>(offset + blockSize),
+                          static_cast<off_t>(blockSize * kWindowBlocks), POSIX_FADV_WILLNEED);
+        }
+    }
+}
@@ -0,0 +1,77 @@
+#include "include/StringArena.h"
+#include <cstring>
+
+namespace pancakemusicbox {
+
+std::string_view StringArena::store(std::string_view value) {
+    size_t bytes = value.size() + 1;
+    char* destination;
+    if (bytes > kChunkSize) {
+        // 청크보다 긴 문자열은 자기만의 청크를 받음 (지금 청크의 남은 공간은 그대로 다음 문자열에 사용)
+        chunks.emplace_back(new char[bytes]);
+        allocatedBytes += bytes;
+        destination = chunks.back().get();
+    } else {
+        if (bytes > remaining) {
+            chunks.emplace_back(new char[kChunkSize]);
+            allocatedBytes += kChunkSize;
+            cursor = chunks.back().get();
+            remaining = kChunkSize;
+        }
+        destination = cursor;
+        cursor += bytes;
+        remaining -= bytes;
+    }
+
+    if (!value.empty()) {
+        memcpy(destination, value.data(), value.size());
+    }
+    destination[value.size()] = '\0';
+    usedBytes += bytes;
+    return std::string_view(destination, value.size());
+}
+
+void StringArena::clear() {
+    chunks.clear();
+    cursor = nullptr;
+    remaining = 0;
+    usedBytes = 0;
+    allocatedBytes = 0;
+}
+
+StringPool::StringPool() {
+    intern(std::string_view());
+}
+
+uint32_t StringPool::intern(std::string_view value) {
+    auto existing = idsByString.find(value);
+    if (existing != idsByString.end()) {
+        return existing->second;
+    }
+    std::string_view stored = arena.store(value);
+    uint32_t id = static_cast<uint32_t>(strings.size());
+    strings.push_back(stored);
+    idsByString.emplace(stored, id);
+    return id;
+}
+
+uint32_t StringPool::find(std::string_view value) const {
+    auto existing = idsByString.find(value);
+    return existing != idsByString.end() ? existing->second : kNotFound;
+}
+
+void StringPool::clear() {
+    std::unordered_map<std::string_view, uint32_t>().swap(idsByString);
+    std::vector<std::string_view>().swap(strings);
+    arena.clear();
+    intern(std::string_view());
+}
+
+size_t StringPool::getMemoryUsage() const {
+    // unordered_map 노드: 키 + 값 + 다음 포인터 + 캐시된 해시
+    size_t nodeBytes = sizeof(std::string_view) + sizeof(uint32_t) + 2 * sizeof(void*);
+    return arena.getAllocatedBytes() + strings.capacity() * sizeof(std::string_view) +
+           idsByString.size() * nodeBytes + idsByString.bucket_count() * sizeof(void*);
+}
+
+} // namespace pancakemusicbox
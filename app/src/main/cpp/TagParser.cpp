@@ -0,0 +1,1569 @@
+#include "include/TagParser.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <vector>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <android/log.h>
+
+#define LOG_TAG "TagParser"
+#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+namespace pancakemusicbox {
+
+namespace {
+
+// 블록 하나를 읽을 때의 상한 (손상된 크기 값으로 큰 메모리를 잡지 않도록)
+constexpr size_t kMaxBlockSize = 16 * 1024 * 1024;
+// 텍스트 프레임/항목 하나의 상한 (이보다 큰 값은 태그가 아닌 바이너리로 보고 건너뜀)
+constexpr size_t kMaxTextSize = 64 * 1024;
+// Ogg 마지막 페이지를 찾을 때 읽는 끝부분 크기
+constexpr size_t kTailSize = 64 * 1024;
+
+// ---- 바이트 순서 ----
+
+uint16_t be16(const uint8_t* p) { return static_cast<uint16_t>((p[0] << 8) | p[1]); }
+uint32_t be24(const uint8_t* p) { return (static_cast<uint32_t>(p[0]) << 16) | (p[1] << 8) | p[2]; }
+uint32_t be32(const uint8_t* p) { return (static_cast<uint32_t>(p[0]) << 24) | (p[1] << 16) | (p[2] << 8) | p[3]; }
+uint64_t be64(const uint8_t* p) { return (static_cast<uint64_t>(be32(p)) << 32) | be32(p + 4); }
+uint16_t le16(const uint8_t* p) { return static_cast<uint16_t>(p[0] | (p[1] << 8)); }
+uint32_t le32(const uint8_t* p) { return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24); }
+uint64_t le64(const uint8_t* p) { return le32(p) | (static_cast<uint64_t>(le32(p + 4)) << 32); }
+
+// ID3v2 동기 안전 정수 (바이트마다 하위 7비트)
+uint32_t syncsafe32(const uint8_t* p) {
+    return ((p[0] & 0x7Fu) << 21) | ((p[1] & 0x7Fu) << 14) | ((p[2] & 0x7Fu) << 7) | (p[3] & 0x7Fu);
+}
+
+long long samplesToMs(uint64_t samples, uint32_t sampleRate) {
+    if (sampleRate == 0) {
+        return 0;
+    }
+    return static_cast<long long>(samples / sampleRate * 1000 + (samples % sampleRate) * 1000 / sampleRate);
+}
+
+// ---- 파일 읽기 ----
+
+/**
+ * 앞부분 버퍼 + 필요한 영역만 pread로 읽는 파일 소스
+ */
+class FileSource {
+public:
+    FileSource(int fd, uint64_t size) : fd(fd), size(size) {}
+
+    bool loadHead() {
+        head.resize(static_cast<size_t>(std::min<uint64_t>(TagParser::kHeadSize, size)));
+        return head.empty() || readFully(0, head.data(), head.size());
+    }
+
+    uint64_t getSize() const { return size; }
+    const uint8_t* headData() const { return head.data(); }
+    size_t headSize() const { return head.size(); }
+
+    // [offset, offset + length) 영역: 앞부분 버퍼 안이면 그대로, 아니면 pread로 scratch에 읽음
+    // 반환 포인터는 같은 scratch로 다음 view를 호출하기 전까지만 유효
+    const uint8_t* view(uint64_t offset, size_t length, std::vector<uint8_t>& scratch) {
+        if (length == 0 || length > kMaxBlockSize || offset > size || length > size - offset) {
+            return nullptr;
+        }
+        if (offset + length <= head.size()) {
+            return head.data() + offset;
+        }
+        scratch.resize(length);
+        if (!readFully(offset, scratch.data(), length)) {
+            return nullptr;
+        }
+        return scratch.data();
+    }
+
+private:
+    bool readFully(uint64_t offset, uint8_t* out, size_t length) {
+        while (length > 0) {
+            ssize_t n = pread(fd, out, length, static_cast<off_t>(offset));
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                return false;
+            }
+            out += n;
+            offset += static_cast<uint64_t>(n);
+            length -= static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    int fd;
+    uint64_t size;
+    std::vector<uint8_t> head;
+};
+
+// ---- 태그 값 ----
+
+enum Field { kTitle, kArtist, kAlbum, kGenre, kYear, kTrack, kComposer, kFieldCount };
+
+// 이미지 시그니처 (JPEG, PNG, WebP, GIF)
+bool isImageData(const uint8_t* p, size_t length) {
+    return (length > 3 && p[0] == 0xFF && p[1] == 0xD8 && p[2] == 0xFF) ||
+           (length > 8 && memcmp(p, "\x89PNG\r\n\x1A\n", 8) == 0) ||
+           (length > 12 && memcmp(p, "RIFF", 4) == 0 && memcmp(p + 8, "WEBP", 4) == 0) ||
+           (length > 6 && memcmp(p, "GIF8", 4) == 0);
+}
+
+struct ParsedTags {
+    std::string values[kFieldCount];
+    bool mqa = false;
+    EmbeddedPicture* picture = nullptr;     // 그림을 요청하지 않았으면 nullptr (그림 프레임을 읽지 않음)
+
+    // 앞표지(종류 3)를 우선하고, 없으면 처음 찾은 그림
+    void offerPicture(uint32_t type, const uint8_t* data, size_t length) {
+        if (picture == nullptr || length > kMaxBlockSize || !isImageData(data, length)) {
+            return;
+        }
+        if (!picture->data.empty() && (picture->type == 3 || type != 3)) {
+            return;
+        }
+        picture->type = static_cast<int>(type);
+        picture->data.assign(data, data + length);
+    }
+
+    // 먼저 찾은 값 우선 (ID3v2 > APE > ID3v1 순으로 호출)
+    void set(Field field, std::string value) {
+        size_t begin = value.find_first_not_of(" \t\r\n");
+        if (begin == std::string::npos) {
+            return;
+        }
+        size_t end = value.find_last_not_of(" \t\r\n");
+        if (values[field].empty()) {
+            values[field] = value.substr(begin, end - begin + 1);
+        }
+    }
+};
+
+struct StreamInfo {
+    uint32_t sampleRate = 0;
+    int bitDepth = 0;
+    int channels = 0;
+    long long durationMs = 0;
+    const char* format = nullptr;
+};
+
+// 태그 키 -> 필드 (Vorbis comment, APE 공통, 대소문자 무시)
+bool fieldForKey(const char* key, size_t length, Field& field) {
+    static const struct { const char* key; Field field; } kKeys[] = {
+        {"TITLE", kTitle}, {"ARTIST", kArtist}, {"ALBUM", kAlbum}, {"GENRE", kGenre},
+        {"DATE", kYear}, {"YEAR", kYear}, {"TRACKNUMBER", kTrack}, {"TRACK", kTrack},
+        {"COMPOSER", kComposer},
+    };
+    for (const auto& entry : kKeys) {
+        if (strlen(entry.key) == length && strncasecmp(entry.key, key, length) == 0) {
+            field = entry.field;
+            return true;
+        }
+    }
+    return false;
+}
+
+// ---- 문자열 변환 (결과는 항상 올바른 UTF-8, JNI NewStringUTF에 그대로 넘김) ----
+
+void appendUtf8(std::string& out, uint32_t codePoint) {
+    if (codePoint < 0x80) {
+        out.push_back(static_cast<char>(codePoint));
+    } else if (codePoint < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else if (codePoint < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+}
+
+std::string latin1ToUtf8(const uint8_t* p, size_t length) {
+    std::string out;
+    for (size_t i = 0; i < length && p[i] != 0; i++) {
+        appendUtf8(out, p[i]);
+    }
+    return out;
+}
+
+std::string utf16ToUtf8(const uint8_t* p, size_t length, bool bigEndian) {
+    std::string out;
+    for (size_t i = 0; i + 1 < length; i += 2) {
+        uint32_t unit = bigEndian ? be16(p + i) : le16(p + i);
+        if (unit == 0) {
+            break;
+        }
+        if (unit >= 0xD800 && unit < 0xDC00 && i + 3 < length) {
+            uint32_t low = bigEndian ? be16(p + i + 2) : le16(p + i + 2);
+            if (low >= 0xDC00 && low < 0xE000) {
+                appendUtf8(out, 0x10000 + ((unit - 0xD800) << 10) + (low - 0xDC00));
+                i += 2;
+                continue;
+            }
+        }
+        if (unit >= 0xD800 && unit < 0xE000) {
+            unit = 0xFFFD; // 짝이 없는 서로게이트
+        }
+        appendUtf8(out, unit);
+    }
+    return out;
+}
+
+// UTF-8로 선언된 값도 잘못된 바이트가 섞여 있으면 Latin-1로 간주
+std::string utf8OrLatin1(const uint8_t* p, size_t length) {
+    size_t end = 0;
+    while (end < length && p[end] != 0) {
+        end++;
+    }
+
+    size_t i = 0;
+    while (i < end) {
+        uint8_t c = p[i];
+        size_t extra = c < 0x80 ? 0 : (c & 0xE0) == 0xC0 ? 1 : (c & 0xF0) == 0xE0 ? 2 : (c & 0xF8) == 0xF0 ? 3 : 4;
+        // 잘못된 선행 바이트, 2바이트 과잉 표현, 중간에 끊긴 시퀀스
+        if (extra == 4 || (extra == 1 && c < 0xC2) || (c >= 0xF5) || extra >= end - i) {
+            return latin1ToUtf8(p, end);
+        }
+        for (size_t k = 1; k <= extra; k++) {
+            if ((p[i + k] & 0xC0) != 0x80) {
+                return latin1ToUtf8(p, end);
+            }
+        }
+        i += extra + 1;
+    }
+    return std::string(reinterpret_cast<const char*>(p), end);
+}
+
+// ---- ID3 ----
+
+// ID3v1 장르 번호 (Winamp 확장 포함)
+const char* const kId3Genres[] = {
+    "Blues", "Classic Rock", "Country", "Dance", "Disco", "Funk", "Grunge", "Hip-Hop", "Jazz", "Metal",
+    "New Age", "Oldies", "Other", "Pop", "R&B", "Rap", "Reggae", "Rock", "Techno", "Industrial",
+    "Alternative", "Ska", "Death Metal", "Pranks", "Soundtrack", "Euro-Techno", "Ambient", "Trip-Hop", "Vocal",
+    "Jazz+Funk", "Fusion", "Trance", "Classical", "Instrumental", "Acid", "House", "Game", "Sound Clip", "Gospel",
+    "Noise", "AlternRock", "Bass", "Soul", "Punk", "Space", "Meditative", "Instrumental Pop", "Instrumental Rock",
+    "Ethnic", "Gothic", "Darkwave", "Techno-Industrial", "Electronic", "Pop-Folk", "Eurodance", "Dream",
+    "Southern Rock", "Comedy", "Cult", "Gangsta", "Top 40", "Christian Rap", "Pop/Funk", "Jungle",
+    "Native American", "Cabaret", "New Wave", "Psychadelic", "Rave", "Showtunes", "Trailer", "Lo-Fi", "Tribal",
+    "Acid Punk", "Acid Jazz", "Polka", "Retro", "Musical", "Rock & Roll", "Hard Rock", "Folk", "Folk-Rock",
+    "National Folk", "Swing", "Fast Fusion", "Bebob", "Latin", "Revival", "Celtic", "Bluegrass", "Avantgarde",
+    "Gothic Rock", "Progressive Rock", "Psychedelic Rock", "Symphonic Rock", "Slow Rock", "Big Band", "Chorus",
+    "Easy Listening", "Acoustic", "Humour", "Speech", "Chanson", "Opera", "Chamber Music", "Sonata", "Symphony",
+    "Booty Bass", "Primus", "Porn Groove", "Satire", "Slow Jam", "Club", "Tango", "Samba", "Folklore", "Ballad",
+    "Power Ballad", "Rhythmic Soul", "Freestyle", "Duet", "Punk Rock", "Drum Solo", "A capella", "Euro-House",
+    "Dance Hall", "Goa", "Drum & Bass", "Club-House", "Hardcore", "Terror", "Indie", "BritPop", "Negerpunk",
+    "Polsk Punk", "Beat", "Christian Gangsta Rap", "Heavy Metal", "Black Metal", "Crossover",
+    "Contemporary Christian", "Christian Rock", "Merengue", "Salsa", "Thrash Metal", "Anime", "JPop", "Synthpop",
+};
+constexpr int kId3GenreCount = sizeof(kId3Genres) / sizeof(kId3Genres[0]);
+
+const char* id3GenreName(int index) {
+    return (index >= 0 && index < kId3GenreCount) ? kId3Genres[index] : nullptr;
+}
+
+// "(13)", "(13)Pop", "13" 형식의 장르 참조를 이름으로 변환
+std::string resolveId3Genre(const std::string& value) {
+    size_t pos = 0;
+    bool parenthesized = !value.empty() && value[0] == '(';
+    if (parenthesized) {
+        pos = 1;
+    }
+    size_t digitsEnd = pos;
+    while (digitsEnd < value.size() && value[digitsEnd] >= '0' && value[digitsEnd] <= '9') {
+        digitsEnd++;
+    }
+    if (digitsEnd == pos || digitsEnd - pos > 3) {
+        return value;
+    }
+    if (parenthesized) {
+        if (digitsEnd >= value.size() || value[digitsEnd] != ')') {
+            return value;
+        }
+        // "(13)Pop"처럼 뒤에 이름이 있으면 이름 우선
+        if (digitsEnd + 1 < value.size()) {
+            return value.substr(digitsEnd + 1);
+        }
+    } else if (digitsEnd != value.size()) {
+        return value;
+    }
+    const char* name = id3GenreName(atoi(value.c_str() + pos));
+    return name != nullptr ? std::string(name) : value;
+}
+
+std::string decodeId3Text(const uint8_t* p, size_t length) {
+    if (length < 1) {
+        return std::string();
+    }
+    uint8_t encoding = p[0];
+    p++;
+    length--;
+    switch (encoding) {
+        case 0:
+            return latin1ToUtf8(p, length);
+        case 1: {
+            // BOM으로 바이트 순서 결정 (없으면 리틀 엔디언)
+            bool bigEndian = false;
+            if (length >= 2 && ((p[0] == 0xFE && p[1] == 0xFF) || (p[0] == 0xFF && p[1] == 0xFE))) {
+                bigEndian = p[0] == 0xFE;
+                p += 2;
+                length -= 2;
+            }
+            return utf16ToUtf8(p, length, bigEndian);
+        }
+        case 2:
+            return utf16ToUtf8(p, length, true);
+        case 3:
+            return utf8OrLatin1(p, length);
+        default:
+            return std::string();
+    }
+}
+
+// 비동기화(0xFF 0x00 -> 0xFF) 되돌리기
+void removeUnsynchronisation(std::vector<uint8_t>& data) {
+    size_t out = 0;
+    for (size_t i = 0; i < data.size(); i++) {
+        data[out++] = data[i];
+        if (data[i] == 0xFF && i + 1 < data.size() && data[i + 1] == 0x00) {
+            i++;
+        }
+    }
+    data.resize(out);
+}
+
+bool fieldForId3Frame(const char* id, int major, Field& field) {
+    static const struct { const char* id; Field field; } kFrames[] = {
+        {"TIT2", kTitle}, {"TPE1", kArtist}, {"TALB", kAlbum}, {"TCON", kGenre},
+        {"TDRC", kYear}, {"TYER", kYear}, {"TRCK", kTrack}, {"TCOM", kComposer},
+    };
+    static const struct { const char* id; Field field; } kFramesV22[] = {
+        {"TT2", kTitle}, {"TP1", kArtist}, {"TAL", kAlbum}, {"TCO", kGenre},
+        {"TYE", kYear}, {"TRK", kTrack}, {"TCM", kComposer},
+    };
+    if (major == 2) {
+        for (const auto& entry : kFramesV22) {
+            if (memcmp(entry.id, id, 3) == 0) {
+                field = entry.field;
+                return true;
+            }
+        }
+        return false;
+    }
+    for (const auto& entry : kFrames) {
+        if (memcmp(entry.id, id, 4) == 0) {
+            field = entry.field;
+            return true;
+        }
+    }
+    return false;
+}
+
+// APIC(2.3/2.4) / PIC(2.2): 인코딩, MIME 형식(2.2는 3글자), 그림 종류, 설명, 이미지 데이터
+void parseId3Picture(const uint8_t* p, size_t length, int major, ParsedTags& tags) {
+    if (length < 4) {
+        return;
+    }
+    uint8_t encoding = p[0];
+    size_t pos = 4;
+    if (major != 2) {
+        const uint8_t* mimeEnd = static_cast<const uint8_t*>(memchr(p + 1, 0, length - 1));
+        if (mimeEnd == nullptr) {
+            return;
+        }
+        pos = static_cast<size_t>(mimeEnd - p) + 1;
+    }
+    if (pos >= length) {
+        return;
+    }
+    uint8_t type = p[pos++];
+
+    // 설명 문자열 종료 문자 (UTF-16은 2바이트 0)
+    if (encoding == 1 || encoding == 2) {
+        while (pos + 1 < length && (p[pos] != 0 || p[pos + 1] != 0)) {
+            pos += 2;
+        }
+        pos += 2;
+    } else {
+        while (pos < length && p[pos] != 0) {
+            pos++;
+        }
+        pos++;
+    }
+    if (pos < length) {
+        tags.offerPicture(type, p + pos, length - pos);
+    }
+}
+
+using RegionView = std::function<const uint8_t*(uint64_t offset, size_t length)>;
+
+// ID3v2 프레임 영역 [begin, end)을 헤더 단위로 건너뛰며 필요한 텍스트 프레임만 읽음
+// (앨범 아트 같은 큰 프레임은 내용을 읽지 않고 크기만큼 건너뜀)
+void parseId3Frames(const RegionView& view, uint64_t begin, uint64_t end, int major, ParsedTags& tags) {
+    const size_t headerLength = major == 2 ? 6 : 10;
+    uint64_t pos = begin;
+    while (pos + headerLength <= end) {
+        const uint8_t* header = view(pos, headerLength);
+        if (header == nullptr || header[0] == 0) {
+            break; // 패딩
+        }
+
+        char id[4];
+        memcpy(id, header, major == 2 ? 3 : 4);
+        uint32_t frameSize = major == 2 ? be24(header + 3) : major == 4 ? syncsafe32(header + 4) : be32(header + 4);
+        uint16_t frameFlags = major == 2 ? 0 : be16(header + 8);
+        uint64_t dataPos = pos + headerLength;
+        if (frameSize == 0 || frameSize > end - dataPos) {
+            break;
+        }
+        pos = dataPos + frameSize;
+
+        // 그림 프레임은 요청받았을 때만 읽음
+        Field field = kFieldCount;
+        bool isPicture = tags.picture != nullptr && memcmp(id, major == 2 ? "PIC" : "APIC", major == 2 ? 3 : 4) == 0;
+        if (!isPicture && (!fieldForId3Frame(id, major, field) || frameSize > kMaxTextSize)) {
+            continue;
+        }
+        // 압축/암호화된 프레임은 건너뜀
+        bool unsupported = major == 4 ? (frameFlags & 0x000C) != 0 : (frameFlags & 0x00C0) != 0;
+        if (unsupported) {
+            continue;
+        }
+
+        const uint8_t* data = view(dataPos, frameSize);
+        if (data == nullptr) {
+            break;
+        }
+        size_t dataLength = frameSize;
+        if (major == 4 && (frameFlags & 0x0001) != 0) {
+            // 데이터 길이 표시자
+            size_t skip = std::min<size_t>(4, dataLength);
+            data += skip;
+            dataLength -= skip;
+        }
+        std::vector<uint8_t> decoded;
+        if (major == 4 && (frameFlags & 0x0002) != 0) {
+            decoded.assign(data, data + dataLength);
+            removeUnsynchronisation(decoded);
+            data = decoded.data();
+            dataLength = decoded.size();
+        }
+
+        if (isPicture) {
+            parseId3Picture(data, dataLength, major, tags);
+            continue;
+        }
+        std::string value = decodeId3Text(data, dataLength);
+        if (field == kGenre) {
+            value = resolveId3Genre(value);
+        }
+        tags.set(field, std::move(value));
+    }
+}
+
+// offset 위치의 ID3v2 태그를 읽고 태그 전체 크기(헤더/푸터 포함)를 반환 (태그가 아니면 0)
+uint64_t parseId3v2(FileSource& source, uint64_t offset, ParsedTags& tags) {
+    std::vector<uint8_t> scratch;
+    const uint8_t* header = source.view(offset, 10, scratch);
+    if (header == nullptr || memcmp(header, "ID3", 3) != 0) {
+        return 0;
+    }
+    int major = header[3];
+    uint8_t flags = header[5];
+    if (major < 2 || major > 4 || ((header[6] | header[7] | header[8] | header[9]) & 0x80) != 0) {
+        return 0;
+    }
+    uint64_t bodySize = syncsafe32(header + 6);
+    uint64_t totalSize = 10 + bodySize + ((major == 4 && (flags & 0x10) != 0) ? 10 : 0);
+    uint64_t bodyStart = offset + 10;
+    uint64_t bodyEnd = std::min(bodyStart + bodySize, source.getSize());
+
+    if ((flags & 0x80) != 0 && major < 4) {
+        // 태그 전체 비동기화: 본문을 통째로 읽어 되돌린 뒤 파싱
+        const uint8_t* body = source.view(bodyStart, static_cast<size_t>(bodyEnd - bodyStart), scratch);
+        if (body == nullptr) {
+            return totalSize;
+        }
+        std::vector<uint8_t> decoded(body, body + (bodyEnd - bodyStart));
+        removeUnsynchronisation(decoded);
+        RegionView view = [&decoded](uint64_t pos, size_t length) -> const uint8_t* {
+            return pos + length <= decoded.size() ? decoded.data() + pos : nullptr;
+        };
+        uint64_t begin = 0;
+        if ((flags & 0x40) != 0 && major == 3 && decoded.size() >= 4) {
+            begin = 4 + be32(decoded.data());
+        }
+        parseId3Frames(view, begin, decoded.size(), major, tags);
+        return totalSize;
+    }
+
+    RegionView view = [&source, &scratch](uint64_t pos, size_t length) {
+        return source.view(pos, length, scratch);
+    };
+    uint64_t begin = bodyStart;
+    if ((flags & 0x40) != 0 && major >= 3) {
+        // 확장 헤더 (2.3은 크기 필드 제외, 2.4는 포함)
+        const uint8_t* extended = source.view(bodyStart, 4, scratch);
+        if (extended == nullptr) {
+            return totalSize;
+        }
+        begin += major == 3 ? 4 + be32(extended) : syncsafe32(extended);
+    }
+    parseId3Frames(view, begin, bodyEnd, major, tags);
+    return totalSize;
+}
+
+void parseId3v1(const uint8_t* p, ParsedTags& tags) {
+    tags.set(kTitle, latin1ToUtf8(p + 3, 30));
+    tags.set(kArtist, latin1ToUtf8(p + 33, 30));
+    tags.set(kAlbum, latin1ToUtf8(p + 63, 30));
+    tags.set(kYear, latin1ToUtf8(p + 93, 4));
+    // ID3v1.1: 주석 마지막 두 바이트가 0, 트랙 번호
+    if (p[125] == 0 && p[126] != 0) {
+        tags.set(kTrack, std::to_string(p[126]));
+    }
+    const char* genre = id3GenreName(p[127]);
+    if (genre != nullptr) {
+        tags.set(kGenre, genre);
+    }
+}
+
+void parseApeItems(const uint8_t* p, size_t length, uint32_t itemCount, ParsedTags& tags) {
+    size_t pos = 0;
+    for (uint32_t i = 0; i < itemCount && pos + 8 < length; i++) {
+        uint32_t valueSize = le32(p + pos);
+        uint32_t itemFlags = le32(p + pos + 4);
+        size_t keyStart = pos + 8;
+        size_t keyEnd = keyStart;
+        while (keyEnd < length && p[keyEnd] != 0) {
+            keyEnd++;
+        }
+        size_t valueStart = keyEnd + 1;
+        if (keyEnd >= length || valueSize > length - valueStart) {
+            break;
+        }
+        Field field;
+        // 텍스트 항목만 (바이너리/외부 링크 제외)
+        if ((itemFlags & 0x6) == 0 &&
+            fieldForKey(reinterpret_cast<const char*>(p + keyStart), keyEnd - keyStart, field)) {
+            tags.set(field, utf8OrLatin1(p + valueStart, valueSize));
+        }
+        pos = valueStart + valueSize;
+    }
+}
+
+// 끝부분의 APE와 ID3v1 태그를 읽고 오디오 데이터 뒤에 붙은 태그 크기를 반환
+uint64_t parseTailTags(FileSource& source, uint64_t audioStart, ParsedTags& tags) {
+    uint64_t size = source.getSize();
+    if (size < audioStart + 128) {
+        return 0;
+    }
+    std::vector<uint8_t> scratch;
+    size_t tailLength = static_cast<size_t>(std::min<uint64_t>(size - audioStart, 128 + 32));
+    const uint8_t* tail = source.view(size - tailLength, tailLength, scratch);
+    if (tail == nullptr) {
+        return 0;
+    }
+
+    uint64_t trailing = 0;
+    uint8_t id3v1[128];
+    bool hasId3v1 = memcmp(tail + tailLength - 128, "TAG", 3) == 0;
+    if (hasId3v1) {
+        memcpy(id3v1, tail + tailLength - 128, 128);
+        trailing = 128;
+    }
+
+    // APE 태그 푸터 (ID3v1이 있으면 그 바로 앞)
+    if (tailLength >= trailing + 32) {
+        const uint8_t* footer = tail + tailLength - trailing - 32;
+        if (memcmp(footer, "APETAGEX", 8) == 0) {
+            uint32_t tagSize = le32(footer + 12);
+            uint32_t itemCount = le32(footer + 16);
+            uint32_t tagFlags = le32(footer + 20);
+            uint64_t footerPos = size - trailing - 32;
+            if (tagSize >= 32 && tagSize - 32 <= footerPos - audioStart) {
+                uint64_t itemsPos = footerPos + 32 - tagSize;
+                const uint8_t* items = tagSize > 32 ? source.view(itemsPos, tagSize - 32, scratch) : nullptr;
+                if (items != nullptr) {
+                    parseApeItems(items, tagSize - 32, itemCount, tags);
+                }
+                trailing += tagSize + ((tagFlags & 0x80000000u) != 0 ? 32 : 0);
+            }
+        }
+    }
+
+    if (hasId3v1) {
+        parseId3v1(id3v1, tags);
+    }
+    return trailing;
+}
+
+// ---- Vorbis comment (FLAC, Ogg) ----
+
+void parseVorbisComment(const uint8_t* p, size_t length, ParsedTags& tags) {
+    if (length < 8) {
+        return;
+    }
+    uint32_t vendorLength = le32(p);
+    if (vendorLength > length - 8) {
+        return;
+    }
+    size_t pos = 4 + vendorLength;
+    uint32_t count = le32(p + pos);
+    pos += 4;
+
+    for (uint32_t i = 0; i < count && pos + 4 <= length; i++) {
+        uint32_t entryLength = le32(p + pos);
+        pos += 4;
+        if (entryLength > length - pos) {
+            break;
+        }
+        const char* entry = reinterpret_cast<const char*>(p + pos);
+        const char* equals = static_cast<const char*>(memchr(entry, '=', entryLength));
+        if (equals != nullptr) {
+            size_t keyLength = equals - entry;
+            Field field;
+            if (fieldForKey(entry, keyLength, field)) {
+                size_t valueOffset = keyLength + 1;
+                tags.set(field, utf8OrLatin1(p + pos + valueOffset, entryLength - valueOffset));
+            } else if (keyLength == 10 && strncasecmp(entry, "MQAENCODER", 10) == 0) {
+                tags.mqa = true;
+            }
+        }
+        pos += entryLength;
+    }
+}
+
+// ---- FLAC ----
+
+void parseFlacStreamInfo(const uint8_t* p, StreamInfo& info) {
+    info.sampleRate = (static_cast<uint32_t>(p[10]) << 12) | (p[11] << 4) | (p[12] >> 4);
+    info.channels = ((p[12] >> 1) & 0x07) + 1;
+    info.bitDepth = (((p[12] & 0x01) << 4) | (p[13] >> 4)) + 1;
+    uint64_t totalSamples = (static_cast<uint64_t>(p[13] & 0x0F) << 32) | be32(p + 14);
+    info.durationMs = samplesToMs(totalSamples, info.sampleRate);
+}
+
+// PICTURE 블록: 그림 종류, MIME, 설명, 크기 정보, 이미지 데이터
+void parseFlacPicture(const uint8_t* p, size_t length, ParsedTags& tags) {
+    if (length < 32) {
+        return;
+    }
+    uint32_t type = be32(p);
+    size_t pos = 4;
+    for (int field = 0; field < 2; field++) {   // MIME, 설명
+        if (length - pos < 4) {
+            return;
+        }
+        uint32_t fieldLength = be32(p + pos);
+        pos += 4;
+        if (fieldLength > length - pos) {
+            return;
+        }
+        pos += fieldLength;
+    }
+    if (length - pos < 20) {
+        return;
+    }
+    pos += 16;  // 너비, 높이, 색 깊이, 팔레트 수
+    uint32_t dataLength = be32(p + pos);
+    pos += 4;
+    if (dataLength <= length - pos) {
+        tags.offerPicture(type, p + pos, dataLength);
+    }
+}
+
+// offset 위치의 "fLaC"부터 메타데이터 블록 헤더를 따라가며 STREAMINFO와 VORBIS_COMMENT만 읽음
+bool parseFlac(FileSource& source, uint64_t offset, ParsedTags& tags, StreamInfo& info) {
+    std::vector<uint8_t> scratch;
+    uint64_t pos = offset + 4;
+    for (int block = 0; block < 256; block++) {
+        const uint8_t* header = source.view(pos, 4, scratch);
+        if (header == nullptr) {
+            break;
+        }
+        bool last = (header[0] & 0x80) != 0;
+        int type = header[0] & 0x7F;
+        uint32_t length = be24(header + 1);
+
+        if (type == 0 && length >= 34) {
+            const uint8_t* data = source.view(pos + 4, 34, scratch);
+            if (data != nullptr) {
+                parseFlacStreamInfo(data, info);
+            }
+        } else if (type == 4) {
+            const uint8_t* data = source.view(pos + 4, length, scratch);
+            if (data != nullptr) {
+                parseVorbisComment(data, length, tags);
+            }
+        } else if (type == 6 && tags.picture != nullptr) {
+            const uint8_t* data = source.view(pos + 4, length, scratch);
+            if (data != nullptr) {
+                parseFlacPicture(data, length, tags);
+            }
+        }
+
+        pos += 4 + static_cast<uint64_t>(length);
+        if (last) {
+            break;
+        }
+    }
+    info.format = "FLAC";
+    return info.sampleRate > 0;
+}
+
+// ---- MPEG 오디오 / ADTS ----
+
+struct MpegHeader {
+    bool mpeg1;
+    int layer;
+    uint32_t bitrate;       // bps
+    uint32_t sampleRate;
+    int channels;
+    uint32_t frameSize;
+    uint32_t samplesPerFrame;
+};
+
+bool parseMpegHeader(const uint8_t* p, MpegHeader& header) {
+    if (p[0] != 0xFF || (p[1] & 0xE0) != 0xE0) {
+        return false;
+    }
+    int versionBits = (p[1] >> 3) & 0x03;    // 0: 2.5, 2: 2, 3: 1
+    int layerBits = (p[1] >> 1) & 0x03;      // 1: III, 2: II, 3: I
+    int bitrateIndex = p[2] >> 4;
+    int sampleRateIndex = (p[2] >> 2) & 0x03;
+    if (versionBits == 1 || layerBits == 0 || bitrateIndex == 0 || bitrateIndex == 15 || sampleRateIndex == 3) {
+        return false;
+    }
+
+    static const uint16_t kBitrates[2][3][15] = {
+        {   // MPEG-1: Layer I, II, III
+            {0, 32, 64, 96, 128, 160, 192, 224, 256, 288, 320, 352, 384, 416, 448},
+            {0, 32, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 384},
+            {0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320},
+        },
+        {   // MPEG-2/2.5
+            {0, 32, 48, 56, 64, 80, 96, 112, 128, 144, 160, 176, 192, 224, 256},
+            {0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160},
+            {0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160},
+        },
+    };
+    static const uint32_t kSampleRates[3] = {44100, 48000, 32000};
+
+    header.mpeg1 = versionBits == 3;
+    header.layer = 4 - layerBits;
+    header.bitrate = kBitrates[header.mpeg1 ? 0 : 1][header.layer - 1][bitrateIndex] * 1000u;
+    header.sampleRate = kSampleRates[sampleRateIndex] >> (versionBits == 3 ? 0 : versionBits == 2 ? 1 : 2);
+    header.channels = (p[3] >> 6) == 3 ? 1 : 2;
+    uint32_t padding = (p[2] >> 1) & 0x01;
+
+    if (header.layer == 1) {
+        header.samplesPerFrame = 384;
+        header.frameSize = (12 * header.bitrate / header.sampleRate + padding) * 4;
+    } else {
+        header.samplesPerFrame = (header.layer == 3 && !header.mpeg1) ? 576 : 1152;
+        header.frameSize = header.samplesPerFrame / 8 * header.bitrate / header.sampleRate + padding;
+    }
+    return header.frameSize >= 4;
+}
+
+bool isAdtsHeader(const uint8_t* p) {
+    return p[0] == 0xFF && (p[1] & 0xF6) == 0xF0 && ((p[2] >> 2) & 0x0F) < 13;
+}
+
+uint32_t adtsFrameLength(const uint8_t* p) {
+    return ((p[3] & 0x03u) << 11) | (p[4] << 3) | (p[5] >> 5);
+}
+
+bool parseAdts(const uint8_t* window, size_t windowLength, size_t first, uint64_t audioBytes, StreamInfo& info) {
+    static const uint32_t kSampleRates[13] = {
+        96000, 88200, 64000, 48000, 44100, 32000, 24000, 22050, 16000, 12000, 11025, 8000, 7350
+    };
+    const uint8_t* p = window + first;
+    info.sampleRate = kSampleRates[(p[2] >> 2) & 0x0F];
+    info.channels = ((p[2] & 0x01) << 2) | (p[3] >> 6);
+    info.bitDepth = 16;
+    info.format = "AAC";
+
+    // 프레임 길이가 가변이므로 앞부분 프레임들의 평균 길이로 전체 프레임 수를 추정
+    uint64_t frames = 0;
+    uint64_t bytes = 0;
+    size_t pos = first;
+    while (pos + 7 <= windowLength && isAdtsHeader(window + pos)) {
+        uint32_t length = adtsFrameLength(window + pos);
+        if (length < 7) {
+            break;
+        }
+        frames++;
+        bytes += length;
+        pos += length;
+    }
+    if (frames > 0 && info.sampleRate > 0) {
+        uint64_t totalFrames = audioBytes * frames / bytes;
+        info.durationMs = samplesToMs(totalFrames * 1024, info.sampleRate);
+    }
+    return info.sampleRate > 0;
+}
+
+// MP3/ADTS: 앞쪽 ID3v2 태그(들), 첫 프레임의 Xing/Info/VBRI 헤더, 끝부분 APE/ID3v1
+bool parseMpegAudio(FileSource& source, ParsedTags& tags, StreamInfo& info) {
+    uint64_t audioStart = 0;
+    for (int i = 0; i < 4; i++) {
+        uint64_t tagSize = parseId3v2(source, audioStart, tags);
+        if (tagSize == 0) {
+            break;
+        }
+        audioStart += tagSize;
+    }
+
+    std::vector<uint8_t> scratch;
+    // ID3v2가 앞에 붙은 FLAC
+    const uint8_t* magic = source.view(audioStart, 4, scratch);
+    if (magic != nullptr && memcmp(magic, "fLaC", 4) == 0) {
+        return parseFlac(source, audioStart, tags, info);
+    }
+
+    uint64_t size = source.getSize();
+    if (audioStart >= size) {
+        return false;
+    }
+    uint64_t trailing = parseTailTags(source, audioStart, tags);
+    uint64_t audioEnd = size - std::min(trailing, size - audioStart);
+
+    size_t windowLength = static_cast<size_t>(std::min<uint64_t>(TagParser::kHeadSize, audioEnd - audioStart));
+    const uint8_t* window = windowLength >= 4 ? source.view(audioStart, windowLength, scratch) : nullptr;
+    if (window == nullptr) {
+        return false;
+    }
+
+    // 첫 프레임: 헤더가 맞고 바로 다음 프레임 헤더도 같은 형식인 위치
+    for (size_t pos = 0; pos + 4 <= windowLength; pos++) {
+        if (window[pos] != 0xFF) {
+            continue;
+        }
+        if (pos + 7 <= windowLength && isAdtsHeader(window + pos)) {
+            size_t next = pos + adtsFrameLength(window + pos);
+            if (next + 7 > windowLength || isAdtsHeader(window + next)) {
+                return parseAdts(window, windowLength, pos, audioEnd - audioStart - pos, info);
+            }
+            continue;
+        }
+
+        MpegHeader header;
+        if (!parseMpegHeader(window + pos, header)) {
+            continue;
+        }
+        size_t next = pos + header.frameSize;
+        MpegHeader nextHeader;
+        if (next + 4 <= windowLength &&
+            (!parseMpegHeader(window + next, nextHeader) || nextHeader.sampleRate != header.sampleRate ||
+             nextHeader.layer != header.layer)) {
+            continue;
+        }
+
+        info.sampleRate = header.sampleRate;
+        info.channels = header.channels;
+        info.bitDepth = 16;
+        info.format = header.layer == 3 ? "MP3" : "MP2";
+
+        // VBR 헤더의 프레임 수 (Xing/Info는 사이드 정보 뒤, VBRI는 32바이트 뒤)
+        uint64_t frameCount = 0;
+        size_t sideInfo = header.mpeg1 ? (header.channels == 1 ? 17 : 32) : (header.channels == 1 ? 9 : 17);
+        size_t xing = pos + 4 + sideInfo;
+        size_t vbri = pos + 4 + 32;
+        if (xing + 12 <= windowLength &&
+            (memcmp(window + xing, "Xing", 4) == 0 || memcmp(window + xing, "Info", 4) == 0) &&
+            (be32(window + xing + 4) & 0x1) != 0) {
+            frameCount = be32(window + xing + 8);
+        } else if (vbri + 18 <= windowLength && memcmp(window + vbri, "VBRI", 4) == 0) {
+            frameCount = be32(window + vbri + 14);
+        }
+
+        if (frameCount > 0) {
+            info.durationMs = samplesToMs(frameCount * header.samplesPerFrame, header.sampleRate);
+        } else if (header.bitrate > 0) {
+            // 고정 비트레이트
+            uint64_t audioBytes = audioEnd - audioStart - pos;
+            info.durationMs = static_cast<long long>(audioBytes * 8000 / header.bitrate);
+        }
+        return true;
+    }
+    return false;
+}
+
+// ---- Ogg ----
+
+bool parseOgg(FileSource& source, ParsedTags& tags, StreamInfo& info) {
+    const uint8_t* head = source.headData();
+    size_t headLength = source.headSize();
+
+    // 첫 논리 스트림의 식별 헤더와 주석 헤더 패킷 복원 (페이지 경계를 넘는 패킷 포함)
+    std::vector<std::vector<uint8_t>> packets;
+    std::vector<uint8_t> current;
+    uint32_t serial = 0;
+    bool serialKnown = false;
+    size_t pos = 0;
+    while (pos + 27 <= headLength && packets.size() < 2) {
+        const uint8_t* page = head + pos;
+        if (memcmp(page, "OggS", 4) != 0) {
+            break;
+        }
+        int segmentCount = page[26];
+        if (pos + 27 + segmentCount > headLength) {
+            break;
+        }
+        const uint8_t* lacing = page + 27;
+        size_t dataPos = pos + 27 + segmentCount;
+        size_t pageDataLength = 0;
+        for (int i = 0; i < segmentCount; i++) {
+            pageDataLength += lacing[i];
+        }
+
+        uint32_t pageSerial = le32(page + 14);
+        if (!serialKnown) {
+            serial = pageSerial;
+            serialKnown = true;
+        }
+        if (pageSerial == serial) {
+            size_t segmentPos = dataPos;
+            for (int i = 0; i < segmentCount && packets.size() < 2; i++) {
+                size_t available = segmentPos < headLength ? std::min<size_t>(lacing[i], headLength - segmentPos) : 0;
+                current.insert(current.end(), head + segmentPos, head + segmentPos + available);
+                segmentPos += lacing[i];
+                if (lacing[i] < 255) {
+                    packets.push_back(std::move(current));
+                    current.clear();
+                }
+            }
+        }
+        pos = dataPos + pageDataLength;
+    }
+    // 앞부분 64KB를 넘는 주석 패킷(큰 커버 이미지 등)은 읽은 데까지만 파싱
+    if (packets.size() == 1 && !current.empty()) {
+        packets.push_back(std::move(current));
+    }
+    if (packets.empty()) {
+        return false;
+    }
+
+    const std::vector<uint8_t>& id = packets[0];
+    uint64_t preSkip = 0;
+    uint32_t granuleRate = 0;
+    size_t commentOffset = 0;
+    const char* commentMagic = nullptr;
+    if (id.size() >= 30 && memcmp(id.data(), "\x01vorbis", 7) == 0) {
+        info.channels = id[11];
+        info.sampleRate = le32(id.data() + 12);
+        info.bitDepth = 16;
+        info.format = "OGG";
+        granuleRate = info.sampleRate;
+        commentMagic = "\x03vorbis";
+        commentOffset = 7;
+    } else if (id.size() >= 19 && memcmp(id.data(), "OpusHead", 8) == 0) {
+        info.channels = id[9];
+        preSkip = le16(id.data() + 10);
+        uint32_t inputRate = le32(id.data() + 12);
+        // Opus는 항상 48kHz로 디코딩 (원본 레이트는 참고용)
+        info.sampleRate = inputRate != 0 ? inputRate : 48000;
+        info.bitDepth = 16;
+        info.format = "OPUS";
+        granuleRate = 48000;
+        commentMagic = "OpusTags";
+        commentOffset = 8;
+    } else if (id.size() >= 51 && memcmp(id.data(), "\x7F" "FLAC", 5) == 0 && memcmp(id.data() + 9, "fLaC", 4) == 0) {
+        parseFlacStreamInfo(id.data() + 17, info);
+        info.format = "FLAC";
+        granuleRate = info.sampleRate;
+        commentOffset = 4; // 메타데이터 블록 헤더
+    } else {
+        return false;
+    }
+
+    if (packets.size() >= 2) {
+        const std::vector<uint8_t>& comment = packets[1];
+        bool matches = commentMagic == nullptr || (comment.size() >= commentOffset &&
+                                                   memcmp(comment.data(), commentMagic, commentOffset) == 0);
+        if (matches && comment.size() > commentOffset) {
+            parseVorbisComment(comment.data() + commentOffset, comment.size() - commentOffset, tags);
+        }
+    }
+
+    // 재생 시간: 끝부분에서 같은 스트림의 마지막 페이지 granule position
+    uint64_t size = source.getSize();
+    size_t tailLength = static_cast<size_t>(std::min<uint64_t>(kTailSize, size));
+    std::vector<uint8_t> scratch;
+    const uint8_t* tail = source.view(size - tailLength, tailLength, scratch);
+    if (tail != nullptr && granuleRate > 0 && tailLength >= 27) {
+        for (size_t i = tailLength - 27 + 1; i-- > 0;) {
+            if (memcmp(tail + i, "OggS", 4) != 0 || le32(tail + i + 14) != serial) {
+                continue;
+            }
+            uint64_t granule = le64(tail + i + 6);
+            if (granule != UINT64_MAX) {
+                info.durationMs = samplesToMs(granule > preSkip ? granule - preSkip : 0, granuleRate);
+                break;
+            }
+        }
+    }
+    return info.sampleRate > 0;
+}
+
+// ---- MP4 ----
+
+// [p, p + length) 안의 자식 atom들을 순서대로 방문
+template <typename Visitor>
+void forEachAtom(const uint8_t* p, size_t length, Visitor visit) {
+    size_t pos = 0;
+    while (pos + 8 <= length) {
+        uint64_t atomSize = be32(p + pos);
+        size_t headerLength = 8;
+        if (atomSize == 1) {
+            if (pos + 16 > length) {
+                break;
+            }
+            atomSize = be64(p + pos + 8);
+            headerLength = 16;
+        } else if (atomSize == 0) {
+            atomSize = length - pos;
+        }
+        if (atomSize < headerLength || atomSize > length - pos) {
+            break;
+        }
+        visit(p + pos + 4, p + pos + headerLength, static_cast<size_t>(atomSize - headerLength));
+        pos += static_cast<size_t>(atomSize);
+    }
+}
+
+bool atomIs(const uint8_t* type, const char* name) {
+    return memcmp(type, name, 4) == 0;
+}
+
+struct Mp4Track {
+    bool sound = false;
+    uint32_t timescale = 0;
+    uint64_t duration = 0;
+    char codec[4] = {};
+    int channels = 0;
+    int sampleSize = 0;
+    uint32_t entrySampleRate = 0;
+    StreamInfo config;      // alac/dfLa 설정에서 읽은 값
+};
+
+void parseMp4SampleEntry(const uint8_t* entry, size_t length, Mp4Track& track) {
+    if (length < 28) {
+        return;
+    }
+    memcpy(track.codec, entry - 4, 4);
+    track.channels = be16(entry + 16);
+    track.sampleSize = be16(entry + 18);
+    track.entrySampleRate = be32(entry + 24) >> 16;
+
+    // QuickTime 사운드 설명 버전 1/2는 기본 항목 뒤에 필드가 더 붙음
+    uint16_t version = be16(entry + 8);
+    size_t childOffset = 28 + (version == 1 ? 16 : version == 2 ? 36 : 0);
+    if (childOffset > length) {
+        return;
+    }
+    forEachAtom(entry + childOffset, length - childOffset, [&](const uint8_t* type, const uint8_t* data, size_t size) {
+        if (atomIs(type, "alac") && size >= 28) {
+            // ALACSpecificConfig (풀 박스 헤더 4바이트 뒤)
+            track.config.bitDepth = data[4 + 5];
+            track.config.channels = data[4 + 9];
+            track.config.sampleRate = be32(data + 4 + 20);
+        } else if (atomIs(type, "dfLa") && size >= 8 + 34) {
+            parseFlacStreamInfo(data + 8, track.config);
+        }
+    });
+}
+
+void parseMp4Trak(const uint8_t* p, size_t length, Mp4Track& track) {
+    forEachAtom(p, length, [&](const uint8_t* type, const uint8_t* data, size_t size) {
+        if (!atomIs(type, "mdia")) {
+            return;
+        }
+        forEachAtom(data, size, [&](const uint8_t* mdiaType, const uint8_t* mdiaData, size_t mdiaSize) {
+            if (atomIs(mdiaType, "hdlr") && mdiaSize >= 12) {
+                track.sound = atomIs(mdiaData + 8, "soun");
+            } else if (atomIs(mdiaType, "mdhd") && mdiaSize >= 20) {
+                if (mdiaData[0] == 1 && mdiaSize >= 32) {
+                    track.timescale = be32(mdiaData + 20);
+                    track.duration = be64(mdiaData + 24);
+                } else {
+                    track.timescale = be32(mdiaData + 12);
+                    track.duration = be32(mdiaData + 16);
+                }
+            } else if (atomIs(mdiaType, "minf")) {
+                forEachAtom(mdiaData, mdiaSize, [&](const uint8_t* minfType, const uint8_t* minfData, size_t minfSize) {
+                    if (!atomIs(minfType, "stbl")) {
+                        return;
+                    }
+                    forEachAtom(minfData, minfSize, [&](const uint8_t* stblType, const uint8_t* stblData, size_t stblSize) {
+                        if (!atomIs(stblType, "stsd") || stblSize < 16) {
+                            return;
+                        }
+                        // 풀 박스 헤더 + 항목 수 뒤의 첫 번째 샘플 항목
+                        uint32_t entrySize = be32(stblData + 8);
+                        if (entrySize >= 8 && entrySize <= stblSize - 8) {
+                            parseMp4SampleEntry(stblData + 16, entrySize - 8, track);
+                        }
+                    });
+                });
+            }
+        });
+    });
+}
+
+void parseMp4Ilst(const uint8_t* p, size_t length, ParsedTags& tags) {
+    forEachAtom(p, length, [&](const uint8_t* type, const uint8_t* data, size_t size) {
+        // 각 항목의 값은 자식 'data' atom (형식 4바이트 + 로캘 4바이트 뒤)
+        if (atomIs(type, "covr") && tags.picture != nullptr) {
+            // 'data' 여러 개면 첫 번째를 앞표지로 봄
+            forEachAtom(data, size, [&](const uint8_t* childType, const uint8_t* childData, size_t childSize) {
+                if (atomIs(childType, "data") && childSize > 8) {
+                    tags.offerPicture(3, childData + 8, childSize - 8);
+                }
+            });
+            return;
+        }
+        const uint8_t* value = nullptr;
+        size_t valueLength = 0;
+        forEachAtom(data, size, [&](const uint8_t* childType, const uint8_t* childData, size_t childSize) {
+            if (value == nullptr && atomIs(childType, "data") && childSize >= 8) {
+                value = childData + 8;
+                valueLength = childSize - 8;
+            }
+        });
+        if (value == nullptr || valueLength == 0) {
+            return;
+        }
+
+        static const struct { const char* type; Field field; } kItems[] = {
+            {"\xA9nam", kTitle}, {"\xA9" "ART", kArtist}, {"\xA9" "alb", kAlbum}, {"\xA9gen", kGenre},
+            {"\xA9" "day", kYear}, {"\xA9wrt", kComposer},
+        };
+        for (const auto& item : kItems) {
+            if (atomIs(type, item.type)) {
+                tags.set(item.field, utf8OrLatin1(value, std::min(valueLength, kMaxTextSize)));
+                return;
+            }
+        }
+        if (atomIs(type, "trkn") && valueLength >= 4) {
+            uint16_t trackNumber = be16(value + 2);
+            if (trackNumber > 0) {
+                tags.set(kTrack, std::to_string(trackNumber));
+            }
+        } else if (atomIs(type, "gnre") && valueLength >= 2) {
+            const char* genre = id3GenreName(be16(value) - 1);
+            if (genre != nullptr) {
+                tags.set(kGenre, genre);
+            }
+        }
+    });
+}
+
+void parseMp4Meta(const uint8_t* p, size_t length, ParsedTags& tags) {
+    // ISO 'meta'는 풀 박스(버전/플래그 4바이트)지만 QuickTime 방식은 바로 자식 atom이 시작됨
+    size_t offset = (length >= 8 && atomIs(p + 4, "hdlr")) ? 0 : 4;
+    if (offset > length) {
+        return;
+    }
+    forEachAtom(p + offset, length - offset, [&](const uint8_t* type, const uint8_t* data, size_t size) {
+        if (atomIs(type, "ilst")) {
+            parseMp4Ilst(data, size, tags);
+        }
+    });
+}
+
+void parseMp4Moov(const uint8_t* p, size_t length, ParsedTags& tags, StreamInfo& info) {
+    long long movieDurationMs = 0;
+    Mp4Track sound;
+    forEachAtom(p, length, [&](const uint8_t* type, const uint8_t* data, size_t size) {
+        if (atomIs(type, "mvhd") && size >= 20) {
+            uint32_t timescale;
+            uint64_t duration;
+            if (data[0] == 1 && size >= 32) {
+                timescale = be32(data + 20);
+                duration = be64(data + 24);
+            } else {
+                timescale = be32(data + 12);
+                duration = be32(data + 16);
+            }
+            movieDurationMs = samplesToMs(duration, timescale);
+        } else if (atomIs(type, "trak") && !sound.sound) {
+            Mp4Track track;
+            parseMp4Trak(data, size, track);
+            if (track.sound) {
+                sound = track;
+            }
+        } else if (atomIs(type, "udta")) {
+            forEachAtom(data, size, [&](const uint8_t* udtaType, const uint8_t* udtaData, size_t udtaSize) {
+                if (atomIs(udtaType, "meta")) {
+                    parseMp4Meta(udtaData, udtaSize, tags);
+                }
+            });
+        } else if (atomIs(type, "meta")) {
+            parseMp4Meta(data, size, tags);
+        }
+    });
+
+    if (!sound.sound) {
+        return;
+    }
+    if (atomIs(reinterpret_cast<const uint8_t*>(sound.codec), "alac")) {
+        info.format = "ALAC";
+    } else if (atomIs(reinterpret_cast<const uint8_t*>(sound.codec), "fLaC")) {
+        info.format = "FLAC";
+    } else if (atomIs(reinterpret_cast<const uint8_t*>(sound.codec), "Opus")) {
+        info.format = "OPUS";
+    } else {
+        info.format = "AAC";
+    }
+
+    if (sound.config.sampleRate > 0) {
+        // 무손실 코덱 설정의 실제 값
+        info.sampleRate = sound.config.sampleRate;
+        info.bitDepth = sound.config.bitDepth;
+        info.channels = sound.config.channels;
+    } else {
+        // 16.16 고정소수점 샘플 항목은 65535Hz를 넘지 못하므로 오디오 트랙 timescale을 우선
+        info.sampleRate = (sound.timescale >= 8000 && sound.timescale <= 768000) ? sound.timescale
+                                                                                 : sound.entrySampleRate;
+        info.bitDepth = sound.sampleSize > 0 ? sound.sampleSize : 16;
+        info.channels = sound.channels;
+    }
+    info.durationMs = sound.timescale > 0 ? samplesToMs(sound.duration, sound.timescale) : movieDurationMs;
+}
+
+bool parseMp4(FileSource& source, ParsedTags& tags, StreamInfo& info) {
+    // 최상위 atom 헤더만 따라가 moov를 찾음 (moov가 mdat 뒤에 있어도 pread 두 번)
+    std::vector<uint8_t> scratch;
+    uint64_t size = source.getSize();
+    uint64_t pos = 0;
+    for (int i = 0; i < 64 && pos + 8 <= size; i++) {
+        const uint8_t* header = source.view(pos, static_cast<size_t>(std::min<uint64_t>(16, size - pos)), scratch);
+        if (header == nullptr) {
+            return false;
+        }
+        uint64_t atomSize = be32(header);
+        uint64_t headerLength = 8;
+        if (atomSize == 1) {
+            if (size - pos < 16) {
+                return false;
+            }
+            atomSize = be64(header + 8);
+            headerLength = 16;
+        } else if (atomSize == 0) {
+            atomSize = size - pos;
+        }
+        if (atomSize < headerLength || atomSize > size - pos) {
+            return false;
+        }
+
+        if (atomIs(header + 4, "moov")) {
+            size_t moovLength = static_cast<size_t>(std::min<uint64_t>(atomSize - headerLength, kMaxBlockSize));
+            const uint8_t* moov = source.view(pos + headerLength, moovLength, scratch);
+            if (moov == nullptr) {
+                return false;
+            }
+            parseMp4Moov(moov, moovLength, tags, info);
+            return info.sampleRate > 0;
+        }
+        pos += atomSize;
+    }
+    return false;
+}
+
+// ---- DSF ----
+
+bool parseDsf(FileSource& source, ParsedTags& tags, StreamInfo& info) {
+    std::vector<uint8_t> scratch;
+    const uint8_t* header = source.view(0, 28 + 52, scratch);
+    if (header == nullptr || memcmp(header + 28, "fmt ", 4) != 0) {
+        return false;
+    }
+    uint64_t metadataPointer = le64(header + 20);
+    const uint8_t* fmt = header + 28;
+    info.channels = static_cast<int>(le32(fmt + 24));
+    info.sampleRate = le32(fmt + 28);
+    info.bitDepth = 1;
+    info.format = "DSD";
+    info.durationMs = samplesToMs(le64(fmt + 36), info.sampleRate);
+
+    // 메타데이터 청크는 파일 끝의 ID3v2 태그
+    if (metadataPointer != 0) {
+        parseId3v2(source, metadataPointer, tags);
+    }
+    return info.sampleRate > 0;
+}
+
+// ---- DFF (DSDIFF) ----
+
+std::string readDffText(const uint8_t* p, size_t length) {
+    if (length < 4) {
+        return std::string();
+    }
+    uint32_t count = be32(p);
+    return utf8OrLatin1(p + 4, std::min<size_t>(count, length - 4));
+}
+
+bool parseDff(FileSource& source, ParsedTags& tags, StreamInfo& info) {
+    std::vector<uint8_t> scratch;
+    uint64_t size = source.getSize();
+    uint64_t soundBytes = 0;
+    uint32_t dstFrames = 0;
+    uint16_t dstFrameRate = 0;
+    uint64_t pos = 16;
+    for (int i = 0; i < 64 && pos + 12 <= size; i++) {
+        const uint8_t* header = source.view(pos, 12, scratch);
+        if (header == nullptr) {
+            break;
+        }
+        char id[4];
+        memcpy(id, header, 4);
+        uint64_t chunkSize = be64(header + 4);
+        uint64_t dataPos = pos + 12;
+        if (chunkSize > size - dataPos) {
+            chunkSize = size - dataPos;
+        }
+        size_t readable = static_cast<size_t>(std::min<uint64_t>(chunkSize, kMaxTextSize));
+
+        if (memcmp(id, "PROP", 4) == 0) {
+            const uint8_t* prop = source.view(dataPos, readable, scratch);
+            if (prop != nullptr && readable >= 4 && memcmp(prop, "SND ", 4) == 0) {
+                size_t sub = 4;
+                while (sub + 12 <= readable) {
+                    uint64_t subSize = be64(prop + sub + 4);
+                    const uint8_t* subData = prop + sub + 12;
+                    if (subSize > readable - sub - 12) {
+                        break;
+                    }
+                    if (memcmp(prop + sub, "FS  ", 4) == 0 && subSize >= 4) {
+                        info.sampleRate = be32(subData);
+                    } else if (memcmp(prop + sub, "CHNL", 4) == 0 && subSize >= 2) {
+                        info.channels = be16(subData);
+                    }
+                    sub += 12 + static_cast<size_t>(subSize) + (subSize & 1);
+                }
+            }
+        } else if (memcmp(id, "DSD ", 4) == 0) {
+            soundBytes = chunkSize;
+        } else if (memcmp(id, "DST ", 4) == 0) {
+            const uint8_t* dst = source.view(dataPos, std::min<size_t>(readable, 18), scratch);
+            if (dst != nullptr && readable >= 18 && memcmp(dst, "FRTE", 4) == 0) {
+                dstFrames = be32(dst + 12);
+                dstFrameRate = be16(dst + 16);
+            }
+        } else if (memcmp(id, "DIIN", 4) == 0) {
+            const uint8_t* diin = source.view(dataPos, readable, scratch);
+            size_t sub = 0;
+            while (diin != nullptr && sub + 12 <= readable) {
+                uint64_t subSize = be64(diin + sub + 4);
+                if (subSize > readable - sub - 12) {
+                    break;
+                }
+                if (memcmp(diin + sub, "DITI", 4) == 0) {
+                    tags.set(kTitle, readDffText(diin + sub + 12, static_cast<size_t>(subSize)));
+                } else if (memcmp(diin + sub, "DIAR", 4) == 0) {
+                    tags.set(kArtist, readDffText(diin + sub + 12, static_cast<size_t>(subSize)));
+                }
+                sub += 12 + static_cast<size_t>(subSize) + (subSize & 1);
+            }
+        } else if (memcmp(id, "ID3 ", 4) == 0) {
+            parseId3v2(source, dataPos, tags);
+        }
+
+        pos = dataPos + chunkSize + (chunkSize & 1);
+    }
+
+    info.bitDepth = 1;
+    info.format = "DSD";
+    if (dstFrames > 0 && dstFrameRate > 0) {
+        info.durationMs = static_cast<long long>(dstFrames) * 1000 / dstFrameRate;
+    } else if (soundBytes > 0 && info.channels > 0) {
+        info.durationMs = samplesToMs(soundBytes * 8 / info.channels, info.sampleRate);
+    }
+    return info.sampleRate > 0;
+}
+
+// ---- WAV ----
+
+void parseRiffInfo(const uint8_t* p, size_t length, ParsedTags& tags) {
+    static const struct { const char* id; Field field; } kInfo[] = {
+        {"INAM", kTitle}, {"IART", kArtist}, {"IPRD", kAlbum}, {"IGNR", kGenre},
+        {"ICRD", kYear}, {"ITRK", kTrack}, {"IPRT", kTrack}, {"IMUS", kComposer},
+    };
+    size_t pos = 4; // "INFO"
+    while (pos + 8 <= length) {
+        uint32_t subSize = le32(p + pos + 4);
+        if (subSize > length - pos - 8) {
+            break;
+        }
+        for (const auto& entry : kInfo) {
+            if (memcmp(p + pos, entry.id, 4) == 0) {
+                tags.set(entry.field, utf8OrLatin1(p + pos + 8, subSize));
+                break;
+            }
+        }
+        pos += 8 + subSize + (subSize & 1);
+    }
+}
+
+bool parseWav(FileSource& source, ParsedTags& tags, StreamInfo& info) {
+    std::vector<uint8_t> scratch;
+    uint64_t size = source.getSize();
+    uint64_t dataSize64 = 0;       // RF64 ds64 청크의 실제 data 크기
+    uint64_t dataSize = 0;
+    uint32_t blockAlign = 0;
+    uint64_t pos = 12;
+    for (int i = 0; i < 64 && pos + 8 <= size; i++) {
+        const uint8_t* header = source.view(pos, 8, scratch);
+        if (header == nullptr) {
+            break;
+        }
+        char id[4];
+        memcpy(id, header, 4);
+        uint64_t chunkSize = le32(header + 4);
+        uint64_t dataPos = pos + 8;
+
+        if (memcmp(id, "ds64", 4) == 0 && chunkSize >= 16) {
+            const uint8_t* ds64 = source.view(dataPos, 16, scratch);
+            if (ds64 != nullptr) {
+                dataSize64 = le64(ds64 + 8);
+            }
+        } else if (memcmp(id, "fmt ", 4) == 0 && chunkSize >= 16) {
+            const uint8_t* fmt = source.view(dataPos, static_cast<size_t>(std::min<uint64_t>(chunkSize, 40)), scratch);
+            if (fmt != nullptr) {
+                info.channels = le16(fmt + 2);
+                info.sampleRate = le32(fmt + 4);
+                blockAlign = le16(fmt + 12);
+                info.bitDepth = le16(fmt + 14);
+                // WAVE_FORMAT_EXTENSIBLE의 유효 비트 수
+                if (le16(fmt) == 0xFFFE && chunkSize >= 20 && le16(fmt + 18) > 0) {
+                    info.bitDepth = le16(fmt + 18);
+                }
+            }
+        } else if (memcmp(id, "data", 4) == 0) {
+            dataSize = (chunkSize == 0xFFFFFFFFu && dataSize64 > 0) ? dataSize64 : chunkSize;
+            chunkSize = dataSize;
+        } else if (memcmp(id, "LIST", 4) == 0 && chunkSize >= 4 && chunkSize <= kMaxTextSize) {
+            const uint8_t* list = source.view(dataPos, static_cast<size_t>(chunkSize), scratch);
+            if (list != nullptr && memcmp(list, "INFO", 4) == 0) {
+                parseRiffInfo(list, static_cast<size_t>(chunkSize), tags);
+            }
+        } else if (memcmp(id, "id3 ", 4) == 0 || memcmp(id, "ID3 ", 4) == 0) {
+            parseId3v2(source, dataPos, tags);
+        }
+
+        if (chunkSize > size - dataPos) {
+            break;
+        }
+        pos = dataPos + chunkSize + (chunkSize & 1);
+    }
+
+    info.format = "WAV";
+    if (blockAlign > 0 && info.sampleRate > 0) {
+        info.durationMs = samplesToMs(std::min(dataSize, size) / blockAlign, info.sampleRate);
+    }
+    return info.sampleRate > 0;
+}
+
+// ---- 결과 적용 ----
+
+int parseLeadingNumber(const std::string& value) {
+    size_t pos = 0;
+    while (pos < value.size() && (value[pos] < '0' || value[pos] > '9')) {
+        pos++;
+    }
+    return pos < value.size() ? atoi(value.c_str() + pos) : 0;
+}
+
+int parseYear(const std::string& value) {
+    // "2019", "2019-05-01", "05/01/2019" 등에서 처음 나오는 네 자리 숫자
+    for (size_t i = 0; i + 4 <= value.size(); i++) {
+        bool digits = true;
+        for (size_t k = 0; k < 4; k++) {
+            if (value[i + k] < '0' || value[i + k] > '9') {
+                digits = false;
+                break;
+            }
+        }
+        if (digits) {
+            return atoi(value.substr(i, 4).c_str());
+        }
+    }
+    return 0;
+}
+
+} // namespace
+
+bool TagParser::parse(const std::string& filePath, TrackMetadata& metadata, EmbeddedPicture* picture) {
+    int fd = open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        LOGE("Cannot open %s: %s", filePath.c_str(), strerror(errno));
+        return false;
+    }
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0) {
+        close(fd);
+        return false;
+    }
+
+    FileSource source(fd, static_cast<uint64_t>(fileStat.st_size));
+    ParsedTags tags;
+    tags.picture = picture;
+    StreamInfo info;
+    bool recognized = false;
+    if (source.loadHead() && source.headSize() >= 12) {
+        const uint8_t* head = source.headData();
+        if (memcmp(head, "fLaC", 4) == 0) {
+            recognized = parseFlac(source, 0, tags, info);
+        } else if (memcmp(head, "OggS", 4) == 0) {
+            recognized = parseOgg(source, tags, info);
+        } else if (memcmp(head + 4, "ftyp", 4) == 0) {
+            recognized = parseMp4(source, tags, info);
+        } else if (memcmp(head, "DSD ", 4) == 0) {
+            recognized = parseDsf(source, tags, info);
+        } else if (memcmp(head, "FRM8", 4) == 0 && memcmp(head + 12, "DSD ", 4) == 0) {
+            recognized = parseDff(source, tags, info);
+        } else if ((memcmp(head, "RIFF", 4) == 0 || memcmp(head, "RF64", 4) == 0 || memcmp(head, "BW64", 4) == 0) &&
+                   memcmp(head + 8, "WAVE", 4) == 0) {
+            recognized = parseWav(source, tags, info);
+        } else {
+            // ID3v2로 시작하거나 바로 프레임 동기 패턴이 나오는 MP3/ADTS (ID3가 붙은 FLAC 포함)
+            recognized = parseMpegAudio(source, tags, info);
+        }
+    }
+    close(fd);
+
+    if (!tags.values[kTitle].empty()) metadata.title = tags.values[kTitle];
+    if (!tags.values[kArtist].empty()) metadata.artist = tags.values[kArtist];
+    if (!tags.values[kAlbum].empty()) metadata.albumTitle = tags.values[kAlbum];
+    if (!tags.values[kGenre].empty()) metadata.genre = tags.values[kGenre];
+    if (!tags.values[kComposer].empty()) metadata.composer = tags.values[kComposer];
+    if (int year = parseYear(tags.values[kYear])) metadata.year = year;
+    if (int track = parseLeadingNumber(tags.values[kTrack])) metadata.trackNumber = track;
+
+    if (!recognized || info.sampleRate == 0) {
+        return false;
+    }
+    metadata.audioQuality.sampleRate = static_cast<int>(info.sampleRate);
+    if (info.bitDepth > 0) metadata.audioQuality.bitDepth = info.bitDepth;
+    if (info.channels > 0) metadata.audioQuality.channels = info.channels;
+    if (info.format != nullptr) metadata.audioQuality.format = tags.mqa ? "MQA" : info.format;
+    if (info.durationMs > 0) metadata.duration = static_cast<long>(info.durationMs);
+    return true;
+}
+
+} // namespace pancakemusicbox
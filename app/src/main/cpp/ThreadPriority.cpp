@@ -0,0 +1,116 @@
+#include "include/ThreadPriority.h"
+#include <android/log.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#define LOG_TAG "ThreadPriority"
+#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+namespace {
+
+constexpr int kRealtimePriority = 2;    // AAudio 콜백 스레드와 같은 낮은 SCHED_FIFO 우선순위
+constexpr int kAudioNice = -16;         // ANDROID_PRIORITY_AUDIO
+
+long readMaxFrequency(int cpu) {
+    char path[96];
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cpufreq/cpuinfo_max_freq", cpu);
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        return -1;
+    }
+    long frequency = -1;
+    if (fscanf(file, "%ld", &frequency) != 1) {
+        frequency = -1;
+    }
+    fclose(file);
+    return frequency;
+}
+
+} // namespace
+
+bool ThreadPriority::promoteToAudio() {
+    sched_param param{};
+    param.sched_priority = kRealtimePriority;
+    int error = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    if (error == 0) {
+        LOGI("Render thread running with SCHED_FIFO priority %d", kRealtimePriority);
+        return true;
+    }
+
+    // 일반 앱은 보통 SCHED_FIFO 권한이 없으므로 CFS에서 가장 높은 오디오 우선순위 사용
+    pid_t tid = static_cast<pid_t>(syscall(SYS_gettid));
+    if (setpriority(PRIO_PROCESS, tid, kAudioNice) != 0) {
+        LOGE("Failed to raise render thread priority: %s", strerror(errno));
+    } else {
+        LOGI("SCHED_FIFO not permitted (%s), using nice %d", strerror(error), kAudioNice);
+    }
+    return false;
+}
+
+bool ThreadPriority::isRealtime() {
+    int policy = 0;
+    sched_param param{};
+    if (pthread_getschedparam(pthread_self(), &policy, &param) != 0) {
+        return false;
+    }
+    return policy == SCHED_FIFO || policy == SCHED_RR;
+}
+
+std::vector<int> ThreadPriority::findBigCores() {
+    long cpuCount = sysconf(_SC_NPROCESSORS_CONF);
+    std::vector<long> frequencies;
+    long highest = -1;
+    long lowest = -1;
+    for (int cpu = 0; cpu < cpuCount && cpu < CPU_SETSIZE; cpu++) {
+        long frequency = readMaxFrequency(cpu);
+        frequencies.push_back(frequency);
+        if (frequency > highest) {
+            highest = frequency;
+        }
+        if (frequency > 0 && (lowest < 0 || frequency < lowest)) {
+            lowest = frequency;
+        }
+    }
+
+    std::vector<int> cores;
+    if (highest <= 0) {
+        return cores;
+    }
+    // 가장 느린(리틀) 클러스터만 빼고 모두 선택 (1+3+4 구성에서 프라임 코어 하나에만 묶여 UI 스레드와 경쟁하지 않게)
+    // 모든 코어의 클럭이 같으면 한 클러스터이므로 전부 반환
+    long threshold = highest > lowest ? lowest : lowest - 1;
+    for (int cpu = 0; cpu < static_cast<int>(frequencies.size()); cpu++) {
+        if (frequencies[cpu] > threshold) {
+            cores.push_back(cpu);
+        }
+    }
+    return cores;
+}
+
+bool ThreadPriority::pinToBigCores() {
+    std::vector<int> cores = findBigCores();
+    long cpuCount = sysconf(_SC_NPROCESSORS_CONF);
+    if (cores.empty() || static_cast<long>(cores.size()) == cpuCount) {
+        // 클럭 정보를 읽을 수 없거나 모든 코어가 같은 클러스터면 스케줄러에 맡김
+        return false;
+    }
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cores) {
+        CPU_SET(cpu, &set);
+    }
+    if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+        LOGE("Failed to pin render thread to big cores: %s", strerror(errno));
+        return false;
+    }
+    LOGI("Render thread pinned to %zu big cores (first cpu %d)", cores.size(), cores.front());
+    return true;
+}
@@ -0,0 +1,508 @@
+#include "include/TimeStretcher.h"
+#include "include/DspKernels.h"
+#include <android/log.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define LOG_TAG "TimeStretcher"
+#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+namespace {
+
+constexpr float kWsolaHopSec = 0.012f;      // WSOLA 합성 홉 (세그먼트 길이 = 2 * 홉)
+constexpr float kWsolaSearchSec = 0.008f;   // 상관 탐색 범위 (±)
+constexpr int kCoarseSearchStep = 4;        // 1차 탐색 간격, 이후 ±(step - 1) 범위 정밀 탐색
+constexpr int kMaxInputChunkFrames = 4096;  // 엔진이 한 번에 공급하는 최대 프레임 수
+constexpr float kTwoPi = static_cast<float>(2.0 * M_PI);
+
+// Hann 분석/합성 창, 홉 = N/4일 때 창 제곱의 OLA 합은 1.5
+constexpr float kPhaseVocoderOlaScale = 1.0f / 1.5f;
+
+float wrapPhase(float phase) {
+    return phase - kTwoPi * std::round(phase / kTwoPi);
+}
+
+} // namespace
+
+void TimeStretcher::configure(int sampleRate, int channelCount) {
+    if (sampleRate == mSampleRate && channelCount == mChannelCount && !mInput.empty()) {
+        return;
+    }
+
+    mSampleRate = sampleRate;
+    mChannelCount = std::max(1, channelCount);
+
+    mWsolaHop = std::max(64, static_cast<int32_t>(sampleRate * kWsolaHopSec));
+    mWsolaSearch = std::max(32, static_cast<int32_t>(sampleRate * kWsolaSearchSec));
+    mFftSize = sampleRate > 48000 ? 4096 : 2048;
+    mPvHop = mFftSize / 4;
+
+    mInputCapacity = 4 * mFftSize + 4 * mWsolaSearch + 8 * mWsolaHop + 2 * kMaxInputChunkFrames;
+    mInput.assign(static_cast<size_t>(mInputCapacity) * mChannelCount, 0.0f);
+    mInputMono.assign(mInputCapacity, 0.0f);
+
+    int32_t outputCapacity = 2 * kMaxInputChunkFrames + 2 * std::max(mWsolaHop, mPvHop);
+    mOutput.assign(static_cast<size_t>(outputCapacity) * mChannelCount, 0.0f);
+
+    mPrevTail.assign(static_cast<size_t>(mWsolaHop) * mChannelCount, 0.0f);
+    mPrevTailMono.assign(mWsolaHop, 0.0f);
+    mFadeIn.resize(mWsolaHop);
+    for (int32_t i = 0; i < mWsolaHop; i++) {
+        mFadeIn[i] = 0.5f - 0.5f * std::cos(static_cast<float>(M_PI) * (i + 0.5f) / mWsolaHop);
+    }
+
+    mFft.resize(mFftSize);
+    mWindow.resize(mFftSize);
+    for (int32_t i = 0; i < mFftSize; i++) {
+        mWindow[i] = 0.5f - 0.5f * std::cos(kTwoPi * i / mFftSize);
+    }
+    mReal.assign(mFftSize, 0.0f);
+    mImag.assign(mFftSize, 0.0f);
+    size_t bins = static_cast<size_t>(mFftSize / 2 + 1) * mChannelCount;
+    mPrevPhase.assign(bins, 0.0f);
+    mSynthPhase.assign(bins, 0.0f);
+    mAccumulator.assign(static_cast<size_t>(mFftSize) * mChannelCount, 0.0f);
+
+    end();
+
+    LOGI("Time stretcher configured: %d Hz, %d ch, WSOLA hop %d search %d, FFT %d",
+         mSampleRate, mChannelCount, mWsolaHop, mWsolaSearch, mFftSize);
+}
+
+void TimeStretcher::setSpeed(float speed) {
+    speed = std::max(kMinSpeed, std::min(kMaxSpeed, speed));
+    if (speed != mSpeed) {
+        // 다음 홉부터 새 분석 홉이 적용되며, 부하 통계는 속도별로 다시 측정
+        mSpeed = speed;
+        mProcessNs = 0;
+        mProducedFrames = 0;
+    }
+}
+
+void TimeStretcher::setMode(TimeStretchMode mode) {
+    if (mode == mMode) {
+        return;
+    }
+    mMode = mode;
+    // 이미 출력 FIFO에 있는 프레임은 그대로 내보내고 다음 홉부터 새 알고리즘으로 처리
+    if (mActive) {
+        resetProcessing();
+    }
+}
+
+void TimeStretcher::begin(int64_t startFrame) {
+    mActive = true;
+    mInputBase = startFrame;
+    mInputFrames = 0;
+    mEndFrame = -1;
+    mOutputStart = 0;
+    mOutputFrames = 0;
+    mAnalysisPos = static_cast<double>(startFrame);
+    mProcessNs = 0;
+    mProducedFrames = 0;
+    resetProcessing();
+}
+
+void TimeStretcher::end() {
+    mActive = false;
+    mInputFrames = 0;
+    mOutputStart = 0;
+    mOutputFrames = 0;
+    mEndFrame = -1;
+    mPrimed = false;
+}
+
+bool TimeStretcher::canBypass() const {
+    if (!mActive || mSpeed != 1.0f || mEndFrame >= 0) {
+        return false;
+    }
+    if (mMode == TimeStretchMode::Speech) {
+        // WSOLA의 대기 구간(mPrevTail)은 원본 프레임 그대로이므로 그 시작점부터 직접 재생하면 끊김이 없음
+        return mOutputFrames == 0;
+    }
+    // 출력 FIFO에 남은 프레임이 모두 원본 그대로이면 그 첫 프레임부터 직접 재생해도 같은 소리
+    return mPassthrough && mOutputFrames <= mPassthroughFrames;
+}
+
+int64_t TimeStretcher::getSourcePosition() const {
+    int64_t position;
+    if (mPrimed && mMode == TimeStretchMode::Speech) {
+        position = mPrevSegment + mWsolaHop;
+    } else {
+        position = std::llround(mAnalysisPos);
+    }
+    // 출력 FIFO에 남은 프레임만큼 아직 들리지 않은 구간 보정
+    position -= static_cast<int64_t>(mOutputFrames * mSpeed);
+    if (mEndFrame >= 0) {
+        position = std::min(position, mEndFrame);
+    }
+    return std::max<int64_t>(0, position);
+}
+
+void TimeStretcher::writeInput(const float* input, int32_t numFrames) {
+    if (!mActive || mEndFrame >= 0 || numFrames <= 0) {
+        return;
+    }
+    appendInput(input, numFrames);
+}
+
+void TimeStretcher::endOfInput() {
+    if (!mActive || mEndFrame >= 0) {
+        return;
+    }
+    mEndFrame = getWrittenFrames();
+
+    // 마지막 홉들이 소스 끝 너머를 참조할 수 있도록 무음으로 채움
+    int32_t padding = 2 * mFftSize + mWsolaSearch + 2 * mWsolaHop;
+    compactInput();
+    if (mInputFrames + padding > mInputCapacity) {
+        mInputCapacity = mInputFrames + padding;
+        mInput.resize(static_cast<size_t>(mInputCapacity) * mChannelCount);
+        mInputMono.resize(mInputCapacity);
+    }
+    std::fill(mInput.begin() + static_cast<size_t>(mInputFrames) * mChannelCount,
+              mInput.begin() + static_cast<size_t>(mInputFrames + padding) * mChannelCount, 0.0f);
+    std::fill(mInputMono.begin() + mInputFrames, mInputMono.begin() + mInputFrames + padding, 0.0f);
+    mInputFrames += padding;
+}
+
+int32_t TimeStretcher::readOutput(float* output, int32_t numFrames) {
+    if (!mActive) {
+        return 0;
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+    bool processed = false;
+    int32_t produced = 0;
+
+    while (true) {
+        int32_t take = std::min(numFrames - produced, mOutputFrames);
+        if (take > 0) {
+            memcpy(output + static_cast<size_t>(produced) * mChannelCount,
+                   mOutput.data() + static_cast<size_t>(mOutputStart) * mChannelCount,
+                   static_cast<size_t>(take) * mChannelCount * sizeof(float));
+            produced += take;
+            mOutputStart += take;
+            mOutputFrames -= take;
+        }
+        if (mOutputFrames == 0) {
+            mOutputStart = 0;
+        }
+        if (produced >= numFrames || !processHop()) {
+            break;
+        }
+        processed = true;
+    }
+
+    // FIFO에서 바로 내보낸 프레임도 생성한 오디오 길이에 포함해야 부하가 과대평가되지 않음
+    if (processed) {
+        mProcessNs += std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - startTime).count();
+    }
+    mProducedFrames += produced;
+    return produced;
+}
+
+float TimeStretcher::getCpuLoad() const {
+    if (mProducedFrames == 0) {
+        return 0.0f;
+    }
+    double audioNs = static_cast<double>(mProducedFrames) * 1e9 / mSampleRate;
+    return static_cast<float>(mProcessNs / audioNs);
+}
+
+bool TimeStretcher::processHop() {
+    int32_t hop = mMode == TimeStretchMode::Speech ? mWsolaHop : mPvHop;
+
+    // 출력 FIFO 공간 확보
+    int32_t outputCapacity = static_cast<int32_t>(mOutput.size() / mChannelCount);
+    if (mOutputStart + mOutputFrames + hop > outputCapacity) {
+        memmove(mOutput.data(),
+                mOutput.data() + static_cast<size_t>(mOutputStart) * mChannelCount,
+                static_cast<size_t>(mOutputFrames) * mChannelCount * sizeof(float));
+        mOutputStart = 0;
+        if (mOutputFrames + hop > outputCapacity) {
+            mOutput.resize(static_cast<size_t>(mOutputFrames + hop) * mChannelCount);
+        }
+    }
+
+    if (mMode == TimeStretchMode::Speech) {
+        return processWsolaHop();
+    }
+    if (mPassthrough && mSpeed != 1.0f) {
+        // 직접 재생으로 넘어가기 전에 다시 속도가 바뀌면 위상 보코더를 새로 시작
+        resetProcessing();
+    }
+    if (mSpeed == 1.0f && !mPrimed) {
+        // 보코더 출력이 아직 없으면 섞을 것 없이 바로 원본 출력
+        mPassthrough = true;
+    }
+    return mPassthrough ? processPassthroughHop() : processPhaseVocoderHop();
+}
+
+bool TimeStretcher::processWsolaHop() {
+    const int32_t hop = mWsolaHop;
+    const int channels = mChannelCount;
+    int64_t nominal = std::llround(mAnalysisPos);
+
+    if (mEndFrame >= 0 && nominal >= mEndFrame + hop) {
+        return false;
+    }
+
+    if (!mPrimed) {
+        // 첫 세그먼트: 시작 위치의 원본을 이전 연속 구간으로 삼아 δ = 0에서 원본과 그대로 이어지게 함
+        if (getWrittenFrames() < nominal + hop) {
+            return false;
+        }
+        memcpy(mPrevTail.data(), inputAt(nominal), static_cast<size_t>(hop) * channels * sizeof(float));
+        memcpy(mPrevTailMono.data(), monoAt(nominal), static_cast<size_t>(hop) * sizeof(float));
+        mPrevSegment = nominal - hop;
+        mPrimed = true;
+    }
+
+    int64_t segment;
+    if (mSpeed == 1.0f) {
+        // 원속도에서는 이전 세그먼트의 자연스러운 연속 위치가 곧 최적 위치
+        segment = mPrevSegment + hop;
+        if (getWrittenFrames() < segment + 2 * hop) {
+            return false;
+        }
+        mAnalysisPos = static_cast<double>(segment);
+    } else {
+        if (getWrittenFrames() < nominal + mWsolaSearch + 2 * hop) {
+            return false;
+        }
+        segment = findBestSegment(nominal);
+    }
+
+    // 이전 연속 구간과 새 세그먼트 앞부분을 크로스페이드
+    const float* in = inputAt(segment);
+    float* out = mOutput.data() + static_cast<size_t>(mOutputStart + mOutputFrames) * channels;
+    for (int32_t i = 0; i < hop; i++) {
+        float fadeIn = mFadeIn[i];
+        float fadeOut = 1.0f - fadeIn;
+        for (int ch = 0; ch < channels; ch++) {
+            size_t index = static_cast<size_t>(i) * channels + ch;
+            out[index] = mPrevTail[index] * fadeOut + in[index] * fadeIn;
+        }
+    }
+    mOutputFrames += hop;
+
+    // 새 세그먼트의 뒷부분이 다음 홉의 연속 구간
+    memcpy(mPrevTail.data(), inputAt(segment + hop), static_cast<size_t>(hop) * channels * sizeof(float));
+    memcpy(mPrevTailMono.data(), monoAt(segment + hop), static_cast<size_t>(hop) * sizeof(float));
+    mPrevSegment = segment;
+    mAnalysisPos += hop * mSpeed;
+    return true;
+}
+
+int64_t TimeStretcher::findBestSegment(int64_t nominal) const {
+    int64_t low = std::max(nominal - mWsolaSearch, mInputBase);
+    int64_t high = nominal + mWsolaSearch;
+
+    // 1차: 간격을 두고 탐색
+    int64_t best = std::max(low, std::min(high, nominal));
+    float bestScore = scoreSegment(best);
+    for (int64_t candidate = low; candidate <= high; candidate += kCoarseSearchStep) {
+        float score = scoreSegment(candidate);
+        if (score > bestScore) {
+            bestScore = score;
+            best = candidate;
+        }
+    }
+
+    // 2차: 최적 후보 주변 정밀 탐색
+    int64_t fineLow = std::max(low, best - (kCoarseSearchStep - 1));
+    int64_t fineHigh = std::min(high, best + (kCoarseSearchStep - 1));
+    for (int64_t candidate = fineLow; candidate <= fineHigh; candidate++) {
+        float score = scoreSegment(candidate);
+        if (score > bestScore) {
+            bestScore = score;
+            best = candidate;
+        }
+    }
+    return best;
+}
+
+float TimeStretcher::scoreSegment(int64_t start) const {
+    // 정규화 상호상관 (후보 에너지로 나누어 큰 소리 구간에 치우치지 않게 함)
+    const DspKernelTable& kernels = DspKernels::active();
+    const float* candidate = monoAt(start);
+    float correlation = kernels.dotProduct(candidate, mPrevTailMono.data(), mWsolaHop);
+    float energy = kernels.sumSquares(candidate, mWsolaHop);
+    return correlation / std::sqrt(energy + 1e-9f);
+}
+
+bool TimeStretcher::processPhaseVocoderHop() {
+    const int32_t size = mFftSize;
+    const int32_t hop = mPvHop;
+    const int32_t bins = size / 2 + 1;
+    const int channels = mChannelCount;
+    int64_t position = std::llround(mAnalysisPos);
+
+    if (mEndFrame >= 0 && position >= mEndFrame + size) {
+        return false;
+    }
+    if (getWrittenFrames() < position + size) {
+        return false;
+    }
+
+    int64_t analysisHop = mPrimed ? std::max<int64_t>(1, position - mPrevAnalysisFrame) : hop;
+    const float* in = inputAt(position);
+
+    for (int ch = 0; ch < channels; ch++) {
+        for (int32_t i = 0; i < size; i++) {
+            mReal[i] = in[static_cast<size_t>(i) * channels + ch] * mWindow[i];
+            mImag[i] = 0.0f;
+        }
+        mFft.forward(mReal.data(), mImag.data());
+
+        float* prevPhase = mPrevPhase.data() + static_cast<size_t>(ch) * bins;
+        float* synthPhase = mSynthPhase.data() + static_cast<size_t>(ch) * bins;
+        for (int32_t k = 0; k < bins; k++) {
+            float magnitude = std::sqrt(mReal[k] * mReal[k] + mImag[k] * mImag[k]);
+            float phase = std::atan2(mImag[k], mReal[k]);
+
+            if (!mPrimed) {
+                synthPhase[k] = phase;
+            } else {
+                // 분석 홉 동안의 위상 변화로 순간 주파수를 구해 합성 홉만큼 위상 진행
+                float omega = kTwoPi * k / size;
+                float deviation = wrapPhase(phase - prevPhase[k] - omega * analysisHop);
+                float frequency = omega + deviation / analysisHop;
+                synthPhase[k] = wrapPhase(synthPhase[k] + frequency * hop);
+            }
+            prevPhase[k] = phase;
+
+            mReal[k] = magnitude * std::cos(synthPhase[k]);
+            mImag[k] = magnitude * std::sin(synthPhase[k]);
+        }
+        // 실수 신호이므로 켤레 대칭으로 나머지 빈 채움
+        for (int32_t k = bins; k < size; k++) {
+            mReal[k] = mReal[size - k];
+            mImag[k] = -mImag[size - k];
+        }
+        mFft.inverse(mReal.data(), mImag.data());
+
+        for (int32_t i = 0; i < size; i++) {
+            mAccumulator[static_cast<size_t>(i) * channels + ch] += mReal[i] * mWindow[i] * kPhaseVocoderOlaScale;
+        }
+    }
+
+    // 완성된 앞쪽 홉을 출력하고 누적 버퍼를 밀어냄
+    size_t hopSamples = static_cast<size_t>(hop) * channels;
+    float* out = mOutput.data() + static_cast<size_t>(mOutputStart + mOutputFrames) * channels;
+    memcpy(out, mAccumulator.data(), hopSamples * sizeof(float));
+    mOutputFrames += hop;
+
+    if (mSpeed == 1.0f) {
+        // 1배속: 누적 버퍼의 앞 홉은 분석 위치부터의 원본에 해당하므로 이 홉 동안 원본으로 크로스페이드하고
+        // 이후로는 원본을 그대로 내보내 엔진이 직접 재생으로 넘어갈 수 있게 함 (보코더가 남긴 위상 번짐 제거)
+        for (int32_t i = 0; i < hop; i++) {
+            float fadeIn = 0.5f - 0.5f * std::cos(static_cast<float>(M_PI) * (i + 0.5f) / hop);
+            for (int ch = 0; ch < channels; ch++) {
+                size_t index = static_cast<size_t>(i) * channels + ch;
+                out[index] = out[index] * (1.0f - fadeIn) + in[index] * fadeIn;
+            }
+        }
+        std::fill(mAccumulator.begin(), mAccumulator.end(), 0.0f);
+        mAnalysisPos = static_cast<double>(position + hop);
+        mPassthrough = true;
+        mPassthroughFrames = 0;
+        return true;
+    }
+    memmove(mAccumulator.data(), mAccumulator.data() + hopSamples,
+            (mAccumulator.size() - hopSamples) * sizeof(float));
+    std::fill(mAccumulator.end() - hopSamples, mAccumulator.end(), 0.0f);
+
+    mPrevAnalysisFrame = position;
+    mAnalysisPos += hop * mSpeed;
+    mPrimed = true;
+    return true;
+}
+
+bool TimeStretcher::processPassthroughHop() {
+    const int32_t hop = mPvHop;
+    int64_t position = std::llround(mAnalysisPos);
+    if (mEndFrame >= 0 && position >= mEndFrame) {
+        return false;
+    }
+    if (getWrittenFrames() < position + hop) {
+        return false;
+    }
+
+    memcpy(mOutput.data() + static_cast<size_t>(mOutputStart + mOutputFrames) * mChannelCount,
+           inputAt(position), static_cast<size_t>(hop) * mChannelCount * sizeof(float));
+    mOutputFrames += hop;
+    mPassthroughFrames += hop;
+    mAnalysisPos = static_cast<double>(position + hop);
+    return true;
+}
+
+void TimeStretcher::compactInput() {
+    // 다음 홉이 참조할 수 있는 가장 앞 위치 이전의 입력은 버림
+    int64_t keepFrom = std::llround(mAnalysisPos) - mWsolaSearch - 1;
+    keepFrom = std::max(mInputBase, std::min(keepFrom, getWrittenFrames()));
+    int32_t drop = static_cast<int32_t>(keepFrom - mInputBase);
+    if (drop <= 0) {
+        return;
+    }
+
+    int32_t remaining = mInputFrames - drop;
+    memmove(mInput.data(), mInput.data() + static_cast<size_t>(drop) * mChannelCount,
+            static_cast<size_t>(remaining) * mChannelCount * sizeof(float));
+    memmove(mInputMono.data(), mInputMono.data() + drop, static_cast<size_t>(remaining) * sizeof(float));
+    mInputBase = keepFrom;
+    mInputFrames = remaining;
+}
+
+void TimeStretcher::appendInput(const float* input, int32_t numFrames) {
+    if (mInputFrames + numFrames > mInputCapacity) {
+        compactInput();
+    }
+    if (mInputFrames + numFrames > mInputCapacity) {
+        // 설정된 청크보다 큰 입력이 들어온 경우에만 발생
+        mInputCapacity = mInputFrames + numFrames;
+        mInput.resize(static_cast<size_t>(mInputCapacity) * mChannelCount);
+        mInputMono.resize(mInputCapacity);
+        LOGE("Time stretch input buffer grown to %d frames", mInputCapacity);
+    }
+
+    float* dst = mInput.data() + static_cast<size_t>(mInputFrames) * mChannelCount;
+    memcpy(dst, input, static_cast<size_t>(numFrames) * mChannelCount * sizeof(float));
+
+    float* mono = mInputMono.data() + mInputFrames;
+    const float scale = 1.0f / mChannelCount;
+    for (int32_t i = 0; i < numFrames; i++) {
+        float sum = 0.0f;
+        for (int ch = 0; ch < mChannelCount; ch++) {
+            sum += input[static_cast<size_t>(i) * mChannelCount + ch];
+        }
+        mono[i] = sum * scale;
+    }
+    mInputFrames += numFrames;
+}
+
+void TimeStretcher::resetProcessing() {
+    mPrimed = false;
+    mPassthrough = false;
+    mPassthroughFrames = 0;
+    std::fill(mPrevPhase.begin(), mPrevPhase.end(), 0.0f);
+    std::fill(mSynthPhase.begin(), mSynthPhase.end(), 0.0f);
+    std::fill(mAccumulator.begin(), mAccumulator.end(), 0.0f);
+}
+
+const float* TimeStretcher::inputAt(int64_t frame) const {
+    return mInput.data() + static_cast<size_t>(frame - mInputBase) * mChannelCount;
+}
+
+const float* TimeStretcher::monoAt(int64_t frame) const {
+    return mInputMono.data() + (frame - mInputBase);
+}
@@ -0,0 +1,512 @@
+#include "include/TrackStore.h"
+#include <algorithm>
+#include <functional>
+#include <string_view>
+
+namespace pancakemusicbox {
+
+namespace {
+
+// 이 비율을 넘으면 해시 인덱스 슬롯을 두 배로 늘림
+constexpr size_t kMaxLoadPercent = 70;
+constexpr size_t kMinIndexSlots = 64;
+
+template <typename T>
+size_t columnBytes(const std::vector<T>& column) {
+    return column.capacity() * sizeof(T);
+}
+
+// 열 배열의 메모리까지 돌려줌 (clear()는 용량을 남김)
+template <typename... Columns>
+void releaseColumns(Columns&... columns) {
+    (std::remove_reference_t<Columns>().swap(columns), ...);
+}
+
+} // namespace
+
+// 해시 인덱스: 선형 탐사로 찾고, 해시가 같은 슬롯만 열의 문자열과 비교
+TrackHandle TrackStore::HandleIndex::find(uint32_t hash, std::string_view key,
+                                          const std::vector<std::string_view>& column) const {
+    if (slots.empty()) {
+        return kInvalidTrackHandle;
+    }
+    size_t mask = slots.size() - 1;
+    for (size_t i = hash & mask; ; i = (i + 1) & mask) {
+        const Slot& slot = slots[i];
+        if (slot.handle == kInvalidTrackHandle) {
+            return kInvalidTrackHandle;
+        }
+        if (slot.hash == hash && column[slot.handle] == key) {
+            return slot.handle;
+        }
+    }
+}
+
+void TrackStore::HandleIndex::insert(uint32_t hash, TrackHandle handle) {
+    if ((count + 1) * 100 > slots.size() * kMaxLoadPercent) {
+        grow();
+    }
+    size_t mask = slots.size() - 1;
+    size_t i = hash & mask;
+    while (slots[i].handle != kInvalidTrackHandle) {
+        i = (i + 1) & mask;
+    }
+    slots[i] = Slot{hash, handle};
+    count++;
+}
+
+// 지운 자리 뒤의 슬롯들을 당겨 탐사 사슬이 끊기지 않게 함 (삭제 표시 없이)
+void TrackStore::HandleIndex::erase(uint32_t hash, TrackHandle handle) {
+    if (slots.empty()) {
+        return;
+    }
+    size_t mask = slots.size() - 1;
+    size_t hole = hash & mask;
+    while (slots[hole].handle != handle) {
+        if (slots[hole].handle == kInvalidTrackHandle) {
+            return;
+        }
+        hole = (hole + 1) & mask;
+    }
+
+    for (size_t next = (hole + 1) & mask; slots[next].handle != kInvalidTrackHandle; next = (next + 1) & mask) {
+        size_t home = slots[next].hash & mask;
+        // next의 원래 자리가 (hole, next] 구간 밖이면 hole로 옮겨도 탐사 중에 찾을 수 있음
+        bool homeInRange = hole <= next ? (hole < home && home <= next) : (hole < home || home <= next);
+        if (!homeInRange) {
+            slots[hole] = slots[next];
+            hole = next;
+        }
+    }
+    slots[hole].handle = kInvalidTrackHandle;
+    count--;
+}
+
+void TrackStore::HandleIndex::grow() {
+    std::vector<Slot> oldSlots(std::max(kMinIndexSlots, slots.size() * 2), Slot{0, kInvalidTrackHandle});
+    oldSlots.swap(slots);
+    count = 0;
+    for (const Slot& slot : oldSlots) {
+        if (slot.handle != kInvalidTrackHandle) {
+            insert(slot.hash, slot.handle);
+        }
+    }
+}
+
+void TrackStore::insertSorted(std::vector<TrackHandle>& handles, TrackHandle handle) {
+    // 새 트랙은 대개 가장 큰 핸들이므로 끝에 붙이는 경우를 먼저 봄
+    if (handles.empty() || handles.back() < handle) {
+        handles.push_back(handle);
+        return;
+    }
+    auto position = std::lower_bound(handles.begin(), handles.end(), handle);
+    if (position == handles.end() || *position != handle) {
+        handles.insert(position, handle);
+    }
+}
+
+void TrackStore::eraseSorted(std::vector<TrackHandle>& handles, TrackHandle handle) {
+    auto position = std::lower_bound(handles.begin(), handles.end(), handle);
+    if (position != handles.end() && *position == handle) {
+        handles.erase(position);
+    }
+}
+
+void TrackStore::FacetIndex::add(uint64_t key, TrackHandle handle) {
+    insertSorted(postings[key], handle);
+}
+
+// 비게 된 값은 목록째 지움 (삭제된 장르/아티스트가 질의에 남지 않게)
+void TrackStore::FacetIndex::remove(uint64_t key, TrackHandle handle) {
+    auto posting = postings.find(key);
+    if (posting == postings.end()) {
+        return;
+    }
+    eraseSorted(posting->second, handle);
+    if (posting->second.empty()) {
+        postings.erase(posting);
+    }
+}
+
+const std::vector<TrackHandle>* TrackStore::FacetIndex::find(uint64_t key) const {
+    auto posting = postings.find(key);
+    return posting != postings.end() ? &posting->second : nullptr;
+}
+
+void TrackStore::RankIndex::add(int64_t value, TrackHandle handle) {
+    if (value > 0) {
+        entries.emplace(value, handle);
+    }
+}
+
+void TrackStore::RankIndex::remove(int64_t value, TrackHandle handle) {
+    if (value > 0) {
+        entries.erase({value, handle});
+    }
+}
+
+std::vector<TrackHandle> TrackStore::topHandles(const RankIndex& index, int limit) {
+    size_t wanted = std::min(index.entries.size(), static_cast<size_t>(std::max(limit, 0)));
+    std::vector<TrackHandle> handles;
+    handles.reserve(wanted);
+    for (auto entry = index.entries.begin(); handles.size() < wanted; ++entry) {
+        handles.push_back(entry->second);
+    }
+    return handles;
+}
+
+void TrackStore::setPlayCount(TrackHandle handle, int32_t playCount) {
+    playCountRanking.remove(playCounts[handle], handle);
+    playCounts[handle] = playCount;
+    playCountRanking.add(playCount, handle);
+}
+
+void TrackStore::setLastPlayed(TrackHandle handle, int64_t lastPlayed) {
+    lastPlayedRanking.remove(lastPlayedTimes[handle], handle);
+    lastPlayedTimes[handle] = lastPlayed;
+    lastPlayedRanking.add(lastPlayed, handle);
+}
+
+void TrackStore::indexFacets(TrackHandle handle) {
+    genreIndex.add(genres[handle], handle);
+    artistIndex.add(artists[handle], handle);
+    albumIndex.add(albumTitles[handle], handle);
+    yearIndex.add(static_cast<uint32_t>(years[handle]), handle);
+    formatIndex.add(formats[handle], handle);
+    if (bitDepths[handle] > 16 || sampleRates[handle] > 44100) {
+        insertSorted(highResolutionHandles, handle);
+    }
+    lastPlayedRanking.add(lastPlayedTimes[handle], handle);
+    playCountRanking.add(playCounts[handle], handle);
+    dateAddedRanking.add(dateAddedTimes[handle], handle);
+}
+
+void TrackStore::unindexFacets(TrackHandle handle) {
+    genreIndex.remove(genres[handle], handle);
+    artistIndex.remove(artists[handle], handle);
+    albumIndex.remove(albumTitles[handle], handle);
+    yearIndex.remove(static_cast<uint32_t>(years[handle]), handle);
+    formatIndex.remove(formats[handle], handle);
+    eraseSorted(highResolutionHandles, handle);
+    lastPlayedRanking.remove(lastPlayedTimes[handle], handle);
+    playCountRanking.remove(playCounts[handle], handle);
+    dateAddedRanking.remove(dateAddedTimes[handle], handle);
+}
+
+bool TrackStore::addStringFacet(const FacetIndex& index, const std::string& value,
+                                std::vector<const std::vector<TrackHandle>*>& lists) const {
+    if (value.empty()) {
+        return true;
+    }
+    uint32_t id = strings.find(value);
+    const std::vector<TrackHandle>* posting = id != StringPool::kNotFound ? index.find(id) : nullptr;
+    if (posting == nullptr) {
+        return false;
+    }
+    lists.push_back(posting);
+    return true;
+}
+
+std::vector<std::string_view> TrackStore::getAlbumArtPaths() const {
+    // 풀 ID마다 한 번만 (빈 문자열 ID는 처음부터 본 것으로 둠)
+    std::vector<uint8_t> seen(strings.size(), 0);
+    seen[StringPool::kEmptyString] = 1;
+    std::vector<std::string_view> paths;
+    forEach([&](TrackHandle handle) {
+        uint32_t id = albumArtPaths[handle];
+        if (seen[id] == 0) {
+            seen[id] = 1;
+            paths.push_back(strings.get(id));
+        }
+    });
+    return paths;
+}
+
+std::vector<TrackHandle> TrackStore::query(const TrackFilter& filter) const {
+    std::vector<const std::vector<TrackHandle>*> lists;
+    if (!addStringFacet(genreIndex, filter.genre, lists) || !addStringFacet(artistIndex, filter.artist, lists) ||
+        !addStringFacet(albumIndex, filter.albumTitle, lists) || !addStringFacet(formatIndex, filter.format, lists)) {
+        return {};
+    }
+    if (filter.year != 0) {
+        const std::vector<TrackHandle>* posting = yearIndex.find(static_cast<uint32_t>(filter.year));
+        if (posting == nullptr) {
+            return {};
+        }
+        lists.push_back(posting);
+    }
+    if (filter.highResolutionOnly) {
+        lists.push_back(&highResolutionHandles);
+    }
+
+    if (lists.empty()) {
+        std::vector<TrackHandle> all;
+        all.reserve(liveCount);
+        forEach([&all](TrackHandle handle) { all.push_back(handle); });
+        return all;
+    }
+    return intersect(std::move(lists));
+}
+
+std::vector<TrackHandle> TrackStore::intersect(std::vector<const std::vector<TrackHandle>*> lists) {
+    if (lists.empty()) {
+        return {};
+    }
+    std::sort(lists.begin(), lists.end(),
+              [](const std::vector<TrackHandle>* a, const std::vector<TrackHandle>* b) { return a->size() < b->size(); });
+
+    std::vector<TrackHandle> result(*lists[0]);
+    for (size_t i = 1; i < lists.size() && !result.empty(); i++) {
+        const std::vector<TrackHandle>& other = *lists[i];
+        size_t kept = 0;
+        size_t position = 0;
+        for (TrackHandle handle : result) {
+            // 지수 탐색으로 범위를 좁힌 뒤 이진 탐색 (짧은 목록 길이 k에 대해 O(k log(n/k)))
+            size_t step = 1;
+            size_t high = position;
+            while (high < other.size() && other[high] < handle) {
+                position = high + 1;
+                high = position + step;
+                step *= 2;
+            }
+            auto found = std::lower_bound(other.begin() + position,
+                                          other.begin() + std::min(high + 1, other.size()), handle);
+            position = static_cast<size_t>(found - other.begin());
+            if (position == other.size()) {
+                break;
+            }
+            if (other[position] == handle) {
+                result[kept++] = handle;
+            }
+        }
+        result.resize(kept);
+    }
+    return result;
+}
+
+uint32_t TrackStore::hashKey(std::string_view key) {
+    size_t hash = std::hash<std::string_view>()(key);
+    return static_cast<uint32_t>(hash ^ (static_cast<uint64_t>(hash) >> 32));
+}
+
+TrackHandle TrackStore::insert(const TrackMetadata& track) {
+    uint32_t idHash = hashKey(track.id);
+    TrackHandle handle = idIndex.find(idHash, track.id, ids);
+    if (handle == kInvalidTrackHandle) {
+        handle = allocateHandle();
+        ids[handle] = arena->store(track.id);
+        idIndex.insert(idHash, handle);
+    } else {
+        unindexFacets(handle);
+        if (filePaths[handle] == track.filePath) {
+            // 같은 ID, 같은 경로: 경로 인덱스는 그대로
+            writeRow(handle, track);
+            indexFacets(handle);
+            return handle;
+        }
+        pathIndex.erase(hashKey(filePaths[handle]), handle);
+    }
+
+    // 같은 경로를 가리키던 다른 트랙은 경로 인덱스에서 밀려남
+    uint32_t pathHash = hashKey(track.filePath);
+    TrackHandle previous = pathIndex.find(pathHash, track.filePath, filePaths);
+    if (previous != kInvalidTrackHandle) {
+        pathIndex.erase(pathHash, previous);
+    }
+    writeRow(handle, track);
+    pathIndex.insert(pathHash, handle);
+    indexFacets(handle);
+    return handle;
+}
+
+void TrackStore::remove(TrackHandle handle) {
+    if (!isValid(handle)) {
+        return;
+    }
+    unindexFacets(handle);
+    idIndex.erase(hashKey(ids[handle]), handle);
+    pathIndex.erase(hashKey(filePaths[handle]), handle);
+    alive[handle] = 0;
+    liveCount--;
+    freeHandles.push_back(handle);
+
+    // 아레나 문자열은 회수 대상으로 세고, 풀 ID는 그대로 둠 (다른 트랙과 공유)
+    for (auto* column : {&ids, &titles, &filePaths}) {
+        releaseArenaString((*column)[handle]);
+        (*column)[handle] = std::string_view();
+    }
+    compactArenaIfNeeded();
+}
+
+// 문자열과 열 배열은 청크/배열 단위로 한 번에 해제하지만, 순위 색인(std::set 노드)과
+// 패싯 목록(unordered_map 노드와 목록 배열)은 항목마다 해제하므로 비용은 트랙 수에 비례함
+void TrackStore::clear() {
+    releaseColumns(ids, titles, filePaths, artists, albumTitles, albumArtPaths, formats, genres, composers,
+                   durations, bitDepths, sampleRates, channelCounts, years, trackNumbers, playCounts, lastPlayedTimes,
+                   dateAddedTimes, fileSizes, modifiedTimesNs, inodes, alive, freeHandles);
+    liveCount = 0;
+    idIndex = HandleIndex();
+    pathIndex = HandleIndex();
+    for (auto* index : {&genreIndex, &artistIndex, &albumIndex, &yearIndex, &formatIndex}) {
+        *index = FacetIndex();
+    }
+    releaseColumns(highResolutionHandles);
+    for (auto* ranking : {&lastPlayedRanking, &playCountRanking, &dateAddedRanking}) {
+        *ranking = RankIndex();
+    }
+    arena = std::make_unique<StringArena>();
+    releasedArenaBytes = 0;
+    strings.clear();
+}
+
+TrackHandle TrackStore::findById(const std::string& id) const {
+    return idIndex.find(hashKey(id), id, ids);
+}
+
+TrackHandle TrackStore::findByPath(const std::string& filePath) const {
+    return pathIndex.find(hashKey(filePath), filePath, filePaths);
+}
+
+TrackMetadata TrackStore::get(TrackHandle handle) const {
+    TrackMetadata track;
+    track.id = ids[handle];
+    track.title = titles[handle];
+    track.artist = strings.get(artists[handle]);
+    track.albumTitle = strings.get(albumTitles[handle]);
+    track.albumArtPath = strings.get(albumArtPaths[handle]);
+    track.duration = static_cast<long>(durations[handle]);
+    track.filePath = filePaths[handle];
+    track.audioQuality.bitDepth = bitDepths[handle];
+    track.audioQuality.sampleRate = sampleRates[handle];
+    track.audioQuality.format = strings.get(formats[handle]);
+    track.audioQuality.channels = channelCounts[handle];
+    track.genre = strings.get(genres[handle]);
+    track.year = years[handle];
+    track.trackNumber = trackNumbers[handle];
+    track.composer = strings.get(composers[handle]);
+    track.playCount = playCounts[handle];
+    track.lastPlayed = lastPlayedTimes[handle];
+    track.dateAdded = dateAddedTimes[handle];
+    track.fingerprint = getFingerprint(handle);
+    return track;
+}
+
+FileFingerprint TrackStore::getFingerprint(TrackHandle handle) const {
+    FileFingerprint fingerprint;
+    fingerprint.size = fileSizes[handle];
+    fingerprint.modifiedTimeNs = modifiedTimesNs[handle];
+    fingerprint.inode = inodes[handle];
+    return fingerprint;
+}
+
+size_t TrackStore::getMemoryUsage() const {
+    size_t bytes = arena->getAllocatedBytes() + strings.getMemoryUsage();
+    bytes += columnBytes(ids) + columnBytes(titles) + columnBytes(filePaths);
+    bytes += columnBytes(artists) + columnBytes(albumTitles) + columnBytes(albumArtPaths) + columnBytes(formats) +
+             columnBytes(genres) + columnBytes(composers);
+    bytes += columnBytes(durations) + columnBytes(bitDepths) + columnBytes(sampleRates) + columnBytes(channelCounts) +
+             columnBytes(years) + columnBytes(trackNumbers) + columnBytes(playCounts) + columnBytes(lastPlayedTimes) +
+             columnBytes(dateAddedTimes) + columnBytes(fileSizes) + columnBytes(modifiedTimesNs) + columnBytes(inodes) + columnBytes(alive) +
+             columnBytes(freeHandles);
+    bytes += columnBytes(idIndex.slots) + columnBytes(pathIndex.slots);
+    for (const auto* index : {&genreIndex, &artistIndex, &albumIndex, &yearIndex, &formatIndex}) {
+        for (const auto& posting : index->postings) {
+            bytes += columnBytes(posting.second) + sizeof(posting) + 2 * sizeof(void*);
+        }
+    }
+    bytes += columnBytes(highResolutionHandles);
+    // 트리 노드: 값 + 핸들 + 색/부모/자식 포인터
+    size_t rankNodeBytes = sizeof(std::pair<int64_t, TrackHandle>) + 4 * sizeof(void*);
+    for (const auto* ranking : {&lastPlayedRanking, &playCountRanking, &dateAddedRanking}) {
+        bytes += ranking->entries.size() * rankNodeBytes;
+    }
+    return bytes;
+}
+
+// 빈 핸들을 재사용하거나 모든 열을 한 칸 늘림
+TrackHandle TrackStore::allocateHandle() {
+    TrackHandle handle;
+    if (!freeHandles.empty()) {
+        handle = freeHandles.back();
+        freeHandles.pop_back();
+    } else {
+        handle = static_cast<TrackHandle>(alive.size());
+        size_t newSize = alive.size() + 1;
+        for (auto* column : {&ids, &titles, &filePaths}) {
+            column->resize(newSize);
+        }
+        for (auto* column : {&artists, &albumTitles, &albumArtPaths, &formats, &genres, &composers}) {
+            column->resize(newSize);
+        }
+        for (auto* column : {&durations, &lastPlayedTimes, &dateAddedTimes, &fileSizes, &modifiedTimesNs}) {
+            column->resize(newSize);
+        }
+        for (auto* column : {&bitDepths, &sampleRates, &channelCounts, &years, &trackNumbers, &playCounts}) {
+            column->resize(newSize);
+        }
+        inodes.resize(newSize);
+        alive.resize(newSize);
+    }
+    alive[handle] = 1;
+    liveCount++;
+    return handle;
+}
+
+// ID를 뺀 모든 열에 값 쓰기
+void TrackStore::writeRow(TrackHandle handle, const TrackMetadata& track) {
+    assignArenaString(titles, handle, track.title);
+    assignArenaString(filePaths, handle, track.filePath);
+    artists[handle] = strings.intern(track.artist);
+    albumTitles[handle] = strings.intern(track.albumTitle);
+    albumArtPaths[handle] = strings.intern(track.albumArtPath);
+    formats[handle] = strings.intern(track.audioQuality.format);
+    genres[handle] = strings.intern(track.genre);
+    composers[handle] = strings.intern(track.composer);
+    durations[handle] = track.duration;
+    bitDepths[handle] = track.audioQuality.bitDepth;
+    sampleRates[handle] = track.audioQuality.sampleRate;
+    channelCounts[handle] = track.audioQuality.channels;
+    years[handle] = track.year;
+    trackNumbers[handle] = track.trackNumber;
+    playCounts[handle] = track.playCount;
+    lastPlayedTimes[handle] = track.lastPlayed;
+    dateAddedTimes[handle] = track.dateAdded;
+    fileSizes[handle] = track.fingerprint.size;
+    modifiedTimesNs[handle] = track.fingerprint.modifiedTimeNs;
+    inodes[handle] = track.fingerprint.inode;
+}
+
+void TrackStore::assignArenaString(std::vector<std::string_view>& column, TrackHandle handle,
+                                   const std::string& value) {
+    if (column[handle] == value && column[handle].data() != nullptr) {
+        return;
+    }
+    releaseArenaString(column[handle]);
+    column[handle] = arena->store(value);
+    compactArenaIfNeeded();
+}
+
+void TrackStore::releaseArenaString(std::string_view value) {
+    if (value.data() != nullptr) {
+        releasedArenaBytes += value.size() + 1;
+    }
+}
+
+void TrackStore::compactArenaIfNeeded() {
+    size_t liveBytes = arena->getUsedBytes() - releasedArenaBytes;
+    if (releasedArenaBytes < kMinCompactionBytes || releasedArenaBytes < liveBytes) {
+        return;
+    }
+
+    // 해시 인덱스는 핸들만 가지므로 문자열을 옮겨도 다시 만들 필요가 없음
+    auto compacted = std::make_unique<StringArena>();
+    forEach([&](TrackHandle handle) {
+        for (auto* column : {&ids, &titles, &filePaths}) {
+            (*column)[handle] = compacted->store((*column)[handle]);
+        }
+    });
+    arena = std::move(compacted);
+    releasedArenaBytes = 0;
+}
+
+} // namespace pancakemusicbox
@@ -0,0 +1,44 @@
+#ifndef PANCAKEMUSICBOX_ALBUMARTCACHE_H
+#define PANCAKEMUSICBOX_ALBUMARTCACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace pancakemusicbox {
+
+/**
+ * 앨범 아트를 내용 해시로 한 번만 저장하는 디스크 캐시
+ *
+ * 파일에 포함된 그림은 내용 해시(64비트)를 이름으로 "<디렉토리>/<해시 16자리>.<확장자>"에 저장하므로,
+ * 같은 표지를 가진 앨범의 트랙 20개가 있어도 파일은 하나만 생기고 모든 트랙이 같은 경로를 가리킴
+ * 그림이 없는 트랙은 같은 디렉토리의 cover.jpg, folder.jpg 같은 폴더 아트 파일 경로를 그대로 씀
+ * 스캔 작업자 스레드에서 동시에 호출됨
+ */
+class AlbumArtCache {
+public:
+    // 저장 디렉토리 설정 (빈 문자열이면 비활성화, 디렉토리가 없으면 만듦)
+    bool setDirectory(const std::string& directoryPath);
+    bool isEnabled();
+
+    // 인코딩된 이미지를 저장하고 캐시 파일 경로 반환 (같은 내용이 이미 있으면 쓰지 않음, 실패 시 빈 문자열)
+    std::string store(const uint8_t* data, size_t size);
+
+    // directoryPath 안의 폴더 아트 파일 경로 (없으면 빈 문자열, 디렉토리별로 결과를 기억함)
+    std::string findFolderArt(const std::string& directoryPath);
+    // 기억해 둔 폴더 아트 결과 지우기 (디렉토리 재스캔 전에 호출)
+    void clearFolderArtCache();
+
+private:
+    std::mutex mutex;
+    std::string cacheDirectory;
+    std::unordered_set<uint64_t> storedHashes;     // 이번 실행에서 저장했거나 디스크에서 확인한 해시
+    std::unordered_map<std::string, std::string> folderArtByDirectory;
+};
+
+} // namespace pancakemusicbox
+
+#endif // PANCAKEMUSICBOX_ALBUMARTCACHE_H
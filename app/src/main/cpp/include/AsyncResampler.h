@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Biquad.h"
+
+/**
+ * 비율을 블록마다 바꿀 수 있는 비동기 리샘플러 (4점 큐빅 Hermite 보간, DspKernels의 resampleCubic/biquadCascade 사용)
+ *
+ * 클럭이 서로 다른 두 장치 사이에서 쓰도록 만든 것으로, ratio(출력 1프레임당 입력 프레임 수)를
+ * 매 블록 조금씩 조정해도 위상이 연속으로 이어짐
+ * 사용법: getInputFramesNeeded()만큼 getInputBuffer()에 채운 뒤 process() 호출
+ * 버퍼는 configure()에서만 할당하므로 오디오 스레드에서 할당하지 않음
+ * 다운샘플링(공칭 비율 > 1)에서는 보간 전에 입력을 8차 Butterworth 로우패스로 출력 나이퀴스트 아래로 제한
+ */
+class AsyncResampler {
+public:
+    // 보간에 필요한 이전 블록의 마지막 프레임 수
+    static constexpr int kHistoryFrames = 4;
+
+    void configure(int channelCount, int32_t maxInputFrames);
+    void reset();
+
+    // 클럭 보정을 뺀 공칭 비율 (입력 레이트 / 출력 레이트), 바뀔 때만 앨리어싱 방지 필터를 다시 설계
+    void setNominalRatio(double nominalRatio);
+
+    // 출력 outputFrames 프레임을 만들기 위해 이번 블록에 공급해야 하는 입력 프레임 수
+    int32_t getInputFramesNeeded(int32_t outputFrames, double ratio) const;
+    int32_t getMaxInputFrames() const { return mMaxInputFrames; }
+
+    // 입력을 쓸 위치 (이전 블록의 히스토리 바로 뒤)
+    float* getInputBuffer() { return mBuffer.data() + static_cast<size_t>(kHistoryFrames) * mChannelCount; }
+
+    // inputFrames는 같은 outputFrames, ratio로 구한 getInputFramesNeeded() 값이어야 함
+    void process(int32_t inputFrames, float* output, int32_t outputFrames, double ratio);
+
+private:
+    // 앨리어싱 방지 로우패스: 2차 섹션 4개 (8차 Butterworth), 차단 주파수는 출력 레이트의 0.45배
+    static constexpr int kAntiAliasSections = 4;
+    static constexpr double kAntiAliasCutoff = 0.45;
+    // 이 비율 이하의 다운샘플링은 접히는 대역이 가청 대역 밖이므로 필터를 쓰지 않음
+    static constexpr double kAntiAliasMinRatio = 1.01;
+
+    void applyAntiAlias(float* input, int32_t inputFrames);
+
+    int mChannelCount = 2;
+    int32_t mMaxInputFrames = 0;
+    double mPhase = 0.0;          // 히스토리 1번 프레임 기준 다음 출력의 소수 위치 [0, 1)
+    std::vector<float> mBuffer;   // [히스토리 | 입력] 인터리브
+
+    double mNominalRatio = 1.0;
+    bool mAntiAliasActive = false;
+    BiquadCoefficients mAntiAlias[kAntiAliasSections];
+    std::vector<BiquadState> mAntiAliasState;   // [섹션][채널]
+};
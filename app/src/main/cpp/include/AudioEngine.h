@@ -1,10 +1,66 @@
 #pragma once
 
 #include <oboe/Oboe.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <vector>
 #include <string>
 #include <mutex>
 #include <memory>
+#include <thread>
+#include "DecodedAudioCache.h"
+#include "DspChain.h"
+#include "IoScheduler.h"
+#include "OutputFanout.h"
+#include "TimeStretcher.h"
+
+/**
+ * 출력 방식 (기기별 콜백 스케줄링 품질에 따라 선택)
+ */
+enum class OutputMode {
+    Callback = 0,       // Oboe 데이터 콜백에서 렌더링 (기본값)
+    BlockingWrite = 1   // 전용 렌더 스레드에서 렌더링 후 블로킹 쓰기
+};
+
+/**
+ * 출력 경로 지연 및 언더런 지표 (두 출력 방식에서 같은 방법으로 측정)
+ */
+struct OutputMetrics {
+    OutputMode mode;
+    int32_t framesPerBurst;
+    int32_t bufferSizeFrames;
+    int32_t burstsInFlight;     // 블로킹 쓰기 모드에서 버퍼에 유지하는 버스트 수
+    double latencyMs;           // 스트림이 계산한 출력 지연 (알 수 없으면 -1)
+    int32_t xRunCount;          // 스트림이 보고한 언더런 횟수 (알 수 없으면 -1)
+    float lastRenderUs;         // 최근 렌더링(디코드 → DSP) 처리 시간
+    float maxRenderUs;          // 스트림을 연 뒤 가장 오래 걸린 렌더링 처리 시간
+    int64_t renderCount;
+    bool realtimeThread;        // 렌더링 스레드가 SCHED_FIFO로 실행 중인지 여부
+    float tapToSoundMs;         // 최근 play() 요청부터 첫 샘플이 스피커에 도달하기까지 (측정 전이면 -1)
+    float loadMs;               // 최근 loadFile() 처리 시간 (디코딩 또는 캐시 조회, 스트림 준비 포함)
+    bool warmStart;             // 무음 상태로 스트림을 미리 열어두는 warm-start 모드 여부
+    bool autoHardwareSwitching; // 트랙마다 하드웨어 레이트/형식을 원본에 맞추는지 여부
+    bool resampling;            // 현재 스트림이 Oboe 리샘플러로 변환 중인지 (자동 전환 꺼짐 또는 기기가 레이트 거부)
+    int32_t streamSwitches;     // 트랙 형식에 맞춰 출력 스트림을 재구성한 횟수
+    float switchOpenMs;         // 최근 재구성에서 새 스트림을 여는 데 걸린 시간 (이전 스트림이 실행되는 동안 수행)
+    float switchGapMs;          // 최근 재구성에서 이전 스트림 분리부터 새 스트림 시작까지의 출력 공백
+};
+
+/**
+ * 스트림 성능 모드별 전력 지표 (재생 시간 기준으로 정규화)
+ */
+struct PowerModeStats {
+    float wakeupsPerMinute;     // 재생 1분당 렌더링(콜백 또는 렌더 스레드 깨어남) 횟수
+    float cpuSecondsPerHour;    // 재생 1시간당 렌더링 스레드 CPU 시간 (초)
+    float playbackMinutes;      // 이 모드로 재생한 시간
+};
+
+struct PowerStats {
+    PowerModeStats lowLatency;
+    PowerModeStats deepBuffer;
+    bool deepBufferActive;      // 현재 스트림이 PowerSaving(deep buffer) 모드인지 여부
+};
 
 /**
  * HiFi 오디오 플레이어를 위한 오디오 엔진 클래스
@@ -25,21 +81,81 @@ public:
     int64_t getCurrentPosition() const;
     int64_t getDuration() const;
 
+    // 디코딩 캐시 관련 함수 (이전/다음 트랙 즉시 재생용)
+    bool preloadFile(const std::string& filePath);
+    void setDecodedCacheBudget(size_t budgetBytes);
+    void setDecodedCacheCompact(bool compact);
+
+    // 다음 트랙 파일 앞부분 I/O 프리페치 및 현재 트랙 I/O 통계
+    void prefetchFile(const std::string& filePath);
+    IoStats getIoStats() const;
+
     // 오디오 품질 및 설정 관련 함수
     void setSampleRate(int sampleRate);
     void setBitDepth(int bitDepth);
     void setChannelCount(int channelCount);
     void setVolume(float volume);
     
-    // 하드웨어별 최적화 설정
+    // 하드웨어별 최적화 설정 (헤드폰 출력이면 크로스피드 자동 적용)
     void optimizeForDevice(bool useHeadphones, bool isHighPerformanceDevice);
 
+    // 헤드폰 크로스피드 프리셋 및 A/B 비교용 바이패스
+    void setCrossfeedPreset(CrossfeedPreset preset);
+    void setCrossfeedBypass(bool bypass);
+    bool isCrossfeedActive() const;
+
     // 오디오 처리 관련 함수 (EQ, 볼륨 정규화 등)
     void enableEQ(bool enable);
     void setEQBand(int band, float gain);
     void enableVolumeNormalization(bool enable);
     void setTargetLUFS(float lufsValue);
 
+    // 볼륨 연동 라우드니스 보상 (낮은 볼륨에서 저역/고역 보강)
+    void enableLoudnessCompensation(bool enable);
+
+    // 3밴드 컴프레서 나이트 모드 (미터는 락 없이 읽음)
+    void enableNightMode(bool enable);
+    void setNightModeMakeupGain(float gainDb);
+    CompressorMeters getNightModeMeters() const;
+
+    // 재생 속도 (피치 유지 타임 스트레치, 스트림 재시작 없이 적용)
+    void setPlaybackSpeed(float speed);
+    float getPlaybackSpeed() const;
+    void setTimeStretchMode(TimeStretchMode mode);
+    float getTimeStretchLoad() const;
+
+    // Bit-perfect 모드 (DSP를 거치지 않고 원본 샘플을 그대로 출력)
+    void enableBitPerfect(bool enable);
+    bool isBitPerfect() const;
+    uint64_t getOutputChecksum() const;
+
+    // warm-start: 출력 스트림을 무음 상태로 미리 열어두고 버퍼를 할당하며 첫 트랙을 디코딩 캐시에 준비
+    // (firstTrackPath가 비어 있으면 트랙 준비 생략, 디코딩이 있으므로 백그라운드 스레드에서 호출)
+    // 재생 없이 kWarmStartIdleSeconds가 지나면 스트림을 멈추고 해제되며, 다시 쓰려면 warmStart를 호출
+    void warmStart(const std::string& firstTrackPath);
+    void disableWarmStart();
+
+    // 절전 deep-buffer 모드: 플레이어 UI가 보이지 않는 동안 PowerSaving 스트림과 큰 버퍼로 재생하고
+    // UI가 다시 보이면 저지연 스트림으로 끊김 없이 전환
+    void enableDeepBuffer(bool enable);
+    void setPlayerUiVisible(bool visible);
+    PowerStats getPowerStats() const;
+
+    // 하드웨어 레이트 자동 전환: 트랙 경계마다 출력을 원본 레이트/형식으로 재구성 (새 스트림을 먼저 연 뒤 교체)
+    // 끄거나 기기가 레이트를 거부하면 Oboe 리샘플러로 변환
+    void setAutoHardwareSwitching(bool enable);
+
+    // 보조 출력 팬아웃: 주 출력과 같은 DSP 결과를 다른 장치에도 동시에 재생 (출력 id 반환, 실패 시 -1)
+    // 장치마다 링 버퍼와 PI 제어 비동기 리샘플러로 클럭 차이를 보정, deviceId가 0 이하면 기본 장치
+    int addOutputDevice(int32_t deviceId);
+    int addNullOutput(int32_t sampleRate, float clockPpm);
+    bool removeOutput(int outputId);
+    std::vector<FanoutOutputStats> getFanoutStats() const;
+
+    // 출력 방식 선택 (스트림을 다시 열어 적용) 및 지연/언더런 지표
+    void setOutputMode(OutputMode mode, int burstsInFlight);
+    OutputMetrics getOutputMetrics() const;
+
     // 오디오 스트림 콜백 함수 (Oboe 요구사항)
     oboe::DataCallbackResult onAudioReady(
         oboe::AudioStream *oboeStream,
@@ -51,25 +167,118 @@ public:
     void onErrorAfterClose(oboe::AudioStream *oboeStream, oboe::Result error) override;
 
 private:
+    // 콜백 한 번에 처리할 것으로 예상되는 최대 프레임 수 (변환 버퍼 크기)
+    static constexpr int32_t kMaxRenderFrames = 4096;
+    // 타임 스트레처에 한 번에 공급하는 소스 프레임 수
+    static constexpr int32_t kStretchChunkFrames = 1024;
+    // 블로킹 쓰기 모드의 버퍼 버스트 수 범위
+    static constexpr int kMinBurstsInFlight = 1;
+    static constexpr int kMaxBurstsInFlight = 8;
+
+    // deep-buffer 모드 블로킹 쓰기 한 번에 묶어 쓰는 버스트 수
+    static constexpr int kDeepBufferBurstsPerWrite = 2;
+
+    // 재생 없이 이 시간 동안 무음만 출력하면 warm-start 스트림을 멈춤
+    static constexpr int32_t kWarmStartIdleSeconds = 30;
+
+    // 렌더 스레드마다 하나씩 두는 종료 제어 (스트림 재시작이 겹쳐도 이전 스레드만 정확히 종료)
+    struct RenderThreadControl {
+        std::atomic<bool> stop{false};
+        bool exited = false;  // mLock 보호
+    };
+
+    // 스트림 생성 요청 (락 밖에서 새 스트림을 열 수 있도록 필요한 엔진 설정을 복사)
+    struct StreamRequest {
+        SampleFormat format = SampleFormat::Float32;
+        int sampleRate = 0;
+        int channelCount = 0;
+        bool deepBuffer = false;
+        bool callback = true;
+        bool hardwareRate = true;   // false면 기기 레이트를 유지하고 리샘플러로 변환
+
+        bool operator==(const StreamRequest& other) const {
+            return format == other.format && sampleRate == other.sampleRate &&
+                   channelCount == other.channelCount && deepBuffer == other.deepBuffer &&
+                   callback == other.callback && hardwareRate == other.hardwareRate;
+        }
+    };
+
+    // 요청대로 연 스트림 (기기 지원에 따라 형식/리샘플링이 요청과 다를 수 있음)
+    struct OpenedStream {
+        std::shared_ptr<oboe::AudioStream> stream;
+        SampleFormat format = SampleFormat::Float32;
+        bool resampled = false;
+    };
+
     // 오디오 스트림 생성 및 관리
     bool openOutputStream();
     void closeOutputStream();
     bool restartStream();
+    StreamRequest makeStreamRequestLocked() const;
+    bool openStreamForRequest(const StreamRequest& request, OpenedStream& opened);
+    void installStreamLocked(OpenedStream& opened, const StreamRequest& request);
+
+    // 새 요청의 스트림을 락을 놓고 연 뒤 교체 (lock은 mLock을 잡은 상태, 이전 스트림은 락 밖에서 닫도록 반환)
+    std::shared_ptr<oboe::AudioStream> reconfigureStream(std::unique_lock<std::mutex>& lock);
+
+    // 성능 모드 전환 (lock은 mLock을 잡은 상태, reconfigureStream과 같이 락 밖에서 열고 이전 스트림을 반환)
+    bool useDeepBufferLocked() const;
+    std::shared_ptr<oboe::AudioStream> switchStreamModeLocked(std::unique_lock<std::mutex>& lock);
+
+    // 열린 스트림을 현재 트랙 형식에 그대로 쓸 수 있는지 여부 및 스트림 재사용 시 렌더 상태 초기화
+    bool isStreamCompatibleLocked() const;
+    void prepareRenderStateLocked();
+
+    // Bit-perfect 경로 판단 (mLock을 잡은 상태에서 호출)
+    bool isDspNeutralLocked() const;
+    SampleFormat selectStreamFormatLocked() const;
+    void updateBitPerfectStateLocked();
+
+    // mLock을 잡은 상태에서 호출하는 내부 재생 제어 함수
+    bool startLocked();
+    void stopLocked();
+
+    // 출력 버퍼 한 블록 렌더링 (콜백과 렌더 스레드 공통, mLock을 잡은 상태에서 호출)
+    void renderLocked(uint8_t* output, int32_t numFrames);
+
+    // 무음 warm-start가 유휴 시간을 넘겼으면 해제하고 true 반환 (호출자가 스트림을 멈춤)
+    bool expireIdleWarmStartLocked();
+
+    // 블로킹 쓰기 모드 렌더 스레드 (시작/종료는 mLock을 잡은 상태에서 호출)
+    void startRenderThreadLocked();
+    void stopRenderThreadLocked();
+    void renderThreadLoop(std::shared_ptr<RenderThreadControl> control,
+                          std::shared_ptr<oboe::AudioStream> stream, int32_t burstFrames);
+
+    // 타임 스트레치 렌더링 및 위치 재설정 (mLock을 잡은 상태에서 호출)
+    int32_t renderStretchedLocked(float* output, int32_t numFrames);
+    void resetTimeStretchLocked();
+
+    // 파일 디코딩 (캐시 미스 시 호출)
+    DecodedAudioKey makeCacheKey(const std::string& filePath) const;
+    std::shared_ptr<const DecodedAudio> decodeFile(const DecodedAudioKey& key);
     
-    // 오디오 포맷 변환 및 처리
-    void processAudioData(float* audioData, int32_t numFrames);
-    void applyEQ(float* audioData, int32_t numFrames);
-    void applyVolumeNormalization(float* audioData, int32_t numFrames);
+    // 오디오 처리 (볼륨, EQ, 정규화, 리미터, 출력 형식 변환을 융합 DSP 체인으로 처리)
+    void processAudioData(const float* input, void* output, int32_t numFrames);
+    
+    // 현재 설정을 DSP 체인에 반영 (mLock을 잡은 상태에서 호출)
+    void reconfigureDspLocked();
     
     // 오디오 분석 및 시각화 데이터 생성
     void updateVisualizationData(const float* audioData, int32_t numFrames);
 
     // Oboe 스트림 객체
     std::shared_ptr<oboe::AudioStream> mAudioStream;
+    SampleFormat mStreamFormat = SampleFormat::Float32;
+    StreamRequest mStreamRequest;     // 현재 스트림을 연 요청 (트랙 형식이 같으면 스트림 재사용)
+    bool mStreamResampled = false;
+    std::vector<float> mRenderBuffer; // float 이외 형식의 스트림 또는 시각화용 변환 버퍼
     
     // 오디오 데이터 버퍼 및 상태 관리
-    std::vector<float> mAudioData;
+    std::shared_ptr<const DecodedAudio> mAudioData;
+    std::string mFilePath;
     std::vector<float> mVisualizationData;
+    std::vector<float> mBandEnergies;   // 시각화 밴드별 제곱합 (렌더링 중 할당하지 않도록 미리 확보)
     int64_t mCurrentFrame = 0;
     int64_t mTotalFrames = 0;
     bool mIsPlaying = false;
@@ -85,6 +294,65 @@ private:
     std::vector<float> mEQGains;
     bool mVolumeNormalizationEnabled = false;
     float mTargetLUFS = -14.0f; // 기본 타겟 LUFS 값
+    bool mLoudnessCompensationEnabled = false;
+    bool mNightModeEnabled = false;
+    float mNightModeMakeupDb = 8.0f;
+    bool mHeadphoneOutput = false;
+    bool mCrossfeedBypassed = false;
+    CrossfeedPreset mCrossfeedPreset = CrossfeedPreset::Default;
+    DspChain mDspChain;
+    TimeStretcher mTimeStretcher;
+    std::vector<float> mStretchInput; // 타임 스트레처 공급용 소스 버퍼
+    
+    // Bit-perfect 설정 및 현재 상태
+    bool mBitPerfectEnabled = false;
+    bool mBitPerfectActive = false;
+    uint64_t mOutputChecksum = 0; // bit-perfect 출력 바이트의 FNV-1a 해시
+
+    // 출력 방식 및 렌더 스레드
+    OutputMode mOutputMode = OutputMode::Callback;
+    int mBurstsInFlight = 2;
+    std::thread mRenderThread;
+    std::shared_ptr<RenderThreadControl> mRenderControl;
+    std::condition_variable mRenderCondition; // mLock과 함께 사용 (재생 시작, 스레드 종료 알림)
+    
+    // 렌더링 지표 (스트림을 열 때 초기화)
+    float mLastRenderUs = 0.0f;
+    float mMaxRenderUs = 0.0f;
+    int64_t mRenderCount = 0;
+    bool mRenderRealtime = false;
+    
+    // deep-buffer 모드 및 성능 모드별 전력 지표 ([0] = 저지연, [1] = deep buffer)
+    struct PowerCounters {
+        int64_t wakeups = 0;
+        int64_t cpuNanos = 0;
+        double playedSeconds = 0.0;
+    };
+    bool mDeepBufferEnabled = false;
+    bool mPlayerUiVisible = true;
+    bool mStreamDeepBuffer = false;
+    PowerCounters mPowerCounters[2];
+
+    // 보조 출력 팬아웃 (렌더링 결과를 mLock 안에서 전달)
+    OutputFanout mFanout;
+
+    // 하드웨어 레이트 자동 전환 및 재구성 지표
+    bool mAutoHardwareSwitching = true;
+    int mStreamSwitchesPending = 0;   // 락 밖에서 새 스트림을 여는 중인 재구성 수 (그동안 기존 스트림은 무음)
+    int32_t mStreamSwitches = 0;
+    float mSwitchOpenMs = 0.0f;
+    float mSwitchGapMs = 0.0f;
+
+    // warm-start 및 탭→소리 지연 측정
+    bool mWarmStart = false;
+    int64_t mWarmIdleFrames = 0;  // warm-start 중 재생 없이 출력한 무음 프레임 수
+    bool mTapPending = false;
+    std::chrono::steady_clock::time_point mTapTime;
+    float mTapToRenderMs = -1.0f; // play()부터 첫 트랙 샘플을 스트림에 넘기기까지 (출력 지연 제외)
+    float mLoadMs = 0.0f;
+
+    // 디코딩된 PCM 캐시
+    DecodedAudioCache mDecodedCache;
     
     // 스레드 안전성을 위한 뮤텍스
     mutable std::mutex mLock;
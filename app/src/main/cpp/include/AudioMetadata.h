@@ -32,6 +32,24 @@ struct AudioQuality {
     }
 };
 
+/**
+ * 증분 재스캔용 파일 지문 (세 값이 모두 같으면 파일이 바뀌지 않았다고 보고 다시 읽지 않음)
+ */
+struct FileFingerprint {
+    long long size;                 // 파일 크기 (바이트)
+    long long modifiedTimeNs;       // 마지막 수정 시간 (나노초)
+    unsigned long long inode;       // inode 번호 (같은 경로에 다른 파일이 들어온 경우 구분)
+    
+    FileFingerprint() : size(0), modifiedTimeNs(0), inode(0) {}
+    
+    bool operator==(const FileFingerprint& other) const {
+        return size == other.size && modifiedTimeNs == other.modifiedTimeNs && inode == other.inode;
+    }
+    bool operator!=(const FileFingerprint& other) const {
+        return !(*this == other);
+    }
+};
+
 /**
  * 트랙/곡 정보 구조체
  */
@@ -50,10 +68,12 @@ struct TrackMetadata {
     std::string composer;        // 작곡가
     int playCount;               // 재생 횟수
     long long lastPlayed;        // 마지막 재생 시간 (타임스탬프)
+    long long dateAdded;         // 라이브러리에 처음 추가된 시간 (밀리초 타임스탬프)
+    FileFingerprint fingerprint; // 스캔 시점의 파일 지문
     
     // 기본 생성자
     TrackMetadata() : 
-        duration(0), year(0), trackNumber(0), playCount(0), lastPlayed(0) {}
+        duration(0), year(0), trackNumber(0), playCount(0), lastPlayed(0), dateAdded(0) {}
 };
 
 /**
@@ -26,6 +26,15 @@ public:
     int64_t getCurrentPosition() const;
     int64_t getDuration() const;
 
+    // 디코딩 캐시 함수
+    bool preloadFile(JNIEnv* env, jstring jFilePath);
+    void setDecodedCacheBudget(size_t budgetBytes);
+    void setDecodedCacheCompact(bool compact);
+
+    // I/O 프리페치 및 통계
+    void prefetchFile(JNIEnv* env, jstring jFilePath);
+    IoStats getIoStats() const;
+
     // 오디오 설정 함수
     void setSampleRate(int sampleRate);
     void setBitDepth(int bitDepth);
@@ -37,9 +46,49 @@ public:
     void setEQBand(int band, float gain);
     void enableVolumeNormalization(bool enable);
     void setTargetLUFS(float lufsValue);
+    void enableLoudnessCompensation(bool enable);
+    void enableNightMode(bool enable);
+    void setNightModeMakeupGain(float gainDb);
+    CompressorMeters getNightModeMeters() const;
+
+    // 재생 속도 (피치 유지 타임 스트레치)
+    void setPlaybackSpeed(float speed);
+    float getPlaybackSpeed() const;
+    void setTimeStretchMode(int mode);
+    float getTimeStretchLoad() const;
+
+    // Bit-perfect 모드
+    void enableBitPerfect(bool enable);
+    bool isBitPerfect() const;
+    uint64_t getOutputChecksum() const;
+
+    // warm-start (앱이 선택한 경우에만 무음 스트림 준비 및 대기열 첫 트랙 디코딩 캐시 준비)
+    void warmStart(JNIEnv* env, jstring jFirstTrackPath);
+    void disableWarmStart();
+
+    // 절전 deep-buffer 모드 (화면 꺼짐 재생)
+    void enableDeepBuffer(bool enable);
+    void setPlayerUiVisible(bool visible);
+    PowerStats getPowerStats() const;
+
+    // 하드웨어 레이트 자동 전환
+    void setAutoHardwareSwitching(bool enable);
+
+    // 보조 출력 팬아웃 (동시 재생)
+    int addOutputDevice(int32_t deviceId);
+    int addNullOutput(int32_t sampleRate, float clockPpm);
+    bool removeOutput(int outputId);
+    std::vector<FanoutOutputStats> getFanoutStats() const;
+
+    // 출력 방식 (콜백 / 전용 렌더 스레드 블로킹 쓰기)
+    void setOutputMode(int mode, int burstsInFlight);
+    OutputMetrics getOutputMetrics() const;
 
     // 하드웨어 최적화
     void optimizeForDevice(bool useHeadphones, bool isHighPerformanceDevice);
+    void setCrossfeedPreset(int preset);
+    void setCrossfeedBypass(bool bypass);
+    bool isCrossfeedActive() const;
 
     // 시각화 데이터 얻기
     std::vector<float> getVisualizationData();
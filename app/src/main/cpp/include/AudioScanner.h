@@ -1,13 +1,20 @@
 #ifndef PANCAKEMUSICBOX_AUDIOSCANNER_H
 #define PANCAKEMUSICBOX_AUDIOSCANNER_H
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <map>
+#include <unordered_map>
+#include <unordered_set>
 #include <memory>
 #include <functional>
 #include <mutex>
+#include <atomic>
+#include "AlbumArtCache.h"
 #include "AudioMetadata.h"
+#include "LibraryWatcher.h"
+#include "TrackStore.h"
 
 namespace pancakemusicbox {
 
@@ -20,12 +27,34 @@ public:
     static AudioScanner& getInstance();
     
     // 경로에 있는 모든 오디오 파일 스캔
+    // 이미 아는 파일은 지문(크기, 수정 시간, inode)이 같으면 건너뛰고, 바뀐 파일은 ID와 재생 기록을 유지한 채 다시 읽으며,
+    // 사라진 파일은 저장소에서 제거함
+    // 라이브러리가 비어 있을 때의 최초 스캔에서만 새 트랙의 추가 시간을 파일 수정 시간으로 둠
     bool scanDirectory(const std::string& directoryPath, 
                      std::function<void(int, int)> progressCallback = nullptr);
     
-    // 단일 오디오 파일 스캔 및 메타데이터 추출
+    // 단일 오디오 파일 스캔 및 메타데이터 추출 (지문이 같으면 건너뜀)
     bool scanFile(const std::string& filePath);
     
+    // 파일 경로의 트랙, 또는 디렉토리 경로 아래의 모든 트랙을 저장소에서 제거
+    // 반환: 제거한 트랙 수
+    int removePath(const std::string& path);
+    
+    // 스캔으로 트랙이 추가/변경/제거될 때마다 증가 (바뀐 것이 있는지 비교용)
+    uint64_t getLibraryGeneration() const { return libraryGeneration.load(); }
+    
+    // 루트 디렉토리들의 변경을 감시해 바뀐 경로만 반영 (callback은 감시 스레드에서 호출됨)
+    bool startWatching(const std::vector<std::string>& directoryPaths, LibraryWatcher::ChangeCallback callback);
+    void stopWatching();
+    LibraryWatcher::Mode getWatchMode();
+    
+    // 앨범 아트 캐시 디렉토리 설정 (설정하면 스캔 시 포함된 그림/폴더 아트를 albumArtPath로 채움, 빈 문자열이면 끔)
+    bool setArtworkCacheDirectory(const std::string& directoryPath);
+    
+    // 디렉토리 스캔에 쓸 작업자 스레드 수 (0이면 코어 수 기준 자동)
+    void setScanThreadCount(int threadCount);
+    int getScanThreadCount() const;
+    
     // ID로 트랙 정보 가져오기
     TrackMetadata getTrackById(const std::string& trackId);
     
@@ -35,13 +64,19 @@ public:
     // 장르별 트랙 정보 가져오기
     std::map<std::string, std::vector<TrackMetadata>> getTracksByGenre();
     
+    // 라이브러리 트랙들이 쓰는 앨범 아트 경로 (중복 제외, 썸네일 생성용)
+    std::vector<std::string> getAlbumArtPaths();
+    
+    // 패싯 조건(장르, 아티스트, 앨범, 연도, 포맷, 고해상도)을 모두 만족하는 트랙 가져오기
+    std::vector<TrackMetadata> queryTracks(const TrackFilter& filter);
+    
     // 최근 재생 트랙 가져오기 (lastPlayed 기준)
     std::vector<TrackMetadata> getRecentlyPlayedTracks(int limit = 10);
     
     // 자주 재생된 트랙 가져오기 (playCount 기준)
     std::vector<TrackMetadata> getFrequentlyPlayedTracks(int limit = 10);
     
-    // 최근 추가된 트랙 가져오기 (filePath의 생성 시간 기준)
+    // 최근 추가된 트랙 가져오기 (스캔에서 처음 발견한 시간 기준)
     std::vector<TrackMetadata> getRecentlyAddedTracks(int limit = 10);
     
     // 트랙 재생 횟수 업데이트
@@ -71,16 +106,46 @@ private:
     // 파일 확장자로 오디오 포맷 유추
     std::string getAudioFormatFromExtension(const std::string& filePath);
     
-    // 파일에서 메타데이터 추출
+    // 파일에서 메타데이터 추출 (스캔 작업자 스레드에서 동시에 호출됨)
     bool extractMetadata(const std::string& filePath, TrackMetadata& metadata);
     
-    // 데이터 저장소
-    std::map<std::string, TrackMetadata> tracks;
+    // 추출한 트랙을 저장소와 앨범 목록에 추가 (mutex를 잡은 상태에서 호출)
+    void addTrackLocked(const TrackMetadata& metadata);
+    
+    // 같은 경로의 기존 트랙이 있으면 ID, 재생 기록, 추가 시간을 이어받고 없으면 지금을 추가 시간으로 (mutex를 잡은 상태에서 호출)
+    bool inheritExistingTrackLocked(TrackMetadata& metadata);
+    
+    // 앨범 트랙 목록에서 주어진 트랙들을 빼고 빈 앨범은 제거 (mutex를 잡은 상태에서 호출)
+    void removeTracksFromAlbumsLocked(const std::unordered_set<std::string>& trackIds);
+    
+    // 파일 경로 자신이나 상위 디렉토리가 스캔 중 읽지 못한 경로인지
+    static bool isUnderUnreadablePath(const std::string& filePath,
+                                      const std::unordered_set<std::string>& unreadablePaths);
+    
+    // 앨범을 묶는 키 (같은 제목이라도 아티스트가 다르면 다른 앨범)
+    static std::string makeAlbumKey(const std::string& albumTitle, const std::string& artist);
+    
+    // 데이터 저장소 (트랙은 열 단위 저장소, ID와 파일 경로로 핸들을 찾음)
+    TrackStore tracks;
     std::map<std::string, AlbumMetadata> albums;
+    std::unordered_map<std::string, std::string> albumIdsByKey;    // 앨범 키 -> 앨범 ID
     std::map<std::string, PlaylistMetadata> playlists;
     
     // 스레드 안전을 위한 뮤텍스
     std::mutex mutex;
+    
+    // 디렉토리 스캔 작업자 수 (0: 자동)
+    std::atomic<int> scanThreadCount{0};
+    
+    // 트랙이 추가/변경/제거될 때마다 증가
+    std::atomic<uint64_t> libraryGeneration{0};
+    
+    // 내용 해시로 중복을 없앤 앨범 아트 저장소
+    AlbumArtCache artworkCache;
+    
+    // 라이브러리 감시 스레드 (감시 스레드가 저장소 mutex를 잡으므로 별도 락으로 보호)
+    std::unique_ptr<LibraryWatcher> watcher;
+    std::mutex watcherMutex;
 };
 
 } // namespace pancakemusicbox
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cmath>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+/**
+ * 2차 IIR 필터 (biquad) 계수
+ * RBJ Audio EQ Cookbook 공식 사용, a0로 정규화된 값 저장
+ */
+struct BiquadCoefficients {
+    float b0 = 1.0f;
+    float b1 = 0.0f;
+    float b2 = 0.0f;
+    float a1 = 0.0f;
+    float a2 = 0.0f;
+
+    // 피킹 EQ (gainDb만큼 centerHz 주변을 증폭/감쇠)
+    static BiquadCoefficients peaking(float sampleRate, float centerHz, float q, float gainDb) {
+        double A = std::pow(10.0, gainDb / 40.0);
+        double w0 = 2.0 * M_PI * centerHz / sampleRate;
+        double alpha = std::sin(w0) / (2.0 * q);
+        double cosW0 = std::cos(w0);
+        return normalize(1.0 + alpha * A, -2.0 * cosW0, 1.0 - alpha * A,
+                         1.0 + alpha / A, -2.0 * cosW0, 1.0 - alpha / A);
+    }
+
+    // 로우 쉘프 (cornerHz 이하 대역을 gainDb만큼 증폭/감쇠)
+    static BiquadCoefficients lowShelf(float sampleRate, float cornerHz, float q, float gainDb) {
+        double A = std::pow(10.0, gainDb / 40.0);
+        double w0 = 2.0 * M_PI * cornerHz / sampleRate;
+        double alpha = std::sin(w0) / (2.0 * q);
+        double cosW0 = std::cos(w0);
+        double sqrtA2alpha = 2.0 * std::sqrt(A) * alpha;
+        return normalize(A * ((A + 1) - (A - 1) * cosW0 + sqrtA2alpha),
+                         2 * A * ((A - 1) - (A + 1) * cosW0),
+                         A * ((A + 1) - (A - 1) * cosW0 - sqrtA2alpha),
+                         (A + 1) + (A - 1) * cosW0 + sqrtA2alpha,
+                         -2 * ((A - 1) + (A + 1) * cosW0),
+                         (A + 1) + (A - 1) * cosW0 - sqrtA2alpha);
+    }
+
+    // 하이 쉘프 (cornerHz 이상 대역을 gainDb만큼 증폭/감쇠)
+    static BiquadCoefficients highShelf(float sampleRate, float cornerHz, float q, float gainDb) {
+        double A = std::pow(10.0, gainDb / 40.0);
+        double w0 = 2.0 * M_PI * cornerHz / sampleRate;
+        double alpha = std::sin(w0) / (2.0 * q);
+        double cosW0 = std::cos(w0);
+        double sqrtA2alpha = 2.0 * std::sqrt(A) * alpha;
+        return normalize(A * ((A + 1) + (A - 1) * cosW0 + sqrtA2alpha),
+                         -2 * A * ((A - 1) + (A + 1) * cosW0),
+                         A * ((A + 1) + (A - 1) * cosW0 - sqrtA2alpha),
+                         (A + 1) - (A - 1) * cosW0 + sqrtA2alpha,
+                         2 * ((A - 1) - (A + 1) * cosW0),
+                         (A + 1) - (A - 1) * cosW0 - sqrtA2alpha);
+    }
+
+    // 2차 로우패스 (Q = 0.7071이면 Butterworth)
+    static BiquadCoefficients lowPass(float sampleRate, float cutoffHz, float q) {
+        double w0 = 2.0 * M_PI * cutoffHz / sampleRate;
+        double alpha = std::sin(w0) / (2.0 * q);
+        double cosW0 = std::cos(w0);
+        return normalize((1.0 - cosW0) / 2.0, 1.0 - cosW0, (1.0 - cosW0) / 2.0,
+                         1.0 + alpha, -2.0 * cosW0, 1.0 - alpha);
+    }
+
+    // 2차 하이패스 (Q = 0.7071이면 Butterworth)
+    static BiquadCoefficients highPass(float sampleRate, float cutoffHz, float q) {
+        double w0 = 2.0 * M_PI * cutoffHz / sampleRate;
+        double alpha = std::sin(w0) / (2.0 * q);
+        double cosW0 = std::cos(w0);
+        return normalize((1.0 + cosW0) / 2.0, -(1.0 + cosW0), (1.0 + cosW0) / 2.0,
+                         1.0 + alpha, -2.0 * cosW0, 1.0 - alpha);
+    }
+
+    // 2차 올패스 (Q = 0.7071이면 LR4 크로스오버 합과 같은 위상 응답)
+    static BiquadCoefficients allPass(float sampleRate, float centerHz, float q) {
+        double w0 = 2.0 * M_PI * centerHz / sampleRate;
+        double alpha = std::sin(w0) / (2.0 * q);
+        double cosW0 = std::cos(w0);
+        return normalize(1.0 - alpha, -2.0 * cosW0, 1.0 + alpha,
+                         1.0 + alpha, -2.0 * cosW0, 1.0 - alpha);
+    }
+
+    // 1차 로우 쉘프 × 1차 하이 쉘프 (두 쉘프를 한 섹션으로, 전환 주파수에서 이득의 절반)
+    static BiquadCoefficients dualShelf(float sampleRate, float lowHz, float lowGainDb,
+                                        float highHz, float highGainDb) {
+        double gLow = std::pow(10.0, lowGainDb / 40.0);
+        double gHigh = std::pow(10.0, highGainDb / 40.0);
+        double kLow = 1.0 / std::tan(M_PI * lowHz / sampleRate);
+        double kHigh = 1.0 / std::tan(M_PI * highHz / sampleRate);
+
+        // 로우 쉘프 H(s) = (s + g) / (s + 1/g), 하이 쉘프 H(s) = (g·s + 1) / (s/g + 1) 를 쌍선형 변환
+        double lowB0 = kLow + gLow, lowB1 = gLow - kLow;
+        double lowA0 = kLow + 1.0 / gLow, lowA1 = 1.0 / gLow - kLow;
+        double highB0 = gHigh * kHigh + 1.0, highB1 = 1.0 - gHigh * kHigh;
+        double highA0 = kHigh / gHigh + 1.0, highA1 = 1.0 - kHigh / gHigh;
+
+        return normalize(lowB0 * highB0, lowB0 * highB1 + lowB1 * highB0, lowB1 * highB1,
+                         lowA0 * highA0, lowA0 * highA1 + lowA1 * highA0, lowA1 * highA1);
+    }
+
+private:
+    static BiquadCoefficients normalize(double b0, double b1, double b2, double a0, double a1, double a2) {
+        BiquadCoefficients c;
+        c.b0 = static_cast<float>(b0 / a0);
+        c.b1 = static_cast<float>(b1 / a0);
+        c.b2 = static_cast<float>(b2 / a0);
+        c.a1 = static_cast<float>(a1 / a0);
+        c.a2 = static_cast<float>(a2 / a0);
+        return c;
+    }
+};
+
+/**
+ * 채널별 biquad 상태 (Direct Form II Transposed)
+ */
+struct BiquadState {
+    float z1 = 0.0f;
+    float z2 = 0.0f;
+
+    inline float process(const BiquadCoefficients& c, float x) {
+        float y = c.b0 * x + z1;
+        z1 = c.b1 * x - c.a1 * y + z2;
+        z2 = c.b2 * x - c.a2 * y;
+        return y;
+    }
+
+    void reset() {
+        z1 = 0.0f;
+        z2 = 0.0f;
+    }
+};
@@ -0,0 +1,18 @@
+#pragma once
+
+/**
+ * 실행 중인 CPU의 SIMD 기능 (시작 시 한 번 감지)
+ * 하나의 APK가 arm64, armv7, x86_64 기기에서 모두 실행되므로 컴파일 타임 매크로만으로는 판단할 수 없음
+ */
+struct CpuFeatures {
+    bool neon = false;
+    bool sse41 = false;
+    bool avx2 = false;
+    bool f16c = false;
+
+    // 감지 결과 (최초 호출 시 감지 후 캐시)
+    static const CpuFeatures& get();
+
+private:
+    static CpuFeatures detect();
+};
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "SampleFormat.h"
+
+/**
+ * 디코딩이 끝난 트랙 하나의 PCM 데이터
+ * 샘플은 소스의 원래 폭(int16/int24/float32) 또는 float16으로 저장하고
+ * readFrames()에서 블록 단위로 float 변환
+ */
+class DecodedAudio {
+public:
+    // 형식에 맞는 TypedDecodedAudio 인스턴스 생성
+    static std::shared_ptr<DecodedAudio> create(SampleFormat format,
+                                                int sampleRate,
+                                                int channelCount,
+                                                int bitDepth,
+                                                int64_t totalFrames);
+
+    // 소스 비트 뎁스에 맞는 저장 형식 선택 (compact이면 고해상도 소스를 float16으로 저장)
+    static SampleFormat selectStorageFormat(int bitDepth, bool compact);
+
+    virtual ~DecodedAudio() = default;
+
+    // startFrame부터 numFrames 프레임을 float로 변환하여 복사, 실제 복사한 프레임 수 반환
+    virtual int32_t readFrames(int64_t startFrame, float* output, int32_t numFrames) const = 0;
+
+    // float 샘플을 저장 형식으로 변환하여 기록 (디코더에서 사용), 실제 기록한 프레임 수 반환
+    virtual int32_t writeFrames(int64_t startFrame, const float* input, int32_t numFrames) = 0;
+
+    // 저장 형식 그대로 복사 (bit-perfect 출력용), 실제 복사한 프레임 수 반환
+    int32_t readRawFrames(int64_t startFrame, void* output, int32_t numFrames) const;
+
+    // 저장 형식이 소스 샘플을 손실 없이 담고 있는지 여부 (float16 압축 저장이면 false)
+    bool isLossless() const;
+
+    // 저장 형식 그대로의 원본 데이터 (디코더가 네이티브 폭으로 직접 기록할 때 사용)
+    uint8_t* getRawData() { return mData.data(); }
+    const uint8_t* getRawData() const { return mData.data(); }
+
+    SampleFormat getFormat() const { return mFormat; }
+    int getSampleRate() const { return mSampleRate; }
+    int getChannelCount() const { return mChannelCount; }
+    int getBitDepth() const { return mBitDepth; }
+    int64_t getTotalFrames() const { return mTotalFrames; }
+    size_t getSizeInBytes() const { return sizeof(*this) + mData.size(); }
+
+protected:
+    DecodedAudio(SampleFormat format, int sampleRate, int channelCount, int bitDepth, int64_t totalFrames);
+
+    // 범위를 벗어나지 않도록 처리할 프레임 수 계산
+    int32_t clampFrames(int64_t startFrame, int32_t numFrames) const {
+        if (startFrame < 0 || startFrame >= mTotalFrames || numFrames <= 0) {
+            return 0;
+        }
+        return static_cast<int32_t>(std::min<int64_t>(numFrames, mTotalFrames - startFrame));
+    }
+
+    SampleFormat mFormat;
+    int mSampleRate;
+    int mChannelCount;
+    int mBitDepth;
+    int64_t mTotalFrames;
+    std::vector<uint8_t> mData;
+};
+
+/**
+ * 저장 형식별 DecodedAudio 구현
+ * 가상 호출은 블록당 한 번이며, 변환 루프는 형식별로 컴파일 타임에 특수화됨
+ */
+template <SampleFormat Format>
+class TypedDecodedAudio : public DecodedAudio {
+public:
+    using Traits = SampleTraits<Format>;
+
+    TypedDecodedAudio(int sampleRate, int channelCount, int bitDepth, int64_t totalFrames)
+        : DecodedAudio(Format, sampleRate, channelCount, bitDepth, totalFrames) {}
+
+    int32_t readFrames(int64_t startFrame, float* output, int32_t numFrames) const override {
+        int32_t frames = clampFrames(startFrame, numFrames);
+        if (frames > 0) {
+            size_t offset = static_cast<size_t>(startFrame) * mChannelCount * Traits::kBytesPerSample;
+            Traits::toFloat(mData.data() + offset, output, static_cast<size_t>(frames) * mChannelCount);
+        }
+        return frames;
+    }
+
+    int32_t writeFrames(int64_t startFrame, const float* input, int32_t numFrames) override {
+        int32_t frames = clampFrames(startFrame, numFrames);
+        if (frames > 0) {
+            size_t offset = static_cast<size_t>(startFrame) * mChannelCount * Traits::kBytesPerSample;
+            Traits::fromFloat(input, mData.data() + offset, static_cast<size_t>(frames) * mChannelCount);
+        }
+        return frames;
+    }
+};
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "DecodedAudio.h"
+
+/**
+ * 디코딩된 PCM 데이터 캐시 키
+ * 같은 파일이라도 디코더 파라미터가 다르면 별도 항목으로 취급
+ */
+struct DecodedAudioKey {
+    std::string filePath;
+    int sampleRate = 0;
+    int channelCount = 0;
+    int bitDepth = 0;
+
+    bool operator==(const DecodedAudioKey& other) const {
+        return filePath == other.filePath &&
+               sampleRate == other.sampleRate &&
+               channelCount == other.channelCount &&
+               bitDepth == other.bitDepth;
+    }
+};
+
+struct DecodedAudioKeyHash {
+    size_t operator()(const DecodedAudioKey& key) const {
+        size_t hash = std::hash<std::string>()(key.filePath);
+        hash ^= std::hash<int>()(key.sampleRate) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        hash ^= std::hash<int>()(key.channelCount) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        hash ^= std::hash<int>()(key.bitDepth) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        return hash;
+    }
+};
+
+/**
+ * 최근 재생/다음 재생 예정 트랙의 디코딩 결과를 보관하는 LRU 캐시
+ * 바이트 예산을 넘으면 가장 오래 사용되지 않은 항목부터 제거
+ */
+class DecodedAudioCache {
+public:
+    static constexpr size_t kDefaultBudgetBytes = 128 * 1024 * 1024; // 128MB
+
+    explicit DecodedAudioCache(size_t budgetBytes = kDefaultBudgetBytes);
+
+    // 캐시 조회 (히트 시 LRU 최신으로 갱신), 없으면 nullptr
+    std::shared_ptr<const DecodedAudio> get(const DecodedAudioKey& key);
+
+    // 캐시에 추가 (예산보다 큰 항목은 저장하지 않음)
+    void put(const DecodedAudioKey& key, std::shared_ptr<const DecodedAudio> audio);
+
+    bool contains(const DecodedAudioKey& key) const;
+    void clear();
+
+    void setBudgetBytes(size_t budgetBytes);
+    size_t getBudgetBytes() const;
+    size_t getUsedBytes() const;
+
+    // 새로 디코딩하는 고해상도 항목을 float16으로 압축 저장할지 여부
+    void setCompactStorage(bool compact);
+    bool isCompactStorage() const;
+
+    uint64_t getHitCount() const;
+    uint64_t getMissCount() const;
+
+private:
+    // mLock을 잡은 상태에서 호출
+    void evictToBudgetLocked();
+
+    using Entry = std::pair<DecodedAudioKey, std::shared_ptr<const DecodedAudio>>;
+    using EntryList = std::list<Entry>;
+
+    EntryList mEntries; // 앞쪽이 가장 최근에 사용된 항목
+    std::unordered_map<DecodedAudioKey, EntryList::iterator, DecodedAudioKeyHash> mIndex;
+
+    size_t mBudgetBytes;
+    size_t mUsedBytes = 0;
+    bool mCompactStorage = false;
+    uint64_t mHitCount = 0;
+    uint64_t mMissCount = 0;
+
+    mutable std::mutex mLock;
+};
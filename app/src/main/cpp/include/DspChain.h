@@ -0,0 +1,216 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "Biquad.h"
+#include "DspKernels.h"
+#include "LoudnessCompensation.h"
+#include "MultibandCompressor.h"
+#include "SampleFormat.h"
+
+/**
+ * 헤드폰 크로스피드 프리셋 (bs2b 방식: 반대 채널 저역 통과 + 직접 채널 고역 쉘프)
+ */
+enum class CrossfeedPreset {
+    Default = 0,   // 700 Hz, 4.5 dB (자연스러운 기본값)
+    ChuMoy = 1,    // 700 Hz, 6.0 dB
+    JanMeier = 2   // 650 Hz, 9.5 dB (약한 크로스피드)
+};
+
+/**
+ * DSP 체인 설정값
+ */
+struct DspSettings {
+    static constexpr int kEQBands = 10;
+
+    int sampleRate = 44100;
+    int channelCount = 2;
+    SampleFormat outputFormat = SampleFormat::Float32;
+
+    float volume = 1.0f;
+    bool eqEnabled = false;
+    std::array<float, kEQBands> eqGains{};  // dB
+    bool loudnessEnabled = false;      // 볼륨 연동 라우드니스 보상 (EQ 캐스케이드에 섹션 하나 추가)
+    bool normalizationEnabled = false;
+    float targetLUFS = -14.0f;
+    bool crossfeedEnabled = false;     // 스테레오 출력에서만 적용
+    CrossfeedPreset crossfeedPreset = CrossfeedPreset::Default;
+    bool compressorEnabled = false;    // 3밴드 나이트 모드 (모노/스테레오)
+    float compressorMakeupDb = 8.0f;
+};
+
+/**
+ * 나이트 모드 미터 (UI 스레드에서 락 없이 읽음)
+ */
+struct CompressorMeters {
+    float gainReductionDb[MultibandCompressor::kBands];
+    float blockTimeUs;          // 192프레임 블록으로 환산한 최근 DSP 처리 시간
+    uint32_t budgetOverruns;    // 처리 시간 예산을 넘긴 블록 수
+};
+
+/**
+ * 단계 on/off 전환 시 원음과 처리 결과를 섞는 비율 램프
+ */
+struct MixRamp {
+    float mix = 0.0f;
+    float target = 0.0f;
+    float step = 0.0f;
+
+    inline float next() {
+        if (mix != target) {
+            mix = mix < target ? std::min(target, mix + step) : std::max(target, mix - step);
+        }
+        return mix;
+    }
+
+    bool isOff() const { return mix == 0.0f && target == 0.0f; }
+};
+
+/**
+ * 볼륨 → EQ → 멀티밴드 컴프레서 → 크로스피드 → 볼륨 정규화 → 리미터 → 출력 형식 변환을
+ * 한 번의 패스로 처리하는 DSP 체인
+ *
+ * 자주 쓰이는 단계 조합은 템플릿으로 컴파일 타임에 융합되어 샘플 루프 안에 설정 분기가 없고,
+ * 설정이 바뀌면 configure()에서 해당 조합의 커널 포인터로 교체
+ * 볼륨/EQ는 L1 크기 블록에 DspKernels SIMD 커널로 먼저 적용하고, 나머지 단계와 출력 변환은 같은 블록을 한 번 더 순회하며 융합
+ */
+class DspChain {
+public:
+    static constexpr int kMaxChannels = 8;
+
+    // 융합 커널이 볼륨/EQ를 먼저 적용하는 블록 크기 (L1에 머무는 크기)
+    static constexpr int32_t kFuseBlockFrames = 256;
+
+    // EQ 밴드 중심 주파수 (ISO 옥타브 밴드)
+    static constexpr std::array<float, DspSettings::kEQBands> kEQFrequencies = {
+        31.0f, 62.0f, 125.0f, 250.0f, 500.0f, 1000.0f, 2000.0f, 4000.0f, 8000.0f, 16000.0f
+    };
+
+    DspChain();
+
+    // 설정 반영 (계수 재계산 및 커널 교체), 오디오 스레드와 같은 락 안에서 호출
+    void configure(const DspSettings& settings);
+
+    // input(float)을 처리하여 output에 출력 형식으로 기록 (input == output 가능, float 출력일 때만)
+    void process(const float* input, void* output, int32_t numFrames);
+
+    // process()와 같은 결과를 단계마다 버퍼 전체를 한 번씩 순회하며 만드는 기준 경로
+    // 융합 커널과의 비교(벤치마크, 검증)용이며 임시 버퍼를 할당할 수 있으므로 오디오 스레드에서는 쓰지 않음
+    void processPerStage(const float* input, void* output, int32_t numFrames);
+
+    // 필터/엔벨로프 상태 초기화 (트랙 변경, 탐색 시)
+    void reset();
+
+    // 모든 단계가 비활성이고 출력이 float이면 true (입력 그대로 통과)
+    bool isNeutral() const { return mNeutral; }
+
+    // 크로스피드가 적용 중인지 여부 (바이패스 전환 페이드 중 포함)
+    bool isCrossfeedActive() const { return mUseCrossfeed; }
+
+    // 나이트 모드 컴프레서가 적용 중인지 여부 (끄는 페이드 중 포함)
+    bool isCompressorActive() const { return mUseCompressor; }
+
+    // 나이트 모드 미터 (락 없이 읽을 수 있음)
+    CompressorMeters getCompressorMeters() const;
+
+private:
+    using Kernel = void (*)(DspChain& chain, const float* input, uint8_t* output, int32_t numFrames);
+
+    // 단계 조합 비트 (커널 테이블 인덱스)
+    enum StageBits {
+        kStageLimit = 1,
+        kStageNormalize = 2,
+        kStageCrossfeed = 4,
+        kStageCompressor = 8,
+        kStageEQ = 16,
+        kStageVolume = 32,
+        kStageCount = 64
+    };
+
+    template <bool kVolume, bool kEQ, bool kCompressor, bool kCrossfeed, bool kNormalize, bool kLimit,
+              SampleFormat OutFormat>
+    static void processFused(DspChain& chain, const float* input, uint8_t* output, int32_t numFrames);
+
+    template <SampleFormat OutFormat, size_t... Stages>
+    static constexpr std::array<Kernel, sizeof...(Stages)> makeKernelTable(std::index_sequence<Stages...>);
+
+    static Kernel selectKernel(int stages, SampleFormat format);
+
+    // 현재 활성 단계에 맞는 커널 선택
+    void updateKernel();
+
+    // 크로스피드 계수 계산
+    void updateCrossfeedCoefficients(CrossfeedPreset preset);
+
+    // 버퍼에 EQ 캐스케이드 제자리 적용 (라우드니스 보상 램프 포함)
+    void applyEQ(const DspKernelTable& kernels, float* buffer, int32_t numFrames);
+
+    // 라우드니스 보상 섹션 계수를 목표값 쪽으로 한 프레임만큼 이동
+    inline void stepLoudnessRamp();
+
+    // 정규화 게인 목표값 갱신 (블록 단위)
+    void updateNormalizationTarget(float blockMeanSquare, int32_t numFrames);
+
+    // 블록 처리 후 바이패스 페이드아웃이 끝난 단계를 커널에서 제외
+    void finishBlock();
+
+    Kernel mKernel;
+    int mStages = 0;
+    bool mNeutral = true;
+    int mSampleRate = 44100;
+    int mChannelCount = 2;
+    SampleFormat mOutputFormat = SampleFormat::Float32;
+
+    // 볼륨
+    float mVolume = 1.0f;
+
+    // EQ (0dB가 아닌 밴드만 섹션으로 유지)
+    std::vector<BiquadCoefficients> mEQSections;
+    std::vector<BiquadState> mEQState;  // [section * kMaxChannels + channel]
+
+    // 라우드니스 보상 (켜져 있으면 mEQSections[0], 볼륨 변경 시 계수를 선형 보간)
+    bool mUseLoudness = false;
+    BiquadCoefficients mLoudnessTarget;
+    BiquadCoefficients mLoudnessStep;
+    int32_t mLoudnessRampFrames = 0;
+
+    // 멀티밴드 컴프레서 (켜고 끌 때 mix 램프)
+    bool mUseCompressor = false;
+    MultibandCompressor mCompressor;
+    float mCompressorMakeupDb = 0.0f;
+    MixRamp mCompressorMix;
+    std::atomic<float> mBlockTimeUs{0.0f};
+    std::atomic<uint32_t> mBudgetOverruns{0};
+
+    // 크로스피드 (1차 IIR, 바이패스 전환 시 mix를 램프하여 끊김 방지)
+    bool mUseCrossfeed = false;
+    float mCrossfeedLowA0 = 0.0f;
+    float mCrossfeedLowB1 = 0.0f;
+    float mCrossfeedHighA0 = 1.0f;
+    float mCrossfeedHighA1 = 0.0f;
+    float mCrossfeedHighB1 = 0.0f;
+    float mCrossfeedGain = 1.0f;
+    MixRamp mCrossfeedMix;
+    float mCrossfeedLow[2] = {0.0f, 0.0f};
+    float mCrossfeedHigh[2] = {0.0f, 0.0f};
+    float mCrossfeedPrevInput[2] = {0.0f, 0.0f};
+
+    // 볼륨 정규화 (K-weighting 없는 근사 LUFS)
+    bool mNormalizationEnabled = false;
+    float mTargetLUFS = -14.0f;
+    float mLoudnessMeanSquare = 0.0f;
+    float mNormalizationGain = 1.0f;
+    float mNormalizationTargetGain = 1.0f;
+    float mNormalizationSmoothing = 0.0f;
+
+    // 리미터 (즉시 어택, 지수 릴리즈)
+    float mLimiterGain = 1.0f;
+    float mLimiterRelease = 0.0f;
+
+    // 볼륨/EQ를 적용한 블록 (융합 커널은 kFuseBlockFrames 단위, processPerStage()는 전체)
+    std::vector<float> mStageBuffer;
+};
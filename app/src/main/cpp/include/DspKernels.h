@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Biquad.h"
+
+/**
+ * 핫 루틴별 구현 함수 테이블
+ * ISA별 변형(scalar, NEON, SSE4.1, AVX2)이 각각 하나의 테이블을 가지며,
+ * 변환 커널과 applyGain은 scalar와 비트 단위로 같아야 하고, 누산 커널(sumSquares, dotProduct, binEnergies)은
+ * 합산 순서 차이, 필터/FFT/보간 커널은 컴파일러의 곱셈-덧셈 융합 차이만큼의 허용 오차 내로 같아야 함
+ */
+struct DspKernelTable {
+    const char* name;
+
+    // int16 PCM -> float [-1, 1)
+    void (*int16ToFloat)(const int16_t* src, float* dst, size_t count);
+
+    // float -> int16 PCM (반올림은 std::round와 동일하게 0에서 먼 쪽, 범위 밖은 클램핑)
+    void (*floatToInt16)(const float* src, int16_t* dst, size_t count);
+
+    // IEEE 754 half -> float
+    void (*halfToFloat)(const uint16_t* src, float* dst, size_t count);
+
+    // 제곱합 (레벨 미터 및 스펙트럼 밴드 에너지 계산)
+    float (*sumSquares)(const float* data, size_t count);
+
+    // 내적 (타임 스트레치의 상호상관 탐색)
+    float (*dotProduct)(const float* a, const float* b, size_t count);
+
+    // 제자리 게인 (볼륨, 역 FFT 스케일링)
+    void (*applyGain)(float* data, size_t count, float gain);
+
+    // 인터리브 버퍼에 biquad 섹션들을 차례로 제자리 적용 (채널 ch, 섹션 s의 상태는 states[s * stateStride + ch])
+    void (*biquadCascade)(float* data, size_t frames, int channels, const BiquadCoefficients* coefficients,
+                          BiquadState* states, size_t sections, size_t stateStride);
+
+    // radix-2 FFT 한 단계의 버터플라이 (길이 2 * half 블록마다, 트위들은 이 단계의 half개, 역변환은 direction = -1)
+    void (*fftStage)(float* real, float* imag, size_t size, size_t half,
+                     const float* twiddleReal, const float* twiddleImag, float direction);
+
+    // 4점 큐빅 Hermite 보간: 출력 n은 buffer의 프레임 위치 1 + phase + n * ratio (AsyncResampler)
+    void (*resampleCubic)(const float* buffer, int channels, float* output, int32_t outputFrames,
+                          double phase, double ratio);
+
+    // 연속 구간 bins개의 제곱합 (스펙트럼/레벨 표시의 밴드 에너지)
+    void (*binEnergies)(const float* data, size_t binSize, size_t bins, float* energies);
+};
+
+/**
+ * DSP 커널 레지스트리
+ * 감지된 CPU 기능에 맞는 가장 빠른 변형을 최초 사용 시 한 번 선택
+ */
+class DspKernels {
+public:
+    // 현재 CPU에서 사용할 커널
+    static const DspKernelTable& active();
+
+    // 기준이 되는 scalar 구현
+    static const DspKernelTable& scalar();
+
+    // 현재 CPU에서 실행 가능한 모든 변형 (scalar 포함, 느린 순)
+    static std::vector<const DspKernelTable*> available();
+};
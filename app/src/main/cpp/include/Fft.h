@@ -0,0 +1,30 @@
+#pragma once
+
+#include <vector>
+
+/**
+ * 고정 크기 radix-2 복소 FFT
+ * 트위들 계수와 비트 역순 테이블을 생성 시 미리 계산하므로 transform()은 메모리를 할당하지 않음
+ * 버터플라이와 역변환 스케일링은 DspKernels의 CPU별 커널로 수행
+ */
+class Fft {
+public:
+    // size는 2의 거듭제곱이어야 함
+    explicit Fft(int size = 0);
+
+    void resize(int size);
+    int getSize() const { return mSize; }
+
+    // 제자리 변환 (inverse는 1/N 스케일링 포함)
+    void forward(float* real, float* imag) const;
+    void inverse(float* real, float* imag) const;
+
+private:
+    void transform(float* real, float* imag, bool inverse) const;
+
+    int mSize = 0;
+    std::vector<int> mBitReverse;
+    // 단계별로 연속 배치한 트위들 (반 길이 half인 단계는 half - 1 위치부터 half개, 벡터로 바로 읽음)
+    std::vector<float> mTwiddleReal;
+    std::vector<float> mTwiddleImag;
+};
@@ -0,0 +1,110 @@
+#pragma once
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**
+ * 4레인 float 벡터
+ * NEON과 SSE2는 각 ABI의 기본 ISA이므로 런타임 디스패치 없이 컴파일 타임에 선택
+ * (밴드 × 채널처럼 레인 수가 고정된 필터 뱅크를 한 번에 처리하는 데 사용)
+ */
+struct Float4 {
+#if defined(__ARM_NEON)
+    float32x4_t v;
+
+    Float4() : v(vdupq_n_f32(0.0f)) {}
+    Float4(float32x4_t value) : v(value) {}
+    explicit Float4(float value) : v(vdupq_n_f32(value)) {}
+    Float4(float a, float b, float c, float d) {
+        const float lanes[4] = {a, b, c, d};
+        v = vld1q_f32(lanes);
+    }
+
+    void store(float* out) const { vst1q_f32(out, v); }
+
+    friend Float4 operator+(Float4 a, Float4 b) { return vaddq_f32(a.v, b.v); }
+    friend Float4 operator-(Float4 a, Float4 b) { return vsubq_f32(a.v, b.v); }
+    friend Float4 operator*(Float4 a, Float4 b) { return vmulq_f32(a.v, b.v); }
+    static Float4 max(Float4 a, Float4 b) { return vmaxq_f32(a.v, b.v); }
+    static Float4 abs(Float4 a) { return vabsq_f32(a.v); }
+    // a > b인 레인은 ifGreater, 나머지는 otherwise
+    static Float4 selectGreater(Float4 a, Float4 b, Float4 ifGreater, Float4 otherwise) {
+        return vbslq_f32(vcgtq_f32(a.v, b.v), ifGreater.v, otherwise.v);
+    }
+#elif defined(__SSE2__)
+    __m128 v;
+
+    Float4() : v(_mm_setzero_ps()) {}
+    Float4(__m128 value) : v(value) {}
+    explicit Float4(float value) : v(_mm_set1_ps(value)) {}
+    Float4(float a, float b, float c, float d) : v(_mm_setr_ps(a, b, c, d)) {}
+
+    void store(float* out) const { _mm_storeu_ps(out, v); }
+
+    friend Float4 operator+(Float4 a, Float4 b) { return _mm_add_ps(a.v, b.v); }
+    friend Float4 operator-(Float4 a, Float4 b) { return _mm_sub_ps(a.v, b.v); }
+    friend Float4 operator*(Float4 a, Float4 b) { return _mm_mul_ps(a.v, b.v); }
+    static Float4 max(Float4 a, Float4 b) { return _mm_max_ps(a.v, b.v); }
+    static Float4 abs(Float4 a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v); }
+    static Float4 selectGreater(Float4 a, Float4 b, Float4 ifGreater, Float4 otherwise) {
+        __m128 mask = _mm_cmpgt_ps(a.v, b.v);
+        return _mm_or_ps(_mm_and_ps(mask, ifGreater.v), _mm_andnot_ps(mask, otherwise.v));
+    }
+#else
+    float v[4];
+
+    Float4() : v{0.0f, 0.0f, 0.0f, 0.0f} {}
+    explicit Float4(float value) : v{value, value, value, value} {}
+    Float4(float a, float b, float c, float d) : v{a, b, c, d} {}
+
+    void store(float* out) const {
+        for (int i = 0; i < 4; i++) out[i] = v[i];
+    }
+
+    friend Float4 operator+(Float4 a, Float4 b) {
+        return Float4(a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3]);
+    }
+    friend Float4 operator-(Float4 a, Float4 b) {
+        return Float4(a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3]);
+    }
+    friend Float4 operator*(Float4 a, Float4 b) {
+        return Float4(a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3]);
+    }
+    static Float4 max(Float4 a, Float4 b) {
+        return Float4(a.v[0] > b.v[0] ? a.v[0] : b.v[0], a.v[1] > b.v[1] ? a.v[1] : b.v[1],
+                      a.v[2] > b.v[2] ? a.v[2] : b.v[2], a.v[3] > b.v[3] ? a.v[3] : b.v[3]);
+    }
+    static Float4 abs(Float4 a) {
+        return Float4(a.v[0] < 0 ? -a.v[0] : a.v[0], a.v[1] < 0 ? -a.v[1] : a.v[1],
+                      a.v[2] < 0 ? -a.v[2] : a.v[2], a.v[3] < 0 ? -a.v[3] : a.v[3]);
+    }
+    static Float4 selectGreater(Float4 a, Float4 b, Float4 ifGreater, Float4 otherwise) {
+        Float4 r;
+        for (int i = 0; i < 4; i++) r.v[i] = a.v[i] > b.v[i] ? ifGreater.v[i] : otherwise.v[i];
+        return r;
+    }
+#endif
+};
+
+/**
+ * 레인별 계수를 갖는 4채널 biquad (Direct Form II Transposed)
+ */
+struct Biquad4 {
+    Float4 b0, b1, b2, a1, a2;
+    Float4 z1, z2;
+
+    inline Float4 process(Float4 x) {
+        Float4 y = b0 * x + z1;
+        z1 = b1 * x - a1 * y + z2;
+        z2 = b2 * x - a2 * y;
+        return y;
+    }
+
+    void reset() {
+        z1 = Float4(0.0f);
+        z2 = Float4(0.0f);
+    }
+};
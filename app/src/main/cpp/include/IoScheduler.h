@@ -0,0 +1,69 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * 트랙별 I/O 통계
+ */
+struct IoStats {
+    uint64_t bytesRead = 0;     // pread로 읽은 바이트 수
+    uint64_t ioWaitNs = 0;      // 디코더가 데이터를 기다린 시간 (나노초)
+    uint32_t stallCount = 0;    // 디코더가 I/O 완료를 기다려야 했던 횟수
+    uint32_t readCount = 0;     // 발행한 pread 횟수
+
+    IoStats& operator+=(const IoStats& other) {
+        bytesRead += other.bytesRead;
+        ioWaitNs += other.ioWaitNs;
+        stallCount += other.stallCount;
+        readCount += other.readCount;
+        return *this;
+    }
+};
+
+/**
+ * 디코더 소스를 위한 전용 I/O 스레드
+ * 큰 단위의 pread 작업과 다음 트랙 프리페치를 디코딩/재생 스레드 밖에서 처리
+ */
+class IoScheduler {
+public:
+    // 다음 트랙 프리페치 기본 크기 (파일 앞부분)
+    static constexpr size_t kDefaultPrefetchBytes = 4 * 1024 * 1024;
+
+    static IoScheduler& getInstance();
+
+    // I/O 스레드에서 실행할 작업 등록 (highPriority 작업은 프리페치보다 먼저 처리)
+    void submit(std::function<void()> job, bool highPriority = false);
+
+    // 파일 앞부분을 페이지 캐시에 미리 올림 (posix_fadvise + pread)
+    void prefetchFile(const std::string& filePath, size_t bytes = kDefaultPrefetchBytes);
+
+    // 트랙별 통계 누적 및 조회
+    void recordStats(const std::string& filePath, const IoStats& stats);
+    IoStats getStats(const std::string& filePath) const;
+
+private:
+    IoScheduler();
+    ~IoScheduler();
+
+    IoScheduler(const IoScheduler&) = delete;
+    IoScheduler& operator=(const IoScheduler&) = delete;
+
+    void threadLoop();
+
+    std::thread mThread;
+    std::deque<std::function<void()>> mJobs;
+    bool mStopping = false;
+    std::mutex mJobLock;
+    std::condition_variable mJobCondition;
+
+    std::map<std::string, IoStats> mStats;
+    mutable std::mutex mStatsLock;
+};
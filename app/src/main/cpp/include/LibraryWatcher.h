@@ -0,0 +1,106 @@
+#ifndef PANCAKEMUSICBOX_LIBRARYWATCHER_H
+#define PANCAKEMUSICBOX_LIBRARYWATCHER_H
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace pancakemusicbox {
+
+class AudioScanner;
+
+/**
+ * 스캔한 루트 디렉토리를 inotify로 감시해 바뀐 경로만 라이브러리에 반영하는 감시 스레드
+ *
+ * inotify는 재귀 감시를 지원하지 않으므로 루트 아래 모든 디렉토리에 감시를 걸고, 새로 생긴 디렉토리에도 바로 추가함
+ * 이벤트(생성, 이동, 쓰기 완료, 삭제)는 경로별로 마지막 동작만 남겨 합치고, 잠잠해진 뒤(또는 최대 지연 시간이 지나면)
+ * 한 번에 scanFile/scanDirectory/removePath로 적용한 다음 변경 묶음 하나로 알림
+ * 커널 감시 한도(max_user_watches)에 걸리거나 inotify를 쓸 수 없으면 주기적인 증분 재스캔으로 전환함
+ */
+class LibraryWatcher {
+public:
+    // UI에 한 번에 알리는 변경 묶음
+    struct ChangeBatch {
+        std::vector<std::string> updatedPaths;  // 추가/변경된 파일 또는 새 디렉토리
+        std::vector<std::string> removedPaths;  // 삭제된 파일 또는 디렉토리
+        bool rescanned = false;                 // 루트 전체를 재스캔함 (경로 목록 없이 전체 새로고침 필요)
+    };
+    // 감시 스레드에서 호출됨
+    using ChangeCallback = std::function<void(const ChangeBatch&)>;
+
+    enum class Mode {
+        Stopped,
+        Inotify,
+        Polling     // 감시 한도 초과 등으로 주기적 재스캔 중
+    };
+
+    // 마지막 이벤트 뒤 이만큼 조용하면 적용
+    static constexpr std::chrono::milliseconds kQuietPeriod{500};
+    // 이벤트가 계속 들어와도 첫 이벤트 뒤 이 시간이 지나면 적용 (대량 복사 중에도 UI가 따라오도록)
+    static constexpr std::chrono::milliseconds kMaxBatchDelay{5000};
+    // 폴링 모드의 재스캔 주기
+    static constexpr std::chrono::milliseconds kPollInterval{120000};
+
+    explicit LibraryWatcher(AudioScanner& scanner);
+    ~LibraryWatcher();
+
+    // 감시 시작 (이미 감시 중이면 중지 후 다시 시작)
+    bool start(const std::vector<std::string>& rootPaths, ChangeCallback callback);
+    void stop();
+
+    Mode getMode() const { return mode.load(); }
+    int getWatchCount() const { return watchCount.load(); }
+
+private:
+    // 경로별로 합쳐진 대기 동작 (같은 경로의 나중 이벤트가 앞 이벤트를 덮어씀)
+    enum class PendingAction {
+        ScanFile,
+        ScanDirectory,
+        Remove
+    };
+
+    LibraryWatcher(const LibraryWatcher&) = delete;
+    LibraryWatcher& operator=(const LibraryWatcher&) = delete;
+
+    void threadLoop();
+
+    // directory와 그 하위 디렉토리에 감시 추가 (감시 한도에 걸리면 false)
+    bool addWatchesRecursive(const std::string& directory);
+    // directory와 그 하위 디렉토리의 감시 해제
+    void removeWatchesUnder(const std::string& directory);
+    // 감시를 모두 해제하고 폴링 모드로 전환 (감시 중에 전환하면 놓친 변경이 있을 수 있으므로 rescanNow로 바로 재스캔)
+    void degradeToPolling(bool rescanNow);
+
+    // inotify 이벤트를 읽어 대기 동작에 합침
+    void readEvents();
+    void queue(const std::string& path, PendingAction action);
+
+    // 대기 동작을 라이브러리에 적용하고 바뀐 것이 있으면 알림
+    void flush();
+
+    AudioScanner& scanner;
+    std::vector<std::string> roots;
+    ChangeCallback changeCallback;
+
+    std::thread thread;
+    int inotifyFd = -1;
+    int stopFd = -1;    // eventfd, 쓰면 감시 스레드 종료
+    std::atomic<Mode> mode{Mode::Stopped};
+    std::atomic<int> watchCount{0};
+
+    // 감시 스레드에서만 접근
+    std::unordered_map<int, std::string> directoriesByWatch;
+    std::unordered_map<std::string, int> watchesByDirectory;
+    std::unordered_map<std::string, PendingAction> pending;
+    bool fullRescanPending = false;
+    std::chrono::steady_clock::time_point firstEventTime;
+    std::chrono::steady_clock::time_point lastEventTime;
+};
+
+} // namespace pancakemusicbox
+
+#endif // PANCAKEMUSICBOX_LIBRARYWATCHER_H
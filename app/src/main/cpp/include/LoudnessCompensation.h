@@ -0,0 +1,22 @@
+#pragma once
+
+#include "Biquad.h"
+
+/**
+ * 볼륨 연동 라우드니스 보상 (ISO 226:2003 등청감 곡선 기반)
+ *
+ * 볼륨 1.0을 기준 청취 레벨로 보고, 볼륨을 낮춘 만큼 내려간 청취 레벨에서 1 kHz 대비 저역/고역이
+ * 덜 들리는 정도를 두 등청감 곡선의 차이로 구해 저역/고역 쉘프 이득으로 사용
+ * 1차 로우 쉘프와 1차 하이 쉘프를 곱해 biquad 한 섹션으로 만들므로 EQ 캐스케이드에 섹션 하나만 추가됨
+ */
+class LoudnessCompensation {
+public:
+    // 볼륨 1.0에 해당하는 청취 레벨 (phon)
+    static constexpr float kReferencePhon = 80.0f;
+
+    // 볼륨(선형)에 맞는 저역/고역 보상 이득 (dB, 0 이상)
+    static void computeGains(float volume, float& bassGainDb, float& trebleGainDb);
+
+    // 볼륨에 맞는 보상 필터 계수 (볼륨 1.0 이상이면 항등 필터)
+    static BiquadCoefficients computeCoefficients(float sampleRate, float volume);
+};
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <atomic>
+#include <cmath>
+#include "Biquad.h"
+#include "Float4.h"
+
+/**
+ * 3밴드 컴프레서 ("나이트 모드")
+ *
+ * Linkwitz-Riley 4차 크로스오버로 저/중/고역을 나누고 밴드마다 독립된 엔벨로프와 게인을 적용한 뒤
+ * 공통 메이크업 게인으로 다시 합침. 필터 뱅크는 [L, R, L, R] 4레인으로 묶어 한 번에 처리하고,
+ * 엔벨로프와 게인 보간도 밴드 레인 단위 벡터 연산으로 처리
+ */
+class MultibandCompressor {
+public:
+    static constexpr int kBands = 3;
+
+    void configure(int sampleRate, float makeupDb);
+    void reset();
+
+    // 스테레오 한 프레임 처리 (모노는 left와 right에 같은 값을 넣고 left 사용)
+    inline void process(float& left, float& right);
+
+    // 블록 동안의 최대 게인 리덕션을 UI용 미터로 게시 (오디오 스레드에서 호출)
+    void publishMeters();
+
+    // 밴드별 게인 리덕션 (dB, 양수), 락 없이 어느 스레드에서나 읽을 수 있음
+    float getGainReductionDb(int band) const;
+
+private:
+    // 게인 계산 주기 (프레임), 사이 구간은 선형 보간
+    static constexpr int kControlInterval = 16;
+
+    void updateGainTargets();
+
+    // 크로스오버 (레인: 0,1 = 저역 통과 L/R, 2,3 = 고역 통과 L/R)
+    Biquad4 mLowSplit[2];
+    Biquad4 mHighSplit[2];
+    Biquad4 mLowAllPass;  // 저역을 중/고역 분할과 같은 위상으로 맞춤
+
+    // 밴드 레인: 0 = 저역, 1 = 중역, 2 = 고역, 3 = 미사용
+    Float4 mEnvelope;
+    Float4 mAttack;
+    Float4 mRelease;
+    Float4 mGain = Float4(1.0f);
+    Float4 mGainStep;
+    int mControlCounter = 0;
+
+    float mThresholdDb[kBands] = {};
+    float mRatio[kBands] = {};
+    float mKneeDb = 6.0f;
+    float mMakeup = 1.0f;
+
+    float mPeakReductionDb[kBands] = {};
+    std::atomic<float> mMeterReductionDb[kBands] = {};
+};
+
+inline void MultibandCompressor::process(float& left, float& right) {
+    float split[4];
+    float upper[4];
+    float low[4];
+
+    Float4 first = mLowSplit[1].process(mLowSplit[0].process(Float4(left, right, left, right)));
+    first.store(split);
+
+    Float4 second = mHighSplit[1].process(mHighSplit[0].process(Float4(split[2], split[3], split[2], split[3])));
+    second.store(upper);
+
+    mLowAllPass.process(Float4(split[0], split[1], 0.0f, 0.0f)).store(low);
+
+    // 밴드별 스테레오 연동 검출 (L/R 중 큰 값)
+    Float4 detect = Float4::max(Float4::abs(Float4(low[0], upper[0], upper[2], 0.0f)),
+                                Float4::abs(Float4(low[1], upper[1], upper[3], 0.0f)));
+    Float4 delta = detect - mEnvelope;
+    mEnvelope = mEnvelope + delta * Float4::selectGreater(detect, mEnvelope, mAttack, mRelease);
+
+    if (--mControlCounter <= 0) {
+        updateGainTargets();
+    }
+    mGain = mGain + mGainStep;
+
+    float gain[4];
+    mGain.store(gain);
+    left = (low[0] * gain[0] + upper[0] * gain[1] + upper[2] * gain[2]) * mMakeup;
+    right = (low[1] * gain[0] + upper[1] * gain[1] + upper[3] * gain[2]) * mMakeup;
+}
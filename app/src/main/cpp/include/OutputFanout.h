@@ -0,0 +1,173 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <oboe/Oboe.h>
+#include "AsyncResampler.h"
+#include "SampleFormat.h"
+
+/**
+ * 보조 출력 하나의 상태 (UI/진단용)
+ */
+struct FanoutOutputStats {
+    int32_t id;
+    int32_t sampleRate;         // 출력 장치 샘플레이트
+    bool nullSink;              // 장치 없이 시뮬레이션 클럭으로 소비하는 null 싱크 여부
+    float fillMs;               // 링 버퍼에 쌓인 입력 (평활화 값)
+    float targetMs;             // PI 제어기가 유지하려는 버퍼 양
+    float correctionPpm;        // 클럭 차이를 맞추기 위해 적용 중인 레이트 보정
+    int64_t underruns;          // 입력이 모자라 무음을 낸 횟수
+    int64_t overflows;          // 버퍼가 가득 차 입력 블록을 버린 횟수
+    int64_t resyncs;            // 버퍼가 크게 밀려 목표량까지 건너뛴 횟수
+};
+
+/**
+ * 팬아웃 출력 하나: 링 버퍼 + 비동기 리샘플러 + 버퍼 양 PI 제어기
+ *
+ * 생산자(엔진 렌더링)는 주 출력 클럭으로 push()하고, 소비자(보조 장치)는 자기 클럭으로 pull()함
+ * 두 클럭의 차이는 소비자 쪽에서 버퍼 양을 목표에 맞추도록 리샘플링 비율을 조정해 흡수하므로
+ * 드롭이나 반복 없이 계속 재생됨. 생산자 1개, 소비자 1개 기준의 락 없는 구조
+ */
+class FanoutOutput {
+public:
+    static int64_t nowNanos();
+
+    FanoutOutput(int32_t outputSampleRate, int32_t initialInputRate);
+
+    // 생산자: 스테레오 인터리브 float (엔진 렌더링 스레드), timeNanos는 steady_clock 기준 호출 시각
+    void push(const float* input, int32_t numFrames, int32_t inputSampleRate, int64_t timeNanos);
+
+    // 소비자: 스테레오 인터리브 float (출력 장치 스레드), 입력이 모자라면 무음
+    void pull(float* output, int32_t numFrames, int64_t timeNanos);
+
+    int32_t getOutputSampleRate() const { return mOutputSampleRate; }
+    void fillStats(FanoutOutputStats& stats) const;
+
+private:
+    static constexpr int kChannels = 2;
+    static constexpr int32_t kRingFrames = 1 << 15;     // 2의 거듭제곱 (인덱스 마스킹)
+    static constexpr int32_t kPullChunkFrames = 1024;
+    static constexpr double kMaxNominalRatio = 8.0;
+
+    void pullChunk(float* output, int32_t numFrames, int64_t timeNanos);
+    void applyPendingRate(uint64_t readIndex);
+    int32_t getTargetFrames(int32_t pullFrames) const;
+    double estimateContinuousFill(int64_t fill, int64_t timeNanos) const;
+
+    const int32_t mOutputSampleRate;
+    std::vector<float> mRing;
+    std::atomic<uint64_t> mWriteIndex{0};
+    std::atomic<uint64_t> mReadIndex{0};
+
+    // 입력 레이트 변경은 해당 위치의 샘플을 소비할 때 반영 (트랙 경계의 레이트 전환)
+    int32_t mProducerRate;
+    std::atomic<int32_t> mPendingRate;
+    std::atomic<uint64_t> mPendingRateIndex{0};
+    std::atomic<int32_t> mMaxPushFrames{0};
+    std::atomic<int32_t> mLastPushFrames{0};
+    std::atomic<int64_t> mLastPushNanos{0};
+
+    // 소비자 전용 상태
+    int32_t mInputRate;
+    bool mPrimed = false;
+    double mFillAverage = 0.0;
+    double mIntegral = 0.0;
+    AsyncResampler mResampler;
+
+    // 게시용 지표
+    std::atomic<float> mFillMs{0.0f};
+    std::atomic<float> mTargetMs{0.0f};
+    std::atomic<float> mCorrectionPpm{0.0f};
+    std::atomic<int64_t> mUnderruns{0};
+    std::atomic<int64_t> mOverflows{0};
+    std::atomic<int64_t> mResyncs{0};
+};
+
+/**
+ * 보조 출력 장치 (Oboe 스트림, 장치 콜백에서 FanoutOutput을 소비)
+ */
+class OboeFanoutSink : public oboe::AudioStreamCallback {
+public:
+    ~OboeFanoutSink() override;
+
+    // deviceId가 0 이하면 기본 장치
+    bool open(int32_t deviceId, int32_t inputSampleRate);
+    void close();
+    FanoutOutput* getOutput() const { return mOutput.get(); }
+
+    oboe::DataCallbackResult onAudioReady(
+        oboe::AudioStream *oboeStream,
+        void *audioData,
+        int32_t numFrames) override;
+
+private:
+    std::shared_ptr<oboe::AudioStream> mStream;
+    std::unique_ptr<FanoutOutput> mOutput;
+};
+
+/**
+ * 장치 없이 자체 클럭으로 소비하는 출력 (녹음/진단 싱크, 클럭 오차를 ppm으로 시뮬레이션)
+ */
+class NullFanoutSink {
+public:
+    ~NullFanoutSink();
+
+    void start(int32_t sampleRate, double clockPpm, int32_t inputSampleRate);
+    void stop();
+    FanoutOutput* getOutput() const { return mOutput.get(); }
+    int64_t getFramesConsumed() const { return mFramesConsumed.load(); }
+
+private:
+    static constexpr int32_t kBlockFrames = 480;
+
+    void run(double framesPerSecond);
+
+    std::unique_ptr<FanoutOutput> mOutput;
+    std::thread mThread;
+    std::atomic<bool> mStop{false};
+    std::atomic<int64_t> mFramesConsumed{0};
+};
+
+/**
+ * 하나의 디코딩/DSP 결과를 여러 보조 출력으로 나눠 보내는 팬아웃 단계
+ * 주 출력 스트림은 엔진이 그대로 관리하고, push()는 엔진 렌더링에서 mLock을 잡은 채 호출
+ * 출력 추가/제거도 엔진 락 안에서 호출하므로 별도 락이 없음
+ */
+class OutputFanout {
+public:
+    OutputFanout();
+    ~OutputFanout();
+
+    // 출력 id 반환 (실패 시 -1)
+    // 장치 싱크는 스트림 열기가 오래 걸리므로 호출자가 엔진 락 밖에서 open()한 뒤 등록만 함
+    int addDeviceOutput(std::unique_ptr<OboeFanoutSink> sink);
+    int addNullOutput(int32_t sampleRate, double clockPpm, int32_t inputSampleRate);
+    bool removeOutput(int id);
+    void removeAll();
+    bool hasOutputs() const { return !mOutputs.empty(); }
+
+    // 주 출력에 쓴 블록을 모든 보조 출력에 전달 (모노는 스테레오로 복제, 3채널 이상은 스테레오로 다운믹스)
+    void push(const uint8_t* data, SampleFormat format, int channelCount, int32_t numFrames, int32_t sampleRate);
+
+    std::vector<FanoutOutputStats> getStats() const;
+
+private:
+    // 한 번에 변환하는 최대 프레임 수 (더 긴 블록은 나눠서 전달)
+    static constexpr int32_t kConvertFrames = 4096;
+    // 다운믹스 시 좌우 외 채널을 더하는 이득 (-3dB)
+    static constexpr float kSurroundGain = 0.70710678f;
+
+    struct Output {
+        int id;
+        std::unique_ptr<OboeFanoutSink> device;
+        std::unique_ptr<NullFanoutSink> null;
+        FanoutOutput* output;
+    };
+
+    std::vector<Output> mOutputs;
+    int mNextId = 1;
+    std::vector<float> mConvertBuffer;
+};
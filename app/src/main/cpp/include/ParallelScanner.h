@@ -0,0 +1,118 @@
+#ifndef PANCAKEMUSICBOX_PARALLELSCANNER_H
+#define PANCAKEMUSICBOX_PARALLELSCANNER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+#include "AudioMetadata.h"
+
+namespace pancakemusicbox {
+
+/**
+ * 작업 훔치기(work-stealing) 스레드 풀로 디렉토리 트리를 병렬 탐색하는 스캐너
+ *
+ * 작업은 디렉토리 하나 또는 파일 묶음 하나: 작업자는 자기 덱의 뒤에서 꺼내 처리하고 새로 생긴 작업을
+ * 다시 자기 덱에 넣으며, 자기 덱이 비면 다른 작업자 덱의 앞(트리 위쪽의 큰 작업)에서 훔쳐 옴
+ * 디렉토리에서 찾은 오디오 파일은 하위 디렉토리를 먼저 내놓은 뒤 같은 작업자가 바로 메타데이터를 추출하고,
+ * 파일이 많은 디렉토리는 묶음으로 나눠 내놓아 다른 작업자도 가져갈 수 있게 함
+ * 결과는 작업자별 버퍼에 모아 호출자가 마지막에 한 번에 병합함
+ * 오디오 파일마다 fstatat 한 번으로 지문을 구해 핸들러에 넘기므로, 핸들러는 바뀌지 않은 파일을 읽지 않고 건너뛸 수 있음
+ * 열거나 끝까지 읽지 못한 디렉토리와 stat하지 못한 오디오 파일은 따로 모아 두므로, 호출자는 그 아래 파일을
+ * 삭제된 것으로 오해하지 않을 수 있음
+ */
+class ParallelScanner {
+public:
+    enum class FileResult {
+        Extracted,      // metadata를 새로 채움 (결과 버퍼에 추가)
+        Unchanged,      // 지문이 같아 건너뜀
+        Failed
+    };
+
+    // 파일 하나 처리 (여러 작업자 스레드에서 동시에 호출됨)
+    using FileHandler = std::function<FileResult(const std::string& filePath,
+                                                 const FileFingerprint& fingerprint,
+                                                 TrackMetadata& metadata)>;
+    // (처리한 파일 수, 지금까지 찾은 파일 수)
+    using ProgressCallback = std::function<void(int, int)>;
+
+    // threadCount가 0 이하면 getDefaultThreadCount()
+    explicit ParallelScanner(int threadCount);
+
+    // 호출 스레드는 작업자를 기다리며 진행률만 보고 (JNI 콜백은 호출 스레드의 JNIEnv로만 호출 가능)
+    // 반환: 작업자별 결과 버퍼
+    std::vector<std::vector<TrackMetadata>> scan(const std::string& rootPath,
+                                                 const FileHandler& handler,
+                                                 const ProgressCallback& progressCallback);
+
+    int getThreadCount() const { return threadCount; }
+    int getFilesFound() const { return filesFound.load(); }
+    int getFilesFailed() const { return filesFailed.load(); }
+    int getFilesUnchanged() const { return filesUnchanged.load(); }
+    int getDirectoriesScanned() const { return directoriesScanned.load(); }
+    int getSteals() const { return steals.load(); }
+    // 마지막 scan()에서 읽지 못한 디렉토리와 오디오 파일 경로 (끝의 '/' 없음)
+    const std::vector<std::string>& getUnreadablePaths() const { return unreadablePaths; }
+
+    // 지원하는 오디오 확장자인지 (대소문자 무시)
+    static bool isSupportedAudioFile(const char* fileName);
+    static int getDefaultThreadCount();
+    static FileFingerprint makeFingerprint(const struct stat& fileStat);
+
+private:
+    // 한 작업에서 처리하는 최대 파일 수 (넘으면 나머지를 훔칠 수 있는 묶음으로 내놓음)
+    static constexpr size_t kFileBatchSize = 32;
+
+    struct FileEntry {
+        std::string path;
+        FileFingerprint fingerprint;
+    };
+
+    // files가 비어 있으면 디렉토리 탐색 작업, 아니면 메타데이터 추출 작업
+    struct Task {
+        std::string directory;
+        std::vector<FileEntry> files;
+    };
+
+    struct Worker {
+        std::mutex lock;
+        std::deque<Task> tasks;
+        std::vector<TrackMetadata> results;
+        std::vector<std::string> unreadablePaths;
+    };
+
+    void workerLoop(int index);
+    bool popLocal(int index, Task& task);
+    bool steal(int index, Task& task);
+    void pushTask(int index, Task task);
+    void scanOneDirectory(int index, const std::string& directory);
+    void extractFiles(int index, const std::vector<FileEntry>& files);
+
+    const int threadCount;
+    std::vector<std::unique_ptr<Worker>> workers;
+    const FileHandler* fileHandler = nullptr;
+
+    // 큐에 있거나 처리 중인 작업 수 (0이 되면 스캔 완료)
+    std::atomic<int> pendingTasks{0};
+    std::atomic<int> idleWorkers{0};
+    std::mutex idleMutex;
+    std::condition_variable idleCondition;
+    std::condition_variable doneCondition;
+
+    std::atomic<int> filesFound{0};
+    std::atomic<int> filesProcessed{0};
+    std::atomic<int> filesFailed{0};
+    std::atomic<int> filesUnchanged{0};
+    std::atomic<int> directoriesScanned{0};
+    std::atomic<int> steals{0};
+    std::vector<std::string> unreadablePaths;
+};
+
+} // namespace pancakemusicbox
+
+#endif // PANCAKEMUSICBOX_PARALLELSCANNER_H
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <sys/types.h>
+#include "IoScheduler.h"
+
+/**
+ * 디코더 소스용 read-ahead 파일 리더
+ * 디코더의 작은 순차 read 요청을 큰 정렬 블록 단위 pread로 모아 IoScheduler 스레드에서 미리 읽고,
+ * 그 다음 구간은 posix_fadvise(WILLNEED)로 커널에 알려 SD카드/eMMC에서의 끊김을 줄임
+ */
+class ReadAheadFile {
+public:
+    static constexpr size_t kBlockSize = 1024 * 1024;   // pread 단위 (kAlignment의 배수)
+    static constexpr size_t kAlignment = 4096;          // 블록 버퍼 및 파일 오프셋 정렬
+    static constexpr int kWindowBlocks = 4;             // 읽기 위치 앞쪽으로 유지할 블록 수
+
+    ReadAheadFile() = default;
+    ~ReadAheadFile();
+
+    bool open(const std::string& filePath);
+    void close();
+    bool isOpen() const { return mState != nullptr; }
+
+    // 현재 위치에서 순차 읽기, 읽은 바이트 수 반환 (EOF면 0, 오류면 -1)
+    ssize_t read(void* buffer, size_t size);
+
+    bool seek(int64_t offset);
+    int64_t tell() const { return mPosition; }
+    int64_t getSize() const;
+
+    // 이 파일을 연 이후의 I/O 통계
+    IoStats getStats() const;
+
+private:
+    ReadAheadFile(const ReadAheadFile&) = delete;
+    ReadAheadFile& operator=(const ReadAheadFile&) = delete;
+
+    struct Block {
+        std::shared_ptr<uint8_t> data;  // I/O 작업이 끝날 때까지 버퍼를 유지하기 위해 공유
+        size_t length = 0;
+        bool ready = false;
+        bool failed = false;
+    };
+
+    // I/O 스레드 작업과 공유하는 상태 (파일을 닫아도 진행 중인 pread가 끝날 때까지 유지)
+    struct SharedState {
+        ~SharedState();
+
+        int fd = -1;
+        int64_t fileSize = 0;
+        std::map<int64_t, Block> blocks;  // 블록 인덱스 -> 블록
+        IoStats stats;
+        std::mutex lock;
+        std::condition_variable condition;
+    };
+
+    // state->lock을 잡은 상태에서 호출
+    void scheduleReadAheadLocked(int64_t firstBlock);
+
+    std::shared_ptr<SharedState> mState;
+    std::string mFilePath;
+    int64_t mPosition = 0;
+};
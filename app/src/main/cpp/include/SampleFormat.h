@@ -0,0 +1,197 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "DspKernels.h"
+
+/**
+ * 내부 PCM 버퍼의 샘플 저장 형식
+ * 소스의 원래 비트 폭을 유지하여 메모리를 절약하고, 재생 시점에 float로 변환
+ */
+enum class SampleFormat {
+    Float32,  // 32비트 float
+    Int16,    // 16비트 정수
+    Int24,    // 24비트 정수 (3바이트 packed, little-endian)
+    Float16   // IEEE 754 half precision
+};
+
+constexpr int getBytesPerSample(SampleFormat format) {
+    return format == SampleFormat::Float32 ? 4 :
+           format == SampleFormat::Int24 ? 3 : 2;
+}
+
+inline const char* getSampleFormatName(SampleFormat format) {
+    switch (format) {
+        case SampleFormat::Float32: return "float32";
+        case SampleFormat::Int16: return "int16";
+        case SampleFormat::Int24: return "int24";
+        case SampleFormat::Float16: return "float16";
+    }
+    return "unknown";
+}
+
+// IEEE 754 float32 -> float16 변환 (round-to-nearest)
+inline uint16_t floatToHalf(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    uint32_t sign = (bits >> 16) & 0x8000;
+    int32_t exponent = static_cast<int32_t>((bits >> 23) & 0xff) - 127 + 15;
+    uint32_t mantissa = bits & 0x7fffff;
+
+    if (exponent <= 0) {
+        // 비정규화 수 또는 0
+        if (exponent < -10) {
+            return static_cast<uint16_t>(sign);
+        }
+        mantissa |= 0x800000;
+        uint32_t shift = static_cast<uint32_t>(14 - exponent);
+        uint32_t half = mantissa >> shift;
+        if ((mantissa >> (shift - 1)) & 1) {
+            half++;
+        }
+        return static_cast<uint16_t>(sign | half);
+    }
+
+    if (exponent >= 31) {
+        // 오디오 데이터에서는 NaN도 무한대로 처리
+        return static_cast<uint16_t>(sign | 0x7c00);
+    }
+
+    uint32_t half = sign | (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+    if (mantissa & 0x1000) {
+        half++; // 올림이 지수로 넘어가도 올바른 값이 됨
+    }
+    return static_cast<uint16_t>(half);
+}
+
+// IEEE 754 float16 -> float32 변환
+inline float halfToFloat(uint16_t half) {
+    uint32_t sign = static_cast<uint32_t>(half & 0x8000) << 16;
+    uint32_t exponent = (half >> 10) & 0x1f;
+    uint32_t mantissa = half & 0x3ff;
+    uint32_t bits;
+
+    if (exponent == 0) {
+        if (mantissa == 0) {
+            bits = sign;
+        } else {
+            // 비정규화 수 정규화
+            exponent = 127 - 15 + 1;
+            while (!(mantissa & 0x400)) {
+                mantissa <<= 1;
+                exponent--;
+            }
+            mantissa &= 0x3ff;
+            bits = sign | (exponent << 23) | (mantissa << 13);
+        }
+    } else if (exponent == 31) {
+        // NaN은 하드웨어 변환(F16C, NEON)과 같게 페이로드를 유지한 채 quiet 비트를 세움
+        bits = sign | 0x7f800000 | (mantissa << 13) | (mantissa ? 0x00400000 : 0);
+    } else {
+        bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+    }
+
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/**
+ * 형식별 float 변환 루틴
+ * 템플릿 특수화로 형식이 컴파일 타임에 결정되므로 루프 안에 형식 분기가 없음
+ * 대량 변환은 DspKernels에서 CPU에 맞는 SIMD 구현으로, 샘플 단위 store는 scalar로 처리
+ */
+template <SampleFormat Format>
+struct SampleTraits;
+
+template <>
+struct SampleTraits<SampleFormat::Float32> {
+    static constexpr int kBytesPerSample = 4;
+
+    static void toFloat(const uint8_t* src, float* dst, size_t count) {
+        memcpy(dst, src, count * sizeof(float));
+    }
+
+    static void fromFloat(const float* src, uint8_t* dst, size_t count) {
+        memcpy(dst, src, count * sizeof(float));
+    }
+
+    static inline void store(uint8_t* dst, size_t index, float value) {
+        reinterpret_cast<float*>(dst)[index] = value;
+    }
+};
+
+template <>
+struct SampleTraits<SampleFormat::Int16> {
+    static constexpr int kBytesPerSample = 2;
+
+    // 변환 루프는 런타임에 선택된 SIMD 커널 사용
+    static void toFloat(const uint8_t* src, float* dst, size_t count) {
+        DspKernels::active().int16ToFloat(reinterpret_cast<const int16_t*>(src), dst, count);
+    }
+
+    static void fromFloat(const float* src, uint8_t* dst, size_t count) {
+        DspKernels::active().floatToInt16(src, reinterpret_cast<int16_t*>(dst), count);
+    }
+
+    static inline void store(uint8_t* dst, size_t index, float value) {
+        float scaled = std::round(value * 32768.0f);
+        reinterpret_cast<int16_t*>(dst)[index] =
+            static_cast<int16_t>(std::max(-32768.0f, std::min(32767.0f, scaled)));
+    }
+};
+
+template <>
+struct SampleTraits<SampleFormat::Int24> {
+    static constexpr int kBytesPerSample = 3;
+
+    static void toFloat(const uint8_t* src, float* dst, size_t count) {
+        constexpr float scale = 1.0f / 8388608.0f;
+        for (size_t i = 0; i < count; i++) {
+            const uint8_t* p = src + i * 3;
+            // 상위 24비트에 배치 후 산술 시프트로 부호 확장
+            int32_t value = static_cast<int32_t>((static_cast<uint32_t>(p[0]) << 8) |
+                                                 (static_cast<uint32_t>(p[1]) << 16) |
+                                                 (static_cast<uint32_t>(p[2]) << 24)) >> 8;
+            dst[i] = value * scale;
+        }
+    }
+
+    static void fromFloat(const float* src, uint8_t* dst, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            store(dst, i, src[i]);
+        }
+    }
+
+    static inline void store(uint8_t* dst, size_t index, float value) {
+        float scaled = std::round(value * 8388608.0f);
+        int32_t sample = static_cast<int32_t>(std::max(-8388608.0f, std::min(8388607.0f, scaled)));
+        uint8_t* p = dst + index * 3;
+        p[0] = static_cast<uint8_t>(sample);
+        p[1] = static_cast<uint8_t>(sample >> 8);
+        p[2] = static_cast<uint8_t>(sample >> 16);
+    }
+};
+
+template <>
+struct SampleTraits<SampleFormat::Float16> {
+    static constexpr int kBytesPerSample = 2;
+
+    static void toFloat(const uint8_t* src, float* dst, size_t count) {
+        DspKernels::active().halfToFloat(reinterpret_cast<const uint16_t*>(src), dst, count);
+    }
+
+    static void fromFloat(const float* src, uint8_t* dst, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            store(dst, i, src[i]);
+        }
+    }
+
+    static inline void store(uint8_t* dst, size_t index, float value) {
+        reinterpret_cast<uint16_t*>(dst)[index] = floatToHalf(value);
+    }
+};
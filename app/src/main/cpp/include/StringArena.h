@@ -0,0 +1,80 @@
+#ifndef PANCAKEMUSICBOX_STRINGARENA_H
+#define PANCAKEMUSICBOX_STRINGARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace pancakemusicbox {
+
+/**
+ * 문자열을 큰 청크에 이어 붙여 저장하는 범프 할당기
+ *
+ * 문자열마다 힙 할당을 하지 않고 청크 끝에 복사한 뒤 그 위치를 가리키는 string_view를 돌려줌
+ * 저장한 문자열은 뒤에 NUL이 붙어 있으므로 data()를 C 문자열로 써도 됨
+ * 개별 해제는 없고 clear()로 청크 전체를 한 번에 버림 (저장한 문자열 수와 무관하게 청크 수만큼만 해제)
+ * 청크는 옮기지 않으므로 돌려준 string_view는 clear() 전까지 유효함
+ */
+class StringArena {
+public:
+    static constexpr size_t kChunkSize = 64 * 1024;
+
+    StringArena() = default;
+
+    std::string_view store(std::string_view value);
+    void clear();
+
+    // 저장한 문자열 바이트 수 (NUL 포함)
+    size_t getUsedBytes() const { return usedBytes; }
+    // 청크로 할당받은 바이트 수
+    size_t getAllocatedBytes() const { return allocatedBytes; }
+
+private:
+    StringArena(const StringArena&) = delete;
+    StringArena& operator=(const StringArena&) = delete;
+
+    std::vector<std::unique_ptr<char[]>> chunks;
+    char* cursor = nullptr;
+    size_t remaining = 0;
+    size_t usedBytes = 0;
+    size_t allocatedBytes = 0;
+};
+
+/**
+ * 종류가 적은 문자열(아티스트, 앨범, 장르, 작곡가, 포맷 등)을 한 번만 저장하고 uint32_t ID로 가리키는 풀
+ *
+ * 같은 값은 항상 같은 ID를 받으므로 트랙마다 "FLAC", "Unknown Artist"를 따로 들고 있지 않고 4바이트 ID만 둠
+ * ID 0은 빈 문자열. 한 번 넣은 문자열은 clear() 전까지 지우지 않음
+ */
+class StringPool {
+public:
+    static constexpr uint32_t kEmptyString = 0;
+    static constexpr uint32_t kNotFound = UINT32_MAX;
+
+    StringPool();
+
+    uint32_t intern(std::string_view value);
+    // 없는 문자열이면 kNotFound
+    uint32_t find(std::string_view value) const;
+    std::string_view get(uint32_t id) const { return strings[id]; }
+    size_t size() const { return strings.size(); }
+    void clear();
+
+    // 문자열 바이트, ID 배열, 해시 테이블이 차지하는 대략적인 바이트 수
+    size_t getMemoryUsage() const;
+
+private:
+    StringPool(const StringPool&) = delete;
+    StringPool& operator=(const StringPool&) = delete;
+
+    StringArena arena;
+    std::vector<std::string_view> strings;
+    std::unordered_map<std::string_view, uint32_t> idsByString;
+};
+
+} // namespace pancakemusicbox
+
+#endif // PANCAKEMUSICBOX_STRINGARENA_H
@@ -0,0 +1,42 @@
+#ifndef PANCAKEMUSICBOX_TAGPARSER_H
+#define PANCAKEMUSICBOX_TAGPARSER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "AudioMetadata.h"
+
+namespace pancakemusicbox {
+
+/**
+ * 파일에 포함된 그림 (ID3 APIC, FLAC PICTURE, MP4 covr)
+ */
+struct EmbeddedPicture {
+    int type = -1;              // ID3/FLAC 그림 종류 (3: 앞표지)
+    std::vector<uint8_t> data;  // 인코딩된 이미지 (JPEG, PNG, WebP, GIF)
+};
+
+/**
+ * 오디오 파일 헤더에서 태그와 스트림 정보를 읽는 파서
+ *
+ * 지원 형식: FLAC, MP3 (ID3v2/ID3v1/APE, Xing/Info/VBRI), Ogg Vorbis/Opus/FLAC, MP4/M4A (AAC/ALAC/FLAC),
+ * DSF, DFF, WAV (RIFF/RF64, LIST INFO, id3 청크), ADTS AAC
+ * 파일 전체를 읽지 않고 앞부분 64KB를 한 번에 읽은 뒤, 그 밖에 있는 블록(큰 ID3 태그 뒤의 프레임, MP4 moov,
+ * FLAC 메타데이터 블록, 끝부분의 ID3v1/APE와 Ogg 마지막 페이지 등)만 pread로 골라 읽음
+ * 형식은 확장자가 아니라 파일 시그니처로 판별함
+ */
+class TagParser {
+public:
+    // 읽은 값만 metadata에 채움 (태그에 없는 필드는 그대로 두므로 호출자가 기본값을 정함)
+    // 채우는 필드: title, artist, albumTitle, genre, year, trackNumber, composer, duration, audioQuality
+    // picture를 주면 포함된 그림도 읽음 (앞표지 우선, 없으면 처음 찾은 그림), nullptr이면 그림 데이터는 건너뜀
+    // 반환: 형식을 인식하고 스트림 정보(샘플레이트, 재생 시간)를 읽었는지
+    static bool parse(const std::string& filePath, TrackMetadata& metadata, EmbeddedPicture* picture = nullptr);
+
+    // 파일 앞부분에서 한 번에 읽는 크기
+    static constexpr size_t kHeadSize = 64 * 1024;
+};
+
+} // namespace pancakemusicbox
+
+#endif // PANCAKEMUSICBOX_TAGPARSER_H
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <vector>
+
+/**
+ * 오디오 렌더 스레드 스케줄링 설정 (호출한 스레드에 적용)
+ */
+class ThreadPriority {
+public:
+    // SCHED_FIFO 실시간 우선순위 요청, 권한이 없으면 오디오 nice 값으로 대체
+    // 실시간 우선순위를 얻었으면 true
+    static bool promoteToAudio();
+
+    // 호출한 스레드가 실시간 스케줄링(SCHED_FIFO/SCHED_RR)으로 실행 중인지 여부
+    static bool isRealtime();
+
+    // 가장 느린(리틀) 클러스터를 뺀 코어에만 스케줄되도록 고정, 코어 구성이 대칭이면 아무것도 하지 않음
+    static bool pinToBigCores();
+
+    // 가장 느린 클러스터를 뺀 코어 목록 (미드 + 프라임, 클러스터가 하나면 모든 코어, 감지 실패 시 빈 목록)
+    static std::vector<int> findBigCores();
+};
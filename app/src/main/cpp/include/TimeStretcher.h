@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "Fft.h"
+
+/**
+ * 타임 스트레치 알고리즘
+ */
+enum class TimeStretchMode {
+    Speech = 0,  // WSOLA (강의, 오디오북: 과도음 보존, 낮은 CPU 비용)
+    Music = 1    // 위상 보코더 (음악: 화성 성분 보존)
+};
+
+/**
+ * 피치를 유지한 채 재생 속도를 바꾸는 스트레처
+ *
+ * 엔진은 소스 프레임을 writeInput()으로 공급하고 readOutput()으로 결과를 가져감
+ * 속도 변경은 다음 홉부터 반영되며 홉 사이가 항상 크로스페이드/OLA로 이어지므로 스트림을 다시 열 필요가 없음
+ * 모든 버퍼는 configure()에서 할당되며 오디오 스레드에서는 할당하지 않음
+ */
+class TimeStretcher {
+public:
+    static constexpr float kMinSpeed = 0.5f;
+    static constexpr float kMaxSpeed = 3.0f;
+
+    void configure(int sampleRate, int channelCount);
+
+    void setSpeed(float speed);
+    float getSpeed() const { return mSpeed; }
+    void setMode(TimeStretchMode mode);
+    TimeStretchMode getMode() const { return mMode; }
+
+    // 소스의 startFrame 위치부터 스트레치 시작 / 종료 (버퍼 초기화)
+    void begin(int64_t startFrame);
+    void end();
+    bool isActive() const { return mActive; }
+
+    // 속도가 1로 돌아왔고 출력이 원본과 정렬되어 있어 직접 재생으로 전환 가능한지 여부
+    // (음악 모드는 1배속이 되면 위상 보코더 출력을 원본으로 한 홉 동안 크로스페이드한 뒤 원본을 그대로 내보냄)
+    bool canBypass() const;
+
+    // 아직 출력하지 않은 다음 소스 프레임 위치 (재생 위치 표시, 직접 재생 전환용)
+    int64_t getSourcePosition() const;
+
+    // 소스 공급
+    void writeInput(const float* input, int32_t numFrames);
+    void endOfInput();
+    bool isEndOfInput() const { return mEndFrame >= 0; }
+
+    // 최대 numFrames 프레임 출력, 입력이 부족하면 더 적게 반환
+    int32_t readOutput(float* output, int32_t numFrames);
+
+    // 처리 시간 / 생성한 오디오 길이 (현재 속도에서의 CPU 부하)
+    float getCpuLoad() const;
+
+private:
+    bool processHop();
+    bool processWsolaHop();
+    bool processPhaseVocoderHop();
+    bool processPassthroughHop();
+
+    // 상호상관이 가장 큰 세그먼트 시작 위치 (절대 프레임)
+    int64_t findBestSegment(int64_t nominal) const;
+    float scoreSegment(int64_t start) const;
+
+    void compactInput();
+    void appendInput(const float* input, int32_t numFrames);
+    void resetProcessing();
+
+    int64_t getWrittenFrames() const { return mInputBase + mInputFrames; }
+    const float* inputAt(int64_t frame) const;
+    const float* monoAt(int64_t frame) const;
+
+    int mSampleRate = 44100;
+    int mChannelCount = 2;
+    float mSpeed = 1.0f;
+    TimeStretchMode mMode = TimeStretchMode::Speech;
+    bool mActive = false;
+    bool mPrimed = false;
+
+    // 입력 FIFO (인터리브 + 상관 계산용 모노 다운믹스)
+    std::vector<float> mInput;
+    std::vector<float> mInputMono;
+    int64_t mInputBase = 0;     // mInput[0]의 절대 프레임 위치
+    int32_t mInputFrames = 0;
+    int32_t mInputCapacity = 0;
+    int64_t mEndFrame = -1;     // 소스 끝 (endOfInput 이후)
+
+    // 출력 FIFO
+    std::vector<float> mOutput;
+    int32_t mOutputStart = 0;
+    int32_t mOutputFrames = 0;
+
+    double mAnalysisPos = 0.0; // 다음 분석 세그먼트의 명목 위치 (절대 프레임)
+
+    // WSOLA
+    int32_t mWsolaHop = 0;
+    int32_t mWsolaSearch = 0;
+    int64_t mPrevSegment = 0;
+    std::vector<float> mPrevTail;       // 이전 세그먼트의 자연스러운 연속 구간
+    std::vector<float> mPrevTailMono;
+    std::vector<float> mFadeIn;
+
+    // 위상 보코더
+    int32_t mFftSize = 0;
+    int32_t mPvHop = 0;
+    int64_t mPrevAnalysisFrame = 0;
+    Fft mFft;
+    std::vector<float> mWindow;
+    std::vector<float> mReal;
+    std::vector<float> mImag;
+    std::vector<float> mPrevPhase;      // [channel * bins + bin]
+    std::vector<float> mSynthPhase;
+    std::vector<float> mAccumulator;    // OLA 누적 버퍼 (인터리브)
+    bool mPassthrough = false;          // 1배속에서 원본으로 넘어가 원본 프레임을 그대로 출력 중
+    int64_t mPassthroughFrames = 0;     // 넘어간 뒤 출력 FIFO에 넣은 원본 프레임 수
+
+    // CPU 부하 측정
+    int64_t mProcessNs = 0;
+    int64_t mProducedFrames = 0;
+};
@@ -0,0 +1,235 @@
+#ifndef PANCAKEMUSICBOX_TRACKSTORE_H
+#define PANCAKEMUSICBOX_TRACKSTORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "AudioMetadata.h"
+#include "StringArena.h"
+
+namespace pancakemusicbox {
+
+// 저장소 안에서 트랙을 가리키는 정수 핸들 (열 배열의 인덱스)
+using TrackHandle = uint32_t;
+constexpr TrackHandle kInvalidTrackHandle = UINT32_MAX;
+
+/**
+ * 패싯 질의 조건 (비어 있거나 0인 조건은 무시, 여러 조건은 AND)
+ */
+struct TrackFilter {
+    std::string genre;
+    std::string artist;
+    std::string albumTitle;
+    std::string format;
+    int year = 0;
+    bool highResolutionOnly = false;    // AudioQuality::isHighResolution()인 트랙만
+};
+
+/**
+ * 트랙을 열(column) 단위 배열로 보관하는 라이브러리 저장소 (struct-of-arrays)
+ *
+ * 트랙마다 TrackMetadata 하나를 트리 노드로 두는 대신 필드마다 연속된 배열을 두고, 트랙은 그 인덱스인
+ * uint32_t 핸들로 가리킴 (삭제된 핸들은 재사용). 재생 횟수/재생 시간 같은 숫자 열은 집계와 정렬이 배열을
+ * 순서대로 훑기만 하면 되고, 필요한 트랙만 마지막에 get()으로 TrackMetadata를 만들어 돌려줌
+ * 외부 ID와 파일 경로는 오픈 어드레싱 해시 인덱스(슬롯당 해시 4바이트 + 핸들 4바이트)로 핸들을 찾음
+ *
+ * 문자열 열은 두 가지로 나눔
+ * - 트랙마다 다른 값(ID, 제목, 파일 경로): 범프 할당기(StringArena)에 이어 붙이고 string_view로 가리킴
+ *   지우거나 바뀐 값의 자리는 쌓아 두었다가 살아 있는 값보다 많아지면 새 아레나로 옮겨 담아 한 번에 회수
+ * - 종류가 적은 값(아티스트, 앨범, 아트 경로, 장르, 작곡가, 포맷): StringPool에 한 번만 넣고 uint32_t ID만 둠
+ * 라이브러리를 비울 때 문자열은 트랙마다가 아니라 아레나 청크 단위로 해제됨
+ * (순위 색인과 패싯 목록은 노드마다 해제하므로 clear() 전체는 트랙 수에 비례)
+ *
+ * 장르, 아티스트, 앨범 제목, 연도, 포맷, 고해상도 여부는 값마다 핸들 오름차순 목록(posting list)을
+ * 추가/변경/삭제 때 함께 고쳐 두므로, 패싯 질의는 라이브러리를 훑지 않고 가장 짧은 목록부터 교집합만 구함
+ * 마지막 재생 시간, 재생 횟수, 추가 시간은 큰 값 순서의 균형 트리에 핸들을 두어 상위 k개를 O(k)로 꺼냄
+ * 스레드 안전하지 않으므로 호출자(AudioScanner)가 락을 잡고 사용
+ */
+class TrackStore {
+public:
+    // 같은 ID가 있으면 그 핸들의 값을 바꾸고, 없으면 새 핸들에 추가
+    // 다른 트랙이 같은 경로를 쓰고 있으면 경로 인덱스는 새 트랙을 가리킴
+    TrackHandle insert(const TrackMetadata& track);
+    void remove(TrackHandle handle);
+    void clear();
+
+    TrackHandle findById(const std::string& id) const;
+    TrackHandle findByPath(const std::string& filePath) const;
+
+    bool isValid(TrackHandle handle) const { return handle < alive.size() && alive[handle] != 0; }
+    size_t size() const { return liveCount; }
+    // 핸들은 항상 이 값보다 작음 (핸들별 보조 배열 크기)
+    size_t handleLimit() const { return alive.size(); }
+
+    // 살아 있는 핸들마다 visit(handle) 호출 (핸들 순서)
+    template <typename Visitor>
+    void forEach(Visitor visit) const {
+        for (TrackHandle handle = 0; handle < alive.size(); handle++) {
+            if (alive[handle] != 0) {
+                visit(handle);
+            }
+        }
+    }
+
+    // 한 트랙의 모든 필드를 TrackMetadata로 복사
+    TrackMetadata get(TrackHandle handle) const;
+
+    // 조건을 모두 만족하는 트랙 핸들 (오름차순, 조건이 없으면 모든 트랙)
+    std::vector<TrackHandle> query(const TrackFilter& filter) const;
+
+    // 장르마다 visit(genre, handles) 호출 (handles는 오름차순)
+    template <typename Visitor>
+    void forEachGenre(Visitor visit) const {
+        for (const auto& posting : genreIndex.postings) {
+            visit(strings.get(static_cast<uint32_t>(posting.first)), posting.second);
+        }
+    }
+
+    // 살아 있는 트랙이 가리키는 앨범 아트 경로 (중복과 빈 경로 제외, 트랙을 복사하지 않음)
+    std::vector<std::string_view> getAlbumArtPaths() const;
+
+    // 오름차순 핸들 목록들의 교집합 (가장 짧은 목록의 원소마다 다른 목록을 지수 탐색)
+    static std::vector<TrackHandle> intersect(std::vector<const std::vector<TrackHandle>*> lists);
+
+    // 열 접근 (핸들이 유효한지는 호출자가 확인, 아레나 문자열은 NUL로 끝나므로 data()를 C 문자열로 써도 됨)
+    std::string_view getId(TrackHandle handle) const { return ids[handle]; }
+    std::string_view getFilePath(TrackHandle handle) const { return filePaths[handle]; }
+    std::string_view getGenre(TrackHandle handle) const { return strings.get(genres[handle]); }
+    FileFingerprint getFingerprint(TrackHandle handle) const;
+    int32_t getPlayCount(TrackHandle handle) const { return playCounts[handle]; }
+    int64_t getLastPlayed(TrackHandle handle) const { return lastPlayedTimes[handle]; }
+    int64_t getDateAdded(TrackHandle handle) const { return dateAddedTimes[handle]; }
+
+    // 값을 바꾸면서 순위 색인도 고침 (O(log n))
+    void setPlayCount(TrackHandle handle, int32_t playCount);
+    void setLastPlayed(TrackHandle handle, int64_t lastPlayed);
+
+    // 값이 0보다 큰 트랙 중 큰 순서로 최대 limit개 (같은 값이면 핸들이 큰 쪽 먼저)
+    std::vector<TrackHandle> topByLastPlayed(int limit) const { return topHandles(lastPlayedRanking, limit); }
+    std::vector<TrackHandle> topByPlayCount(int limit) const { return topHandles(playCountRanking, limit); }
+    std::vector<TrackHandle> topByDateAdded(int limit) const { return topHandles(dateAddedRanking, limit); }
+
+    // 열 배열 전체 (삭제된 핸들 자리도 포함하므로 isValid로 거름)
+    const std::vector<int64_t>& durationColumn() const { return durations; }
+    const std::vector<int32_t>& yearColumn() const { return years; }
+    const std::vector<int32_t>& sampleRateColumn() const { return sampleRates; }
+
+    // 열 배열, 아레나와 문자열 풀, 해시 인덱스가 차지하는 대략적인 바이트 수
+    size_t getMemoryUsage() const;
+
+    // 다시 옮겨 담기 전에 쌓아 두는 최소 회수 대상 바이트 수
+    static constexpr size_t kMinCompactionBytes = 1024 * 1024;
+
+private:
+    // 핸들을 값으로 갖는 오픈 어드레싱(선형 탐사) 해시 테이블, 키 문자열은 열 배열에 있는 것을 비교
+    struct HandleIndex {
+        struct Slot {
+            uint32_t hash;
+            TrackHandle handle;     // kInvalidTrackHandle이면 빈 슬롯
+        };
+        std::vector<Slot> slots;
+        size_t count = 0;
+
+        TrackHandle find(uint32_t hash, std::string_view key, const std::vector<std::string_view>& column) const;
+        void insert(uint32_t hash, TrackHandle handle);
+        void erase(uint32_t hash, TrackHandle handle);
+        void grow();
+    };
+
+    // 패싯 값 -> 그 값을 가진 트랙 핸들 (오름차순)
+    struct FacetIndex {
+        std::unordered_map<uint64_t, std::vector<TrackHandle>> postings;
+
+        void add(uint64_t key, TrackHandle handle);
+        void remove(uint64_t key, TrackHandle handle);
+        const std::vector<TrackHandle>* find(uint64_t key) const;
+    };
+
+    // 숫자 값 -> 핸들, 큰 값부터 순회 (값이 0 이하인 트랙은 넣지 않음)
+    struct RankIndex {
+        std::set<std::pair<int64_t, TrackHandle>, std::greater<>> entries;
+
+        void add(int64_t value, TrackHandle handle);
+        void remove(int64_t value, TrackHandle handle);
+    };
+
+    static std::vector<TrackHandle> topHandles(const RankIndex& index, int limit);
+
+    static void insertSorted(std::vector<TrackHandle>& handles, TrackHandle handle);
+    static void eraseSorted(std::vector<TrackHandle>& handles, TrackHandle handle);
+
+    // 한 트랙을 모든 패싯 목록과 순위 색인에 넣기/빼기 (행 값을 바꾸기 전에 빼고, 바꾼 뒤에 넣음)
+    void indexFacets(TrackHandle handle);
+    void unindexFacets(TrackHandle handle);
+    // 문자열 패싯 조건의 목록 (조건이 비어 있으면 true만 반환, 값이 없으면 false)
+    bool addStringFacet(const FacetIndex& index, const std::string& value,
+                        std::vector<const std::vector<TrackHandle>*>& lists) const;
+
+    static uint32_t hashKey(std::string_view key);
+    TrackHandle allocateHandle();
+    void writeRow(TrackHandle handle, const TrackMetadata& track);
+
+    // 아레나 문자열 열의 값 바꾸기 (같으면 그대로 두고, 다르면 이전 값 자리를 회수 대상으로 셈)
+    void assignArenaString(std::vector<std::string_view>& column, TrackHandle handle, const std::string& value);
+    void releaseArenaString(std::string_view value);
+    // 회수 대상이 살아 있는 문자열보다 많으면 살아 있는 값만 새 아레나로 옮김
+    void compactArenaIfNeeded();
+
+    // 트랙마다 다른 문자열 (arena에 저장)
+    std::unique_ptr<StringArena> arena = std::make_unique<StringArena>();
+    size_t releasedArenaBytes = 0;
+    std::vector<std::string_view> ids;
+    std::vector<std::string_view> titles;
+    std::vector<std::string_view> filePaths;
+
+    // 종류가 적은 문자열 (strings의 ID)
+    StringPool strings;
+    std::vector<uint32_t> artists;
+    std::vector<uint32_t> albumTitles;
+    std::vector<uint32_t> albumArtPaths;
+    std::vector<uint32_t> formats;
+    std::vector<uint32_t> genres;
+    std::vector<uint32_t> composers;
+
+    // 숫자 열
+    std::vector<int64_t> durations;
+    std::vector<int32_t> bitDepths;
+    std::vector<int32_t> sampleRates;
+    std::vector<int32_t> channelCounts;
+    std::vector<int32_t> years;
+    std::vector<int32_t> trackNumbers;
+    std::vector<int32_t> playCounts;
+    std::vector<int64_t> lastPlayedTimes;
+    std::vector<int64_t> dateAddedTimes;
+    std::vector<int64_t> fileSizes;
+    std::vector<int64_t> modifiedTimesNs;
+    std::vector<uint64_t> inodes;
+
+    std::vector<uint8_t> alive;
+    std::vector<TrackHandle> freeHandles;
+    size_t liveCount = 0;
+
+    HandleIndex idIndex;
+    HandleIndex pathIndex;
+
+    FacetIndex genreIndex;
+    FacetIndex artistIndex;
+    FacetIndex albumIndex;
+    FacetIndex yearIndex;
+    FacetIndex formatIndex;
+    std::vector<TrackHandle> highResolutionHandles;
+
+    RankIndex lastPlayedRanking;
+    RankIndex playCountRanking;
+    RankIndex dateAddedRanking;
+};
+
+} // namespace pancakemusicbox
+
+#endif // PANCAKEMUSICBOX_TRACKSTORE_H
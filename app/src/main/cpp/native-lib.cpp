@@ -104,6 +104,62 @@ Java_com_example_pancakemusicbox_audio_AudioPlayerNative_nativeGetDuration(
     return static_cast<jlong>(getPlayer().getDuration());
 }
 
+extern "C" JNIEXPORT jboolean JNICALL
+Java_com_example_pancakemusicbox_audio_AudioPlayerNative_nativePreloadFile(
+        JNIEnv* env,
+        jobject /* this */,
+        jstring jFilePath) {
+    return static_cast<jboolean>(getPlayer().preloadFile(env, jFilePath));
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_example_pancakemusicbox_audio_AudioPlayerNative_nativeSetDecodedCacheBudget(
+        JNIEnv* env,
+        jobject /* this */,
+        jlong budgetBytes) {
+    if (budgetBytes < 0) budgetBytes = 0;
+    getPlayer().setDecodedCacheBudget(static_cast<size_t>(budgetBytes));
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_example_pancakemusicbox_audio_AudioPlayerNative_nativeSetDecodedCacheCompact(
+        JNIEnv* env,
+        jobject /* this */,
+        jboolean compact) {
+    getPlayer().setDecodedCacheCompact(compact);
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_example_pancakemusicbox_audio_AudioPlayerNative_nativePrefetchFile(
+        JNIEnv* env,
+        jobject /* this */,
+        jstring jFilePath) {
+    getPlayer().prefetchFile(env, jFilePath);
+}
+
+extern "C" JNIEXPORT jlongArray JNICALL
+Java_com_example_pancakemusicbox_audio_AudioPlayerNative_nativeGetIoStats(
+        JNIEnv* env,
+        jobject /* this */) {
+    IoStats stats = getPlayer().getIoStats();
+    
+    // [읽은 바이트, I/O 대기 시간(us), stall 횟수, pread 횟수]
+    jlong values[4] = {
+        static_cast<jlong>(stats.bytesRead),
+        static_cast<jlong>(stats.ioWaitNs / 1000),
+        static_cast<jlong>(stats.stallCount),
+        static_cast<jlong>(stats.readCount)
+    };
+    
+    jlongArray result = env->NewLongArray(4);
+    if (result == nullptr) {
+        return nullptr; // OutOfMemoryError
+    }
+    
+    env->SetLongArrayRegion(result, 0, 4, values);
+    return result;
+}
+
 extern "C" JNIEXPORT void JNICALL
 Java_com_example_pancakemusicbox_audio_AudioPlayerNative_nativeSetSampleRate(
         JNIEnv* env,
@@ -169,6 +225,277 @@ Java_com_example_pancakemusicbox_audio_AudioPlayerNative_nativeSetTargetLUFS(
     getPlayer().setTargetLUFS(lufsValue);
 }
 
+extern "C" JNIEXPORT void JNICALL
+Java_com_example_pancakemusicbox_audio_AudioPlayerNative_nativeEnableLoudnessCompensation(
+        JNIEnv* env,
+        jobject /* this */,
+        jboolean enable) {
+    getPlayer().enableLoudnessCompensation(enable);
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_example_pancakemusicbox_audio_AudioPlayerNative_nativeEnableNightMode(
+        JNIEnv* env,
+        jobject /* this */,
+        jboolean enable) {
+    getPlayer().enableNightMode(enable);
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_example_pancakemusicbox_audio_AudioPlayerNative_nativeSetNightModeMakeupGain(
+        JNIEnv* env,
+        jobject /* this */,
+        jfloat gainDb) {
+    getPlayer().setNightModeMakeupGain(gainDb);
+}
+
+extern "C" JNIEXPORT jfloatArray JNICALL
+Java_com_example_pancakemusicbox_audio_AudioPlayerNative_nativeGetNightModeMeters(
+        JNIEnv* env,
+        jobject /* this */) {
+    CompressorMeters meters = getPlayer().getNightModeMeters();
+    
+    // [저역 GR(dB), 중역 GR(dB), 고역 GR(dB), 192프레임 블록 처리 시간(us), 예산 초과 횟수]
+    jfloat values[5] = {
+        meters.gainReductionDb[0],
+        meters.gainReductionDb[1],
+        meters.gainReductionDb[2],
+        meters.blockTimeUs,
+        static_cast<jfloat>(meters.budgetOverruns)
+    };
+    
+    jfloatArray result = env->NewFloatArray(5);
+    if (result == nullptr) {
+        return nullptr; // OutOfMemoryError
+    }
+    
+    env->SetFloatArrayRegion(result, 0, 5, values);
+    return result;
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_example_pancakemusicbox_audio_AudioPlayerNative_nativeSetPlaybackSpeed(
+        JNIEnv* env,
+        jobject /* this */,
+        jfloat speed) {
+    getPlayer().setPlaybackSpeed(speed);
+}
+
+extern "C" JNIEXPORT jfloat JNICALL
+Java_com_example_pancakemusicbox_audio_AudioPlayerNative_nativeGetPlaybackSpeed(
+        JNIEnv* env,
+        jobject /* this */) {
+    return getPlayer().getPlaybackSpeed();
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_example_pancakemusicbox_audio_AudioPlayerNative_nativeSetTimeStretchMode(
+        JNIEnv* env,
+        jobject /* this */,
+        jint mode) {
+    getPlayer().setTimeStretchMode(mode);
+}
+
+extern "C" JNIEXPORT jfloat JNICALL
+Java_com_example_pancakemusicbox_audio_AudioPlayerNative_nativeGetTimeStretchLoad(
+        JNIEnv* env,
+        jobject /* this */) {
+    return getPlayer().getTimeStretchLoad();
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_example_pancakemusicbox_audio_AudioPlayerNative_nativeEnableBitPerfect(
+        JNIEnv* env,
+        jobject /* this */,
+        jboolean enable) {
+    getPlayer().enableBitPerfect(enable);
+}
+
+extern "C" JNIEXPORT jboolean JNICALL
+Java_com_example_pancakemusicbox_audio_AudioPlayerNative_nativeIsBitPerfect(
+        JNIEnv* env,
+        jobject /* this */) {
+    return static_cast<jboolean>(getPlayer().isBitPerfect());
+}
+
+extern "C" JNIEXPORT jlong JNICALL
+Java_com_example_pancakemusicbox_audio_AudioPlayerNative_nativeGetOutputChecksum(
+        JNIEnv* env,
+        jobject /* this */) {
+    return static_cast<jlong>(getPlayer().getOutputChecksum());
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_example_pancakemusicbox_audio_AudioPlayerNative_nativeWarmStart(
+        JNIEnv* env,
+        jobject /* this */,
+        jstring jFirstTrackPath) {
+    getPlayer().warmStart(env, jFirstTrackPath);
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_example_pancakemusicbox_audio_AudioPlayerNative_nativeDisableWarmStart(
+        JNIEnv* env,
+        jobject /* this */) {
+    getPlayer().disableWarmStart();
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_example_pancakemusicbox_audio_AudioPlayerNative_nativeEnableDeepBuffer(
+        JNIEnv* env,
+        jobject /* this */,
+        jboolean enable) {
+    getPlayer().enableDeepBuffer(enable);
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_example_pancakemusicbox_audio_AudioPlayerNative_nativeSetPlayerUiVisible(
+        JNIEnv* env,
+        jobject /* this */,
+        jboolean visible) {
+    getPlayer().setPlayerUiVisible(visible);
+}
+
+extern "C" JNIEXPORT jfloatArray JNICALL
+Java_com_example_pancakemusicbox_audio_AudioPlayerNative_nativeGetPowerStats(
+        JNIEnv* env,
+        jobject /* this */) {
+    PowerStats stats = getPlayer().getPowerStats();
+    
+    // [저지연: 분당 깨어남, 시간당 CPU(s), 재생 시간(분),
+    //  deep buffer: 분당 깨어남, 시간당 CPU(s), 재생 시간(분), 현재 deep buffer 여부]
+    jfloat values[7] = {
+        stats.lowLatency.wakeupsPerMinute,
+        stats.lowLatency.cpuSecondsPerHour,
+        stats.lowLatency.playbackMinutes,
+        stats.deepBuffer.wakeupsPerMinute,
+        stats.deepBuffer.cpuSecondsPerHour,
+        stats.deepBuffer.playbackMinutes,
+        stats.deepBufferActive ? 1.0f : 0.0f
+    };
+    
+    jfloatArray result = env->NewFloatArray(7);
+    if (result == nullptr) {
+        return nullptr; // OutOfMemoryError
+    }
+    
+    env->SetFloatArrayRegion(result, 0, 7, values);
+    return result;
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_example_pancakemusicbox_audio_AudioPlayerNative_nativeSetAutoHardwareSwitching(
+        JNIEnv* env,
+        jobject /* this */,
+        jboolean enable) {
+    getPlayer().setAutoHardwareSwitching(enable);
+}
+
+extern "C" JNIEXPORT jint JNICALL
+Java_com_example_pancakemusicbox_audio_AudioPlayerNative_nativeAddOutputDevice(
+        JNIEnv* env,
+        jobject /* this */,
+        jint deviceId) {
+    return getPlayer().addOutputDevice(deviceId);
+}
+
+extern "C" JNIEXPORT jint JNICALL
+Java_com_example_pancakemusicbox_audio_AudioPlayerNative_nativeAddNullOutput(
+        JNIEnv* env,
+        jobject /* this */,
+        jint sampleRate,
+        jfloat clockPpm) {
+    return getPlayer().addNullOutput(sampleRate, clockPpm);
+}
+
+extern "C" JNIEXPORT jboolean JNICALL
+Java_com_example_pancakemusicbox_audio_AudioPlayerNative_nativeRemoveOutput(
+        JNIEnv* env,
+        jobject /* this */,
+        jint outputId) {
+    return getPlayer().removeOutput(outputId);
+}
+
+extern "C" JNIEXPORT jfloatArray JNICALL
+Java_com_example_pancakemusicbox_audio_AudioPlayerNative_nativeGetFanoutStats(
+        JNIEnv* env,
+        jobject /* this */) {
+    std::vector<FanoutOutputStats> stats = getPlayer().getFanoutStats();
+    
+    // 출력마다 [id, 샘플레이트, null 싱크 여부, 버퍼 양(ms), 목표 버퍼 양(ms),
+    //          레이트 보정(ppm), 언더런 횟수, 오버플로 횟수, 재동기화 횟수]
+    constexpr int kValuesPerOutput = 9;
+    std::vector<jfloat> values;
+    values.reserve(stats.size() * kValuesPerOutput);
+    for (const FanoutOutputStats& output : stats) {
+        values.push_back(static_cast<jfloat>(output.id));
+        values.push_back(static_cast<jfloat>(output.sampleRate));
+        values.push_back(output.nullSink ? 1.0f : 0.0f);
+        values.push_back(output.fillMs);
+        values.push_back(output.targetMs);
+        values.push_back(output.correctionPpm);
+        values.push_back(static_cast<jfloat>(output.underruns));
+        values.push_back(static_cast<jfloat>(output.overflows));
+        values.push_back(static_cast<jfloat>(output.resyncs));
+    }
+    
+    jfloatArray result = env->NewFloatArray(static_cast<jsize>(values.size()));
+    if (result == nullptr) {
+        return nullptr; // OutOfMemoryError
+    }
+    
+    env->SetFloatArrayRegion(result, 0, static_cast<jsize>(values.size()), values.data());
+    return result;
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_example_pancakemusicbox_audio_AudioPlayerNative_nativeSetOutputMode(
+        JNIEnv* env,
+        jobject /* this */,
+        jint mode,
+        jint burstsInFlight) {
+    getPlayer().setOutputMode(mode, burstsInFlight);
+}
+
+extern "C" JNIEXPORT jfloatArray JNICALL
+Java_com_example_pancakemusicbox_audio_AudioPlayerNative_nativeGetOutputMetrics(
+        JNIEnv* env,
+        jobject /* this */) {
+    OutputMetrics metrics = getPlayer().getOutputMetrics();
+    
+    // [출력 방식, 버스트 프레임, 버퍼 프레임, 버스트 수, 지연(ms), 언더런 횟수,
+    //  최근 렌더링 시간(us), 최대 렌더링 시간(us), 실시간 스레드 여부,
+    //  탭→소리 지연(ms), 트랙 로드 시간(ms), warm-start 여부,
+    //  하드웨어 레이트 자동 전환 여부, 리샘플링 여부, 스트림 재구성 횟수, 새 스트림 열기 시간(ms), 전환 공백(ms)]
+    jfloat values[17] = {
+        static_cast<jfloat>(metrics.mode),
+        static_cast<jfloat>(metrics.framesPerBurst),
+        static_cast<jfloat>(metrics.bufferSizeFrames),
+        static_cast<jfloat>(metrics.burstsInFlight),
+        static_cast<jfloat>(metrics.latencyMs),
+        static_cast<jfloat>(metrics.xRunCount),
+        metrics.lastRenderUs,
+        metrics.maxRenderUs,
+        metrics.realtimeThread ? 1.0f : 0.0f,
+        metrics.tapToSoundMs,
+        metrics.loadMs,
+        metrics.warmStart ? 1.0f : 0.0f,
+        metrics.autoHardwareSwitching ? 1.0f : 0.0f,
+        metrics.resampling ? 1.0f : 0.0f,
+        static_cast<jfloat>(metrics.streamSwitches),
+        metrics.switchOpenMs,
+        metrics.switchGapMs
+    };
+    
+    jfloatArray result = env->NewFloatArray(17);
+    if (result == nullptr) {
+        return nullptr; // OutOfMemoryError
+    }
+    
+    env->SetFloatArrayRegion(result, 0, 17, values);
+    return result;
+}
+
 extern "C" JNIEXPORT void JNICALL
 Java_com_example_pancakemusicbox_audio_AudioPlayerNative_nativeOptimizeForDevice(
         JNIEnv* env,
@@ -178,6 +505,29 @@ Java_com_example_pancakemusicbox_audio_AudioPlayerNative_nativeOptimizeForDevice
     getPlayer().optimizeForDevice(useHeadphones, isHighPerformanceDevice);
 }
 
+extern "C" JNIEXPORT void JNICALL
+Java_com_example_pancakemusicbox_audio_AudioPlayerNative_nativeSetCrossfeedPreset(
+        JNIEnv* env,
+        jobject /* this */,
+        jint preset) {
+    getPlayer().setCrossfeedPreset(preset);
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_example_pancakemusicbox_audio_AudioPlayerNative_nativeSetCrossfeedBypass(
+        JNIEnv* env,
+        jobject /* this */,
+        jboolean bypass) {
+    getPlayer().setCrossfeedBypass(bypass);
+}
+
+extern "C" JNIEXPORT jboolean JNICALL
+Java_com_example_pancakemusicbox_audio_AudioPlayerNative_nativeIsCrossfeedActive(
+        JNIEnv* env,
+        jobject /* this */) {
+    return static_cast<jboolean>(getPlayer().isCrossfeedActive());
+}
+
 extern "C" JNIEXPORT jfloatArray JNICALL
 Java_com_example_pancakemusicbox_audio_AudioPlayerNative_nativeGetVisualizationData(
         JNIEnv* env,
@@ -1,20 +1,31 @@
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <string>
 #include <vector>
 #include <memory>
 #include <functional>
+#include <mutex>
+#include <chrono>
+#include <thread>
 
 namespace oboe {
 
-// Oboe enums
-enum class Direction { Output };
-enum class PerformanceMode { LowLatency, None };
-enum class SharingMode { Exclusive, Shared };
-enum class AudioFormat { Float, I16, Unspecified };
-enum class StreamState { Started, Stopped, Paused, Unknown };
-enum class Result { OK, ErrorBase, ErrorDisconnected };
+// Oboe enums (값은 upstream Oboe / AAudio와 동일)
+enum class Direction : int32_t { Output = 0, Input = 1 };
+enum class PerformanceMode : int32_t { None = 10, PowerSaving = 11, LowLatency = 12 };
+enum class SharingMode : int32_t { Exclusive = 0, Shared = 1 };
+enum class AudioFormat : int32_t { Invalid = -1, Unspecified = 0, I16 = 1, Float = 2, I24 = 3, I32 = 4 };
+enum class StreamState : int32_t {
+    Uninitialized = 0, Unknown = 1, Open = 2, Starting = 3, Started = 4, Pausing = 5, Paused = 6,
+    Flushing = 7, Flushed = 8, Stopping = 9, Stopped = 10, Closing = 11, Closed = 12, Disconnected = 13
+};
+enum class SampleRateConversionQuality : int32_t { None, Fastest, Low, Medium, High, Best };
+enum class Result : int32_t {
+    OK = 0, ErrorBase = -900, ErrorDisconnected = -899, ErrorIllegalArgument = -898, ErrorInternal = -896,
+    ErrorInvalidState = -895, ErrorUnimplemented = -890, ErrorUnavailable = -889, ErrorTimeout = -885
+};
 
 // Result to string
 inline const char* convertToText(Result result) {
@@ -22,10 +33,32 @@ inline const char* convertToText(Result result) {
         case Result::OK: return "OK";
         case Result::ErrorBase: return "Error";
         case Result::ErrorDisconnected: return "Disconnected";
+        case Result::ErrorIllegalArgument: return "IllegalArgument";
+        case Result::ErrorInternal: return "Internal";
+        case Result::ErrorInvalidState: return "InvalidState";
+        case Result::ErrorUnimplemented: return "Unimplemented";
+        case Result::ErrorUnavailable: return "Unavailable";
+        case Result::ErrorTimeout: return "Timeout";
         default: return "Unknown";
     }
 }
 
+// Result or value
+template <typename T>
+class ResultWithValue {
+public:
+    ResultWithValue(Result error) : mValue{}, mError(error) {}
+    ResultWithValue(T value) : mValue(value), mError(Result::OK) {}
+
+    T value() const { return mValue; }
+    Result error() const { return mError; }
+    explicit operator bool() const { return mError == Result::OK; }
+
+private:
+    T mValue;
+    Result mError;
+};
+
 // Forward declarations
 class AudioStream;
 
@@ -47,39 +80,163 @@ public:
 };
 
 // AudioStream class
+// 목업 장치는 데이터 콜백을 호출하지 않으며, 재생 위치(getFramesRead)는 시작 시각 기준 장치 클럭으로 진행
 class AudioStream {
 public:
     virtual ~AudioStream() = default;
     
     virtual Result requestStart() { 
+        std::lock_guard<std::mutex> lock(mClockLock);
+        if (mState == StreamState::Closed) {
+            return Result::ErrorInvalidState;
+        }
         mState = StreamState::Started; 
+        restartClockLocked(mFramesRead);
         return Result::OK; 
     }
     
+    // 출력 스트림은 버퍼에 남은 프레임을 모두 재생한 뒤 정지
     virtual Result requestStop() { 
+        std::lock_guard<std::mutex> lock(mClockLock);
+        if (mState == StreamState::Closed) {
+            return Result::ErrorInvalidState;
+        }
+        mFramesRead = mFramesWritten;
         mState = StreamState::Stopped; 
         return Result::OK; 
     }
     
+    // 버퍼를 그대로 둔 채 재생 위치만 멈춤 (남은 프레임은 requestFlush로 버릴 수 있음)
     virtual Result requestPause() { 
+        std::lock_guard<std::mutex> lock(mClockLock);
+        if (mState == StreamState::Closed) {
+            return Result::ErrorInvalidState;
+        }
+        mFramesRead = getFramesReadLocked();
         mState = StreamState::Paused; 
         return Result::OK; 
     }
     
+    // 아직 재생되지 않은 프레임을 버림 (일시정지 상태에서만 가능, 재생 위치가 쓰기 위치로 이동)
+    virtual Result requestFlush() {
+        std::lock_guard<std::mutex> lock(mClockLock);
+        if (mState != StreamState::Paused && mState != StreamState::Flushed) {
+            return Result::ErrorInvalidState;
+        }
+        mFramesRead = mFramesWritten;
+        mState = StreamState::Flushed;
+        return Result::OK;
+    }
+    
     virtual Result close() { 
-        mState = StreamState::Unknown; 
+        std::lock_guard<std::mutex> lock(mClockLock);
+        mFramesRead = getFramesReadLocked();
+        mState = StreamState::Closed; 
         return Result::OK; 
     }
     
     virtual StreamState getState() const { return mState; }
     
+    virtual int32_t getDeviceId() const { return mDeviceId; }
     virtual int getChannelCount() const { return mChannelCount; }
     virtual int getSampleRate() const { return mSampleRate; }
+    virtual AudioFormat getFormat() const { return mFormat; }
+    
+    virtual PerformanceMode getPerformanceMode() const { return mPerformanceMode; }
+    virtual SharingMode getSharingMode() const { return mSharingMode; }
+    
+    virtual int32_t getFramesPerBurst() const { return mFramesPerBurst; }
+    virtual int32_t getBufferSizeInFrames() const { return mBufferSizeInFrames; }
+    virtual int32_t getBufferCapacityInFrames() const { return mBufferCapacityInFrames; }
+    
+    virtual int64_t getFramesWritten() { return mFramesWritten; }
+    
+    // 장치가 실제로 소비한 프레임 수 (쓰기 위치를 넘지 않음)
+    virtual int64_t getFramesRead() {
+        std::lock_guard<std::mutex> lock(mClockLock);
+        return getFramesReadLocked();
+    }
+    
+    virtual ResultWithValue<int32_t> setBufferSizeInFrames(int32_t requestedFrames) {
+        int32_t frames = requestedFrames < mFramesPerBurst ? mFramesPerBurst : requestedFrames;
+        mBufferSizeInFrames = frames > getBufferCapacityInFrames() ? getBufferCapacityInFrames() : frames;
+        return mBufferSizeInFrames;
+    }
+    
+    virtual ResultWithValue<int32_t> getXRunCount() const { return mXRunCount.load(); }
+    
+    virtual ResultWithValue<double> calculateLatencyMillis() {
+        return mBufferSizeInFrames * 1000.0 / mSampleRate;
+    }
+    
+    // 블로킹 쓰기 (콜백 없이 연 스트림용), 버퍼에 빈 공간이 생길 때까지 최대 timeout 동안 대기
+    // 대기 후에도 공간이 모자라면 들어간 만큼만 쓰고 그 프레임 수를 반환
+    virtual ResultWithValue<int32_t> write(const void *buffer, int32_t numFrames, int64_t timeoutNanoseconds) {
+        std::unique_lock<std::mutex> lock(mClockLock);
+        if (mState != StreamState::Started) {
+            return Result::ErrorInvalidState;
+        }
+        // 장치가 버퍼를 모두 비웠으면 언더런: 현재 쓰기 위치에서 클럭을 다시 시작
+        if (getClockFramesLocked() > mFramesWritten) {
+            mXRunCount++;
+            restartClockLocked(mFramesWritten);
+        }
+        
+        int64_t readNeeded = mFramesWritten + numFrames - mBufferSizeInFrames;
+        auto ready = mClockStart + std::chrono::nanoseconds((readNeeded - mClockBase) * 1000000000LL / mSampleRate);
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::nanoseconds(timeoutNanoseconds);
+        lock.unlock();
+        std::this_thread::sleep_until(ready < deadline ? ready : deadline);
+        lock.lock();
+        
+        if (mState != StreamState::Started) {
+            return Result::ErrorInvalidState;
+        }
+        int64_t space = mBufferSizeInFrames - (mFramesWritten - getFramesReadLocked());
+        int32_t frames = static_cast<int32_t>(space < 0 ? 0 : (space < numFrames ? space : numFrames));
+        mFramesWritten += frames;
+        return frames;
+    }
     
 private:
-    StreamState mState = StreamState::Unknown;
+    int64_t getClockFramesLocked() const {
+        auto elapsed = std::chrono::steady_clock::now() - mClockStart;
+        return mClockBase + std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() * mSampleRate / 1000000000LL;
+    }
+    
+    int64_t getFramesReadLocked() const {
+        if (mState != StreamState::Started) {
+            return mFramesRead;
+        }
+        int64_t frames = getClockFramesLocked();
+        return frames < mFramesWritten ? frames : mFramesWritten.load();
+    }
+    
+    void restartClockLocked(int64_t position) {
+        mClockStart = std::chrono::steady_clock::now();
+        mClockBase = position;
+    }
+    
+    // 블로킹 쓰기 스레드와 제어 스레드가 함께 접근
+    std::atomic<StreamState> mState{StreamState::Uninitialized};
+    std::atomic<int64_t> mFramesWritten{0};
+    std::atomic<int32_t> mXRunCount{0};
+    
+    int32_t mDeviceId = 0;
     int mChannelCount = 2;
     int mSampleRate = 44100;
+    AudioFormat mFormat = AudioFormat::Float;
+    PerformanceMode mPerformanceMode = PerformanceMode::None;
+    SharingMode mSharingMode = SharingMode::Shared;
+    int32_t mFramesPerBurst = 192;
+    int32_t mBufferSizeInFrames = 384;
+    int32_t mBufferCapacityInFrames = 192 * 16;
+    
+    // 장치 클럭 (실행 중에는 mClockStart 시각의 재생 위치 mClockBase부터 샘플레이트로 진행)
+    mutable std::mutex mClockLock;
+    std::chrono::steady_clock::time_point mClockStart;
+    int64_t mClockBase = 0;
+    int64_t mFramesRead = 0;    // 실행 중이 아닐 때의 재생 위치
     
     friend class AudioStreamBuilder;
 };
@@ -92,14 +249,22 @@ public:
     }
     
     AudioStreamBuilder* setPerformanceMode(PerformanceMode mode) {
+        mPerformanceMode = mode;
         return this;
     }
     
     AudioStreamBuilder* setSharingMode(SharingMode mode) {
+        mSharingMode = mode;
         return this;
     }
     
     AudioStreamBuilder* setFormat(AudioFormat format) {
+        mFormat = format;
+        return this;
+    }
+    
+    AudioStreamBuilder* setDeviceId(int32_t deviceId) {
+        mDeviceId = deviceId;
         return this;
     }
     
@@ -113,6 +278,12 @@ public:
         return this;
     }
     
+    // None이 아니면 기기가 요청 레이트를 지원하지 않을 때 Oboe 리샘플러로 변환
+    AudioStreamBuilder* setSampleRateConversionQuality(SampleRateConversionQuality quality) {
+        mSampleRateConversionQuality = quality;
+        return this;
+    }
+    
     AudioStreamBuilder* setCallback(AudioStreamCallback* callback) {
         mCallback = callback;
         return this;
@@ -120,14 +291,37 @@ public:
     
     Result openStream(std::shared_ptr<AudioStream>& stream) {
         stream = std::make_shared<AudioStream>();
+        stream->mState = StreamState::Open;
+        stream->mDeviceId = mDeviceId;
         stream->mChannelCount = mChannelCount;
-        stream->mSampleRate = mSampleRate;
+        // 목업 기기는 아래 레이트만 하드웨어로 지원하며, 그 외에는 변환을 요청하지 않으면 48kHz로 열림
+        bool supported = mSampleRate == 44100 || mSampleRate == 48000 || mSampleRate == 88200 ||
+                         mSampleRate == 96000 || mSampleRate == 192000;
+        stream->mSampleRate = supported || mSampleRateConversionQuality != SampleRateConversionQuality::None
+                              ? mSampleRate : 48000;
+        stream->mFormat = mFormat;
+        stream->mPerformanceMode = mPerformanceMode;
+        stream->mSharingMode = mSharingMode;
+        // 저지연 경로는 짧은 버스트, 절전(deep buffer) 경로는 약 40ms 버스트
+        if (mPerformanceMode == PerformanceMode::LowLatency) {
+            stream->mFramesPerBurst = 192;
+            stream->mBufferCapacityInFrames = 192 * 16;
+        } else {
+            stream->mFramesPerBurst = 1920;
+            stream->mBufferCapacityInFrames = 1920 * 4;
+        }
+        stream->mBufferSizeInFrames = stream->mFramesPerBurst * 2;
         return Result::OK;
     }
     
 private:
+    int32_t mDeviceId = 0;
     int mChannelCount = 2;
     int mSampleRate = 44100;
+    AudioFormat mFormat = AudioFormat::Float;
+    PerformanceMode mPerformanceMode = PerformanceMode::None;
+    SharingMode mSharingMode = SharingMode::Shared;
+    SampleRateConversionQuality mSampleRateConversionQuality = SampleRateConversionQuality::None;
     AudioStreamCallback* mCallback = nullptr;
 };
 
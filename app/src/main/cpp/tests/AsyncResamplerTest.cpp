@@ -0,0 +1,90 @@
+#include "include/AsyncResampler.h"
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+/**
+ * 다운샘플링 앨리어싱 방지 필터 확인
+ *
+ * 96kHz → 48kHz (공칭 비율 2)로 출력 나이퀴스트 위의 40kHz 톤을 넣으면 8kHz로 접히므로
+ * 필터가 충분히 걸러야 하고, 가청 대역의 1kHz 톤은 거의 그대로 통과해야 함
+ * 클럭 보정 수준의 비율(1에 가까움)에서는 필터 없이 원래 보간 결과와 같아야 함
+ */
+
+namespace {
+
+constexpr int kChannels = 2;
+constexpr int32_t kBlockFrames = 480;
+constexpr int kBlocks = 400;
+constexpr int kSettleBlocks = 50;
+
+int gFailures = 0;
+
+void check(bool condition, const char* what) {
+    printf("%s %s\n", condition ? "PASS" : "FAIL", what);
+    if (!condition) {
+        gFailures++;
+    }
+}
+
+// ratio로 리샘플링한 사인파 출력의 RMS (필터 과도 응답이 끝난 뒤 구간)
+double resampledRms(double inputRate, double toneHz, double ratio, bool setNominal) {
+    AsyncResampler resampler;
+    resampler.configure(kChannels, static_cast<int32_t>(kBlockFrames * ratio) + 2);
+    if (setNominal) {
+        resampler.setNominalRatio(ratio);
+    }
+
+    std::vector<float> output(static_cast<size_t>(kBlockFrames) * kChannels);
+    int64_t inputIndex = 0;
+    double sum = 0.0;
+    int64_t count = 0;
+    for (int block = 0; block < kBlocks; block++) {
+        int32_t needed = resampler.getInputFramesNeeded(kBlockFrames, ratio);
+        float* input = resampler.getInputBuffer();
+        for (int32_t i = 0; i < needed; i++, inputIndex++) {
+            float x = static_cast<float>(std::sin(2.0 * M_PI * toneHz * inputIndex / inputRate));
+            input[i * kChannels] = x;
+            input[i * kChannels + 1] = x;
+        }
+        resampler.process(needed, output.data(), kBlockFrames, ratio);
+        if (block >= kSettleBlocks) {
+            for (float y : output) {
+                sum += static_cast<double>(y) * y;
+                count++;
+            }
+        }
+    }
+    return std::sqrt(sum / count);
+}
+
+double toDb(double rms) {
+    // 진폭 1 사인파의 RMS 기준
+    return 20.0 * std::log10(rms * std::sqrt(2.0) + 1e-12);
+}
+
+} // namespace
+
+int main() {
+    const double sineRms = 1.0 / std::sqrt(2.0);
+
+    double passband = toDb(resampledRms(96000.0, 1000.0, 2.0, true));
+    printf("1 kHz at 96k -> 48k: %.2f dB\n", passband);
+    check(std::fabs(passband) < 0.5, "passband tone passes within 0.5 dB");
+
+    double aliased = toDb(resampledRms(96000.0, 40000.0, 2.0, true));
+    double unfiltered = toDb(resampledRms(96000.0, 40000.0, 2.0, false));
+    printf("40 kHz at 96k -> 48k: %.1f dB filtered, %.1f dB without the anti-alias stage\n", aliased, unfiltered);
+    check(aliased < -40.0, "tone above output Nyquist is attenuated by at least 40 dB");
+
+    double highRatio = toDb(resampledRms(384000.0, 100000.0, 8.0, true));
+    printf("100 kHz at 384k -> 48k: %.1f dB\n", highRatio);
+    check(highRatio < -40.0, "maximum nominal ratio is filtered too");
+
+    double nearUnity = resampledRms(48000.0, 1000.0, 1.0003, true);
+    double plain = resampledRms(48000.0, 1000.0, 1.0003, false);
+    check(nearUnity == plain && std::fabs(toDb(nearUnity)) < 0.1 && plain > 0.9 * sineRms,
+          "clock-correction ratios bypass the filter");
+
+    return gFailures == 0 ? 0 : 1;
+}
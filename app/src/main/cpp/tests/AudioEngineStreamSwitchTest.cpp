@@ -0,0 +1,144 @@
+#include "include/AudioEngine.h"
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+/**
+ * 성능 모드 전환 시 이전 스트림 버퍼에 남은 프레임 처리 확인 (fakes/oboe로 장치 재생 위치를 뒤처지게 함)
+ *
+ * 재생 위치가 쓰기 위치보다 몇 버스트 뒤처진 상태에서 저지연 ↔ deep buffer를 전환하고,
+ * 장치가 실제로 재생한 순서(이전 스트림 → 새 스트림)를 전환 없이 재생한 결과와 비교
+ * 남은 프레임이 두 번 재생되거나(되감은 뒤 이전 스트림이 마저 재생) 건너뛰면 실패
+ * warm-start 무음 스트림이 유휴 시간 뒤 멈추고 play()로 다시 시작하는지도 확인
+ */
+
+namespace {
+
+constexpr int32_t kLowLatencyBurst = 192;
+constexpr int32_t kDeepBufferBurst = 1920;
+constexpr int kLagBursts = 3;
+
+int gFailures = 0;
+
+void check(bool condition, const char* what) {
+    printf("%s %s\n", condition ? "PASS" : "FAIL", what);
+    if (!condition) {
+        gFailures++;
+    }
+}
+
+std::shared_ptr<oboe::AudioStream> latestStream() {
+    return oboe::fake::openedStreams().back();
+}
+
+// 콜백을 count번 호출하고 장치 재생 위치는 lagFrames만큼 뒤처지게 진행
+void render(oboe::AudioStream& stream, int32_t burst, int count, int64_t lagFrames) {
+    for (int i = 0; i < count; i++) {
+        stream.fakeRenderCallback(burst);
+    }
+    stream.fakeAdvanceReadClock(stream.getFramesWritten() - lagFrames - stream.getFramesRead());
+}
+
+void appendPlayed(std::vector<uint8_t>& played, const oboe::AudioStream& stream) {
+    std::vector<uint8_t> bytes = stream.fakeGetPlayed();
+    played.insert(played.end(), bytes.begin(), bytes.end());
+}
+
+std::string createSourceFile() {
+    char path[] = "/tmp/pancake-switch-XXXXXX";
+    int fd = mkstemp(path);
+    std::vector<uint8_t> bytes(64 * 1024, 0x5a);
+    ssize_t written = write(fd, bytes.data(), bytes.size());
+    close(fd);
+    return written == static_cast<ssize_t>(bytes.size()) ? path : "";
+}
+
+} // namespace
+
+int main() {
+    std::string path = createSourceFile();
+    if (path.empty()) {
+        printf("FAIL could not create source file\n");
+        return 1;
+    }
+
+    // 전환 없이 한 스트림으로 재생한 기준 출력
+    std::vector<uint8_t> reference;
+    {
+        AudioEngine engine;
+        engine.loadFile(path);
+        engine.play();
+        std::shared_ptr<oboe::AudioStream> stream = latestStream();
+        render(*stream, kLowLatencyBurst, 400, 0);
+        appendPlayed(reference, *stream);
+    }
+
+    std::vector<uint8_t> played;
+    {
+        AudioEngine engine;
+        engine.enableDeepBuffer(true);
+        engine.loadFile(path);
+        engine.play();
+
+        // 저지연 스트림에서 재생하다가 플레이어 UI가 가려지면 deep buffer로 전환
+        std::shared_ptr<oboe::AudioStream> lowLatency = latestStream();
+        render(*lowLatency, kLowLatencyBurst, 50, kLowLatencyBurst * kLagBursts);
+        engine.setPlayerUiVisible(false);
+        std::shared_ptr<oboe::AudioStream> deepBuffer = latestStream();
+        check(deepBuffer != lowLatency && deepBuffer->getPerformanceMode() == oboe::PerformanceMode::PowerSaving,
+              "switched to a PowerSaving stream");
+        check(lowLatency->getState() == oboe::StreamState::Closed && lowLatency->fakeGetFlushCount() == 1,
+              "previous stream paused, flushed and closed");
+        appendPlayed(played, *lowLatency);
+
+        // deep buffer에서 재생하다가 UI가 다시 보이면 저지연으로 전환
+        render(*deepBuffer, kDeepBufferBurst, 10, kDeepBufferBurst * kLagBursts);
+        engine.setPlayerUiVisible(true);
+        std::shared_ptr<oboe::AudioStream> back = latestStream();
+        check(back != deepBuffer && back->getPerformanceMode() == oboe::PerformanceMode::LowLatency,
+              "switched back to a LowLatency stream");
+        check(deepBuffer->fakeGetFlushCount() == 1, "deep buffer stream flushed before close");
+        appendPlayed(played, *deepBuffer);
+
+        render(*back, kLowLatencyBurst, 50, 0);
+        appendPlayed(played, *back);
+    }
+
+    // 재생하지 않는 warm-start 스트림은 유휴 시간이 지나면 콜백에서 멈춤
+    {
+        AudioEngine engine;
+        engine.warmStart(path);
+        std::shared_ptr<oboe::AudioStream> warm = latestStream();
+        check(warm->getState() == oboe::StreamState::Started, "warm start runs the stream before play");
+        int64_t silentFrames = 0;
+        while (silentFrames < 60 * warm->getSampleRate() && warm->fakeRenderCallback(kLowLatencyBurst)) {
+            silentFrames += kLowLatencyBurst;
+        }
+        int64_t rate = warm->getSampleRate();
+        check(warm->getState() == oboe::StreamState::Stopped &&
+              silentFrames >= 29 * rate && silentFrames <= 31 * rate,
+              "idle warm stream stops after about 30 s of silence");
+
+        engine.loadFile(path);
+        engine.play();
+        check(latestStream() == warm && warm->getState() == oboe::StreamState::Started,
+              "play restarts the stopped warm stream");
+    }
+    unlink(path.c_str());
+
+    check(played.size() > 0 && played.size() <= reference.size(), "reference covers the switched playback");
+    size_t frameBytes = 2 * sizeof(float);
+    size_t mismatch = 0;
+    while (mismatch < played.size() && mismatch < reference.size() && played[mismatch] == reference[mismatch]) {
+        mismatch++;
+    }
+    bool continuous = mismatch == played.size();
+    if (!continuous) {
+        printf("played audio diverges from the reference at frame %zu of %zu\n",
+               mismatch / frameBytes, played.size() / frameBytes);
+    }
+    check(continuous, "queued frames are neither replayed nor skipped across mode switches");
+    return gFailures == 0 ? 0 : 1;
+}
@@ -0,0 +1,160 @@
+#include "include/DspChain.h"
+#include "include/DspKernels.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+/**
+ * 융합 DSP 커널과 단계별 기준 경로(processPerStage) 비교
+ *
+ * 같은 설정의 체인 두 개에 같은 입력을 192프레임(48kHz 4ms) 콜백 단위로 넣어
+ * 프레임당 처리 시간과 두 경로 출력의 최대 차이를 출력
+ * 차이는 SIMD biquad 커널의 곱셈-덧셈 융합 차이 수준이어야 함 (int16은 1 LSB 이내)
+ */
+
+namespace {
+
+constexpr int kSampleRate = 48000;
+constexpr int kChannels = 2;
+constexpr int32_t kBlockFrames = 192;
+constexpr int kSeconds = 20;
+constexpr int kRepeats = 3;
+
+struct Config {
+    const char* name;
+    DspSettings settings;
+};
+
+DspSettings baseSettings(SampleFormat format) {
+    DspSettings settings;
+    settings.sampleRate = kSampleRate;
+    settings.channelCount = kChannels;
+    settings.outputFormat = format;
+    settings.volume = 0.8f;
+    return settings;
+}
+
+std::vector<Config> makeConfigs() {
+    std::vector<Config> configs;
+    const SampleFormat formats[] = {SampleFormat::Float32, SampleFormat::Int16};
+    for (SampleFormat format : formats) {
+        bool int16 = format == SampleFormat::Int16;
+
+        DspSettings volume = baseSettings(format);
+        configs.push_back({int16 ? "volume -> i16" : "volume", volume});
+
+        DspSettings eq = volume;
+        eq.eqEnabled = true;
+        eq.eqGains = {4.0f, 3.0f, 1.5f, 0.0f, -1.0f, -2.0f, 0.0f, 1.0f, 2.5f, 3.5f};
+        configs.push_back({int16 ? "eq8 + limit -> i16" : "eq8 + limit", eq});
+
+        DspSettings loudness = eq;
+        loudness.loudnessEnabled = true;
+        loudness.normalizationEnabled = true;
+        configs.push_back({int16 ? "eq9 + norm -> i16" : "eq9 + norm", loudness});
+
+        DspSettings crossfeed = loudness;
+        crossfeed.crossfeedEnabled = true;
+        configs.push_back({int16 ? "+ crossfeed -> i16" : "+ crossfeed", crossfeed});
+
+        DspSettings all = crossfeed;
+        all.compressorEnabled = true;
+        configs.push_back({int16 ? "+ compressor -> i16" : "+ compressor", all});
+    }
+    return configs;
+}
+
+std::vector<float> makeInput(int32_t frames) {
+    std::vector<float> input(static_cast<size_t>(frames) * kChannels);
+    uint32_t noise = 987654321u;
+    for (int32_t i = 0; i < frames; i++) {
+        double t = static_cast<double>(i) / kSampleRate;
+        double tone = 0.3 * std::sin(2.0 * M_PI * 55.0 * t) + 0.2 * std::sin(2.0 * M_PI * 440.0 * t)
+                      + 0.1 * std::sin(2.0 * M_PI * 6000.0 * t);
+        noise = noise * 1664525u + 1013904223u;
+        double hiss = 0.1 * (static_cast<double>(noise >> 8) / (1 << 24) - 0.5);
+        input[static_cast<size_t>(i) * kChannels] = static_cast<float>(tone + hiss);
+        input[static_cast<size_t>(i) * kChannels + 1] = static_cast<float>(tone - hiss);
+    }
+    return input;
+}
+
+size_t bytesPerSample(SampleFormat format) {
+    return format == SampleFormat::Int16 ? sizeof(int16_t) : sizeof(float);
+}
+
+float sampleAt(const std::vector<uint8_t>& buffer, SampleFormat format, size_t index) {
+    if (format == SampleFormat::Int16) {
+        return reinterpret_cast<const int16_t*>(buffer.data())[index];
+    }
+    return reinterpret_cast<const float*>(buffer.data())[index];
+}
+
+// 전체 입력을 블록 단위로 처리하고 프레임당 ns 반환
+double timeRun(const DspSettings& settings, const std::vector<float>& input, bool perStage) {
+    DspChain chain;
+    chain.configure(settings);
+    const int32_t totalFrames = static_cast<int32_t>(input.size() / kChannels);
+    std::vector<uint8_t> output(static_cast<size_t>(kBlockFrames) * kChannels * bytesPerSample(settings.outputFormat));
+
+    auto start = std::chrono::steady_clock::now();
+    for (int32_t frame = 0; frame + kBlockFrames <= totalFrames; frame += kBlockFrames) {
+        const float* block = input.data() + static_cast<size_t>(frame) * kChannels;
+        if (perStage) {
+            chain.processPerStage(block, output.data(), kBlockFrames);
+        } else {
+            chain.process(block, output.data(), kBlockFrames);
+        }
+    }
+    double elapsedNs = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count());
+    return elapsedNs / totalFrames;
+}
+
+// 두 경로 출력의 최대 절대 차이 (float은 진폭, int16은 LSB)
+float maxDifference(const DspSettings& settings, const std::vector<float>& input) {
+    DspChain fused;
+    DspChain perStage;
+    fused.configure(settings);
+    perStage.configure(settings);
+    const int32_t totalFrames = static_cast<int32_t>(input.size() / kChannels);
+    const size_t blockBytes = static_cast<size_t>(kBlockFrames) * kChannels * bytesPerSample(settings.outputFormat);
+    std::vector<uint8_t> a(blockBytes);
+    std::vector<uint8_t> b(blockBytes);
+
+    float worst = 0.0f;
+    for (int32_t frame = 0; frame + kBlockFrames <= totalFrames; frame += kBlockFrames) {
+        const float* block = input.data() + static_cast<size_t>(frame) * kChannels;
+        fused.process(block, a.data(), kBlockFrames);
+        perStage.processPerStage(block, b.data(), kBlockFrames);
+        for (size_t i = 0; i < static_cast<size_t>(kBlockFrames) * kChannels; i++) {
+            worst = std::max(worst, std::fabs(sampleAt(a, settings.outputFormat, i) -
+                                              sampleAt(b, settings.outputFormat, i)));
+        }
+    }
+    return worst;
+}
+
+} // namespace
+
+int main() {
+    std::vector<float> input = makeInput(kSeconds * kSampleRate);
+
+    printf("kernels: %s, %d Hz stereo, %d-frame blocks, %d s per run, best of %d\n",
+           DspKernels::active().name, kSampleRate, kBlockFrames, kSeconds, kRepeats);
+    printf("%-22s %12s %12s %9s %12s\n", "stages", "fused ns/f", "staged ns/f", "speedup", "max diff");
+
+    for (const Config& config : makeConfigs()) {
+        double fusedNs = 1e9;
+        double stagedNs = 1e9;
+        for (int r = 0; r < kRepeats; r++) {
+            fusedNs = std::min(fusedNs, timeRun(config.settings, input, false));
+            stagedNs = std::min(stagedNs, timeRun(config.settings, input, true));
+        }
+        printf("%-22s %12.2f %12.2f %8.2fx %12.3g\n", config.name, fusedNs, stagedNs, stagedNs / fusedNs,
+               maxDifference(config.settings, input));
+    }
+    return 0;
+}
@@ -0,0 +1,437 @@
+#include "include/DspKernels.h"
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+/**
+ * 현재 CPU에서 실행 가능한 모든 커널 테이블을 scalar 기준 구현과 비교
+ * 변환 커널(int16ToFloat, floatToInt16, halfToFloat)과 applyGain은 비트 단위로 같아야 하고,
+ * 누산 커널(sumSquares, dotProduct, binEnergies)은 합산 순서 차이만큼의 오차만 허용
+ * biquadCascade, fftStage, resampleCubic은 곱셈-덧셈 융합 여부에 따른 반올림 차이만 허용
+ * 길이와 시작 오프셋을 바꿔가며 벡터 본체와 scalar 꼬리 처리 경계를 모두 지나가게 함
+ */
+
+namespace {
+
+// 벡터 폭(최대 8 floats)의 여러 배수와 그 사이 길이, 큰 블록 하나
+const size_t kLengths[] = {0, 1, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65, 1000, 4099};
+const size_t kMaxOffset = 3;
+
+int gFailures = 0;
+
+void fail(const DspKernelTable& table, const char* kernel, size_t length, size_t offset, const char* detail) {
+    printf("FAIL %s.%s (length %zu, offset %zu): %s\n", table.name, kernel, length, offset, detail);
+    gFailures++;
+}
+
+bool sameBits(float a, float b) {
+    uint32_t x;
+    uint32_t y;
+    memcpy(&x, &a, sizeof(x));
+    memcpy(&y, &b, sizeof(y));
+    return x == y;
+}
+
+void testInt16ToFloat(const DspKernelTable& table, const DspKernelTable& scalar) {
+    // int16 전 범위
+    std::vector<int16_t> src(65536 + kMaxOffset);
+    for (size_t i = 0; i < src.size(); i++) {
+        src[i] = static_cast<int16_t>(i - 32768);
+    }
+    std::vector<float> expected(src.size());
+    std::vector<float> actual(src.size());
+    scalar.int16ToFloat(src.data(), expected.data(), src.size());
+    table.int16ToFloat(src.data(), actual.data(), src.size());
+    for (size_t i = 0; i < src.size(); i++) {
+        if (!sameBits(expected[i], actual[i])) {
+            char detail[96];
+            snprintf(detail, sizeof(detail), "input %d -> %.9g, expected %.9g", src[i], actual[i], expected[i]);
+            fail(table, "int16ToFloat", src.size(), 0, detail);
+            return;
+        }
+    }
+
+    for (size_t length : kLengths) {
+        for (size_t offset = 0; offset <= kMaxOffset && length + offset <= src.size(); offset++) {
+            std::fill(actual.begin(), actual.end(), -2.0f);
+            table.int16ToFloat(src.data() + offset, actual.data() + offset, length);
+            for (size_t i = 0; i < length; i++) {
+                if (!sameBits(actual[offset + i], src[offset + i] * (1.0f / 32768.0f))) {
+                    fail(table, "int16ToFloat", length, offset, "mismatch");
+                    break;
+                }
+            }
+            if (actual[offset + length] != -2.0f) {
+                fail(table, "int16ToFloat", length, offset, "wrote past the end");
+            }
+        }
+    }
+}
+
+void testFloatToInt16(const DspKernelTable& table, const DspKernelTable& scalar) {
+    // 반올림 경계(.5), 클램핑 경계, 범위 밖 값과 임의 값
+    std::vector<float> src;
+    for (int32_t v = -32800; v <= 32800; v++) {
+        src.push_back(v / 32768.0f);
+        src.push_back((v + 0.5f) / 32768.0f);
+        src.push_back(std::nextafter((v + 0.5f) / 32768.0f, 0.0f));
+    }
+    const float specials[] = {0.0f, -0.0f, 1.0f, -1.0f, 1.5f, -1.5f, 100.0f, -100.0f, 1e30f, -1e30f,
+                              1e-30f, -1e-30f, INFINITY, -INFINITY};
+    src.insert(src.end(), std::begin(specials), std::end(specials));
+    std::mt19937 rng(31);
+    std::uniform_real_distribution<float> dist(-1.2f, 1.2f);
+    for (int i = 0; i < 100000; i++) {
+        src.push_back(dist(rng));
+    }
+    src.resize(src.size() + kMaxOffset, 0.0f);
+
+    std::vector<int16_t> expected(src.size());
+    std::vector<int16_t> actual(src.size());
+    scalar.floatToInt16(src.data(), expected.data(), src.size());
+    table.floatToInt16(src.data(), actual.data(), src.size());
+    for (size_t i = 0; i < src.size(); i++) {
+        if (expected[i] != actual[i]) {
+            char detail[96];
+            snprintf(detail, sizeof(detail), "input %.9g -> %d, expected %d", src[i], actual[i], expected[i]);
+            fail(table, "floatToInt16", src.size(), 0, detail);
+            return;
+        }
+    }
+
+    for (size_t length : kLengths) {
+        for (size_t offset = 0; offset <= kMaxOffset; offset++) {
+            std::fill(actual.begin(), actual.end(), static_cast<int16_t>(0x5a5a));
+            table.floatToInt16(src.data() + offset, actual.data() + offset, length);
+            for (size_t i = 0; i < length; i++) {
+                if (actual[offset + i] != expected[offset + i]) {
+                    fail(table, "floatToInt16", length, offset, "mismatch");
+                    break;
+                }
+            }
+            if (actual[offset + length] != 0x5a5a) {
+                fail(table, "floatToInt16", length, offset, "wrote past the end");
+            }
+        }
+    }
+}
+
+void testHalfToFloat(const DspKernelTable& table, const DspKernelTable& scalar) {
+    // half 비트 패턴 전체 (0, 서브노멀, 무한대, NaN 포함)
+    std::vector<uint16_t> src(65536 + kMaxOffset);
+    for (size_t i = 0; i < src.size(); i++) {
+        src[i] = static_cast<uint16_t>(i);
+    }
+    std::vector<float> expected(src.size());
+    std::vector<float> actual(src.size());
+    scalar.halfToFloat(src.data(), expected.data(), src.size());
+    table.halfToFloat(src.data(), actual.data(), src.size());
+    for (size_t i = 0; i < src.size(); i++) {
+        if (!sameBits(expected[i], actual[i])) {
+            char detail[96];
+            snprintf(detail, sizeof(detail), "input 0x%04x -> %.9g, expected %.9g", src[i], actual[i], expected[i]);
+            fail(table, "halfToFloat", src.size(), 0, detail);
+            return;
+        }
+    }
+
+    for (size_t length : kLengths) {
+        for (size_t offset = 0; offset <= kMaxOffset; offset++) {
+            std::fill(actual.begin(), actual.end(), -2.0f);
+            table.halfToFloat(src.data() + offset, actual.data() + offset, length);
+            for (size_t i = 0; i < length; i++) {
+                if (!sameBits(actual[offset + i], expected[offset + i])) {
+                    fail(table, "halfToFloat", length, offset, "mismatch");
+                    break;
+                }
+            }
+            if (actual[offset + length] != -2.0f) {
+                fail(table, "halfToFloat", length, offset, "wrote past the end");
+            }
+        }
+    }
+}
+
+// 합산 순서만 다르면 오차는 항 크기의 합에 비례 (float 누산, 길이 n에 대해 대략 n * eps)
+bool withinTolerance(double actual, double expected, double magnitude, size_t length) {
+    double tolerance = magnitude * 1.2e-7 * (length + 8) + 1e-30;
+    return std::fabs(actual - expected) <= tolerance;
+}
+
+void testAccumulators(const DspKernelTable& table, const DspKernelTable& scalar) {
+    std::mt19937 rng(32);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::vector<float> a(4099 + kMaxOffset);
+    std::vector<float> b(a.size());
+    for (size_t i = 0; i < a.size(); i++) {
+        a[i] = dist(rng);
+        b[i] = dist(rng);
+    }
+
+    for (size_t length : kLengths) {
+        for (size_t offset = 0; offset <= kMaxOffset; offset++) {
+            const float* x = a.data() + offset;
+            const float* y = b.data() + offset;
+            double squares = 0.0;
+            double magnitude = 0.0;
+            for (size_t i = 0; i < length; i++) {
+                squares += static_cast<double>(x[i]) * x[i];
+                magnitude += std::fabs(static_cast<double>(x[i]) * y[i]);
+            }
+
+            float expected = scalar.sumSquares(x, length);
+            float actual = table.sumSquares(x, length);
+            if (!withinTolerance(actual, expected, squares, length)) {
+                char detail[96];
+                snprintf(detail, sizeof(detail), "%.9g, expected %.9g", actual, expected);
+                fail(table, "sumSquares", length, offset, detail);
+            }
+
+            expected = scalar.dotProduct(x, y, length);
+            actual = table.dotProduct(x, y, length);
+            if (!withinTolerance(actual, expected, magnitude, length)) {
+                char detail[96];
+                snprintf(detail, sizeof(detail), "%.9g, expected %.9g", actual, expected);
+                fail(table, "dotProduct", length, offset, detail);
+            }
+        }
+    }
+}
+
+// 필터/FFT/보간: 같은 연산 순서이므로 곱셈-덧셈 융합(FMA) 여부에 따른 마지막 비트 차이만 허용
+bool closeTo(float actual, float expected, float scale) {
+    return std::fabs(actual - expected) <= 1e-5f * scale + 1e-6f;
+}
+
+void testGain(const DspKernelTable& table, const DspKernelTable& scalar) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> dist(-2.0f, 2.0f);
+    std::vector<float> src(4099 + kMaxOffset + 1);
+    for (float& x : src) {
+        x = dist(rng);
+    }
+    const float gains[] = {0.0f, 0.5f, 1.0f, 1.0f / 4096.0f, 0.7071f, 3.7f};
+
+    for (float gain : gains) {
+        for (size_t length : kLengths) {
+            for (size_t offset = 0; offset <= kMaxOffset; offset++) {
+                std::vector<float> expected = src;
+                std::vector<float> actual = src;
+                scalar.applyGain(expected.data() + offset, length, gain);
+                table.applyGain(actual.data() + offset, length, gain);
+                for (size_t i = 0; i < src.size(); i++) {
+                    if (!sameBits(actual[i], expected[i])) {
+                        fail(table, "applyGain", length, offset,
+                             i < offset || i >= offset + length ? "wrote outside the range" : "mismatch");
+                        break;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void testBiquadCascade(const DspKernelTable& table, const DspKernelTable& scalar) {
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    // 실제 사용하는 섹션 수(안티에일리어싱 4, EQ 10 + 라우드니스 1)와 벡터 경로의 한계 넘는 수
+    const size_t kSectionCounts[] = {1, 2, 4, 11, 17};
+    const int kChannelCounts[] = {1, 2, 3};
+    const size_t kStateStride = 4;
+
+    for (size_t sections : kSectionCounts) {
+        std::vector<BiquadCoefficients> coefficients;
+        for (size_t s = 0; s < sections; s++) {
+            float hz = 100.0f * (s + 1);
+            switch (s % 3) {
+                case 0: coefficients.push_back(BiquadCoefficients::peaking(48000.0f, hz, 1.4f, 6.0f)); break;
+                case 1: coefficients.push_back(BiquadCoefficients::lowPass(48000.0f, 5 * hz, 0.7071f)); break;
+                default: coefficients.push_back(BiquadCoefficients::highShelf(48000.0f, 10 * hz, 0.7071f, -4.0f)); break;
+            }
+        }
+        for (int channels : kChannelCounts) {
+            for (size_t length : kLengths) {
+                std::vector<float> expected(length * channels);
+                for (float& x : expected) {
+                    x = dist(rng);
+                }
+                std::vector<float> actual = expected;
+                // 블록 사이 상태 이어받기도 확인하도록 0이 아닌 상태에서 시작
+                std::vector<BiquadState> expectedStates(sections * kStateStride);
+                for (BiquadState& state : expectedStates) {
+                    state.z1 = dist(rng) * 0.1f;
+                    state.z2 = dist(rng) * 0.1f;
+                }
+                std::vector<BiquadState> actualStates = expectedStates;
+
+                scalar.biquadCascade(expected.data(), length, channels, coefficients.data(), expectedStates.data(),
+                                     sections, kStateStride);
+                table.biquadCascade(actual.data(), length, channels, coefficients.data(), actualStates.data(),
+                                    sections, kStateStride);
+                bool ok = true;
+                for (size_t i = 0; i < expected.size() && ok; i++) {
+                    ok = closeTo(actual[i], expected[i], 4.0f);
+                }
+                for (size_t i = 0; i < expectedStates.size() && ok; i++) {
+                    ok = closeTo(actualStates[i].z1, expectedStates[i].z1, 4.0f) &&
+                         closeTo(actualStates[i].z2, expectedStates[i].z2, 4.0f);
+                }
+                if (!ok) {
+                    char detail[64];
+                    snprintf(detail, sizeof(detail), "%zu sections, %d channels", sections, channels);
+                    fail(table, "biquadCascade", length, 0, detail);
+                }
+            }
+        }
+    }
+}
+
+// 커널의 단계 함수로 전체 FFT 수행 (Fft와 같은 트위들 배치)
+void runFft(const DspKernelTable& table, std::vector<float>& real, std::vector<float>& imag, bool inverse) {
+    const size_t size = real.size();
+    size_t bits = 0;
+    while ((size_t(1) << bits) < size) {
+        bits++;
+    }
+    for (size_t i = 0; i < size; i++) {
+        size_t j = 0;
+        for (size_t b = 0; b < bits; b++) {
+            j |= ((i >> b) & 1) << (bits - 1 - b);
+        }
+        if (j > i) {
+            std::swap(real[i], real[j]);
+            std::swap(imag[i], imag[j]);
+        }
+    }
+    for (size_t half = 1; half < size; half <<= 1) {
+        std::vector<float> twiddleReal(half);
+        std::vector<float> twiddleImag(half);
+        for (size_t k = 0; k < half; k++) {
+            double angle = -M_PI * k / half;
+            twiddleReal[k] = static_cast<float>(std::cos(angle));
+            twiddleImag[k] = static_cast<float>(std::sin(angle));
+        }
+        table.fftStage(real.data(), imag.data(), size, half, twiddleReal.data(), twiddleImag.data(),
+                       inverse ? -1.0f : 1.0f);
+    }
+}
+
+void testFftStage(const DspKernelTable& table, const DspKernelTable& scalar) {
+    std::mt19937 rng(13);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    for (size_t size = 2; size <= 4096; size <<= 1) {
+        for (int inverse = 0; inverse <= 1; inverse++) {
+            std::vector<float> expectedReal(size);
+            std::vector<float> expectedImag(size);
+            for (size_t i = 0; i < size; i++) {
+                expectedReal[i] = dist(rng);
+                expectedImag[i] = dist(rng);
+            }
+            std::vector<float> actualReal = expectedReal;
+            std::vector<float> actualImag = expectedImag;
+            runFft(scalar, expectedReal, expectedImag, inverse != 0);
+            runFft(table, actualReal, actualImag, inverse != 0);
+
+            // 출력 크기는 sqrt(N) 정도, 단계마다 반올림 차이가 쌓임
+            float scale = std::sqrt(static_cast<float>(size)) * std::log2(static_cast<float>(size));
+            for (size_t i = 0; i < size; i++) {
+                if (!closeTo(actualReal[i], expectedReal[i], scale) || !closeTo(actualImag[i], expectedImag[i], scale)) {
+                    fail(table, inverse ? "fftStage (inverse)" : "fftStage", size, 0, "mismatch");
+                    break;
+                }
+            }
+        }
+    }
+}
+
+void testResampleCubic(const DspKernelTable& table, const DspKernelTable& scalar) {
+    std::mt19937 rng(17);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    const double kRatios[] = {0.5, 0.9997, 1.0, 1.0003, 1.088435, 2.0, 8.0};
+    const int kChannelCounts[] = {1, 2, 3};
+
+    for (double ratio : kRatios) {
+        for (int channels : kChannelCounts) {
+            for (size_t length : kLengths) {
+                double phase = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+                int32_t outputFrames = static_cast<int32_t>(length);
+                // 보간이 읽는 범위: 위치 1 + phase + (n - 1) * ratio의 앞 1 프레임 ~ 뒤 2 프레임
+                size_t inputFrames = static_cast<size_t>(phase + outputFrames * ratio) + 4;
+                std::vector<float> buffer(inputFrames * channels);
+                for (float& x : buffer) {
+                    x = dist(rng);
+                }
+                std::vector<float> expected(length * channels + 1, -2.0f);
+                std::vector<float> actual(expected.size(), -2.0f);
+                scalar.resampleCubic(buffer.data(), channels, expected.data(), outputFrames, phase, ratio);
+                table.resampleCubic(buffer.data(), channels, actual.data(), outputFrames, phase, ratio);
+                for (size_t i = 0; i < expected.size(); i++) {
+                    if (!closeTo(actual[i], expected[i], 4.0f)) {
+                        char detail[64];
+                        snprintf(detail, sizeof(detail), "ratio %.6g, %d channels", ratio, channels);
+                        fail(table, "resampleCubic", length, 0, detail);
+                        break;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void testBinEnergies(const DspKernelTable& table, const DspKernelTable& scalar) {
+    std::mt19937 rng(19);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    const size_t kBinCounts[] = {1, 3, 20};
+
+    for (size_t bins : kBinCounts) {
+        for (size_t length : kLengths) {
+            std::vector<float> data(bins * length);
+            for (float& x : data) {
+                x = dist(rng);
+            }
+            std::vector<float> expected(bins + 1, -2.0f);
+            std::vector<float> actual(bins + 1, -2.0f);
+            scalar.binEnergies(data.data(), length, bins, expected.data());
+            table.binEnergies(data.data(), length, bins, actual.data());
+            for (size_t b = 0; b <= bins; b++) {
+                double magnitude = 0.0;
+                for (size_t i = 0; b < bins && i < length; i++) {
+                    magnitude += static_cast<double>(data[b * length + i]) * data[b * length + i];
+                }
+                if (!withinTolerance(actual[b], expected[b], magnitude, length)) {
+                    fail(table, "binEnergies", length, 0, b == bins ? "wrote past the last bin" : "mismatch");
+                    break;
+                }
+            }
+        }
+    }
+}
+
+} // namespace
+
+int main() {
+    const DspKernelTable& scalar = DspKernels::scalar();
+    std::vector<const DspKernelTable*> tables = DspKernels::available();
+
+    for (const DspKernelTable* table : tables) {
+        int before = gFailures;
+        testInt16ToFloat(*table, scalar);
+        testFloatToInt16(*table, scalar);
+        testHalfToFloat(*table, scalar);
+        testAccumulators(*table, scalar);
+        testGain(*table, scalar);
+        testBiquadCascade(*table, scalar);
+        testFftStage(*table, scalar);
+        testResampleCubic(*table, scalar);
+        testBinEnergies(*table, scalar);
+        printf("%s %s\n", gFailures == before ? "PASS" : "FAIL", table->name);
+    }
+
+    if (tables.size() < 2) {
+        printf("note: no SIMD kernels available on this CPU, only scalar was checked\n");
+    }
+    return gFailures == 0 ? 0 : 1;
+}
@@ -0,0 +1,336 @@
+#include "LibraryFixture.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace fixture {
+
+namespace {
+
+constexpr uint32_t kSampleRate = 44100;
+constexpr uint64_t kFlacTotalSamples = 44100ULL * 240;  // 4분
+constexpr int kMp3Frames = 8;
+constexpr uint32_t kMp3FrameSize = 417;                 // MPEG1 Layer III 128kbps 44.1kHz
+
+const char* const kGenres[] = {"Rock", "Jazz", "Classical", "Electronic", "Pop", "Hip-Hop", "Folk", "Ambient"};
+
+void appendBe(std::vector<uint8_t>& out, uint64_t value, int bytes) {
+    for (int i = bytes - 1; i >= 0; i--) {
+        out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+void appendLe32(std::vector<uint8_t>& out, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+void appendString(std::vector<uint8_t>& out, const std::string& value) {
+    out.insert(out.end(), value.begin(), value.end());
+}
+
+struct TrackTags {
+    std::string title;
+    std::string artist;
+    std::string album;
+    std::string genre;
+    int year;
+    int trackNumber;
+};
+
+std::vector<uint8_t> makeFlac(const TrackTags& tags) {
+    std::vector<uint8_t> out;
+    appendString(out, "fLaC");
+
+    // STREAMINFO: 블록 크기, 프레임 크기, 20비트 샘플레이트 | 3비트 채널-1 | 5비트 비트 깊이-1 | 36비트 총 샘플 수, MD5
+    out.push_back(0x00);
+    appendBe(out, 34, 3);
+    appendBe(out, 4096, 2);
+    appendBe(out, 4096, 2);
+    appendBe(out, 0, 3);
+    appendBe(out, 0, 3);
+    uint64_t packed = (static_cast<uint64_t>(kSampleRate) << 44) | (1ULL << 41) | (15ULL << 36) | kFlacTotalSamples;
+    appendBe(out, packed, 8);
+    out.insert(out.end(), 16, 0);
+
+    std::vector<std::string> comments = {
+        "TITLE=" + tags.title,
+        "ARTIST=" + tags.artist,
+        "ALBUM=" + tags.album,
+        "GENRE=" + tags.genre,
+        "DATE=" + std::to_string(tags.year),
+        "TRACKNUMBER=" + std::to_string(tags.trackNumber),
+    };
+    std::vector<uint8_t> block;
+    const std::string vendor = "pancake fixture";
+    appendLe32(block, static_cast<uint32_t>(vendor.size()));
+    appendString(block, vendor);
+    appendLe32(block, static_cast<uint32_t>(comments.size()));
+    for (const std::string& comment : comments) {
+        appendLe32(block, static_cast<uint32_t>(comment.size()));
+        appendString(block, comment);
+    }
+    out.push_back(0x80 | 4);  // 마지막 메타데이터 블록, VORBIS_COMMENT
+    appendBe(out, block.size(), 3);
+    out.insert(out.end(), block.begin(), block.end());
+
+    // 오디오 프레임 자리 (파서는 읽지 않음)
+    out.insert(out.end(), 512, 0);
+    return out;
+}
+
+std::vector<uint8_t> makeId3Frame(const char* id, const std::string& text) {
+    std::vector<uint8_t> frame;
+    appendString(frame, id);
+    appendBe(frame, text.size() + 1, 4);
+    appendBe(frame, 0, 2);
+    frame.push_back(0x00);  // ISO-8859-1
+    appendString(frame, text);
+    return frame;
+}
+
+std::vector<uint8_t> makeMp3(const TrackTags& tags) {
+    std::vector<uint8_t> frames;
+    for (const auto& frame : {makeId3Frame("TIT2", tags.title), makeId3Frame("TPE1", tags.artist),
+                              makeId3Frame("TALB", tags.album), makeId3Frame("TCON", tags.genre),
+                              makeId3Frame("TYER", std::to_string(tags.year)),
+                              makeId3Frame("TRCK", std::to_string(tags.trackNumber))}) {
+        frames.insert(frames.end(), frame.begin(), frame.end());
+    }
+
+    std::vector<uint8_t> out;
+    appendString(out, "ID3");
+    out.push_back(3);
+    out.push_back(0);
+    out.push_back(0);
+    uint32_t size = static_cast<uint32_t>(frames.size());
+    for (int shift = 21; shift >= 0; shift -= 7) {
+        out.push_back(static_cast<uint8_t>((size >> shift) & 0x7F));  // syncsafe
+    }
+    out.insert(out.end(), frames.begin(), frames.end());
+
+    for (int i = 0; i < kMp3Frames; i++) {
+        size_t start = out.size();
+        out.push_back(0xFF);
+        out.push_back(0xFB);
+        out.push_back(0x90);
+        out.push_back(0x00);
+        out.resize(start + kMp3FrameSize, 0);
+    }
+    return out;
+}
+
+void appendInfoChunk(std::vector<uint8_t>& out, const char* id, const std::string& value) {
+    appendString(out, id);
+    appendLe32(out, static_cast<uint32_t>(value.size() + 1));
+    appendString(out, value);
+    out.push_back(0);
+    if ((value.size() + 1) & 1) {
+        out.push_back(0);
+    }
+}
+
+// dataBytes: data 청크에 기록할 크기 (파일을 희소 파일로 늘릴 때 그 끝까지)
+std::vector<uint8_t> makeWav(const TrackTags& tags, uint32_t dataBytes) {
+    std::vector<uint8_t> info;
+    appendString(info, "INFO");
+    appendInfoChunk(info, "INAM", tags.title);
+    appendInfoChunk(info, "IART", tags.artist);
+    appendInfoChunk(info, "IPRD", tags.album);
+    appendInfoChunk(info, "IGNR", tags.genre);
+    appendInfoChunk(info, "ICRD", std::to_string(tags.year));
+    appendInfoChunk(info, "ITRK", std::to_string(tags.trackNumber));
+
+    std::vector<uint8_t> out;
+    appendString(out, "RIFF");
+    appendLe32(out, 0);  // 아래에서 채움
+    appendString(out, "WAVE");
+
+    appendString(out, "fmt ");
+    appendLe32(out, 16);
+    out.push_back(1);  // PCM
+    out.push_back(0);
+    out.push_back(2);
+    out.push_back(0);
+    appendLe32(out, kSampleRate);
+    appendLe32(out, kSampleRate * 4);
+    out.push_back(4);
+    out.push_back(0);
+    out.push_back(16);
+    out.push_back(0);
+
+    appendString(out, "LIST");
+    appendLe32(out, static_cast<uint32_t>(info.size()));
+    out.insert(out.end(), info.begin(), info.end());
+
+    appendString(out, "data");
+    appendLe32(out, dataBytes);
+    uint32_t riffSize = static_cast<uint32_t>(out.size() - 8 + dataBytes);
+    for (int i = 0; i < 4; i++) {
+        out[4 + i] = static_cast<uint8_t>(riffSize >> (8 * i));
+    }
+    return out;
+}
+
+TrackTags tagsFor(int artist, int album, int track) {
+    char buffer[64];
+    TrackTags tags;
+    snprintf(buffer, sizeof(buffer), "Track %02d of Album %02d", track + 1, album + 1);
+    tags.title = buffer;
+    snprintf(buffer, sizeof(buffer), "Artist %04d", artist);
+    tags.artist = buffer;
+    snprintf(buffer, sizeof(buffer), "Album %02d by Artist %04d", album + 1, artist);
+    tags.album = buffer;
+    tags.genre = kGenres[(artist + album) % (sizeof(kGenres) / sizeof(kGenres[0]))];
+    tags.year = 1960 + (artist * 7 + album) % 65;
+    tags.trackNumber = track + 1;
+    return tags;
+}
+
+enum class Format { Flac, Mp3, Wav };
+
+// 앨범 단위로 형식을 돌려 가며 씀 (FLAC이 가장 많은 라이브러리를 흉내)
+Format formatFor(int artist, int album) {
+    switch ((artist + album) % 5) {
+        case 0:
+        case 1:
+        case 2: return Format::Flac;
+        case 3: return Format::Mp3;
+        default: return Format::Wav;
+    }
+}
+
+const char* extensionFor(Format format) {
+    switch (format) {
+        case Format::Mp3: return "mp3";
+        case Format::Wav: return "wav";
+        case Format::Flac:
+        default: return "flac";
+    }
+}
+
+std::string albumDirectory(const std::string& root, int artist, int album) {
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "/Artist %04d/Album %02d", artist, album + 1);
+    return root + buffer;
+}
+
+// fileBytes가 데이터보다 크면 나머지는 구멍으로 남겨 디스크를 쓰지 않고 파일 크기만 늘림
+bool writeFile(const std::string& path, const std::vector<uint8_t>& data, long long fileBytes = 0) {
+    int fd = open(path.c_str(), O_CREAT | O_WRONLY | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    bool ok = write(fd, data.data(), data.size()) == static_cast<ssize_t>(data.size());
+    if (ok && fileBytes > static_cast<long long>(data.size())) {
+        ok = ftruncate(fd, static_cast<off_t>(fileBytes)) == 0;
+    }
+    close(fd);
+    return ok;
+}
+
+bool writeTrack(const std::string& root, int artist, int album, int track, const TrackTags& tags,
+                long long fileBytes) {
+    std::vector<uint8_t> data;
+    switch (formatFor(artist, album)) {
+        case Format::Flac:
+            data = makeFlac(tags);
+            break;
+        case Format::Mp3:
+            data = makeMp3(tags);
+            break;
+        case Format::Wav: {
+            // 헤더 뒤 전체를 data 청크로 (재생 시간이 파일 크기에서 나옴)
+            long long headerBytes = static_cast<long long>(makeWav(tags, 0).size());
+            long long total = std::max(fileBytes, headerBytes + 4096);
+            data = makeWav(tags, static_cast<uint32_t>(total - headerBytes));
+            fileBytes = total;
+            break;
+        }
+    }
+    return writeFile(trackPath(root, artist, album, track), data, fileBytes);
+}
+
+} // namespace
+
+std::string trackPath(const std::string& root, int artist, int album, int track) {
+    char buffer[48];
+    snprintf(buffer, sizeof(buffer), "/%02d Track %02d.%s", track + 1, track + 1,
+             extensionFor(formatFor(artist, album)));
+    return albumDirectory(root, artist, album) + buffer;
+}
+
+int createLibrary(const std::string& root, const LibraryLayout& layout) {
+    if (mkdir(root.c_str(), 0755) != 0) {
+        return -1;
+    }
+    const std::vector<uint8_t> cover(2048, 0xD8);
+    int created = 0;
+    for (int artist = 0; artist < layout.artists; artist++) {
+        char buffer[32];
+        snprintf(buffer, sizeof(buffer), "/Artist %04d", artist);
+        if (mkdir((root + buffer).c_str(), 0755) != 0) {
+            return -1;
+        }
+        for (int album = 0; album < layout.albumsPerArtist; album++) {
+            std::string directory = albumDirectory(root, artist, album);
+            if (mkdir(directory.c_str(), 0755) != 0 || !writeFile(directory + "/cover.jpg", cover)) {
+                return -1;
+            }
+            for (int track = 0; track < layout.tracksPerAlbum; track++) {
+                if (!writeTrack(root, artist, album, track, tagsFor(artist, album, track), layout.fileBytes)) {
+                    return -1;
+                }
+                created++;
+            }
+        }
+    }
+    return created;
+}
+
+bool rewriteTrack(const std::string& root, int artist, int album, int track, const std::string& title) {
+    struct stat fileStat;
+    if (stat(trackPath(root, artist, album, track).c_str(), &fileStat) != 0) {
+        return false;
+    }
+    TrackTags tags = tagsFor(artist, album, track);
+    tags.title = title;
+    return writeTrack(root, artist, album, track, tags, static_cast<long long>(fileStat.st_size));
+}
+
+void removeTree(const std::string& root) {
+    DIR* directory = opendir(root.c_str());
+    if (directory == nullptr) {
+        unlink(root.c_str());
+        return;
+    }
+    while (dirent* entry = readdir(directory)) {
+        std::string name = entry->d_name;
+        if (name == "." || name == "..") {
+            continue;
+        }
+        std::string path = root + "/" + name;
+        if (entry->d_type == DT_DIR) {
+            removeTree(path);
+        } else {
+            unlink(path.c_str());
+        }
+    }
+    closedir(directory);
+    rmdir(root.c_str());
+}
+
+std::string defaultRoot(const char* name) {
+    struct stat shm;
+    std::string base = stat("/dev/shm", &shm) == 0 && S_ISDIR(shm.st_mode) ? "/dev/shm" : "/tmp";
+    return base + "/" + name;
+}
+
+} // namespace fixture
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <string>
+
+/**
+ * 스캐너 벤치마크용 가짜 음악 라이브러리
+ *
+ * root/Artist NNNN/Album NN/NN Track NN.(flac|mp3|wav) 트리를 만들며, 파일마다 TagParser가 읽는
+ * 실제 헤더(FLAC STREAMINFO + VORBIS_COMMENT, ID3v2.3 + MPEG1 Layer III 프레임, RIFF fmt + LIST INFO)를 넣고
+ * 오디오 데이터는 몇 프레임만 둠 (앨범 폴더마다 오디오가 아닌 cover.jpg 하나 포함)
+ * fileBytes를 주면 파일을 그 크기까지 희소 파일로 늘려 실제 음원처럼 헤더와 끝부분이 멀리 떨어지게 함
+ * tmpfs(/dev/shm)에 만들면 저장 장치가 아니라 스캐너 자체의 비용을 잴 수 있음
+ */
+namespace fixture {
+
+struct LibraryLayout {
+    int artists = 1000;
+    int albumsPerArtist = 10;
+    int tracksPerAlbum = 10;
+    long long fileBytes = 0;  // 0이면 헤더와 몇 프레임만
+
+    int trackCount() const { return artists * albumsPerArtist * tracksPerAlbum; }
+};
+
+// 반환: 만든 오디오 파일 수 (실패하면 -1)
+int createLibrary(const std::string& root, const LibraryLayout& layout);
+
+// 트랙 파일 경로 (확장자 포함)
+std::string trackPath(const std::string& root, int artist, int album, int track);
+
+// 트랙 파일을 다른 제목 태그로 다시 써서 지문(크기, 수정 시간)을 바꿈
+bool rewriteTrack(const std::string& root, int artist, int album, int track, const std::string& title);
+
+// root 아래 전체 삭제
+void removeTree(const std::string& root);
+
+// 벤치마크 기본 위치 (/dev/shm이 있으면 그 아래, 없으면 /tmp 아래)
+std::string defaultRoot(const char* name);
+
+} // namespace fixture
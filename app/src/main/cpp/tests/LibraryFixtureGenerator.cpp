@@ -0,0 +1,34 @@
+#include "LibraryFixture.h"
+#include <cstdio>
+#include <cstdlib>
+
+/**
+ * 스캐너 벤치마크용 라이브러리를 원하는 위치에 만드는 도구
+ * 기기 저장소(예: adb shell로 /sdcard/Music 아래)에 만들어 실제 저장 장치의 콜드 캐시 스캔을 잴 때 사용
+ *
+ * 사용법: LibraryFixtureGenerator <경로> [아티스트 수] [아티스트당 앨범 수] [앨범당 트랙 수] [파일 크기 MB]
+ */
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <root> [artists] [albums per artist] [tracks per album] [file MB]\n", argv[0]);
+        return 2;
+    }
+
+    fixture::LibraryLayout layout;
+    if (argc > 2) layout.artists = atoi(argv[2]);
+    if (argc > 3) layout.albumsPerArtist = atoi(argv[3]);
+    if (argc > 4) layout.tracksPerAlbum = atoi(argv[4]);
+    if (argc > 5) layout.fileBytes = atoll(argv[5]) * 1024 * 1024;
+    if (layout.artists <= 0 || layout.albumsPerArtist <= 0 || layout.tracksPerAlbum <= 0) {
+        fprintf(stderr, "counts must be positive\n");
+        return 2;
+    }
+
+    int created = fixture::createLibrary(argv[1], layout);
+    if (created < 0) {
+        fprintf(stderr, "failed to create %s (it must not exist yet)\n", argv[1]);
+        return 1;
+    }
+    printf("created %d tracks under %s\n", created, argv[1]);
+    return 0;
+}
@@ -0,0 +1,144 @@
+#include "include/OutputFanout.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+/**
+ * 클럭이 서로 다른 null 싱크 두 개로 팬아웃 클럭 보정을 확인
+ *
+ * NullFanoutSink와 같은 방식(480프레임 블록, 누적 기준 시각)으로 각 싱크의 클럭을 시뮬레이션하되
+ * 실제 sleep 대신 가상 시간 순서대로 push/pull을 호출하므로 결과가 결정적이고 빠름
+ * (실시간 스레드로 돌리면 호스트 스케줄링 지연이 목표 버퍼 양을 넘을 때 언더런이 나서 판정이 흔들림)
+ * 생산자와 소비자의 깨어나는 시각에는 고정 시드의 지터를 더함
+ *
+ * 안정화 이후 구간에서 버퍼 양 오차가 작게 유지되고, 언더런/오버플로/재동기화가 없으며,
+ * correctionPpm이 싱크 클럭 오차를 상쇄하는 값으로 수렴해야 함
+ */
+
+namespace {
+
+constexpr int32_t kInputRate = 48000;
+constexpr int32_t kPushFrames = 480;             // 주 출력 10ms 블록
+constexpr int32_t kPullFrames = 480;             // NullFanoutSink 블록 크기
+constexpr double kSettleSeconds = 60.0;          // 임계 감쇠 PI (ω ≈ 0.1/s)가 수렴할 때까지
+constexpr double kMeasureSeconds = 60.0;
+constexpr double kMaxJitterSeconds = 0.002;
+constexpr double kMaxFillErrorMs = 2.0;
+constexpr double kMaxPpmError = 20.0;
+
+struct SinkConfig {
+    int32_t sampleRate;
+    double clockPpm;
+};
+
+const SinkConfig kSinks[] = {
+    {48000, 300.0},     // 같은 레이트, 장치 클럭이 빠름
+    {44100, -450.0},    // 레이트 변환 + 장치 클럭이 느림
+};
+
+struct SimulatedSink {
+    SinkConfig config;
+    std::unique_ptr<FanoutOutput> output;
+    std::vector<float> buffer;
+    double framesPerSecond;
+    int64_t blocks = 0;
+    double nextWake = 0.0;
+
+    // 측정 구간 지표
+    double maxFillErrorMs = 0.0;
+    double ppmSum = 0.0;
+    int samples = 0;
+};
+
+int64_t toNanos(double seconds) {
+    return static_cast<int64_t>(std::llround(seconds * 1e9));
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(40);
+    std::uniform_real_distribution<double> jitter(0.0, kMaxJitterSeconds);
+
+    std::vector<SimulatedSink> sinks;
+    for (const SinkConfig& config : kSinks) {
+        SimulatedSink sink;
+        sink.config = config;
+        sink.output.reset(new FanoutOutput(config.sampleRate, kInputRate));
+        sink.buffer.resize(static_cast<size_t>(kPullFrames) * 2);
+        sink.framesPerSecond = config.sampleRate * (1.0 + config.clockPpm * 1e-6);
+        sinks.push_back(std::move(sink));
+    }
+
+    const double endTime = kSettleSeconds + kMeasureSeconds;
+    std::vector<float> block(static_cast<size_t>(kPushFrames) * 2);
+    int64_t pushes = 0;
+    double nextPush = 0.0;
+    double phase = 0.0;
+
+    while (true) {
+        auto next = std::min_element(sinks.begin(), sinks.end(), [](const SimulatedSink& a, const SimulatedSink& b) {
+            return a.nextWake < b.nextWake;
+        });
+        double now = std::min(nextPush, next->nextWake);
+        if (now >= endTime) {
+            break;
+        }
+
+        if (nextPush <= next->nextWake) {
+            for (int32_t i = 0; i < kPushFrames; i++) {
+                float sample = 0.25f * static_cast<float>(std::sin(phase));
+                block[2 * i] = sample;
+                block[2 * i + 1] = sample;
+                phase += 2.0 * M_PI * 440.0 / kInputRate;
+            }
+            for (SimulatedSink& sink : sinks) {
+                sink.output->push(block.data(), kPushFrames, kInputRate, toNanos(now));
+            }
+            pushes++;
+            nextPush = static_cast<double>(pushes) * kPushFrames / kInputRate + jitter(rng);
+            continue;
+        }
+
+        SimulatedSink& sink = *next;
+        sink.output->pull(sink.buffer.data(), kPullFrames, toNanos(now));
+        sink.blocks++;
+        sink.nextWake = sink.blocks * kPullFrames / sink.framesPerSecond + jitter(rng);
+
+        if (now >= kSettleSeconds) {
+            FanoutOutputStats stats{};
+            sink.output->fillStats(stats);
+            sink.maxFillErrorMs = std::max(sink.maxFillErrorMs, std::fabs(static_cast<double>(stats.fillMs - stats.targetMs)));
+            sink.ppmSum += stats.correctionPpm;
+            sink.samples++;
+        }
+    }
+
+    int failures = 0;
+    for (const SimulatedSink& sink : sinks) {
+        FanoutOutputStats stats{};
+        sink.output->fillStats(stats);
+        double meanPpm = sink.samples > 0 ? sink.ppmSum / sink.samples : 0.0;
+        // 장치가 (1 + p)배 빠르게 소비하면 입력 소비 비율을 1 / (1 + p)로 맞춰야 함
+        double expectedPpm = (1.0 / (1.0 + sink.config.clockPpm * 1e-6) - 1.0) * 1e6;
+
+        bool ok = sink.samples > 0
+            && sink.maxFillErrorMs <= kMaxFillErrorMs
+            && stats.underruns == 0
+            && stats.overflows == 0
+            && stats.resyncs == 0
+            && std::fabs(meanPpm - expectedPpm) <= kMaxPpmError;
+        printf("%s %d Hz %+.0f ppm: fill error max %.2f ms, correction %.1f ppm (expected %.1f), "
+               "underruns %lld, overflows %lld, resyncs %lld\n",
+               ok ? "PASS" : "FAIL", sink.config.sampleRate, sink.config.clockPpm, sink.maxFillErrorMs,
+               meanPpm, expectedPpm, static_cast<long long>(stats.underruns),
+               static_cast<long long>(stats.overflows), static_cast<long long>(stats.resyncs));
+        if (!ok) {
+            failures++;
+        }
+    }
+    return failures == 0 ? 0 : 1;
+}
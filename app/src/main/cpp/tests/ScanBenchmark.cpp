@@ -0,0 +1,78 @@
+#include "include/AudioScanner.h"
+#include "LibraryFixture.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+/**
+ * 작업자 수별 전체 디렉토리 스캔 시간
+ *
+ * tmpfs에 트랙 10만 개(아티스트 1000 x 앨범 10 x 트랙 10, FLAC/MP3 반반)의 라이브러리를 만들고
+ * 빈 라이브러리에서 AudioScanner::scanDirectory()를 1/2/4/8 작업자로 실행
+ * 저장 장치 지연이 없으므로 디렉토리 탐색, stat, 헤더 파싱, 병합의 CPU 비용과 작업 분배 효율이 드러남
+ *
+ * 사용법: ScanBenchmark [라이브러리 경로] [아티스트 수]
+ * 경로를 주지 않으면 /dev/shm 아래에 만들고 끝나면 지움
+ */
+
+using namespace pancakemusicbox;
+
+namespace {
+
+constexpr int kThreadCounts[] = {1, 2, 4, 8};
+constexpr int kRepeats = 3;
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string root = argc > 1 ? argv[1] : fixture::defaultRoot("pancake-scan-benchmark");
+    fixture::LibraryLayout layout;
+    if (argc > 2) {
+        layout.artists = std::max(1, atoi(argv[2]));
+    }
+
+    fixture::removeTree(root);
+    auto createStart = std::chrono::steady_clock::now();
+    int created = fixture::createLibrary(root, layout);
+    if (created != layout.trackCount()) {
+        fprintf(stderr, "failed to create the library under %s\n", root.c_str());
+        fixture::removeTree(root);
+        return 1;
+    }
+    printf("created %d tracks under %s in %.1f s\n", created, root.c_str(),
+           std::chrono::duration<double>(std::chrono::steady_clock::now() - createStart).count());
+
+    AudioScanner& scanner = AudioScanner::getInstance();
+    printf("default thread count: %d\n", scanner.getScanThreadCount());
+    printf("%8s %10s %12s %9s %8s\n", "threads", "best s", "tracks/s", "speedup", "tracks");
+
+    int exitCode = 0;
+    double singleThread = 0.0;
+    for (int threads : kThreadCounts) {
+        scanner.setScanThreadCount(threads);
+        double best = 1e9;
+        size_t tracks = 0;
+        for (int r = 0; r < kRepeats; r++) {
+            // 매번 빈 라이브러리에서 시작 (지문이 같은 파일을 건너뛰지 않도록)
+            scanner.removePath(root);
+            auto start = std::chrono::steady_clock::now();
+            scanner.scanDirectory(root);
+            best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+            tracks = scanner.getAllTracks().size();
+        }
+        if (threads == 1) {
+            singleThread = best;
+        }
+        printf("%8d %10.3f %12.0f %8.2fx %8zu\n", threads, best, created / best, singleThread / best, tracks);
+        if (tracks != static_cast<size_t>(created)) {
+            exitCode = 1;
+        }
+    }
+
+    scanner.removePath(root);
+    if (argc <= 1) {
+        fixture::removeTree(root);
+    }
+    return exitCode;
+}
@@ -0,0 +1,125 @@
+#include "include/StringArena.h"
+#include "include/TrackStore.h"
+#include "SyntheticTracks.h"
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * 트랙 10만 개의 문자열 필드 메모리: 트랙마다 std::string 9개 vs 아레나 + 인턴 풀
+ *
+ * 이전: ID, 제목, 경로, 아티스트, 앨범, 아트 경로, 장르, 작곡가, 포맷을 트랙마다 std::string으로 보관
+ * 이후: 트랙마다 다른 ID/제목/경로는 StringArena에, 나머지는 StringPool에 한 번만 넣고 트랙은 string_view/ID만 보관
+ * 힙 사용량(malloc 통계)의 감소 배율과 해제 시간을 출력하고, 참고로 TrackStore 전체의 clear() 시간도 출력
+ * (TrackStore::clear()는 순위 색인과 패싯 목록을 노드마다 해제하므로 문자열 해제만큼 싸지 않음)
+ */
+
+using namespace pancakemusicbox;
+
+namespace {
+
+constexpr int kTrackCount = 100000;
+
+// 이전 구조에서 트랙 하나가 들고 있던 문자열
+struct OwnedStrings {
+    std::string id;
+    std::string title;
+    std::string filePath;
+    std::string artist;
+    std::string albumTitle;
+    std::string albumArtPath;
+    std::string genre;
+    std::string composer;
+    std::string format;
+};
+
+// 아레나/풀 구조에서 트랙 하나가 들고 있는 값
+struct InternedStrings {
+    std::string_view id;
+    std::string_view title;
+    std::string_view filePath;
+    uint32_t artist;
+    uint32_t albumTitle;
+    uint32_t albumArtPath;
+    uint32_t genre;
+    uint32_t composer;
+    uint32_t format;
+};
+
+double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main() {
+    std::vector<TrackMetadata> source = synthetic::makeTracks(kTrackCount);
+
+    // 각 구조를 따로 만들고 해제 (앞 구조가 해제한 조각의 병합 비용이 뒤 구조의 해제 시간에 섞이지 않도록)
+    size_t heapBefore = synthetic::heapBytesInUse();
+    auto* owned = new std::vector<OwnedStrings>();
+    owned->reserve(source.size());
+    for (const TrackMetadata& track : source) {
+        owned->push_back({track.id, track.title, track.filePath, track.artist, track.albumTitle, track.albumArtPath,
+                          track.genre, track.composer, track.audioQuality.format});
+    }
+    size_t ownedBytes = synthetic::heapBytesInUse() - heapBefore;
+    auto start = std::chrono::steady_clock::now();
+    delete owned;
+    double ownedFreeMs = elapsedMs(start);
+
+    heapBefore = synthetic::heapBytesInUse();
+    auto* arena = new StringArena();
+    auto* pool = new StringPool();
+    auto* interned = new std::vector<InternedStrings>();
+    interned->reserve(source.size());
+    for (const TrackMetadata& track : source) {
+        interned->push_back({arena->store(track.id), arena->store(track.title), arena->store(track.filePath),
+                             pool->intern(track.artist), pool->intern(track.albumTitle),
+                             pool->intern(track.albumArtPath), pool->intern(track.genre), pool->intern(track.composer),
+                             pool->intern(track.audioQuality.format)});
+    }
+    size_t internedBytes = synthetic::heapBytesInUse() - heapBefore;
+
+    // 원본과 같은 값을 돌려주는지 확인
+    int mismatches = 0;
+    for (size_t i = 0; i < source.size(); i++) {
+        const TrackMetadata& a = source[i];
+        const InternedStrings& b = (*interned)[i];
+        if (a.id != b.id || a.title != b.title || a.filePath != b.filePath || a.artist != pool->get(b.artist) ||
+            a.albumTitle != pool->get(b.albumTitle) || a.albumArtPath != pool->get(b.albumArtPath) ||
+            a.genre != pool->get(b.genre) || a.composer != pool->get(b.composer) ||
+            a.audioQuality.format != pool->get(b.format)) {
+            mismatches++;
+        }
+    }
+
+    printf("%d tracks, %zu pooled strings, arena %.1f MB used / %.1f MB allocated\n", kTrackCount, pool->size(),
+           arena->getUsedBytes() / 1048576.0, arena->getAllocatedBytes() / 1048576.0);
+
+    start = std::chrono::steady_clock::now();
+    delete interned;
+    delete pool;
+    delete arena;
+    double internedFreeMs = elapsedMs(start);
+
+    printf("string heap: std::string per field %.1f MB, arena + pool %.1f MB (%.2fx smaller)\n",
+           ownedBytes / 1048576.0, internedBytes / 1048576.0, static_cast<double>(ownedBytes) / internedBytes);
+    printf("free: std::string per field %.2f ms, arena + pool %.2f ms\n", ownedFreeMs, internedFreeMs);
+
+    // 참고: 색인까지 포함한 TrackStore 전체
+    TrackStore store;
+    for (const TrackMetadata& track : source) {
+        store.insert(track);
+    }
+    start = std::chrono::steady_clock::now();
+    store.clear();
+    printf("TrackStore::clear() with facet and rank indexes: %.2f ms\n", elapsedMs(start));
+
+    if (mismatches > 0) {
+        printf("FAIL %d tracks read back differently\n", mismatches);
+        return 1;
+    }
+    return 0;
+}
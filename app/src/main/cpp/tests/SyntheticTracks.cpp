@@ -0,0 +1,96 @@
+#include "SyntheticTracks.h"
+#include <random>
+#include <string>
+#include <malloc.h>
+
+namespace synthetic {
+
+namespace {
+
+constexpr int kTracksPerAlbum = 12;
+constexpr int kAlbumsPerArtist = 10;
+constexpr int64_t kBaseTimeMs = 1700000000000LL;
+
+const char* const kGenres[] = {"Rock", "Pop", "Jazz", "Classical", "Electronic", "Hip-Hop", "Unknown", "Metal",
+                               "Folk", "Soundtrack"};
+
+struct FormatInfo {
+    const char* name;
+    const char* extension;
+    int bitDepth;
+    int sampleRate;
+};
+
+const FormatInfo kFormats[] = {
+    {"FLAC", "flac", 16, 44100},
+    {"FLAC", "flac", 24, 96000},
+    {"MP3", "mp3", 16, 44100},
+    {"AAC", "m4a", 16, 48000},
+    {"WAV", "wav", 24, 48000},
+    {"DSD", "dsf", 1, 2822400},
+};
+
+std::string makeUuid(std::mt19937& rng) {
+    static const char kHex[] = "0123456789abcdef";
+    std::string id;
+    id.reserve(36);
+    for (int i = 0; i < 32; i++) {
+        id += kHex[rng() % 16];
+        if (i == 7 || i == 11 || i == 15 || i == 19) {
+            id += '-';
+        }
+    }
+    return id;
+}
+
+} // namespace
+
+std::vector<pancakemusicbox::TrackMetadata> makeTracks(int count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<pancakemusicbox::TrackMetadata> tracks(count);
+    for (int i = 0; i < count; i++) {
+        pancakemusicbox::TrackMetadata& track = tracks[i];
+        int album = i / kTracksPerAlbum;
+        int artist = album / kAlbumsPerArtist;
+        int number = i % kTracksPerAlbum + 1;
+        const FormatInfo& format = kFormats[album % (sizeof(kFormats) / sizeof(kFormats[0]))];
+
+        track.id = makeUuid(rng);
+        track.artist = "Artist Name " + std::to_string(artist);
+        track.albumTitle = "Album Title " + std::to_string(album);
+        track.title = "Track Title " + std::to_string(i);
+        track.filePath = "/storage/emulated/0/Music/" + track.artist + "/" + track.albumTitle + "/" +
+                         std::to_string(number) + " " + track.title + "." + format.extension;
+        track.albumArtPath = "/data/user/0/com.example.pancakemusicbox/files/artwork/" +
+                             std::to_string(1000000 + album) + ".jpg";
+        track.genre = kGenres[album % (sizeof(kGenres) / sizeof(kGenres[0]))];
+        track.composer = "Composer " + std::to_string(artist % 50);
+        track.audioQuality.format = format.name;
+        track.audioQuality.bitDepth = format.bitDepth;
+        track.audioQuality.sampleRate = format.sampleRate;
+        track.audioQuality.channels = 2;
+        track.duration = 150000 + static_cast<long>(rng() % 240000);
+        track.year = 1960 + album % 65;
+        track.trackNumber = number;
+        if (rng() % 4 == 0) {
+            track.playCount = 1 + static_cast<int>(rng() % 200);
+            track.lastPlayed = kBaseTimeMs + static_cast<int64_t>(rng() % 100000000);
+        }
+        track.dateAdded = kBaseTimeMs - static_cast<int64_t>(count - i) * 60000;
+        track.fingerprint.size = 20000000 + static_cast<long long>(rng() % 30000000);
+        track.fingerprint.modifiedTimeNs = track.dateAdded * 1000000;
+        track.fingerprint.inode = static_cast<unsigned long long>(100000 + i);
+    }
+    return tracks;
+}
+
+size_t heapBytesInUse() {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    struct mallinfo2 info = mallinfo2();
+#else
+    struct mallinfo info = mallinfo();
+#endif
+    return static_cast<size_t>(info.uordblks) + static_cast<size_t>(info.hblkhd);
+}
+
+} // namespace synthetic
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "include/AudioMetadata.h"
+
+/**
+ * 라이브러리 저장소 벤치마크용 메모리 안의 트랙 목록
+ *
+ * 실제 스캔 결과와 같은 모양: 36자 UUID ID, /storage/emulated/0/Music/아티스트/앨범/번호 제목.확장자 경로,
+ * 앨범당 12곡, 아티스트당 10앨범, 장르/포맷/작곡가/아트 경로는 종류가 적고, 약 1/4만 재생 기록이 있음
+ * 같은 seed면 같은 목록
+ */
+namespace synthetic {
+
+std::vector<pancakemusicbox::TrackMetadata> makeTracks(int count, uint32_t seed = 42);
+
+// 현재 힙에 할당된 바이트 수 (malloc 통계)
+size_t heapBytesInUse();
+
+} // namespace synthetic
@@ -0,0 +1,199 @@
+#include "include/AudioScanner.h"
+#include "include/ParallelScanner.h"
+#include "include/TagParser.h"
+#include "LibraryFixture.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/vfs.h>
+#include <unistd.h>
+
+/**
+ * 헤더 파서 처리량 (콜드/웜 페이지 캐시)과 지문 기반 증분 재스캔 비용
+ *
+ * 1. TagParser::parse()만 파일 목록 전체에 실행: 콜드는 sync 후 파일마다 POSIX_FADV_DONTNEED로 캐시를 비운 뒤 1회,
+ *    웜은 바로 이어서 3회 중 최선. /proc/self/io의 rchar로 파일당 읽은 바이트도 출력 (헤더 + 끝부분만 읽는지 확인)
+ * 2. AudioScanner::scanDirectory(): 빈 라이브러리에서 전체 스캔, 바뀐 것 없는 재스캔, 1%를 다시 쓴 뒤 재스캔
+ *
+ * 사용법: TagParserBenchmark [라이브러리 경로] [아티스트 수]
+ * 경로를 주지 않으면 /tmp 아래에 8MB 희소 파일로 트랙 2만 개를 만들고 끝나면 지움
+ * 콜드 캐시는 디스크 기반 파일 시스템에서만 의미가 있음 (tmpfs는 비울 캐시가 없음)
+ */
+
+using namespace pancakemusicbox;
+
+namespace {
+
+constexpr int kDefaultArtists = 200;
+constexpr long long kDefaultFileBytes = 8LL * 1024 * 1024;
+constexpr int kWarmRepeats = 3;
+constexpr int kRewritePercent = 1;
+constexpr long kTmpfsMagic = 0x01021994;
+
+void collectAudioFiles(const std::string& directory, std::vector<std::string>& files) {
+    DIR* dir = opendir(directory.c_str());
+    if (dir == nullptr) {
+        return;
+    }
+    while (dirent* entry = readdir(dir)) {
+        if (entry->d_name[0] == '.') {
+            continue;
+        }
+        std::string path = directory + "/" + entry->d_name;
+        if (entry->d_type == DT_DIR) {
+            collectAudioFiles(path, files);
+        } else if (ParallelScanner::isSupportedAudioFile(entry->d_name)) {
+            files.push_back(path);
+        }
+    }
+    closedir(dir);
+}
+
+long long readCharCount() {
+    FILE* io = fopen("/proc/self/io", "r");
+    if (io == nullptr) {
+        return 0;
+    }
+    long long value = 0;
+    char line[128];
+    while (fgets(line, sizeof(line), io)) {
+        if (strncmp(line, "rchar:", 6) == 0) {
+            value = atoll(line + 6);
+        }
+    }
+    fclose(io);
+    return value;
+}
+
+void dropPageCache(const std::vector<std::string>& files) {
+    sync();
+    for (const std::string& file : files) {
+        int fd = open(file.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd >= 0) {
+            posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+            close(fd);
+        }
+    }
+}
+
+struct ParseRun {
+    double seconds;
+    int recognized;
+    long long bytesRead;
+};
+
+ParseRun parseAll(const std::vector<std::string>& files) {
+    long long readBefore = readCharCount();
+    int recognized = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const std::string& file : files) {
+        TrackMetadata metadata;
+        if (TagParser::parse(file, metadata)) {
+            recognized++;
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return {seconds, recognized, readCharCount() - readBefore};
+}
+
+void printParseRun(const char* label, const ParseRun& run, size_t files) {
+    printf("%-6s %9.3f s %10.0f files/s %10.1f KB/file %8d/%zu recognized\n", label, run.seconds,
+           files / run.seconds, run.bytesRead / 1024.0 / files, run.recognized, files);
+}
+
+double timeScan(AudioScanner& scanner, const std::string& root) {
+    auto start = std::chrono::steady_clock::now();
+    scanner.scanDirectory(root);
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool ownsLibrary = argc <= 1;
+    std::string root = ownsLibrary ? "/tmp/pancake-tag-benchmark" : argv[1];
+    fixture::LibraryLayout layout;
+    layout.artists = argc > 2 ? std::max(1, atoi(argv[2])) : kDefaultArtists;
+    layout.fileBytes = kDefaultFileBytes;
+
+    struct stat rootStat;
+    bool generated = stat(root.c_str(), &rootStat) != 0 || ownsLibrary;
+    if (generated) {
+        fixture::removeTree(root);
+        if (fixture::createLibrary(root, layout) != layout.trackCount()) {
+            fprintf(stderr, "failed to create the library under %s\n", root.c_str());
+            fixture::removeTree(root);
+            return 1;
+        }
+    }
+
+    std::vector<std::string> files;
+    collectAudioFiles(root, files);
+    if (files.empty()) {
+        fprintf(stderr, "no audio files under %s\n", root.c_str());
+        return 1;
+    }
+    struct statfs fsInfo;
+    bool tmpfs = statfs(root.c_str(), &fsInfo) == 0 && static_cast<long>(fsInfo.f_type) == kTmpfsMagic;
+    printf("%zu audio files under %s%s\n", files.size(), root.c_str(),
+           tmpfs ? " (tmpfs: the cold run is not actually cold)" : "");
+
+    // 1. 헤더 파서 처리량
+    dropPageCache(files);
+    ParseRun cold = parseAll(files);
+    ParseRun warm = {1e9, 0, 0};
+    for (int r = 0; r < kWarmRepeats; r++) {
+        ParseRun run = parseAll(files);
+        if (run.seconds < warm.seconds) {
+            warm = run;
+        }
+    }
+    printParseRun("cold", cold, files.size());
+    printParseRun("warm", warm, files.size());
+
+    // 2. 전체 스캔과 지문 기반 증분 재스캔 (증분 재스캔은 생성한 라이브러리에서만)
+    AudioScanner& scanner = AudioScanner::getInstance();
+    scanner.removePath(root);
+    double fullScan = timeScan(scanner, root);
+    size_t tracks = scanner.getAllTracks().size();
+    double unchangedScan = timeScan(scanner, root);
+    printf("full scan %.3f s, unchanged rescan %.3f s (%.1fx), %zu tracks\n", fullScan, unchangedScan,
+           fullScan / unchangedScan, tracks);
+
+    int exitCode = tracks == files.size() ? 0 : 1;
+    if (generated) {
+        int rewritten = 0;
+        int stride = 100 / kRewritePercent;
+        for (int index = 0; index < layout.trackCount(); index += stride, rewritten++) {
+            int track = index % layout.tracksPerAlbum;
+            int album = (index / layout.tracksPerAlbum) % layout.albumsPerArtist;
+            int artist = index / (layout.tracksPerAlbum * layout.albumsPerArtist);
+            fixture::rewriteTrack(root, artist, album, track, "Rewritten " + std::to_string(index));
+        }
+        double changedScan = timeScan(scanner, root);
+
+        int updated = 0;
+        for (const TrackMetadata& track : scanner.getAllTracks()) {
+            if (track.title.compare(0, 10, "Rewritten ") == 0) {
+                updated++;
+            }
+        }
+        printf("rescan after rewriting %d files %.3f s (%.1fx faster than full), %d updated\n", rewritten,
+               changedScan, fullScan / changedScan, updated);
+        if (updated != rewritten) {
+            exitCode = 1;
+        }
+    }
+
+    scanner.removePath(root);
+    if (ownsLibrary) {
+        fixture::removeTree(root);
+    }
+    return exitCode;
+}
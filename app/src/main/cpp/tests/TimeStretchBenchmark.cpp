@@ -0,0 +1,115 @@
+#include "include/TimeStretcher.h"
+#include "include/DspKernels.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+/**
+ * 재생 속도별 타임 스트레치 CPU 비용
+ *
+ * 엔진의 renderStretchedLocked()와 같은 방식으로 1024프레임씩 소스를 공급하며
+ * 모드(WSOLA / 위상 보코더)와 속도마다 출력 kOutputSeconds초를 만드는 데 걸린 시간을 잼
+ * load = 처리 시간 / 생성한 오디오 길이 (1이면 실시간 한계), getCpuLoad()와 같은 정의
+ */
+
+namespace {
+
+constexpr int kSampleRate = 48000;
+constexpr int kChannels = 2;
+constexpr int32_t kChunkFrames = 1024;     // AudioEngine::kStretchChunkFrames
+constexpr int32_t kCallbackFrames = 192;   // 4ms 콜백
+constexpr int kOutputSeconds = 30;
+constexpr int kRepeats = 3;
+constexpr float kSpeeds[] = {0.5f, 0.75f, 0.9f, 1.1f, 1.25f, 1.5f, 2.0f, 3.0f};
+
+// 화음 + 타악기성 과도음이 섞인 소스 (상관 탐색이 쉬운 순음만 쓰면 WSOLA 비용이 과소평가됨)
+std::vector<float> makeSource(int64_t frames) {
+    std::vector<float> source(static_cast<size_t>(frames) * kChannels);
+    uint32_t noise = 12345;
+    for (int64_t i = 0; i < frames; i++) {
+        double t = static_cast<double>(i) / kSampleRate;
+        double tone = 0.2 * std::sin(2.0 * M_PI * 220.0 * t) + 0.15 * std::sin(2.0 * M_PI * 277.2 * t)
+                      + 0.1 * std::sin(2.0 * M_PI * 329.6 * t);
+        noise = noise * 1664525u + 1013904223u;
+        double envelope = std::exp(-30.0 * std::fmod(t, 0.25));
+        double hit = envelope * 0.3 * (static_cast<double>(noise >> 8) / (1 << 24) - 0.5);
+        source[i * kChannels] = static_cast<float>(tone + hit);
+        source[i * kChannels + 1] = static_cast<float>(tone - hit);
+    }
+    return source;
+}
+
+struct Result {
+    double load;
+    float reportedLoad;
+};
+
+Result run(const std::vector<float>& source, TimeStretchMode mode, float speed) {
+    TimeStretcher stretcher;
+    stretcher.configure(kSampleRate, kChannels);
+    stretcher.setMode(mode);
+    stretcher.setSpeed(speed);
+    stretcher.begin(0);
+
+    const int64_t sourceFrames = static_cast<int64_t>(source.size() / kChannels);
+    const int64_t target = static_cast<int64_t>(kOutputSeconds) * kSampleRate;
+    std::vector<float> output(static_cast<size_t>(kCallbackFrames) * kChannels);
+    int64_t sourcePos = 0;
+    int64_t produced = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    while (produced < target) {
+        int32_t filled = 0;
+        while (filled < kCallbackFrames) {
+            filled += stretcher.readOutput(output.data() + static_cast<size_t>(filled) * kChannels,
+                                           kCallbackFrames - filled);
+            if (filled >= kCallbackFrames) {
+                break;
+            }
+            int32_t chunk = static_cast<int32_t>(std::min<int64_t>(kChunkFrames, sourceFrames - sourcePos));
+            if (chunk <= 0) {
+                break;
+            }
+            stretcher.writeInput(source.data() + static_cast<size_t>(sourcePos) * kChannels, chunk);
+            sourcePos += chunk;
+        }
+        if (filled == 0) {
+            break;
+        }
+        produced += filled;
+    }
+    double elapsedNs = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count());
+
+    double audioNs = static_cast<double>(produced) * 1e9 / kSampleRate;
+    return {elapsedNs / audioNs, stretcher.getCpuLoad()};
+}
+
+} // namespace
+
+int main() {
+    // 최대 속도에서도 소스가 끝나지 않을 만큼 생성
+    std::vector<float> source = makeSource(static_cast<int64_t>(kOutputSeconds * 3.2) * kSampleRate);
+
+    printf("kernels: %s, %d Hz stereo, %d s output per run, best of %d\n",
+           DspKernels::active().name, kSampleRate, kOutputSeconds, kRepeats);
+    printf("%-6s %6s %12s %12s %14s\n", "mode", "speed", "load %", "reported %", "x realtime");
+
+    const TimeStretchMode modes[] = {TimeStretchMode::Speech, TimeStretchMode::Music};
+    for (TimeStretchMode mode : modes) {
+        for (float speed : kSpeeds) {
+            Result best = {1e9, 0.0f};
+            for (int r = 0; r < kRepeats; r++) {
+                Result result = run(source, mode, speed);
+                if (result.load < best.load) {
+                    best = result;
+                }
+            }
+            printf("%-6s %6.2f %12.3f %12.3f %14.0f\n",
+                   mode == TimeStretchMode::Speech ? "speech" : "music", speed,
+                   best.load * 100.0, best.reportedLoad * 100.0, 1.0 / best.load);
+        }
+    }
+    return 0;
+}
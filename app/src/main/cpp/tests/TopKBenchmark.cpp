@@ -0,0 +1,172 @@
+#include "include/TrackStore.h"
+#include "SyntheticTracks.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+/**
+ * 트랙 10만 개에서 최근 재생/자주 재생/최근 추가 상위 k개 질의 시간 비교
+ *
+ * 이전: getRecentlyPlayedTracks 등이 조건에 맞는 트랙을 전부 TrackMetadata로 복사한 뒤 전체 정렬
+ * 비교용: 복사 없이 열만 훑어 핸들을 partial_sort
+ * 이후: TrackStore 순위 색인에서 앞의 k개만 읽음
+ * refreshData처럼 세 질의를 연달아 부른 시간과, 색인을 유지하는 대가인 setPlayCount/setLastPlayed 갱신 비용도 출력
+ * 세 방식의 결과(같은 값이면 핸들이 큰 쪽 먼저)가 다르면 0이 아닌 값으로 종료
+ */
+
+using namespace pancakemusicbox;
+
+namespace {
+
+constexpr int kTrackCount = 100000;
+constexpr int kRepeats = 5;
+constexpr int kUpdates = 100000;
+const int kLimits[] = {10, 20, 100};
+
+using Getter = int64_t (*)(const TrackStore&, TrackHandle);
+using Top = std::vector<TrackHandle> (TrackStore::*)(int) const;
+
+double nowSeconds() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// 최선 시간 (ms)
+template <typename Function>
+double bestMs(Function function) {
+    double best = 1e9;
+    for (int r = 0; r < kRepeats; r++) {
+        double start = nowSeconds();
+        function();
+        best = std::min(best, nowSeconds() - start);
+    }
+    return best * 1e3;
+}
+
+// 이전 방식: 값이 있는 트랙을 모두 복사해 전체 정렬
+std::vector<TrackHandle> copyAndSort(const TrackStore& store, Getter value, int limit) {
+    std::vector<std::pair<TrackHandle, TrackMetadata>> copies;
+    store.forEach([&](TrackHandle handle) {
+        if (value(store, handle) > 0) {
+            copies.emplace_back(handle, store.get(handle));
+        }
+    });
+    std::sort(copies.begin(), copies.end(), [&](const auto& a, const auto& b) {
+        int64_t left = value(store, a.first);
+        int64_t right = value(store, b.first);
+        return left != right ? left > right : a.first > b.first;
+    });
+    std::vector<TrackHandle> handles;
+    for (size_t i = 0; i < copies.size() && static_cast<int>(i) < limit; i++) {
+        handles.push_back(copies[i].first);
+    }
+    return handles;
+}
+
+// 복사 없이 핸들만 모아 앞의 k개만 정렬
+std::vector<TrackHandle> scanAndPartialSort(const TrackStore& store, Getter value, int limit) {
+    std::vector<std::pair<int64_t, TrackHandle>> entries;
+    store.forEach([&](TrackHandle handle) {
+        int64_t v = value(store, handle);
+        if (v > 0) {
+            entries.emplace_back(v, handle);
+        }
+    });
+    size_t count = std::min(entries.size(), static_cast<size_t>(limit));
+    std::partial_sort(entries.begin(), entries.begin() + count, entries.end(), std::greater<>());
+    std::vector<TrackHandle> handles;
+    handles.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        handles.push_back(entries[i].second);
+    }
+    return handles;
+}
+
+int64_t lastPlayedOf(const TrackStore& store, TrackHandle handle) {
+    return store.getLastPlayed(handle);
+}
+
+int64_t playCountOf(const TrackStore& store, TrackHandle handle) {
+    return store.getPlayCount(handle);
+}
+
+int64_t dateAddedOf(const TrackStore& store, TrackHandle handle) {
+    return store.getDateAdded(handle);
+}
+
+} // namespace
+
+int main() {
+    std::vector<TrackMetadata> source = synthetic::makeTracks(kTrackCount);
+    TrackStore store;
+    for (const TrackMetadata& track : source) {
+        store.insert(track);
+    }
+
+    struct Ranking {
+        const char* name;
+        Getter value;
+        Top top;
+    };
+    const Ranking rankings[] = {
+        {"recently played", lastPlayedOf, &TrackStore::topByLastPlayed},
+        {"frequently played", playCountOf, &TrackStore::topByPlayCount},
+        {"recently added", dateAddedOf, &TrackStore::topByDateAdded},
+    };
+
+    int mismatches = 0;
+    printf("%d tracks\n", kTrackCount);
+    printf("%-22s %5s %12s %12s %12s\n", "query", "k", "copy+sort ms", "scan+psort", "rank index");
+    for (const Ranking& ranking : rankings) {
+        for (int limit : kLimits) {
+            std::vector<TrackHandle> copied;
+            std::vector<TrackHandle> scanned;
+            std::vector<TrackHandle> indexed;
+            double copyMs = bestMs([&] { copied = copyAndSort(store, ranking.value, limit); });
+            double scanMs = bestMs([&] { scanned = scanAndPartialSort(store, ranking.value, limit); });
+            double indexMs = bestMs([&] { indexed = (store.*ranking.top)(limit); });
+            bool same = copied == scanned && scanned == indexed;
+            printf("%-22s %5d %12.3f %12.3f %12.4f %s\n", ranking.name, limit, copyMs, scanMs, indexMs,
+                   same ? "" : "MISMATCH");
+            if (!same) {
+                mismatches++;
+            }
+        }
+    }
+
+    // refreshData: 세 질의를 20개씩 연달아
+    double refreshMs = bestMs([&] {
+        store.topByLastPlayed(20);
+        store.topByPlayCount(20);
+        store.topByDateAdded(20);
+    });
+    printf("refreshData (3 x top-20 from rank indexes): %.4f ms\n", refreshMs);
+
+    // 색인 유지 비용: 임의 트랙의 재생 기록 갱신
+    std::mt19937 rng(11);
+    std::vector<TrackHandle> handles;
+    store.forEach([&](TrackHandle handle) { handles.push_back(handle); });
+    std::vector<TrackHandle> targets;
+    for (int i = 0; i < kUpdates; i++) {
+        targets.push_back(handles[rng() % handles.size()]);
+    }
+    double start = nowSeconds();
+    int64_t now = 1800000000000LL;
+    for (TrackHandle handle : targets) {
+        store.setPlayCount(handle, store.getPlayCount(handle) + 1);
+        store.setLastPlayed(handle, ++now);
+    }
+    double updateUs = (nowSeconds() - start) * 1e6 / kUpdates;
+    printf("setPlayCount + setLastPlayed: %.3f us per played track (%d updates)\n", updateUs, kUpdates);
+
+    if (store.topByLastPlayed(1) != std::vector<TrackHandle>{targets.back()}) {
+        printf("FAIL last updated track is not the most recently played\n");
+        mismatches++;
+    }
+    if (mismatches > 0) {
+        printf("FAIL %d rankings differ between methods\n", mismatches);
+        return 1;
+    }
+    return 0;
+}
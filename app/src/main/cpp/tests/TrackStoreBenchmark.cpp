@@ -0,0 +1,242 @@
+#include "include/TrackStore.h"
+#include "SyntheticTracks.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * 트랙 10만 개에서 열 저장소(TrackStore)와 이전 구조(트랙마다 TrackMetadata 노드)의 메모리와 질의 시간 비교
+ *
+ * 기준 구조는 TrackStore 도입 전 AudioScanner와 같음: UUID 문자열 키의 std::map<std::string, TrackMetadata>와
+ * 경로 -> ID 해시, 질의도 그때처럼 전체를 훑어 복사한 뒤 정렬
+ * 두 쪽 질의 결과가 같은지도 확인하여 다르면 0이 아닌 값으로 종료
+ */
+
+using namespace pancakemusicbox;
+
+namespace {
+
+constexpr int kTrackCount = 100000;
+constexpr int kRepeats = 5;
+constexpr int kTopCount = 20;
+
+// TrackStore 이전의 저장 구조
+struct ReferenceLibrary {
+    std::map<std::string, TrackMetadata> tracks;
+    std::unordered_map<std::string, std::string> trackIdsByPath;
+
+    void insert(const TrackMetadata& track) {
+        tracks[track.id] = track;
+        trackIdsByPath[track.filePath] = track.id;
+    }
+};
+
+double nowSeconds() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// 최선 시간 (ms)
+template <typename Function>
+double bestMs(Function function) {
+    double best = 1e9;
+    for (int r = 0; r < kRepeats; r++) {
+        double start = nowSeconds();
+        function();
+        best = std::min(best, nowSeconds() - start);
+    }
+    return best * 1e3;
+}
+
+int gMismatches = 0;
+
+void report(const char* query, double referenceMs, double columnarMs, long long referenceValue, long long columnarValue) {
+    bool same = referenceValue == columnarValue;
+    printf("%-28s %10.2f %10.2f %8.1fx %s\n", query, referenceMs, columnarMs, referenceMs / columnarMs,
+           same ? "" : "MISMATCH");
+    if (!same) {
+        gMismatches++;
+    }
+}
+
+} // namespace
+
+int main() {
+    std::vector<TrackMetadata> source = synthetic::makeTracks(kTrackCount);
+    std::mt19937 rng(7);
+    std::vector<const TrackMetadata*> probes;
+    for (int i = 0; i < kTrackCount; i++) {
+        probes.push_back(&source[rng() % kTrackCount]);
+    }
+    TrackFilter filter;
+    filter.genre = "Jazz";
+    filter.year = 1992;
+
+    // 기준 구조
+    size_t heapBefore = synthetic::heapBytesInUse();
+    double start = nowSeconds();
+    auto* reference = new ReferenceLibrary();
+    for (const TrackMetadata& track : source) {
+        reference->insert(track);
+    }
+    double referenceBuildMs = (nowSeconds() - start) * 1e3;
+    size_t referenceBytes = synthetic::heapBytesInUse() - heapBefore;
+
+    // 열 저장소
+    heapBefore = synthetic::heapBytesInUse();
+    start = nowSeconds();
+    auto* store = new TrackStore();
+    for (const TrackMetadata& track : source) {
+        store->insert(track);
+    }
+    double columnarBuildMs = (nowSeconds() - start) * 1e3;
+    size_t columnarBytes = synthetic::heapBytesInUse() - heapBefore;
+
+    printf("%d tracks\n", kTrackCount);
+    printf("heap: map<string, TrackMetadata> %.1f MB, TrackStore %.1f MB (%.2fx smaller, getMemoryUsage %.1f MB)\n",
+           referenceBytes / 1048576.0, columnarBytes / 1048576.0, static_cast<double>(referenceBytes) / columnarBytes,
+           store->getMemoryUsage() / 1048576.0);
+    printf("%-28s %10s %10s %9s\n", "query", "map ms", "store ms", "speedup");
+    report("build", referenceBuildMs, columnarBuildMs, static_cast<long long>(reference->tracks.size()),
+           static_cast<long long>(store->size()));
+
+    long long referenceValue = 0;
+    long long columnarValue = 0;
+
+    double referenceMs = bestMs([&] {
+        referenceValue = 0;
+        for (const TrackMetadata* probe : probes) {
+            referenceValue += reference->tracks.find(probe->id)->second.playCount;
+        }
+    });
+    double columnarMs = bestMs([&] {
+        columnarValue = 0;
+        for (const TrackMetadata* probe : probes) {
+            columnarValue += store->getPlayCount(store->findById(probe->id));
+        }
+    });
+    report("id lookup x100k", referenceMs, columnarMs, referenceValue, columnarValue);
+
+    referenceMs = bestMs([&] {
+        referenceValue = 0;
+        for (const TrackMetadata* probe : probes) {
+            const std::string& id = reference->trackIdsByPath.find(probe->filePath)->second;
+            referenceValue += reference->tracks.find(id)->second.year;
+        }
+    });
+    columnarMs = bestMs([&] {
+        columnarValue = 0;
+        const std::vector<int32_t>& years = store->yearColumn();
+        for (const TrackMetadata* probe : probes) {
+            columnarValue += years[store->findByPath(probe->filePath)];
+        }
+    });
+    report("path lookup x100k", referenceMs, columnarMs, referenceValue, columnarValue);
+
+    referenceMs = bestMs([&] {
+        referenceValue = 0;
+        for (const auto& entry : reference->tracks) {
+            referenceValue += entry.second.duration;
+        }
+    });
+    columnarMs = bestMs([&] {
+        columnarValue = 0;
+        const std::vector<int64_t>& durations = store->durationColumn();
+        store->forEach([&](TrackHandle handle) { columnarValue += durations[handle]; });
+    });
+    report("sum(duration)", referenceMs, columnarMs, referenceValue, columnarValue);
+
+    referenceMs = bestMs([&] {
+        referenceValue = 0;
+        for (const auto& entry : reference->tracks) {
+            referenceValue += entry.second.audioQuality.isHighResolution();
+        }
+    });
+    columnarMs = bestMs([&] {
+        columnarValue = 0;
+        TrackFilter highResolution;
+        highResolution.highResolutionOnly = true;
+        columnarValue = static_cast<long long>(store->query(highResolution).size());
+    });
+    report("count hi-res", referenceMs, columnarMs, referenceValue, columnarValue);
+
+    referenceMs = bestMs([&] {
+        std::vector<TrackMetadata> result;
+        for (const auto& entry : reference->tracks) {
+            if (entry.second.genre == filter.genre && entry.second.year == filter.year) {
+                result.push_back(entry.second);
+            }
+        }
+        referenceValue = static_cast<long long>(result.size());
+    });
+    columnarMs = bestMs([&] {
+        std::vector<TrackMetadata> result;
+        for (TrackHandle handle : store->query(filter)) {
+            result.push_back(store->get(handle));
+        }
+        columnarValue = static_cast<long long>(result.size());
+    });
+    report("genre + year facet", referenceMs, columnarMs, referenceValue, columnarValue);
+
+    referenceMs = bestMs([&] {
+        std::vector<TrackMetadata> result;
+        for (const auto& entry : reference->tracks) {
+            if (entry.second.playCount > 0) {
+                result.push_back(entry.second);
+            }
+        }
+        std::sort(result.begin(), result.end(), [](const TrackMetadata& a, const TrackMetadata& b) {
+            return a.playCount > b.playCount;
+        });
+        result.resize(std::min<size_t>(result.size(), kTopCount));
+        referenceValue = 0;
+        for (const TrackMetadata& track : result) {
+            referenceValue += track.playCount;
+        }
+    });
+    columnarMs = bestMs([&] {
+        std::vector<TrackMetadata> result;
+        for (TrackHandle handle : store->topByPlayCount(kTopCount)) {
+            result.push_back(store->get(handle));
+        }
+        columnarValue = 0;
+        for (const TrackMetadata& track : result) {
+            columnarValue += track.playCount;
+        }
+    });
+    report("top-20 play count", referenceMs, columnarMs, referenceValue, columnarValue);
+
+    referenceMs = bestMs([&] {
+        std::map<std::string, std::vector<TrackMetadata>> byGenre;
+        for (const auto& entry : reference->tracks) {
+            byGenre[entry.second.genre].push_back(entry.second);
+        }
+        referenceValue = static_cast<long long>(byGenre.size());
+    });
+    columnarMs = bestMs([&] {
+        std::map<std::string, std::vector<TrackMetadata>> byGenre;
+        store->forEachGenre([&](std::string_view genre, const std::vector<TrackHandle>& handles) {
+            std::vector<TrackMetadata>& tracks = byGenre[std::string(genre)];
+            tracks.reserve(handles.size());
+            for (TrackHandle handle : handles) {
+                tracks.push_back(store->get(handle));
+            }
+        });
+        columnarValue = static_cast<long long>(byGenre.size());
+    });
+    report("group by genre (copies all)", referenceMs, columnarMs, referenceValue, columnarValue);
+
+    start = nowSeconds();
+    delete reference;
+    referenceMs = (nowSeconds() - start) * 1e3;
+    start = nowSeconds();
+    delete store;
+    columnarMs = (nowSeconds() - start) * 1e3;
+    report("free library", referenceMs, columnarMs, 0, 0);
+
+    return gMismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,149 @@
+#include "include/TrackStore.h"
+#include "SyntheticTracks.h"
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * TrackStore 순위 색인(topByLastPlayed/topByPlayCount/topByDateAdded)을 전수 정렬 결과와 비교
+ *
+ * 고정 시드로 추가, 같은 ID 다시 넣기(값 변경), 삭제 후 핸들 재사용, setPlayCount/setLastPlayed를 섞어 실행하며
+ * 테스트가 따로 들고 있는 기대값으로 매번 전수 정렬한 상위 k개와 같은지 확인
+ * 값의 범위를 좁게 두어 같은 값이 많이 생기게 함 (같은 값이면 핸들이 큰 쪽 먼저, 0 이하는 제외)
+ */
+
+using namespace pancakemusicbox;
+
+namespace {
+
+constexpr int kInitialTracks = 3000;
+constexpr int kOperations = 30000;
+constexpr int kCheckInterval = 97;
+const int kLimits[] = {0, 1, 2, 10, 20, 257, 1000000};
+
+struct Expected {
+    int64_t lastPlayed;
+    int64_t playCount;
+    int64_t dateAdded;
+};
+
+int gFailures = 0;
+
+using Column = int64_t Expected::*;
+
+std::vector<TrackHandle> bruteForceTop(const TrackStore& store, const std::unordered_map<std::string, Expected>& model,
+                                       Column column, int limit) {
+    std::vector<std::pair<int64_t, TrackHandle>> entries;
+    for (const auto& entry : model) {
+        int64_t value = entry.second.*column;
+        if (value > 0) {
+            entries.emplace_back(value, store.findById(entry.first));
+        }
+    }
+    std::sort(entries.begin(), entries.end(), std::greater<>());
+    std::vector<TrackHandle> handles;
+    for (size_t i = 0; i < entries.size() && static_cast<int>(i) < limit; i++) {
+        handles.push_back(entries[i].second);
+    }
+    return handles;
+}
+
+void checkAll(const TrackStore& store, const std::unordered_map<std::string, Expected>& model, int operation) {
+    struct Ranking {
+        const char* name;
+        Column column;
+        std::vector<TrackHandle> (TrackStore::*top)(int) const;
+    };
+    const Ranking rankings[] = {
+        {"lastPlayed", &Expected::lastPlayed, &TrackStore::topByLastPlayed},
+        {"playCount", &Expected::playCount, &TrackStore::topByPlayCount},
+        {"dateAdded", &Expected::dateAdded, &TrackStore::topByDateAdded},
+    };
+    if (store.size() != model.size()) {
+        printf("FAIL after operation %d: store has %zu tracks, expected %zu\n", operation, store.size(), model.size());
+        gFailures++;
+    }
+    for (const Ranking& ranking : rankings) {
+        for (int limit : kLimits) {
+            std::vector<TrackHandle> expected = bruteForceTop(store, model, ranking.column, limit);
+            std::vector<TrackHandle> actual = (store.*ranking.top)(limit);
+            if (actual != expected) {
+                printf("FAIL after operation %d: top %d by %s differs (%zu vs %zu handles)\n", operation, limit,
+                       ranking.name, actual.size(), expected.size());
+                gFailures++;
+            }
+        }
+    }
+}
+
+} // namespace
+
+int main() {
+    std::vector<TrackMetadata> pool = synthetic::makeTracks(kInitialTracks * 2);
+    std::mt19937 rng(2024);
+    auto smallValue = [&rng]() { return static_cast<int64_t>(rng() % 40); };  // 0 포함, 같은 값이 흔함
+
+    TrackStore store;
+    std::unordered_map<std::string, Expected> model;
+    std::vector<std::string> liveIds;
+    size_t nextTrack = 0;
+
+    auto insertTrack = [&](TrackMetadata track) {
+        track.playCount = static_cast<int>(smallValue());
+        track.lastPlayed = smallValue();
+        track.dateAdded = smallValue();
+        store.insert(track);
+        if (model.find(track.id) == model.end()) {
+            liveIds.push_back(track.id);
+        }
+        model[track.id] = {track.lastPlayed, track.playCount, track.dateAdded};
+    };
+
+    for (int i = 0; i < kInitialTracks; i++) {
+        insertTrack(pool[nextTrack++]);
+    }
+    checkAll(store, model, 0);
+
+    for (int operation = 1; operation <= kOperations && gFailures == 0; operation++) {
+        uint32_t kind = rng() % 10;
+        if (liveIds.empty()) {
+            kind = 0;
+        }
+        size_t pick = liveIds.empty() ? 0 : rng() % liveIds.size();
+        if (kind == 0) {
+            // 새 트랙 (삭제된 핸들 재사용), 다 쓰면 삭제했던 트랙을 다시 넣음
+            const TrackMetadata& track = pool[nextTrack % pool.size()];
+            nextTrack++;
+            insertTrack(track);
+        } else if (kind == 1) {
+            // 같은 ID로 다시 넣기 (재스캔으로 값이 바뀐 경우)
+            TrackMetadata track = store.get(store.findById(liveIds[pick]));
+            insertTrack(track);
+        } else if (kind == 2) {
+            store.remove(store.findById(liveIds[pick]));
+            model.erase(liveIds[pick]);
+            liveIds[pick] = liveIds.back();
+            liveIds.pop_back();
+        } else if (kind < 6) {
+            int64_t value = smallValue();
+            store.setPlayCount(store.findById(liveIds[pick]), static_cast<int32_t>(value));
+            model[liveIds[pick]].playCount = value;
+        } else {
+            int64_t value = smallValue();
+            store.setLastPlayed(store.findById(liveIds[pick]), value);
+            model[liveIds[pick]].lastPlayed = value;
+        }
+        if (operation % kCheckInterval == 0) {
+            checkAll(store, model, operation);
+        }
+    }
+    checkAll(store, model, kOperations);
+
+    if (gFailures == 0) {
+        printf("PASS top-K of all three rankings match a full sort over %d random operations\n", kOperations);
+    }
+    return gFailures == 0 ? 0 : 1;
+}
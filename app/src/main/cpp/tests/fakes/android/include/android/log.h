@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+
+/**
+ * 호스트 테스트용 liblog 대체 (기기 빌드에서는 쓰지 않음)
+ * 기본은 출력하지 않고, PANCAKE_TEST_LOG 환경 변수가 있으면 stderr로 출력
+ */
+enum android_LogPriority {
+    ANDROID_LOG_UNKNOWN = 0,
+    ANDROID_LOG_DEFAULT,
+    ANDROID_LOG_VERBOSE,
+    ANDROID_LOG_DEBUG,
+    ANDROID_LOG_INFO,
+    ANDROID_LOG_WARN,
+    ANDROID_LOG_ERROR,
+    ANDROID_LOG_FATAL,
+    ANDROID_LOG_SILENT,
+};
+
+inline int __android_log_print(int priority, const char* tag, const char* fmt, ...) {
+    static const bool enabled = std::getenv("PANCAKE_TEST_LOG") != nullptr;
+    if (!enabled) {
+        return 0;
+    }
+    va_list args;
+    va_start(args, fmt);
+    fprintf(stderr, "%d %s: ", priority, tag);
+    int written = vfprintf(stderr, fmt, args);
+    fputc('\n', stderr);
+    va_end(args);
+    return written;
+}
@@ -0,0 +1,307 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * 엔진 테스트용 Oboe 대체 (vendored 목업과 같은 API, 장치 클럭은 테스트가 직접 진행)
+ *
+ * 스트림은 스레드 없이 동작: 테스트가 fakeRenderCallback()으로 데이터 콜백을 한 번씩 호출하고
+ * fakeAdvanceReadClock()으로 장치 재생 위치를 옮김. 재생 위치가 쓰기 위치보다 뒤처진 상태를
+ * 만들 수 있으므로 버퍼에 남은 프레임 수에 의존하는 엔진 로직을 검증할 수 있음
+ * 장치가 실제로 재생한 바이트는 fakeGetPlayed()로 확인 (flush로 버린 프레임은 포함되지 않음)
+ */
+
+namespace oboe {
+
+// Oboe enums (값은 upstream Oboe / AAudio와 동일)
+enum class Direction : int32_t { Output = 0, Input = 1 };
+enum class PerformanceMode : int32_t { None = 10, PowerSaving = 11, LowLatency = 12 };
+enum class SharingMode : int32_t { Exclusive = 0, Shared = 1 };
+enum class AudioFormat : int32_t { Invalid = -1, Unspecified = 0, I16 = 1, Float = 2, I24 = 3, I32 = 4 };
+enum class StreamState : int32_t {
+    Uninitialized = 0, Unknown = 1, Open = 2, Starting = 3, Started = 4, Pausing = 5, Paused = 6,
+    Flushing = 7, Flushed = 8, Stopping = 9, Stopped = 10, Closing = 11, Closed = 12, Disconnected = 13
+};
+enum class SampleRateConversionQuality : int32_t { None, Fastest, Low, Medium, High, Best };
+enum class Result : int32_t {
+    OK = 0, ErrorBase = -900, ErrorDisconnected = -899, ErrorIllegalArgument = -898, ErrorInternal = -896,
+    ErrorInvalidState = -895, ErrorUnimplemented = -890, ErrorUnavailable = -889, ErrorTimeout = -885
+};
+
+inline const char* convertToText(Result result) {
+    switch (result) {
+        case Result::OK: return "OK";
+        case Result::ErrorInvalidState: return "InvalidState";
+        case Result::ErrorTimeout: return "Timeout";
+        default: return "Error";
+    }
+}
+
+template <typename T>
+class ResultWithValue {
+public:
+    ResultWithValue(Result error) : mValue{}, mError(error) {}
+    ResultWithValue(T value) : mValue(value), mError(Result::OK) {}
+
+    T value() const { return mValue; }
+    Result error() const { return mError; }
+    explicit operator bool() const { return mError == Result::OK; }
+
+private:
+    T mValue;
+    Result mError;
+};
+
+class AudioStream;
+
+enum class DataCallbackResult { Continue, Stop };
+
+class AudioStreamCallback {
+public:
+    virtual ~AudioStreamCallback() = default;
+
+    virtual DataCallbackResult onAudioReady(AudioStream *audioStream, void *audioData, int32_t numFrames) = 0;
+
+    virtual void onErrorBeforeClose(AudioStream *audioStream, Result error) {}
+    virtual void onErrorAfterClose(AudioStream *audioStream, Result error) {}
+};
+
+class AudioStream {
+public:
+    virtual ~AudioStream() = default;
+
+    virtual Result requestStart() {
+        std::lock_guard<std::mutex> lock(mLock);
+        if (mState == StreamState::Closed) {
+            return Result::ErrorInvalidState;
+        }
+        mState = StreamState::Started;
+        return Result::OK;
+    }
+
+    // 출력 스트림은 버퍼에 남은 프레임을 모두 재생한 뒤 정지 (upstream과 같음)
+    virtual Result requestStop() {
+        std::lock_guard<std::mutex> lock(mLock);
+        if (mState == StreamState::Closed) {
+            return Result::ErrorInvalidState;
+        }
+        playUntilLocked(mFramesWritten);
+        mState = StreamState::Stopped;
+        return Result::OK;
+    }
+
+    virtual Result requestPause() {
+        std::lock_guard<std::mutex> lock(mLock);
+        if (mState == StreamState::Closed) {
+            return Result::ErrorInvalidState;
+        }
+        mState = StreamState::Paused;
+        return Result::OK;
+    }
+
+    // 재생되지 않은 프레임을 버림 (일시정지 상태에서만 가능)
+    virtual Result requestFlush() {
+        std::lock_guard<std::mutex> lock(mLock);
+        if (mState != StreamState::Paused && mState != StreamState::Flushed) {
+            return Result::ErrorInvalidState;
+        }
+        mFramesRead = mFramesWritten;
+        mFlushCount++;
+        mState = StreamState::Flushed;
+        return Result::OK;
+    }
+
+    virtual Result close() {
+        std::lock_guard<std::mutex> lock(mLock);
+        mState = StreamState::Closed;
+        return Result::OK;
+    }
+
+    virtual StreamState getState() const { return mState; }
+
+    virtual int32_t getDeviceId() const { return mDeviceId; }
+    virtual int getChannelCount() const { return mChannelCount; }
+    virtual int getSampleRate() const { return mSampleRate; }
+    virtual AudioFormat getFormat() const { return mFormat; }
+
+    virtual PerformanceMode getPerformanceMode() const { return mPerformanceMode; }
+    virtual SharingMode getSharingMode() const { return mSharingMode; }
+
+    virtual int32_t getFramesPerBurst() const { return mFramesPerBurst; }
+    virtual int32_t getBufferSizeInFrames() const { return mBufferSizeInFrames; }
+    virtual int32_t getBufferCapacityInFrames() const { return mBufferCapacityInFrames; }
+
+    virtual int64_t getFramesWritten() {
+        std::lock_guard<std::mutex> lock(mLock);
+        return mFramesWritten;
+    }
+
+    virtual int64_t getFramesRead() {
+        std::lock_guard<std::mutex> lock(mLock);
+        return mFramesRead;
+    }
+
+    virtual ResultWithValue<int32_t> setBufferSizeInFrames(int32_t requestedFrames) {
+        int32_t frames = requestedFrames < mFramesPerBurst ? mFramesPerBurst : requestedFrames;
+        mBufferSizeInFrames = frames > mBufferCapacityInFrames ? mBufferCapacityInFrames : frames;
+        return mBufferSizeInFrames;
+    }
+
+    virtual ResultWithValue<int32_t> getXRunCount() const { return 0; }
+
+    virtual ResultWithValue<double> calculateLatencyMillis() {
+        return mBufferSizeInFrames * 1000.0 / mSampleRate;
+    }
+
+    // 블로킹 쓰기: 버퍼에 들어가는 만큼만 쓰고, 공간이 없으면 잠시 쉬고 0을 반환 (재생 위치는 테스트가 옮김)
+    virtual ResultWithValue<int32_t> write(const void *buffer, int32_t numFrames, int64_t timeoutNanoseconds) {
+        std::unique_lock<std::mutex> lock(mLock);
+        if (mState != StreamState::Started) {
+            return Result::ErrorInvalidState;
+        }
+        int64_t space = mBufferSizeInFrames - (mFramesWritten - mFramesRead);
+        int32_t frames = static_cast<int32_t>(space < 0 ? 0 : (space < numFrames ? space : numFrames));
+        if (frames == 0) {
+            lock.unlock();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            return 0;
+        }
+        appendLocked(buffer, frames);
+        return frames;
+    }
+
+    // 테스트 제어: 실행 중이면 데이터 콜백을 한 번 호출하고 결과를 스트림 버퍼에 씀
+    bool fakeRenderCallback(int32_t numFrames) {
+        if (!mCallback || mState != StreamState::Started) {
+            return false;
+        }
+        std::vector<uint8_t> buffer(static_cast<size_t>(numFrames) * getFrameBytes());
+        DataCallbackResult result = mCallback->onAudioReady(this, buffer.data(), numFrames);
+        std::lock_guard<std::mutex> lock(mLock);
+        appendLocked(buffer.data(), numFrames);
+        if (result == DataCallbackResult::Stop) {
+            // upstream과 같이 Stop을 반환하면 스트림이 멈춤
+            mState = StreamState::Stopped;
+        }
+        return result == DataCallbackResult::Continue;
+    }
+
+    // 테스트 제어: 실행 중이면 장치가 frames만큼 재생 (쓰기 위치를 넘지 않음)
+    void fakeAdvanceReadClock(int64_t frames) {
+        std::lock_guard<std::mutex> lock(mLock);
+        if (mState == StreamState::Started) {
+            playUntilLocked(std::min(mFramesWritten, mFramesRead + frames));
+        }
+    }
+
+    // 장치가 실제로 재생한 바이트 (재생 순서대로)
+    std::vector<uint8_t> fakeGetPlayed() const {
+        std::lock_guard<std::mutex> lock(mLock);
+        return mPlayed;
+    }
+
+    int fakeGetFlushCount() const {
+        std::lock_guard<std::mutex> lock(mLock);
+        return mFlushCount;
+    }
+
+    size_t getFrameBytes() const {
+        size_t sampleBytes = mFormat == AudioFormat::I16 ? 2 : (mFormat == AudioFormat::I24 ? 3 : 4);
+        return sampleBytes * mChannelCount;
+    }
+
+private:
+    void appendLocked(const void* data, int32_t frames) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        mWritten.insert(mWritten.end(), bytes, bytes + frames * getFrameBytes());
+        mFramesWritten += frames;
+    }
+
+    void playUntilLocked(int64_t position) {
+        if (position > mFramesRead) {
+            mPlayed.insert(mPlayed.end(), mWritten.begin() + mFramesRead * getFrameBytes(),
+                           mWritten.begin() + position * getFrameBytes());
+            mFramesRead = position;
+        }
+    }
+
+    mutable std::mutex mLock;
+    StreamState mState = StreamState::Uninitialized;
+    int32_t mDeviceId = 0;
+    int mChannelCount = 2;
+    int mSampleRate = 44100;
+    AudioFormat mFormat = AudioFormat::Float;
+    PerformanceMode mPerformanceMode = PerformanceMode::None;
+    SharingMode mSharingMode = SharingMode::Shared;
+    int32_t mFramesPerBurst = 192;
+    int32_t mBufferSizeInFrames = 384;
+    int32_t mBufferCapacityInFrames = 192 * 16;
+    AudioStreamCallback* mCallback = nullptr;
+
+    int64_t mFramesWritten = 0;
+    int64_t mFramesRead = 0;
+    int mFlushCount = 0;
+    std::vector<uint8_t> mWritten;  // 쓰기 위치 0부터 쓴 모든 바이트
+    std::vector<uint8_t> mPlayed;
+
+    friend class AudioStreamBuilder;
+};
+
+namespace fake {
+
+// 테스트가 연 순서대로 모든 스트림에 접근할 수 있도록 기록
+inline std::vector<std::shared_ptr<AudioStream>>& openedStreams() {
+    static std::vector<std::shared_ptr<AudioStream>> streams;
+    return streams;
+}
+
+} // namespace fake
+
+class AudioStreamBuilder {
+public:
+    AudioStreamBuilder* setDirection(Direction direction) { return this; }
+    AudioStreamBuilder* setPerformanceMode(PerformanceMode mode) { mPerformanceMode = mode; return this; }
+    AudioStreamBuilder* setSharingMode(SharingMode mode) { mSharingMode = mode; return this; }
+    AudioStreamBuilder* setFormat(AudioFormat format) { mFormat = format; return this; }
+    AudioStreamBuilder* setDeviceId(int32_t deviceId) { mDeviceId = deviceId; return this; }
+    AudioStreamBuilder* setChannelCount(int channelCount) { mChannelCount = channelCount; return this; }
+    AudioStreamBuilder* setSampleRate(int sampleRate) { mSampleRate = sampleRate; return this; }
+    AudioStreamBuilder* setSampleRateConversionQuality(SampleRateConversionQuality quality) { return this; }
+    AudioStreamBuilder* setCallback(AudioStreamCallback* callback) { mCallback = callback; return this; }
+
+    // 요청한 설정 그대로 열림 (저지연 192프레임 버스트, 절전 1920프레임 버스트)
+    Result openStream(std::shared_ptr<AudioStream>& stream) {
+        stream = std::make_shared<AudioStream>();
+        stream->mState = StreamState::Open;
+        stream->mDeviceId = mDeviceId;
+        stream->mChannelCount = mChannelCount;
+        stream->mSampleRate = mSampleRate;
+        stream->mFormat = mFormat;
+        stream->mPerformanceMode = mPerformanceMode;
+        stream->mSharingMode = mSharingMode;
+        stream->mCallback = mCallback;
+        stream->mFramesPerBurst = mPerformanceMode == PerformanceMode::LowLatency ? 192 : 1920;
+        stream->mBufferCapacityInFrames = stream->mFramesPerBurst * (mPerformanceMode == PerformanceMode::LowLatency ? 16 : 4);
+        stream->mBufferSizeInFrames = stream->mFramesPerBurst * 2;
+        fake::openedStreams().push_back(stream);
+        return Result::OK;
+    }
+
+private:
+    int32_t mDeviceId = 0;
+    int mChannelCount = 2;
+    int mSampleRate = 44100;
+    AudioFormat mFormat = AudioFormat::Float;
+    PerformanceMode mPerformanceMode = PerformanceMode::None;
+    SharingMode mSharingMode = SharingMode::Shared;
+    AudioStreamCallback* mCallback = nullptr;
+};
+
+} // namespace oboe
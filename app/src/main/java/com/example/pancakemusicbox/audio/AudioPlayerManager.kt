@@ -40,6 +40,9 @@ class AudioPlayerManager {
     private var updateJob: Job? = null
     private val updateScope = CoroutineScope(Dispatchers.Main)
     
+    // 트랙 미리 디코딩을 위한 백그라운드 코루틴 스코프
+    private val preloadScope = CoroutineScope(Dispatchers.IO)
+    
     // 오디오 품질 설정
     private var _sampleRate = 44100
     val sampleRate: Int get() = _sampleRate
@@ -50,6 +53,10 @@ class AudioPlayerManager {
     private var _channelCount = 2
     val channelCount: Int get() = _channelCount
     
+    // warm-start 대상 트랙 (enableWarmStart로 켠 경우에만 설정) 및 앱 포그라운드 여부
+    private var warmStartTrackPath: String? = null
+    private var isAppInForeground = true
+    
     // 생성자
     init {
         // 초기 하드웨어 최적화
@@ -81,6 +88,10 @@ class AudioPlayerManager {
             val success = nativePlayer.loadFile(filePath)
             if (success) {
                 currentTrackPath = filePath
+                if (warmStartTrackPath != null) {
+                    // 포그라운드 복귀 시 다시 준비할 트랙을 현재 트랙으로 갱신 (캐시 적중)
+                    warmStartTrackPath = filePath
+                }
                 _duration.value = nativePlayer.getDuration()
                 _currentPosition.value = 0
                 startUpdates()
@@ -93,6 +104,70 @@ class AudioPlayerManager {
         }
     }
     
+    /**
+     * 큐의 다음/이전 트랙을 미리 디코딩하여 즉시 재생할 수 있게 준비
+     * @param filePath 오디오 파일 경로
+     */
+    fun preloadTrack(filePath: String) {
+        if (!AudioPlayerNative.isNativeLibraryLoaded()) return
+        
+        preloadScope.launch {
+            nativePlayer.preloadFile(filePath)
+        }
+    }
+    
+    /**
+     * 큐의 다음 트랙 파일 앞부분을 미리 읽어 첫 디코딩 시 I/O 대기를 줄임
+     * @param filePath 오디오 파일 경로
+     */
+    fun prefetchTrack(filePath: String) {
+        nativePlayer.prefetchFile(filePath)
+    }
+    
+    /**
+     * warm-start 활성화: 출력 스트림을 무음으로 미리 열고 대기열 트랙을 디코딩 캐시에 준비하여 첫 재생 지연을 줄임
+     * 재생 없이 일정 시간이 지나거나 앱이 백그라운드로 가면 무음 스트림은 멈춤
+     * @param queuedTrackPath 다음에 재생될 대기열 트랙 경로
+     */
+    fun enableWarmStart(queuedTrackPath: String) {
+        if (!AudioPlayerNative.isNativeLibraryLoaded()) return
+        
+        warmStartTrackPath = queuedTrackPath
+        if (!isAppInForeground) return
+        
+        // 스트림 열기와 디코딩은 수십 ms 이상 걸릴 수 있으므로 백그라운드에서 수행
+        preloadScope.launch {
+            nativePlayer.warmStart(queuedTrackPath)
+        }
+    }
+    
+    /**
+     * warm-start 해제 (재생 중이 아니면 무음 스트림을 멈춤)
+     */
+    fun disableWarmStart() {
+        warmStartTrackPath = null
+        nativePlayer.disableWarmStart()
+    }
+    
+    /**
+     * 앱 포그라운드/백그라운드 전환 알림
+     * 백그라운드에서는 무음 스트림을 멈추고, 포그라운드로 돌아오면 warm-start를 다시 준비
+     * @param foreground 앱이 포그라운드이면 true
+     */
+    fun setAppInForeground(foreground: Boolean) {
+        if (isAppInForeground == foreground) return
+        isAppInForeground = foreground
+        
+        val path = warmStartTrackPath ?: return
+        if (foreground) {
+            preloadScope.launch {
+                nativePlayer.warmStart(path)
+            }
+        } else {
+            nativePlayer.disableWarmStart()
+        }
+    }
+    
     /**
      * 재생 시작
      */
@@ -158,6 +233,14 @@ class AudioPlayerManager {
         nativePlayer.setChannelCount(channelCount)
     }
     
+    /**
+     * 하드웨어 레이트 자동 전환 활성화/비활성화
+     * @param enable 활성화 여부
+     */
+    fun setAutoHardwareSwitching(enable: Boolean) {
+        nativePlayer.setAutoHardwareSwitching(enable)
+    }
+    
     /**
      * 볼륨 설정
      * @param volume 볼륨 (0.0 ~ 1.0)
@@ -243,5 +326,6 @@ class AudioPlayerManager {
     fun release() {
         stop()
         stopUpdates()
+        disableWarmStart()
     }
 }
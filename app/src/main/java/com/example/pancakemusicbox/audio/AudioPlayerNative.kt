@@ -6,6 +6,22 @@ package com.example.pancakemusicbox.audio
 class AudioPlayerNative private constructor() {
     
     companion object {
+        // 타임 스트레치 모드 (네이티브 TimeStretchMode와 동일한 값)
+        const val TIME_STRETCH_SPEECH = 0
+        const val TIME_STRETCH_MUSIC = 1
+        
+        // 크로스피드 프리셋 (네이티브 CrossfeedPreset과 동일한 값)
+        const val CROSSFEED_DEFAULT = 0
+        const val CROSSFEED_CHU_MOY = 1
+        const val CROSSFEED_JAN_MEIER = 2
+        
+        // 출력 방식 (네이티브 OutputMode와 동일한 값)
+        const val OUTPUT_MODE_CALLBACK = 0
+        const val OUTPUT_MODE_BLOCKING_WRITE = 1
+        
+        // getFanoutStats()에서 출력 하나가 차지하는 값 개수
+        const val FANOUT_STATS_SIZE = 9
+        
         // 라이브러리 로드 성공 여부
         private var nativeLibraryLoaded = false
         
@@ -145,6 +161,72 @@ class AudioPlayerNative private constructor() {
     
     private external fun nativeGetDuration(): Long
 
+    /**
+     * 다음/이전 트랙을 미리 디코딩하여 캐시에 저장
+     * 디코딩 작업이 오래 걸릴 수 있으므로 백그라운드 스레드에서 호출해야 함
+     * @param filePath 오디오 파일 경로
+     * @return 캐시 적재 성공 여부
+     */
+    fun preloadFile(filePath: String): Boolean {
+        return if (nativeLibraryLoaded) {
+            nativePreloadFile(filePath)
+        } else {
+            false
+        }
+    }
+    
+    private external fun nativePreloadFile(filePath: String): Boolean
+
+    /**
+     * 디코딩 캐시 메모리 예산 설정
+     * @param budgetBytes 바이트 단위 예산
+     */
+    fun setDecodedCacheBudget(budgetBytes: Long) {
+        if (nativeLibraryLoaded) {
+            nativeSetDecodedCacheBudget(budgetBytes)
+        }
+    }
+    
+    private external fun nativeSetDecodedCacheBudget(budgetBytes: Long)
+
+    /**
+     * 디코딩 캐시 압축 저장 (int16/float16) 사용 여부 설정
+     * @param compact 압축 저장 여부
+     */
+    fun setDecodedCacheCompact(compact: Boolean) {
+        if (nativeLibraryLoaded) {
+            nativeSetDecodedCacheCompact(compact)
+        }
+    }
+    
+    private external fun nativeSetDecodedCacheCompact(compact: Boolean)
+
+    /**
+     * 다음 트랙 파일 앞부분을 I/O 스레드에서 미리 읽음
+     * @param filePath 오디오 파일 경로
+     */
+    fun prefetchFile(filePath: String) {
+        if (nativeLibraryLoaded) {
+            nativePrefetchFile(filePath)
+        }
+    }
+    
+    private external fun nativePrefetchFile(filePath: String)
+
+    /**
+     * 현재 트랙의 I/O 통계 가져오기
+     * @return [읽은 바이트, I/O 대기 시간(us), stall 횟수, pread 횟수]
+     */
+    fun getIoStats(): LongArray {
+        return if (nativeLibraryLoaded) {
+            nativeGetIoStats() ?: LongArray(4)
+        } else {
+            LongArray(4)
+        }
+    }
+    
+    private external fun nativeGetIoStats(): LongArray?
+
     /**
      * 샘플링 레이트 설정
      * @param sampleRate 샘플링 레이트 (Hz)
@@ -242,6 +324,325 @@ class AudioPlayerNative private constructor() {
     
     private external fun nativeSetTargetLUFS(lufsValue: Float)
 
+    /**
+     * 볼륨 연동 라우드니스 보상 활성화/비활성화
+     * 볼륨을 낮췄을 때 덜 들리는 저역과 고역을 등청감 곡선에 맞춰 보강
+     * @param enable 활성화 여부
+     */
+    fun enableLoudnessCompensation(enable: Boolean) {
+        if (nativeLibraryLoaded) {
+            nativeEnableLoudnessCompensation(enable)
+        }
+    }
+    
+    private external fun nativeEnableLoudnessCompensation(enable: Boolean)
+
+    /**
+     * 나이트 모드 (3밴드 컴프레서) 활성화/비활성화
+     * 출퇴근, 야간 청취 시 큰 소리와 작은 소리의 차이를 줄임
+     * @param enable 활성화 여부
+     */
+    fun enableNightMode(enable: Boolean) {
+        if (nativeLibraryLoaded) {
+            nativeEnableNightMode(enable)
+        }
+    }
+    
+    private external fun nativeEnableNightMode(enable: Boolean)
+
+    /**
+     * 나이트 모드 공통 메이크업 게인 설정
+     * @param gainDb 메이크업 게인 (0 ~ 18 dB)
+     */
+    fun setNightModeMakeupGain(gainDb: Float) {
+        if (nativeLibraryLoaded) {
+            nativeSetNightModeMakeupGain(gainDb)
+        }
+    }
+    
+    private external fun nativeSetNightModeMakeupGain(gainDb: Float)
+
+    /**
+     * 나이트 모드 미터 (오디오 스레드를 막지 않고 읽음)
+     * @return [저역 GR(dB), 중역 GR(dB), 고역 GR(dB), 192프레임 블록 처리 시간(us), 예산 초과 횟수]
+     */
+    fun getNightModeMeters(): FloatArray {
+        return if (nativeLibraryLoaded) {
+            nativeGetNightModeMeters()
+        } else {
+            FloatArray(5)
+        }
+    }
+    
+    private external fun nativeGetNightModeMeters(): FloatArray
+
+    /**
+     * 재생 속도 설정 (피치 유지, 스트림 재시작 없이 다음 처리 블록부터 적용)
+     * @param speed 재생 배속 (0.5 ~ 3.0, 1.0은 원속도)
+     */
+    fun setPlaybackSpeed(speed: Float) {
+        if (nativeLibraryLoaded) {
+            nativeSetPlaybackSpeed(speed)
+        }
+    }
+    
+    private external fun nativeSetPlaybackSpeed(speed: Float)
+
+    /**
+     * 현재 재생 속도
+     * @return 재생 배속
+     */
+    fun getPlaybackSpeed(): Float {
+        return if (nativeLibraryLoaded) {
+            nativeGetPlaybackSpeed()
+        } else {
+            1.0f
+        }
+    }
+    
+    private external fun nativeGetPlaybackSpeed(): Float
+
+    /**
+     * 타임 스트레치 알고리즘 선택
+     * @param mode TIME_STRETCH_SPEECH (WSOLA, 강의/오디오북) 또는 TIME_STRETCH_MUSIC (위상 보코더)
+     */
+    fun setTimeStretchMode(mode: Int) {
+        if (nativeLibraryLoaded) {
+            nativeSetTimeStretchMode(mode)
+        }
+    }
+    
+    private external fun nativeSetTimeStretchMode(mode: Int)
+
+    /**
+     * 현재 속도에서 타임 스트레치 처리의 CPU 부하 (처리 시간 / 오디오 길이)
+     * @return 부하 비율 (0.01이면 실시간의 1%)
+     */
+    fun getTimeStretchLoad(): Float {
+        return if (nativeLibraryLoaded) {
+            nativeGetTimeStretchLoad()
+        } else {
+            0.0f
+        }
+    }
+    
+    private external fun nativeGetTimeStretchLoad(): Float
+
+    /**
+     * Bit-perfect 모드 활성화/비활성화
+     * 볼륨 1.0, EQ/정규화 off 상태에서 원본 샘플 레이트와 형식 그대로 출력
+     * @param enable 활성화 여부
+     */
+    fun enableBitPerfect(enable: Boolean) {
+        if (nativeLibraryLoaded) {
+            nativeEnableBitPerfect(enable)
+        }
+    }
+    
+    private external fun nativeEnableBitPerfect(enable: Boolean)
+
+    /**
+     * 현재 출력 경로가 실제로 bit-perfect인지 확인
+     * @return bit-perfect이면 true
+     */
+    fun isBitPerfect(): Boolean {
+        return if (nativeLibraryLoaded) {
+            nativeIsBitPerfect()
+        } else {
+            false
+        }
+    }
+    
+    private external fun nativeIsBitPerfect(): Boolean
+
+    /**
+     * bit-perfect 출력 바이트의 FNV-1a 체크섬 (트랙 로드/탐색 시 초기화)
+     * 원본 PCM의 체크섬과 비교하여 bit-perfect 여부를 검증하는 데 사용
+     */
+    fun getOutputChecksum(): Long {
+        return if (nativeLibraryLoaded) {
+            nativeGetOutputChecksum()
+        } else {
+            0L
+        }
+    }
+    
+    private external fun nativeGetOutputChecksum(): Long
+
+    /**
+     * warm-start: 출력 스트림을 무음 상태로 열어 유지하고 첫 트랙을 디코딩 캐시에 미리 준비
+     * 호출한 경우에만 스트림이 열리며, 재생 없이 30초가 지나면 네이티브에서 무음 스트림을 멈춤
+     * 디코딩 작업이 오래 걸릴 수 있으므로 백그라운드 스레드에서 호출해야 함
+     * @param firstTrackPath 첫 재생이 예상되는 트랙 경로 (빈 문자열이면 스트림만 준비)
+     */
+    fun warmStart(firstTrackPath: String) {
+        if (nativeLibraryLoaded) {
+            nativeWarmStart(firstTrackPath)
+        }
+    }
+    
+    private external fun nativeWarmStart(firstTrackPath: String)
+
+    /**
+     * warm-start 해제 (재생 중이 아니면 무음 스트림을 멈춰 전력 소모 방지)
+     */
+    fun disableWarmStart() {
+        if (nativeLibraryLoaded) {
+            nativeDisableWarmStart()
+        }
+    }
+    
+    private external fun nativeDisableWarmStart()
+
+    /**
+     * 절전 deep-buffer 모드 활성화/비활성화
+     * 활성화하면 플레이어 UI가 보이지 않는 동안 PowerSaving 스트림과 큰 버퍼로 재생하여 CPU 깨어남을 줄임
+     * @param enable 활성화 여부
+     */
+    fun enableDeepBuffer(enable: Boolean) {
+        if (nativeLibraryLoaded) {
+            nativeEnableDeepBuffer(enable)
+        }
+    }
+    
+    private external fun nativeEnableDeepBuffer(enable: Boolean)
+
+    /**
+     * 플레이어 UI 표시 여부 (화면 꺼짐/백그라운드 전환 시 false)
+     * deep-buffer 모드에서는 UI가 보이면 저지연 스트림으로 끊김 없이 전환
+     * @param visible UI 표시 여부
+     */
+    fun setPlayerUiVisible(visible: Boolean) {
+        if (nativeLibraryLoaded) {
+            nativeSetPlayerUiVisible(visible)
+        }
+    }
+    
+    private external fun nativeSetPlayerUiVisible(visible: Boolean)
+
+    /**
+     * 성능 모드별 전력 지표
+     * @return [저지연: 분당 깨어남, 시간당 CPU(초), 재생 시간(분),
+     *          deep buffer: 분당 깨어남, 시간당 CPU(초), 재생 시간(분), 현재 deep buffer 여부(1/0)]
+     */
+    fun getPowerStats(): FloatArray {
+        return if (nativeLibraryLoaded) {
+            nativeGetPowerStats()
+        } else {
+            FloatArray(7)
+        }
+    }
+    
+    private external fun nativeGetPowerStats(): FloatArray
+
+    /**
+     * 하드웨어 레이트 자동 전환 활성화/비활성화
+     * 활성화하면 트랙마다 출력을 원본 샘플레이트/형식으로 재구성 (새 스트림을 먼저 열어 전환 공백 최소화)
+     * 비활성화하거나 기기가 레이트를 지원하지 않으면 리샘플러로 변환
+     * @param enable 활성화 여부
+     */
+    fun setAutoHardwareSwitching(enable: Boolean) {
+        if (nativeLibraryLoaded) {
+            nativeSetAutoHardwareSwitching(enable)
+        }
+    }
+    
+    private external fun nativeSetAutoHardwareSwitching(enable: Boolean)
+
+    /**
+     * 보조 출력 장치 추가 (주 출력과 동시에 재생, 예: 내장 스피커 + USB DAC)
+     * 장치마다 링 버퍼와 비동기 리샘플러로 클럭 차이를 보정
+     * @param deviceId AudioDeviceInfo.id (0이면 기본 장치)
+     * @return 출력 id (실패 시 -1)
+     */
+    fun addOutputDevice(deviceId: Int): Int {
+        return if (nativeLibraryLoaded) {
+            nativeAddOutputDevice(deviceId)
+        } else {
+            -1
+        }
+    }
+    
+    private external fun nativeAddOutputDevice(deviceId: Int): Int
+
+    /**
+     * 장치 없이 자체 클럭으로 소비하는 null 출력 추가 (녹음/진단용)
+     * @param sampleRate 출력 샘플레이트
+     * @param clockPpm 시뮬레이션할 클럭 오차 (ppm)
+     * @return 출력 id
+     */
+    fun addNullOutput(sampleRate: Int, clockPpm: Float): Int {
+        return if (nativeLibraryLoaded) {
+            nativeAddNullOutput(sampleRate, clockPpm)
+        } else {
+            -1
+        }
+    }
+    
+    private external fun nativeAddNullOutput(sampleRate: Int, clockPpm: Float): Int
+
+    /**
+     * 보조 출력 제거
+     * @param outputId addOutputDevice/addNullOutput이 반환한 id
+     * @return 제거 여부
+     */
+    fun removeOutput(outputId: Int): Boolean {
+        return if (nativeLibraryLoaded) {
+            nativeRemoveOutput(outputId)
+        } else {
+            false
+        }
+    }
+    
+    private external fun nativeRemoveOutput(outputId: Int): Boolean
+
+    /**
+     * 보조 출력별 동기화 상태
+     * @return 출력마다 FANOUT_STATS_SIZE개씩 [id, 샘플레이트, null 싱크 여부(1/0), 버퍼 양(ms), 목표 버퍼 양(ms),
+     *          레이트 보정(ppm), 언더런 횟수, 오버플로 횟수, 재동기화 횟수]
+     */
+    fun getFanoutStats(): FloatArray {
+        return if (nativeLibraryLoaded) {
+            nativeGetFanoutStats()
+        } else {
+            FloatArray(0)
+        }
+    }
+    
+    private external fun nativeGetFanoutStats(): FloatArray
+
+    /**
+     * 출력 방식 선택 (스트림을 다시 열어 적용)
+     * 콜백 스케줄링이 불안정한 기기에서는 전용 렌더 스레드의 블로킹 쓰기 방식을 사용
+     * @param mode OUTPUT_MODE_CALLBACK 또는 OUTPUT_MODE_BLOCKING_WRITE
+     * @param burstsInFlight 블로킹 쓰기 모드에서 버퍼에 유지할 버스트 수 (1 ~ 8)
+     */
+    fun setOutputMode(mode: Int, burstsInFlight: Int = 2) {
+        if (nativeLibraryLoaded) {
+            nativeSetOutputMode(mode, burstsInFlight)
+        }
+    }
+    
+    private external fun nativeSetOutputMode(mode: Int, burstsInFlight: Int)
+
+    /**
+     * 출력 지연 및 언더런 지표 (두 출력 방식에서 동일하게 측정, 기기별 방식 선택용)
+     * @return [출력 방식, 버스트 프레임, 버퍼 프레임, 버스트 수, 지연(ms), 언더런 횟수,
+     *          최근 렌더링 시간(us), 최대 렌더링 시간(us), 실시간 스레드 여부(1/0),
+     *          탭→소리 지연(ms, 측정 전이면 -1), 트랙 로드 시간(ms), warm-start 여부(1/0),
+     *          하드웨어 레이트 자동 전환 여부(1/0), 리샘플링 여부(1/0), 스트림 재구성 횟수,
+     *          새 스트림 열기 시간(ms), 전환 공백(ms)]
+     */
+    fun getOutputMetrics(): FloatArray {
+        return if (nativeLibraryLoaded) {
+            nativeGetOutputMetrics()
+        } else {
+            FloatArray(17)
+        }
+    }
+    
+    private external fun nativeGetOutputMetrics(): FloatArray
+
     /**
      * 하드웨어에 맞게 오디오 엔진 최적화
      * @param useHeadphones 헤드폰 사용 여부
@@ -255,6 +656,44 @@ class AudioPlayerNative private constructor() {
     
     private external fun nativeOptimizeForDevice(useHeadphones: Boolean, isHighPerformanceDevice: Boolean)
 
+    /**
+     * 헤드폰 크로스피드 프리셋 설정 (헤드폰 출력일 때 자동 적용)
+     * @param preset CROSSFEED_DEFAULT, CROSSFEED_CHU_MOY, CROSSFEED_JAN_MEIER 중 하나
+     */
+    fun setCrossfeedPreset(preset: Int) {
+        if (nativeLibraryLoaded) {
+            nativeSetCrossfeedPreset(preset)
+        }
+    }
+    
+    private external fun nativeSetCrossfeedPreset(preset: Int)
+
+    /**
+     * 크로스피드 A/B 비교용 바이패스 (짧은 크로스페이드로 끊김 없이 전환)
+     * @param bypass true이면 크로스피드 없이 원음 출력
+     */
+    fun setCrossfeedBypass(bypass: Boolean) {
+        if (nativeLibraryLoaded) {
+            nativeSetCrossfeedBypass(bypass)
+        }
+    }
+    
+    private external fun nativeSetCrossfeedBypass(bypass: Boolean)
+
+    /**
+     * 크로스피드가 현재 출력에 적용 중인지 확인
+     * @return 적용 중이면 true
+     */
+    fun isCrossfeedActive(): Boolean {
+        return if (nativeLibraryLoaded) {
+            nativeIsCrossfeedActive()
+        } else {
+            false
+        }
+    }
+    
+    private external fun nativeIsCrossfeedActive(): Boolean
+
     /**
      * 시각화 데이터 가져오기
      * @return 시각화 데이터 배열 (0.0 ~ 1.0 범위의 값들)
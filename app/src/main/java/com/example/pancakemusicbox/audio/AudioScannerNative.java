@@ -22,12 +22,26 @@ public class AudioScannerNative {
         void onProgress(int current, int total);
     }
 
+    // 라이브러리 변경 리스너 인터페이스 (감시 스레드에서 호출됨)
+    public interface LibraryChangeListener {
+        // rescanned가 true면 경로 목록 없이 전체를 다시 읽어야 함
+        void onLibraryChanged(String[] updatedPaths, String[] removedPaths, boolean rescanned);
+    }
+
+    // 라이브러리 감시 상태
+    public static final int WATCH_MODE_STOPPED = 0;
+    public static final int WATCH_MODE_INOTIFY = 1;
+    public static final int WATCH_MODE_POLLING = 2;
+
     // 싱글톤 인스턴스
     private static AudioScannerNative instance;
     
     // 프로그레스 리스너
     private static ScanProgressListener progressListener;
 
+    // 라이브러리 변경 리스너
+    private static LibraryChangeListener libraryChangeListener;
+
     // 생성자 (비공개)
     private AudioScannerNative() {
         try {
@@ -60,6 +74,18 @@ public class AudioScannerNative {
         }
     }
 
+    // 라이브러리 변경 리스너 설정
+    public void setLibraryChangeListener(LibraryChangeListener listener) {
+        libraryChangeListener = listener;
+    }
+
+    // 네이티브 감시 스레드에서 호출하는 변경 콜백 메서드 (변경 묶음당 한 번)
+    public static void onLibraryChanged(String[] updatedPaths, String[] removedPaths, boolean rescanned) {
+        if (libraryChangeListener != null) {
+            libraryChangeListener.onLibraryChanged(updatedPaths, removedPaths, rescanned);
+        }
+    }
+
     // 디렉토리 스캔
     public boolean scanDirectory(String directoryPath) {
         Log.d(TAG, "Scanning directory: " + directoryPath);
@@ -96,6 +122,64 @@ public class AudioScannerNative {
         }
     }
 
+    // 디렉토리 스캔 작업자 스레드 수 설정 (0이면 코어 수 기준 자동)
+    public void setScanThreadCount(int threadCount) {
+        try {
+            nativeSetScanThreadCount(threadCount);
+        } catch (UnsatisfiedLinkError e) {
+            Log.e(TAG, "Native library error setting scan thread count: " + e.getMessage());
+        }
+    }
+    
+    // 실제로 사용할 디렉토리 스캔 작업자 스레드 수
+    public int getScanThreadCount() {
+        try {
+            return nativeGetScanThreadCount();
+        } catch (UnsatisfiedLinkError e) {
+            Log.e(TAG, "Native library error getting scan thread count: " + e.getMessage());
+            return 1;
+        }
+    }
+    
+    // 앨범 아트 캐시 디렉토리 설정 (설정 후 스캔하는 트랙은 포함된 그림/폴더 아트 경로를 albumArtPath로 가짐)
+    public boolean setArtworkCacheDirectory(String directoryPath) {
+        try {
+            return nativeSetArtworkCacheDirectory(directoryPath);
+        } catch (UnsatisfiedLinkError e) {
+            Log.e(TAG, "Native library error setting artwork cache directory: " + e.getMessage());
+            return false;
+        }
+    }
+    
+    // 스캔한 디렉토리들의 변경 감시 시작 (바뀐 파일만 반영하고 LibraryChangeListener로 알림)
+    public boolean startWatching(String[] directoryPaths) {
+        try {
+            return nativeStartWatching(directoryPaths);
+        } catch (UnsatisfiedLinkError e) {
+            Log.e(TAG, "Native library error starting library watcher: " + e.getMessage());
+            return false;
+        }
+    }
+    
+    // 변경 감시 중지
+    public void stopWatching() {
+        try {
+            nativeStopWatching();
+        } catch (UnsatisfiedLinkError e) {
+            Log.e(TAG, "Native library error stopping library watcher: " + e.getMessage());
+        }
+    }
+    
+    // 변경 감시 상태 (WATCH_MODE_*)
+    public int getWatchMode() {
+        try {
+            return nativeGetWatchMode();
+        } catch (UnsatisfiedLinkError e) {
+            Log.e(TAG, "Native library error getting watch mode: " + e.getMessage());
+            return WATCH_MODE_STOPPED;
+        }
+    }
+    
     // 파일 스캔
     public boolean scanFile(String filePath) {
         Log.d(TAG, "Scanning file: " + filePath);
@@ -130,6 +214,18 @@ public class AudioScannerNative {
         }
     }
     
+    // 라이브러리 트랙들이 쓰는 앨범 아트 경로 (중복 제외, 트랙을 복사하지 않음)
+    public String[] getAlbumArtPaths() {
+        try {
+            String[] paths = nativeGetAlbumArtPaths();
+            return paths != null ? paths : new String[0];
+        } catch (Exception e) {
+            Log.e(TAG, "Error getting album art paths: " + e.getMessage());
+            e.printStackTrace();
+            return new String[0];
+        }
+    }
+    
     // 장르별 트랙 가져오기
     public Map<String, List<Track>> getTracksByGenre() {
         try {
@@ -141,6 +237,19 @@ public class AudioScannerNative {
         }
     }
     
+    // 패싯 조건을 모두 만족하는 트랙 가져오기 (null/빈 문자열과 0은 조건 없음)
+    public List<Track> queryTracks(String genre, String artist, String album, int year,
+                                   String format, boolean highResOnly) {
+        try {
+            return nativeQueryTracks(genre != null ? genre : "", artist != null ? artist : "",
+                    album != null ? album : "", year, format != null ? format : "", highResOnly);
+        } catch (Exception e) {
+            Log.e(TAG, "Error querying tracks: " + e.getMessage());
+            e.printStackTrace();
+            return new ArrayList<>();
+        }
+    }
+    
     // 최근 재생 트랙 가져오기
     public List<Track> getRecentlyPlayedTracks(int limit) {
         try {
@@ -219,9 +328,18 @@ public class AudioScannerNative {
     // 네이티브 메소드 선언
     private native boolean nativeScanDirectory(String directoryPath);
     private native boolean nativeScanFile(String filePath);
+    private native void nativeSetScanThreadCount(int threadCount);
+    private native int nativeGetScanThreadCount();
+    private native boolean nativeSetArtworkCacheDirectory(String directoryPath);
+    private native boolean nativeStartWatching(String[] directoryPaths);
+    private native void nativeStopWatching();
+    private native int nativeGetWatchMode();
     private native Track nativeGetTrackById(String trackId);
     private native List<Track> nativeGetAllTracks();
     private native Map<String, List<Track>> nativeGetTracksByGenre();
+    private native String[] nativeGetAlbumArtPaths();
+    private native List<Track> nativeQueryTracks(String genre, String artist, String album, int year,
+                                                 String format, boolean highResOnly);
     private native List<Track> nativeGetRecentlyPlayedTracks(int limit);
     private native List<Track> nativeGetFrequentlyPlayedTracks(int limit);
     private native List<Track> nativeGetRecentlyAddedTracks(int limit);
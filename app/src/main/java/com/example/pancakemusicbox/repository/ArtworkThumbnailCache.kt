@@ -0,0 +1,135 @@
+package com.example.pancakemusicbox.repository
+
+import android.content.Context
+import android.graphics.Bitmap
+import android.graphics.BitmapFactory
+import android.util.Log
+import kotlinx.coroutines.flow.MutableStateFlow
+import kotlinx.coroutines.flow.StateFlow
+import kotlinx.coroutines.flow.asStateFlow
+import kotlinx.coroutines.flow.update
+import java.io.File
+import java.io.FileOutputStream
+
+/**
+ * UI 그리드/목록 크기로 미리 줄여 둔 앨범 아트 썸네일 디스크 캐시
+ * 원본은 네이티브 스캐너가 내용 해시로 저장한 그림(또는 폴더 아트)이고,
+ * 썸네일은 원본마다 크기별로 한 번만 만들어 스크롤 중에 큰 이미지를 디코딩하지 않게 함
+ */
+class ArtworkThumbnailCache private constructor(context: Context) {
+    companion object {
+        private const val TAG = "ArtworkThumbnailCache"
+        private const val THUMBNAIL_DIRNAME = "artwork_thumbs"
+        private const val JPEG_QUALITY = 85
+
+        // 목록 행 (48dp, xxxhdpi 기준)
+        const val LIST_SIZE_PX = 192
+        // 2열 앨범 그리드 셀
+        const val GRID_SIZE_PX = 512
+        private val SIZES_PX = intArrayOf(LIST_SIZE_PX, GRID_SIZE_PX)
+
+        @Volatile
+        private var instance: ArtworkThumbnailCache? = null
+
+        @JvmStatic
+        fun getInstance(context: Context): ArtworkThumbnailCache {
+            return instance ?: synchronized(this) {
+                instance ?: ArtworkThumbnailCache(context.applicationContext).also { instance = it }
+            }
+        }
+    }
+
+    private val thumbnailDir = File(context.cacheDir, THUMBNAIL_DIRNAME)
+
+    // 새 썸네일을 만들 때마다 증가 (화면이 아직 없던 썸네일을 다시 찾도록)
+    private val _generation = MutableStateFlow(0)
+    val generation: StateFlow<Int> = _generation.asStateFlow()
+
+    // 썸네일 파일 경로 (원본이 내용 해시 이름이면 그대로 쓰고, 폴더 아트는 경로와 수정 시간으로 구분)
+    private fun thumbnailFile(source: File, sizePx: Int): File {
+        val key = if (source.nameWithoutExtension.length == 16 && source.parentFile?.name == MusicRepository.ARTWORK_DIRNAME) {
+            source.nameWithoutExtension
+        } else {
+            Integer.toHexString(source.absolutePath.hashCode()) + "-" + java.lang.Long.toHexString(source.lastModified() / 1000)
+        }
+        return File(thumbnailDir, "${key}_$sizePx.jpg")
+    }
+
+    // 화면에 표시할 썸네일 경로 (아트가 없거나 썸네일이 아직 없으면 null)
+    // 파일 시스템을 확인하므로 메인 스레드가 아닌 곳(Dispatchers.IO)에서 호출
+    fun resolve(artworkPath: String, sizePx: Int): String? {
+        if (artworkPath.isEmpty()) return null
+        val thumbnail = thumbnailFile(File(artworkPath), sizePx)
+        return if (thumbnail.exists()) thumbnail.absolutePath else null
+    }
+
+    // 아직 썸네일이 없는 원본들의 썸네일 생성 (스캔 스레드에서 호출)
+    // 반환: 새로 만든 썸네일 수
+    fun generate(artworkPaths: Collection<String>): Int {
+        if (!thumbnailDir.exists() && !thumbnailDir.mkdirs()) {
+            Log.e(TAG, "Cannot create thumbnail directory: ${thumbnailDir.absolutePath}")
+            return 0
+        }
+
+        var created = 0
+        for (path in artworkPaths) {
+            if (path.isEmpty()) continue
+            val source = File(path)
+            val missingSizes = SIZES_PX.filter { !thumbnailFile(source, it).exists() }
+            if (missingSizes.isEmpty() || !source.exists()) continue
+
+            // 원본은 한 번만 디코딩하고 큰 크기부터 줄임
+            val bitmap = decodeSampled(source, missingSizes.maxOrNull() ?: continue) ?: continue
+            for (sizePx in missingSizes.sortedDescending()) {
+                if (writeThumbnail(bitmap, sizePx, thumbnailFile(source, sizePx))) created++
+            }
+            bitmap.recycle()
+        }
+        if (created > 0) {
+            Log.d(TAG, "Created $created artwork thumbnails")
+            _generation.update { it + 1 }
+        }
+        return created
+    }
+
+    // 짧은 변이 sizePx 이상으로 남는 가장 큰 2의 거듭제곱 배율로 디코딩 (전체 해상도 디코딩을 피함)
+    private fun decodeSampled(source: File, sizePx: Int): Bitmap? {
+        val bounds = BitmapFactory.Options().apply { inJustDecodeBounds = true }
+        BitmapFactory.decodeFile(source.absolutePath, bounds)
+        if (bounds.outWidth <= 0 || bounds.outHeight <= 0) {
+            Log.e(TAG, "Cannot decode artwork: ${source.absolutePath}")
+            return null
+        }
+
+        var sampleSize = 1
+        while (minOf(bounds.outWidth, bounds.outHeight) / (sampleSize * 2) >= sizePx) {
+            sampleSize *= 2
+        }
+        val options = BitmapFactory.Options().apply { inSampleSize = sampleSize }
+        return BitmapFactory.decodeFile(source.absolutePath, options)
+    }
+
+    // 짧은 변을 sizePx로 맞춰 JPEG로 저장 (임시 파일에 쓴 뒤 이름 변경)
+    private fun writeThumbnail(bitmap: Bitmap, sizePx: Int, target: File): Boolean {
+        val shortSide = minOf(bitmap.width, bitmap.height)
+        val scaled = if (shortSide > sizePx) {
+            val scale = sizePx.toFloat() / shortSide
+            Bitmap.createScaledBitmap(bitmap, (bitmap.width * scale).toInt().coerceAtLeast(1),
+                (bitmap.height * scale).toInt().coerceAtLeast(1), true)
+        } else {
+            bitmap
+        }
+
+        val tempFile = File(target.parentFile, target.name + ".tmp")
+        return try {
+            FileOutputStream(tempFile).use { scaled.compress(Bitmap.CompressFormat.JPEG, JPEG_QUALITY, it) } &&
+                tempFile.renameTo(target)
+        } catch (e: Exception) {
+            Log.e(TAG, "Error writing thumbnail: ${target.absolutePath}", e)
+            false
+        } finally {
+            tempFile.delete()
+            if (scaled !== bitmap) scaled.recycle()
+        }
+    }
+}
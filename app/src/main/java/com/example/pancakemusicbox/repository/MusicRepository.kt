@@ -20,6 +20,8 @@ class MusicRepository private constructor(private val context: Context) {
     companion object {
         private const val TAG = "MusicRepository"
         private const val DB_FILENAME = "music_database.db"
+        // 네이티브 스캐너가 내용 해시 이름으로 앨범 아트를 저장하는 디렉토리 (filesDir 아래)
+        const val ARTWORK_DIRNAME = "artwork"
 
         // 싱글톤 인스턴스
         @Volatile
@@ -36,6 +38,9 @@ class MusicRepository private constructor(private val context: Context) {
     // 네이티브 스캐너 인스턴스
     private val scanner = AudioScannerNative.getInstance()
 
+    // 미리 줄여 둔 앨범 아트 썸네일
+    private val thumbnailCache = ArtworkThumbnailCache.getInstance(context)
+
     // 현재 재생 중인 트랙
     private val currentlyPlayingTrack = MutableLiveData<Track>()
 
@@ -70,6 +75,19 @@ class MusicRepository private constructor(private val context: Context) {
             scanProgress.postValue(progressPercent)
         }
 
+        // 감시 중인 폴더에서 파일이 바뀌면 (감시 스레드에서 한 묶음씩) 저장 후 새로고침
+        scanner.setLibraryChangeListener { updatedPaths, removedPaths, rescanned ->
+            Log.d(TAG, "Library changed: ${updatedPaths.size} updated, ${removedPaths.size} removed, rescanned=$rescanned")
+            saveDatabase()
+            updateThumbnails()
+            refreshData()
+        }
+
+        // 스캔하면서 포함된 앨범 아트를 추출해 저장
+        if (!scanner.setArtworkCacheDirectory(File(context.filesDir, ARTWORK_DIRNAME).absolutePath)) {
+            Log.e(TAG, "Failed to set artwork cache directory")
+        }
+
         // 데이터베이스 로드
         loadDatabase()
     }
@@ -103,6 +121,11 @@ class MusicRepository private constructor(private val context: Context) {
         }
     }
 
+    // 새로 생긴 앨범 아트의 썸네일 생성 (네이티브에서 중복을 뺀 아트 경로만 받아 트랙 목록은 복사하지 않음)
+    private fun updateThumbnails() {
+        thumbnailCache.generate(scanner.getAlbumArtPaths().asList())
+    }
+
     // 데이터 새로고침
     private fun refreshData() {
         // 모든 트랙 목록 업데이트
@@ -171,8 +194,19 @@ class MusicRepository private constructor(private val context: Context) {
                 
                 // 스캔 완료 후 데이터베이스 저장 및 데이터 새로고침
                 saveDatabase()
+                updateThumbnails()
                 refreshData()
                 Log.d(TAG, "Scan completed")
+                
+                // 이후 변경은 전체 재스캔 없이 감시 스레드가 반영
+                val watchedDirs = listOfNotNull(
+                    externalMusicDir,
+                    downloadDir,
+                    context.getExternalFilesDir(Environment.DIRECTORY_MUSIC)?.absolutePath
+                )
+                if (!scanner.startWatching(watchedDirs.toTypedArray())) {
+                    Log.e(TAG, "Failed to start library watcher")
+                }
             } catch (e: Exception) {
                 Log.e(TAG, "Error during music directory scanning", e)
             }
@@ -185,6 +219,7 @@ class MusicRepository private constructor(private val context: Context) {
             val success = scanner.scanDirectory(directoryPath)
             if (success) {
                 saveDatabase()
+                updateThumbnails()
                 refreshData()
             }
         }.start()
@@ -196,6 +231,7 @@ class MusicRepository private constructor(private val context: Context) {
             val success = scanner.scanFile(filePath)
             if (success) {
                 saveDatabase()
+                updateThumbnails()
                 refreshData()
             }
         }.start()
@@ -1,7 +1,11 @@
 package com.example.pancakemusicbox.ui
 
 import androidx.compose.runtime.Composable
+import androidx.compose.runtime.DisposableEffect
 import androidx.compose.runtime.remember
+import androidx.compose.ui.platform.LocalLifecycleOwner
+import androidx.lifecycle.Lifecycle
+import androidx.lifecycle.LifecycleEventObserver
 import androidx.lifecycle.viewmodel.compose.viewModel
 import androidx.navigation.compose.rememberNavController
 import com.example.pancakemusicbox.ui.components.player.PlayerUI
@@ -26,6 +30,22 @@ fun HiFiPlayerApp() {
     val rememberedAudioViewModel = remember { audioViewModel }
     val rememberedMusicViewModel = remember { musicViewModel }
     
+    // 앱이 백그라운드로 가면 warm-start 무음 스트림을 멈추고 돌아오면 다시 준비
+    val lifecycleOwner = LocalLifecycleOwner.current
+    DisposableEffect(lifecycleOwner) {
+        val observer = LifecycleEventObserver { _, event ->
+            when (event) {
+                Lifecycle.Event.ON_START -> rememberedAudioViewModel.onAppForegroundChanged(true)
+                Lifecycle.Event.ON_STOP -> rememberedAudioViewModel.onAppForegroundChanged(false)
+                else -> Unit
+            }
+        }
+        lifecycleOwner.lifecycle.addObserver(observer)
+        onDispose {
+            lifecycleOwner.lifecycle.removeObserver(observer)
+        }
+    }
+    
     HiFiPlayerTheme {
         // PlayerUI를 통해 앱의 모든 UI 컴포넌트 구성
         PlayerUI(
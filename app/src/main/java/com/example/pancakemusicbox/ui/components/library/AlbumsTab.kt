@@ -9,6 +9,7 @@ import androidx.compose.foundation.layout.PaddingValues
 import androidx.compose.foundation.layout.Row
 import androidx.compose.foundation.layout.Spacer
 import androidx.compose.foundation.layout.aspectRatio
+import androidx.compose.foundation.layout.fillMaxSize
 import androidx.compose.foundation.layout.fillMaxWidth
 import androidx.compose.foundation.layout.height
 import androidx.compose.foundation.layout.padding
@@ -23,16 +24,20 @@ import androidx.compose.material3.Icon
 import androidx.compose.material3.MaterialTheme
 import androidx.compose.material3.Text
 import androidx.compose.runtime.Composable
+import androidx.compose.runtime.getValue
 import androidx.compose.ui.Alignment
 import androidx.compose.ui.Modifier
 import androidx.compose.ui.draw.clip
+import androidx.compose.ui.layout.ContentScale
 import androidx.compose.ui.res.painterResource
 import androidx.compose.ui.text.style.TextAlign
 import androidx.compose.ui.text.style.TextOverflow
 import androidx.compose.ui.unit.dp
+import coil.compose.AsyncImage
 import com.example.pancakemusicbox.R
 import com.example.pancakemusicbox.model.Album
 import com.example.pancakemusicbox.model.Track
+import com.example.pancakemusicbox.repository.ArtworkThumbnailCache
 import com.example.pancakemusicbox.ui.theme.HighResAudio
 import java.util.UUID
 
@@ -91,13 +96,23 @@ fun AlbumGridItem(
                 .background(MaterialTheme.colorScheme.primary.copy(alpha = 0.1f)),
             contentAlignment = Alignment.Center
         ) {
-            // 실제로는 Coil로 실제 이미지 로드
-            Icon(
-                painter = painterResource(id = R.drawable.ic_placeholder),
-                contentDescription = null,
-                modifier = Modifier.size(40.dp),
-                tint = MaterialTheme.colorScheme.primary
-            )
+            // 그리드 크기로 미리 줄여 둔 썸네일 (아트가 없거나 썸네일을 찾는 중이면 기본 아이콘)
+            val artworkPath by rememberArtworkThumbnail(album.getArtworkUri(), ArtworkThumbnailCache.GRID_SIZE_PX)
+            if (artworkPath != null) {
+                AsyncImage(
+                    model = artworkPath,
+                    contentDescription = null,
+                    contentScale = ContentScale.Crop,
+                    modifier = Modifier.fillMaxSize()
+                )
+            } else {
+                Icon(
+                    painter = painterResource(id = R.drawable.ic_placeholder),
+                    contentDescription = null,
+                    modifier = Modifier.size(40.dp),
+                    tint = MaterialTheme.colorScheme.primary
+                )
+            }
             
             // 하이레스 오디오 인디케이터 (앨범의 모든 트랙이 하이레스인 경우)
             if (album.getTracks().all { it.isHighRes }) {
@@ -0,0 +1,28 @@
+package com.example.pancakemusicbox.ui.components.library
+
+import androidx.compose.runtime.Composable
+import androidx.compose.runtime.State
+import androidx.compose.runtime.collectAsState
+import androidx.compose.runtime.produceState
+import androidx.compose.ui.platform.LocalContext
+import com.example.pancakemusicbox.repository.ArtworkThumbnailCache
+import kotlinx.coroutines.Dispatchers
+import kotlinx.coroutines.withContext
+
+/**
+ * 목록/그리드에 표시할 앨범 아트 썸네일 경로
+ * 썸네일 파일 확인은 Dispatchers.IO에서 하고, 찾기 전이나 썸네일이 아직 없으면 null (호출자는 기본 아이콘 표시)
+ * 원본 크기 그림으로 대신하지 않으며, 스캔 스레드가 썸네일을 새로 만들면 다시 찾음
+ * @param artworkPath 원본 앨범 아트 경로 (없으면 빈 문자열)
+ * @param sizePx ArtworkThumbnailCache.LIST_SIZE_PX 또는 GRID_SIZE_PX
+ */
+@Composable
+fun rememberArtworkThumbnail(artworkPath: String, sizePx: Int): State<String?> {
+    val thumbnailCache = ArtworkThumbnailCache.getInstance(LocalContext.current)
+    val generation = thumbnailCache.generation.collectAsState()
+    return produceState<String?>(initialValue = null, artworkPath, sizePx, generation.value) {
+        value = withContext(Dispatchers.IO) {
+            thumbnailCache.resolve(artworkPath, sizePx)
+        }
+    }
+}
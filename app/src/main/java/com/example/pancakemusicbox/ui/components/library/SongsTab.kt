@@ -7,6 +7,7 @@ import androidx.compose.foundation.layout.Box
 import androidx.compose.foundation.layout.Column
 import androidx.compose.foundation.layout.Row
 import androidx.compose.foundation.layout.Spacer
+import androidx.compose.foundation.layout.fillMaxSize
 import androidx.compose.foundation.layout.fillMaxWidth
 import androidx.compose.foundation.layout.height
 import androidx.compose.foundation.layout.padding
@@ -21,14 +22,18 @@ import androidx.compose.material3.Icon
 import androidx.compose.material3.MaterialTheme
 import androidx.compose.material3.Text
 import androidx.compose.runtime.Composable
+import androidx.compose.runtime.getValue
 import androidx.compose.ui.Alignment
 import androidx.compose.ui.Modifier
 import androidx.compose.ui.draw.clip
+import androidx.compose.ui.layout.ContentScale
 import androidx.compose.ui.res.painterResource
 import androidx.compose.ui.text.style.TextOverflow
 import androidx.compose.ui.unit.dp
+import coil.compose.AsyncImage
 import com.example.pancakemusicbox.R
 import com.example.pancakemusicbox.model.Track
+import com.example.pancakemusicbox.repository.ArtworkThumbnailCache
 import com.example.pancakemusicbox.ui.theme.HighResAudio
 
 /**
@@ -58,13 +63,23 @@ fun SongListItem(
                 .background(MaterialTheme.colorScheme.primary.copy(alpha = 0.2f)),
             contentAlignment = Alignment.Center
         ) {
-            // 실제로는 Coil로 이미지 로드
-            Icon(
-                painter = painterResource(id = R.drawable.ic_placeholder),
-                contentDescription = null,
-                modifier = Modifier.size(24.dp),
-                tint = MaterialTheme.colorScheme.primary
-            )
+            // 목록 행 크기로 미리 줄여 둔 썸네일 (아트가 없거나 썸네일을 찾는 중이면 기본 아이콘)
+            val artworkPath by rememberArtworkThumbnail(track.getAlbumArtUri(), ArtworkThumbnailCache.LIST_SIZE_PX)
+            if (artworkPath != null) {
+                AsyncImage(
+                    model = artworkPath,
+                    contentDescription = null,
+                    contentScale = ContentScale.Crop,
+                    modifier = Modifier.fillMaxSize()
+                )
+            } else {
+                Icon(
+                    painter = painterResource(id = R.drawable.ic_placeholder),
+                    contentDescription = null,
+                    modifier = Modifier.size(24.dp),
+                    tint = MaterialTheme.colorScheme.primary
+                )
+            }
         }
         
         Spacer(modifier = Modifier.width(16.dp))
@@ -64,6 +64,7 @@ fun PlayerTabContent(
                             )
                             "volumeNormalization" -> audioViewModel.toggleVolumeNormalization()
                             "targetLufs" -> audioViewModel.setTargetLufs(value as Int)
+                            "autoHardwareSwitching" -> audioViewModel.setAutoHardwareSwitching(value as Boolean)
                             // 기타 설정 처리
                         }
                     }
@@ -57,9 +57,21 @@ class AudioPlayerViewModel : ViewModel() {
         if (tracks.isNotEmpty() && initialIndex in tracks.indices) {
             _currentTrackIndex.value = initialIndex
             _currentTrack.value = tracks[initialIndex]
+            
+            // 대기열의 첫 트랙으로 출력 스트림과 디코딩 캐시를 미리 준비
+            playerManager.enableWarmStart(tracks[initialIndex].getFilePath())
         }
     }
     
+    /**
+     * 앱 포그라운드/백그라운드 전환 처리
+     * 백그라운드에서는 warm-start 무음 스트림을 멈춤
+     * @param foreground 앱이 포그라운드이면 true
+     */
+    fun onAppForegroundChanged(foreground: Boolean) {
+        playerManager.setAppInForeground(foreground)
+    }
+    
     /**
      * 특정 트랙 로드 및 재생
      * @param index 플레이리스트 내 트랙 인덱스
@@ -216,6 +228,14 @@ class AudioPlayerViewModel : ViewModel() {
         playerManager.setAudioQuality(sampleRate, bitDepth, channelCount)
     }
     
+    /**
+     * 하드웨어 레이트 자동 전환 설정
+     * @param enable 활성화 여부
+     */
+    fun setAutoHardwareSwitching(enable: Boolean) {
+        playerManager.setAutoHardwareSwitching(enable)
+    }
+    
     /**
      * 타겟 LUFS 값 설정
      * @param lufsValue LUFS 값